@@ -95,6 +95,7 @@ foreach(TOOL_BUILD_NAME ${TOOLS_BUILD_LIST})
 endforeach()
 
 option(BUILD_TESTING       "Build unit tests"                                            0)
+option(BUILD_BENCHMARKS    "Build benchmarks, requires BUILD_TESTING"                    0)
 option(USE_SCRIPTPCH       "Use precompiled headers when compiling scripts"              1)
 option(USE_COREPCH         "Use precompiled headers when compiling servers"              1)
 option(WITH_WARNINGS       "Show all warnings during compile"                            0)
@@ -0,0 +1,4 @@
+--
+DELETE FROM `command` WHERE `name` = 'server dbstats';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('server dbstats', 3, 'Syntax: .server dbstats [login|world|character] [#count]\r\n\r\nShows the queue size and queue wait times of each database lane, and the #count (default 10) statements with the highest total execution time.');
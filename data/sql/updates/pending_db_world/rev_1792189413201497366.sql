@@ -0,0 +1,4 @@
+--
+DELETE FROM `command` WHERE `name` = 'mmap cache';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('mmap cache', 3, 'Syntax: .mmap cache\r\n\r\nShows the number of paths in the path cache, its hits, misses and hit rate, and the number of paths dropped when their navmesh tiles were unloaded.');
@@ -12,6 +12,7 @@
 
 set(BUILD_TOOLS_MAPS 0)
 set(BUILD_TOOLS_DB_IMPORT 0)
+set(BUILD_TOOLS_LOADGEN 0)
 
 # Returns the base path to the tools directory in the source directory
 function(GetToolsBasePath variable)
@@ -102,6 +103,8 @@ function(CheckToolsBuildList)
     if (${TOOL_BUILD_VARIABLE} MATCHES "enabled")
       if (${TOOL_BUILD_NAME} MATCHES "dbimport")
         set(BUILD_TOOLS_DB_IMPORT 1 PARENT_SCOPE)
+      elseif (${TOOL_BUILD_NAME} MATCHES "loadgen")
+        set(BUILD_TOOLS_LOADGEN 1 PARENT_SCOPE)
       else()
         set(BUILD_TOOLS_MAPS 1 PARENT_SCOPE)
       endif()
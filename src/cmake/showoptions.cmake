@@ -64,6 +64,12 @@ else()
   message("* Build unit tests                : No  (default)")
 endif()
 
+if( BUILD_TESTING AND BUILD_BENCHMARKS )
+  message("* Build benchmarks                : Yes")
+else()
+  message("* Build benchmarks                : No  (default)")
+endif()
+
 if( USE_COREPCH )
   message("* Build core w/PCH                : Yes (default)")
 else()
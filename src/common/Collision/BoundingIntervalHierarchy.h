@@ -23,6 +23,7 @@
 #include "G3D/Vector3.h"
 
 #include "Define.h"
+#include "RayPacket.h"
 
 #include <algorithm>
 #include <cmath>
@@ -122,45 +123,20 @@ public:
     template<typename RayCallback>
     void intersectRay(const G3D::Ray& r, RayCallback& intersectCallback, float& maxDist, bool stopAtFirstHit) const
     {
-        float intervalMin = -1.f;
-        float intervalMax = -1.f;
+        float intervalMin;
+        float intervalMax;
+        if (!clipRayToBounds(r, maxDist, intervalMin, intervalMax))
+        {
+            return;
+        }
+
         G3D::Vector3 org = r.origin();
         G3D::Vector3 dir = r.direction();
         G3D::Vector3 invDir;
         for (int i = 0; i < 3; ++i)
         {
             invDir[i] = 1.f / dir[i];
-            if (G3D::fuzzyNe(dir[i], 0.0f))
-            {
-                float t1 = (bounds.low()[i]  - org[i]) * invDir[i];
-                float t2 = (bounds.high()[i] - org[i]) * invDir[i];
-                if (t1 > t2)
-                {
-                    std::swap(t1, t2);
-                }
-                if (t1 > intervalMin)
-                {
-                    intervalMin = t1;
-                }
-                if (t2 < intervalMax || intervalMax < 0.f)
-                {
-                    intervalMax = t2;
-                }
-                // intervalMax can only become smaller for other axis,
-                //  and intervalMin only larger respectively, so stop early
-                if (intervalMax <= 0 || intervalMin >= maxDist)
-                {
-                    return;
-                }
-            }
-        }
-
-        if (intervalMin > intervalMax)
-        {
-            return;
         }
-        intervalMin = std::max(intervalMin, 0.f);
-        intervalMax = std::min(intervalMax, maxDist);
 
         uint32 offsetFront[3];
         uint32 offsetBack[3];
@@ -373,6 +349,170 @@ public:
             node = stack[stackPos].node;
         }
     }
+    /**
+     * Same as intersectRay for the lanes of a packet selected by rayMask, maxDist holds the distance of each lane.
+     * The callback gets the lanes reaching a leaf and returns the lanes it hit, with stopAtFirstHit those lanes stop there.
+     * A node is visited while any lane overlaps it, each lane keeps its own interval.
+     */
+    template<typename PacketCallback>
+    void intersectRayPacket(RayPacket const& packet, PacketCallback& intersectCallback, float* maxDist, uint32 rayMask, bool stopAtFirstHit) const
+    {
+        using namespace RayLanes;
+
+        alignas(16) float intervalMin[RAY_PACKET_SIZE];
+        alignas(16) float intervalMax[RAY_PACKET_SIZE];
+        alignas(16) float invDir[3][RAY_PACKET_SIZE];
+        for (uint32 lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                invDir[i][lane] = 1.f / packet.Rays[lane].direction()[i];
+            }
+
+            intervalMin[lane] = 0.f;
+            intervalMax[lane] = 0.f;
+            if ((rayMask & (1 << lane)) && !clipRayToBounds(packet.Rays[lane], maxDist[lane], intervalMin[lane], intervalMax[lane]))
+            {
+                rayMask &= ~(1 << lane);
+            }
+        }
+
+        if (!rayMask)
+        {
+            return;
+        }
+
+        Lanes const org[3] = { Load(packet.OriginX), Load(packet.OriginY), Load(packet.OriginZ) };
+        Lanes const inv[3] = { Load(invDir[0]), Load(invDir[1]), Load(invDir[2]) };
+        // lanes going down an axis meet the right child first, see offsetFront in intersectRay
+        Lanes const negative[3] = { SignMask(Load(packet.DirX)), SignMask(Load(packet.DirY)), SignMask(Load(packet.DirZ)) };
+        uint32 const negativeMask[3] = { Mask(negative[0]), Mask(negative[1]), Mask(negative[2]) };
+
+        PacketStackNode stack[MAX_STACK_SIZE];
+        int stackPos = 0;
+        int node = 0;
+        Lanes tMin = Load(intervalMin);
+        Lanes tMax = Load(intervalMax);
+        uint32 nodeMask = rayMask; // lanes whose interval overlaps the current node
+
+        while (true)
+        {
+            while (true)
+            {
+                uint32 tn = tree[node];
+                uint32 axis = (tn & (3 << 30)) >> 30; // cppcheck-suppress integerOverflow
+                bool BVH2 = tn & (1 << 29); // cppcheck-suppress integerOverflow
+                int offset = tn & ~(7 << 29); // cppcheck-suppress integerOverflow
+                if (!BVH2)
+                {
+                    if (axis < 3)
+                    {
+                        // "normal" interior node
+                        Lanes tLeft = Mul(Sub(Set(intBitsToFloat(tree[node + 1])), org[axis]), inv[axis]);
+                        Lanes tRight = Mul(Sub(Set(intBitsToFloat(tree[node + 2])), org[axis]), inv[axis]);
+                        Lanes tf = Select(negative[axis], tRight, tLeft);
+                        Lanes tb = Select(negative[axis], tLeft, tRight);
+                        Lanes frontMax = Min(tf, tMax);
+                        Lanes backMin = Max(tb, tMin);
+                        uint32 frontMask = nodeMask & Mask(LessEqual(tMin, frontMax));
+                        uint32 backMask = nodeMask & Mask(LessEqual(backMin, tMax));
+                        // all lanes pass between clip zones
+                        if (!frontMask && !backMask)
+                        {
+                            break;
+                        }
+
+                        PacketStackNode left{ uint32(offset), (frontMask & ~negativeMask[axis]) | (backMask & negativeMask[axis]), {}, {} };
+                        Store(left.tnear, Select(negative[axis], backMin, tMin));
+                        Store(left.tfar, Select(negative[axis], tMax, frontMax));
+                        PacketStackNode right{ uint32(offset + 3), (backMask & ~negativeMask[axis]) | (frontMask & negativeMask[axis]), {}, {} };
+                        Store(right.tnear, Select(negative[axis], tMin, backMin));
+                        Store(right.tfar, Select(negative[axis], frontMax, tMax));
+
+                        // go to the near child of the first lane, keep the other one for later
+                        bool leftFirst = !(negativeMask[axis] & nodeMask & (~nodeMask + 1));
+                        PacketStackNode const& first = leftFirst ? left : right;
+                        PacketStackNode const& second = leftFirst ? right : left;
+                        if (first.mask && second.mask)
+                        {
+                            stack[stackPos++] = second;
+                        }
+
+                        PacketStackNode const& next = first.mask ? first : second;
+                        node = next.node;
+                        nodeMask = next.mask;
+                        tMin = Load(next.tnear);
+                        tMax = Load(next.tfar);
+                        continue;
+                    }
+                    else
+                    {
+                        // leaf - test some objects
+                        int n = tree[node + 1];
+                        while (n > 0)
+                        {
+                            uint32 hits = intersectCallback(packet, objects[offset], maxDist, nodeMask, stopAtFirstHit);
+                            if (stopAtFirstHit && hits)
+                            {
+                                rayMask &= ~hits;
+                                nodeMask &= ~hits;
+                                if (!rayMask)
+                                {
+                                    return;
+                                }
+
+                                if (!nodeMask)
+                                {
+                                    break;
+                                }
+                            }
+                            --n;
+                            ++offset;
+                        }
+                        break;
+                    }
+                }
+                else
+                {
+                    if (axis > 2)
+                    {
+                        return;    // should not happen
+                    }
+                    Lanes tLow = Mul(Sub(Set(intBitsToFloat(tree[node + 1])), org[axis]), inv[axis]);
+                    Lanes tHigh = Mul(Sub(Set(intBitsToFloat(tree[node + 2])), org[axis]), inv[axis]);
+                    node = offset;
+                    tMin = Max(Select(negative[axis], tHigh, tLow), tMin);
+                    tMax = Min(Select(negative[axis], tLow, tHigh), tMax);
+                    nodeMask &= Mask(LessEqual(tMin, tMax));
+                    if (!nodeMask)
+                    {
+                        break;
+                    }
+                    continue;
+                }
+            } // traversal loop
+
+            // pop back the first node still reached by some lane
+            while (true)
+            {
+                // stack is empty?
+                if (stackPos == 0)
+                {
+                    return;
+                }
+
+                PacketStackNode const& entry = stack[--stackPos];
+                tMin = Load(entry.tnear);
+                nodeMask = entry.mask & rayMask & Mask(LessEqual(tMin, Load(maxDist)));
+                if (nodeMask)
+                {
+                    node = entry.node;
+                    tMax = Load(entry.tfar);
+                    break;
+                }
+            }
+        }
+    }
 
     bool writeToFile(FILE* wf) const;
     bool readFromFile(FILE* rf);
@@ -395,6 +535,57 @@ protected:
         float tnear;
         float tfar;
     };
+    struct PacketStackNode
+    {
+        uint32 node;
+        uint32 mask;
+        alignas(16) float tnear[RAY_PACKET_SIZE];
+        alignas(16) float tfar[RAY_PACKET_SIZE];
+    };
+
+    // Clips the ray to the tree bounds, false when it misses them within maxDist
+    bool clipRayToBounds(G3D::Ray const& r, float maxDist, float& intervalMin, float& intervalMax) const
+    {
+        intervalMin = -1.f;
+        intervalMax = -1.f;
+        G3D::Vector3 org = r.origin();
+        G3D::Vector3 dir = r.direction();
+        for (int i = 0; i < 3; ++i)
+        {
+            if (G3D::fuzzyNe(dir[i], 0.0f))
+            {
+                float invDir = 1.f / dir[i];
+                float t1 = (bounds.low()[i]  - org[i]) * invDir;
+                float t2 = (bounds.high()[i] - org[i]) * invDir;
+                if (t1 > t2)
+                {
+                    std::swap(t1, t2);
+                }
+                if (t1 > intervalMin)
+                {
+                    intervalMin = t1;
+                }
+                if (t2 < intervalMax || intervalMax < 0.f)
+                {
+                    intervalMax = t2;
+                }
+                // intervalMax can only become smaller for other axis,
+                //  and intervalMin only larger respectively, so stop early
+                if (intervalMax <= 0 || intervalMin >= maxDist)
+                {
+                    return false;
+                }
+            }
+        }
+
+        if (intervalMin > intervalMax)
+        {
+            return false;
+        }
+        intervalMin = std::max(intervalMin, 0.f);
+        intervalMax = std::min(intervalMax, maxDist);
+        return true;
+    }
 
     class BuildStats
     {
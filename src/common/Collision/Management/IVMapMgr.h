@@ -21,6 +21,7 @@
 #include "Define.h"
 #include "ModelIgnoreFlags.h"
 #include "Optional.h"
+#include <G3D/Vector3.h>
 #include <string>
 
 //===========================================================
@@ -96,6 +97,11 @@ namespace VMAP
         virtual void unloadMap(unsigned int pMapId) = 0;
 
         virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, ModelIgnoreFlags ignoreFlags) = 0;
+        /**
+        line of sight from one position to many targets, results[i] is the answer for targets[i].
+        Cheaper than one call per target, the rays are traced together through the trees.
+        */
+        virtual void isInLineOfSight(unsigned int pMapId, float x, float y, float z, G3D::Vector3 const* targets, bool* results, std::size_t count, ModelIgnoreFlags ignoreFlags) = 0;
         virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
         /**
         test if we hit an object. return true if we hit one. rx, ry, rz will hold the hit position or the dest position, if no intersection was found
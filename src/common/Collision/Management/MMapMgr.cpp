@@ -17,20 +17,43 @@
 
 #include "MMapMgr.h"
 #include "Config.h"
+#include "DetourNavMeshQuery.h"
 #include "Errors.h"
 #include "Log.h"
 #include "MapDefines.h"
+#include <mutex>
 
 namespace MMAP
 {
-    // ######################## MMapMgr ########################
-    MMapMgr::~MMapMgr()
+    namespace
     {
-        for (MMapDataSet::iterator i = loadedMMaps.begin(); i != loadedMMaps.end(); ++i)
+        // queries of the calling thread, one per map id, re-initialized when the map got a new navmesh
+        struct ThreadNavMeshQueries
         {
-            delete i->second;
-        }
+            struct Entry
+            {
+                dtNavMeshQuery* query = nullptr;
+                uint32 serial = 0;
+            };
+
+            ~ThreadNavMeshQueries()
+            {
+                for (auto& [mapId, entry] : queries)
+                {
+                    dtFreeNavMeshQuery(entry.query);
+                }
+            }
+
+            std::unordered_map<uint32, Entry> queries;
+        };
+
+        thread_local ThreadNavMeshQueries threadQueries;
+        std::atomic<uint32> nextNavMeshSerial{1};
+    }
 
+    // ######################## MMapMgr ########################
+    MMapMgr::~MMapMgr()
+    {
         // by now we should not have maps loaded
         // if we had, tiles in MMapData->mmapLoadedTiles, their actual data is lost!
     }
@@ -46,27 +69,41 @@ namespace MMAP
         thread_safe_environment = false;
     }
 
-    MMapDataSet::const_iterator MMapMgr::GetMMapData(uint32 mapId) const
+    std::shared_ptr<MMapData> MMapMgr::GetMMapData(uint32 mapId) const
     {
-        // return the iterator if found or end() if not found/NULL
+        // return the data if found or nullptr if not found/NULL
+        std::shared_lock<std::shared_mutex> lock(loadedMMapsLock);
         MMapDataSet::const_iterator itr = loadedMMaps.find(mapId);
-        if (itr != loadedMMaps.cend() && !itr->second)
+        if (itr == loadedMMaps.cend())
         {
-            itr = loadedMMaps.cend();
+            return nullptr;
         }
 
-        return itr;
+        return itr->second;
     }
 
-    bool MMapMgr::loadMapData(uint32 mapId)
+    uint32 MMapMgr::getLoadedMapsCount() const
+    {
+        std::shared_lock<std::shared_mutex> lock(loadedMMapsLock);
+        return loadedMMaps.size();
+    }
+
+    std::shared_ptr<MMapData> MMapMgr::loadMapData(uint32 mapId)
     {
         // we already have this map loaded?
+        if (std::shared_ptr<MMapData> mmap = GetMMapData(mapId))
+        {
+            return mmap;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(loadedMMapsLock);
         MMapDataSet::iterator itr = loadedMMaps.find(mapId);
         if (itr != loadedMMaps.end())
         {
+            // loaded by another thread meanwhile
             if (itr->second)
             {
-                return true;
+                return itr->second;
             }
         }
         else
@@ -88,7 +125,7 @@ namespace MMAP
         if (!file)
         {
             LOG_DEBUG("maps", "MMAP:loadMapData: Error: Could not open mmap file '{}'", fileName);
-            return false;
+            return nullptr;
         }
 
         dtNavMeshParams params;
@@ -97,7 +134,7 @@ namespace MMAP
         if (count != 1)
         {
             LOG_DEBUG("maps", "MMAP:loadMapData: Error: Could not read params from file '{}'", fileName);
-            return false;
+            return nullptr;
         }
 
         dtNavMesh* mesh = dtAllocNavMesh();
@@ -106,15 +143,14 @@ namespace MMAP
         {
             dtFreeNavMesh(mesh);
             LOG_ERROR("maps", "MMAP:loadMapData: Failed to initialize dtNavMesh for mmap {:03} from file {}", mapId, fileName);
-            return false;
+            return nullptr;
         }
 
         LOG_DEBUG("maps", "MMAP:loadMapData: Loaded {:03}.mmap", mapId);
 
         // store inside our map list
-        MMapData* mmap_data = new MMapData(mesh);
-        itr->second = mmap_data;
-        return true;
+        itr->second = std::make_shared<MMapData>(mesh, nextNavMeshSerial++);
+        return itr->second;
     }
 
     uint32 MMapMgr::packTileID(int32 x, int32 y)
@@ -125,24 +161,28 @@ namespace MMAP
     bool MMapMgr::loadMap(uint32 mapId, int32 x, int32 y)
     {
         // make sure the mmap is loaded and ready to load tiles
-        if (!loadMapData(mapId))
+        std::shared_ptr<MMapData> mmap = loadMapData(mapId);
+        if (!mmap)
         {
             return false;
         }
 
-        // get this mmap data
-        MMapData* mmap = loadedMMaps[mapId];
         ASSERT(mmap->navMesh);
 
-        // check if we already have this tile loaded
+        // check if we already have this tile loaded, without waiting for the queries reading the navmesh
         uint32 packedGridPos = packTileID(x, y);
-        if (mmap->loadedTileRefs.find(packedGridPos) != mmap->loadedTileRefs.end())
         {
-            LOG_ERROR("maps", "MMAP:loadMap: Asked to load already loaded navmesh tile. {:03}{:02}{:02}.mmtile", mapId, x, y);
-            return false;
+            std::lock_guard<std::mutex> refsLock(mmap->tileRefsLock);
+            MMapTileSet::iterator tile = mmap->loadedTileRefs.find(packedGridPos);
+            if (tile != mmap->loadedTileRefs.end())
+            {
+                ++tile->second.refCount;
+                return true;
+            }
         }
 
         // load this tile :: mmaps/MMMXXYY.mmtile
+        // the file is read without holding the lock, queries on loaded tiles go on meanwhile
         std::string fileName = Acore::StringFormat(TILE_FILE_NAME_FORMAT, sConfigMgr->GetOption<std::string>("DataDir", "."), mapId, x, y);
         FILE* file = fopen(fileName.c_str(), "rb");
         if (!file)
@@ -176,17 +216,30 @@ namespace MMAP
         {
             LOG_ERROR("maps", "MMAP:loadMap: Bad header or data in mmap {:03}{:02}{:02}.mmtile", mapId, x, y);
             fclose(file);
+            dtFree(data);
             return false;
         }
 
         fclose(file);
 
+        std::unique_lock<std::shared_mutex> lock(mmap->tilesLock);
+        std::lock_guard<std::mutex> refsLock(mmap->tileRefsLock);
+
+        // another thread may have loaded the same tile meanwhile
+        MMapTileSet::iterator tile = mmap->loadedTileRefs.find(packedGridPos);
+        if (tile != mmap->loadedTileRefs.end())
+        {
+            ++tile->second.refCount;
+            dtFree(data);
+            return true;
+        }
+
         dtTileRef tileRef = 0;
 
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
         if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef)))
         {
-            mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
+            mmap->loadedTileRefs.emplace(packedGridPos, MMapTile{ tileRef, 1 });
             ++loadedTiles;
             dtMeshHeader* header = (dtMeshHeader*)data;
             LOG_DEBUG("maps", "MMAP:loadMap: Loaded mmtile {:03}[{:02},{:02}] into {:03}[{:02},{:02}]", mapId, x, y, mapId, header->x, header->y);
@@ -201,29 +254,52 @@ namespace MMAP
     bool MMapMgr::unloadMap(uint32 mapId, int32 x, int32 y)
     {
         // check if we have this map loaded
-        MMapDataSet::const_iterator itr = GetMMapData(mapId);
-        if (itr == loadedMMaps.end())
+        std::shared_ptr<MMapData> mmap = GetMMapData(mapId);
+        if (!mmap)
         {
             // file may not exist, therefore not loaded
             LOG_DEBUG("maps", "MMAP:unloadMap: Asked to unload not loaded navmesh map. {:03}{:02}{:02}.mmtile", mapId, x, y);
             return false;
         }
 
-        MMapData* mmap = itr->second;
-
         // check if we have this tile loaded
         uint32 packedGridPos = packTileID(x, y);
-        if (mmap->loadedTileRefs.find(packedGridPos) == mmap->loadedTileRefs.end())
         {
-            // file may not exist, therefore not loaded
-            LOG_DEBUG("maps", "MMAP:unloadMap: Asked to unload not loaded navmesh tile. {:03}{:02}{:02}.mmtile", mapId, x, y);
-            return false;
+            std::lock_guard<std::mutex> refsLock(mmap->tileRefsLock);
+            MMapTileSet::iterator tile = mmap->loadedTileRefs.find(packedGridPos);
+            if (tile == mmap->loadedTileRefs.end())
+            {
+                // file may not exist, therefore not loaded
+                LOG_DEBUG("maps", "MMAP:unloadMap: Asked to unload not loaded navmesh tile. {:03}{:02}{:02}.mmtile", mapId, x, y);
+                return false;
+            }
+
+            // still used by another grid
+            if (--tile->second.refCount)
+            {
+                return true;
+            }
         }
 
-        dtTileRef tileRef = mmap->loadedTileRefs[packedGridPos];
+        // waits for the queries reading the navmesh
+        std::unique_lock<std::shared_mutex> lock(mmap->tilesLock);
+        std::lock_guard<std::mutex> refsLock(mmap->tileRefsLock);
+
+        // a grid may have loaded the tile again meanwhile, or another unload removed it already
+        MMapTileSet::iterator tile = mmap->loadedTileRefs.find(packedGridPos);
+        if (tile == mmap->loadedTileRefs.end() || tile->second.refCount)
+        {
+            return true;
+        }
+
+        if (TileUnloadedPtr)
+        {
+            dtMeshTile const* meshTile = mmap->navMesh->getTileByRef(tile->second.ref);
+            TileUnloadedPtr(mapId, meshTile->header->x, meshTile->header->y);
+        }
 
         // unload, and mark as non loaded
-        if (dtStatusFailed(mmap->navMesh->removeTile(tileRef, nullptr, nullptr)))
+        if (dtStatusFailed(mmap->navMesh->removeTile(tile->second.ref, nullptr, nullptr)))
         {
             // this is technically a memory leak
             // if the grid is later reloaded, dtNavMesh::addTile will return error but no extra memory is used
@@ -232,7 +308,7 @@ namespace MMAP
             ABORT();
         }
 
-        mmap->loadedTileRefs.erase(packedGridPos);
+        mmap->loadedTileRefs.erase(tile);
         --loadedTiles;
         LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded mmtile {:03}[{:02},{:02}] from {:03}", mapId, x, y, mapId);
         return true;
@@ -240,22 +316,35 @@ namespace MMAP
 
     bool MMapMgr::unloadMap(uint32 mapId)
     {
-        MMapDataSet::iterator itr = loadedMMaps.find(mapId);
-        if (itr == loadedMMaps.end() || !itr->second)
+        std::shared_ptr<MMapData> mmap;
         {
-            // file may not exist, therefore not loaded
-            LOG_DEBUG("maps", "MMAP:unloadMap: Asked to unload not loaded navmesh map {:03}", mapId);
-            return false;
+            std::unique_lock<std::shared_mutex> lock(loadedMMapsLock);
+            MMapDataSet::iterator itr = loadedMMaps.find(mapId);
+            if (itr == loadedMMaps.end() || !itr->second)
+            {
+                // file may not exist, therefore not loaded
+                LOG_DEBUG("maps", "MMAP:unloadMap: Asked to unload not loaded navmesh map {:03}", mapId);
+                return false;
+            }
+
+            mmap.swap(itr->second);
         }
 
-        // unload all tiles from given map
-        MMapData* mmap = itr->second;
+        // unload all tiles from given map, the navmesh itself is freed with the last handle using it
+        std::unique_lock<std::shared_mutex> lock(mmap->tilesLock);
+        std::lock_guard<std::mutex> refsLock(mmap->tileRefsLock);
         for (auto& i : mmap->loadedTileRefs)
         {
             uint32 x = (i.first >> 16);
             uint32 y = (i.first & 0x0000FFFF);
 
-            if (dtStatusFailed(mmap->navMesh->removeTile(i.second, nullptr, nullptr)))
+            if (TileUnloadedPtr)
+            {
+                dtMeshTile const* meshTile = mmap->navMesh->getTileByRef(i.second.ref);
+                TileUnloadedPtr(mapId, meshTile->header->x, meshTile->header->y);
+            }
+
+            if (dtStatusFailed(mmap->navMesh->removeTile(i.second.ref, nullptr, nullptr)))
             {
                 LOG_ERROR("maps", "MMAP:unloadMap: Could not unload {:03}{:02}{:02}.mmtile from navmesh", mapId, x, y);
             }
@@ -266,81 +355,54 @@ namespace MMAP
             }
         }
 
-        delete mmap;
-        itr->second = nullptr;
+        mmap->loadedTileRefs.clear();
         LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded {:03}.mmap", mapId);
 
         return true;
     }
 
-    bool MMapMgr::unloadMapInstance(uint32 mapId, uint32 instanceId)
-    {
-        // check if we have this map loaded
-        MMapDataSet::const_iterator itr = GetMMapData(mapId);
-        if (itr == loadedMMaps.end())
-        {
-            // file may not exist, therefore not loaded
-            LOG_DEBUG("maps", "MMAP:unloadMapInstance: Asked to unload not loaded navmesh map {:03}", mapId);
-            return false;
-        }
-
-        MMapData* mmap = itr->second;
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
-        {
-            LOG_DEBUG("maps", "MMAP:unloadMapInstance: Asked to unload not loaded dtNavMeshQuery mapId {:03} instanceId {}", mapId, instanceId);
-            return false;
-        }
-
-        dtNavMeshQuery* query = mmap->navMeshQueries[instanceId];
-
-        dtFreeNavMeshQuery(query);
-        mmap->navMeshQueries.erase(instanceId);
-        LOG_DEBUG("maps", "MMAP:unloadMapInstance: Unloaded mapId {:03} instanceId {}", mapId, instanceId);
-
-        return true;
-    }
-
     dtNavMesh const* MMapMgr::GetNavMesh(uint32 mapId)
     {
-        MMapDataSet::const_iterator itr = GetMMapData(mapId);
-        if (itr == loadedMMaps.end())
+        std::shared_ptr<MMapData> mmap = GetMMapData(mapId);
+        if (!mmap)
         {
             return nullptr;
         }
 
-        return itr->second->navMesh;
+        return mmap->navMesh;
     }
 
-    dtNavMeshQuery const* MMapMgr::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
+    NavMeshQueryHandle MMapMgr::GetNavMeshQuery(uint32 mapId)
     {
-        MMapDataSet::const_iterator itr = GetMMapData(mapId);
-        if (itr == loadedMMaps.end())
+        std::shared_ptr<MMapData> mmap = GetMMapData(mapId);
+        if (!mmap)
         {
-            return nullptr;
+            return NavMeshQueryHandle();
         }
 
-        MMapData* mmap = itr->second;
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
+        ThreadNavMeshQueries::Entry& entry = threadQueries.queries[mapId];
+        if (entry.serial != mmap->serial)
         {
-            // check again after acquiring mutex
-            if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
+            if (!entry.query)
             {
                 // allocate mesh query
-                dtNavMeshQuery* query = dtAllocNavMeshQuery();
-                ASSERT(query);
-
-                if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
-                {
-                    dtFreeNavMeshQuery(query);
-                    LOG_ERROR("maps", "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId {:03} instanceId {}", mapId, instanceId);
-                    return nullptr;
-                }
+                entry.query = dtAllocNavMeshQuery();
+                ASSERT(entry.query);
+            }
 
-                LOG_DEBUG("maps", "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId {:03} instanceId {}", mapId, instanceId);
-                mmap->navMeshQueries.insert(std::pair<uint32, dtNavMeshQuery*>(instanceId, query));
+            // init only reads the navmesh parameters, no lock needed
+            if (dtStatusFailed(entry.query->init(mmap->navMesh, 1024)))
+            {
+                entry.serial = 0;
+                LOG_ERROR("maps", "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId {:03}", mapId);
+                return NavMeshQueryHandle();
             }
+
+            entry.serial = mmap->serial;
+            LOG_DEBUG("maps", "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId {:03}", mapId);
         }
 
-        return mmap->navMeshQueries[instanceId];
+        std::shared_lock<std::shared_mutex> lock(mmap->tilesLock);
+        return NavMeshQueryHandle(std::move(mmap), std::move(lock), entry.query);
     }
 }
@@ -22,6 +22,10 @@
 #include "DetourAlloc.h"
 #include "DetourExtended.h"
 #include "DetourNavMesh.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -42,37 +46,71 @@ namespace MMAP
     static char const* const MAP_FILE_NAME_FORMAT = "{}/mmaps/{:03}.mmap";
     static char const* const TILE_FILE_NAME_FORMAT = "{}/mmaps/{:03}{:02}{:02}.mmtile";
 
-    typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
-    typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
+    struct MMapTile
+    {
+        dtTileRef ref;
+        uint32 refCount;    // grids using the tile, it is removed from the navmesh when the last one unloads it
+    };
+
+    typedef std::unordered_map<uint32, MMapTile> MMapTileSet;
 
     // dummy struct to hold map's mmap data
     struct MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) { }
+        MMapData(dtNavMesh* mesh, uint32 meshSerial) : navMesh(mesh), serial(meshSerial) { }
 
         ~MMapData()
         {
-            for (auto& navMeshQuerie : navMeshQueries)
-            {
-                dtFreeNavMeshQuery(navMeshQuerie.second);
-            }
-
             if (navMesh)
             {
                 dtFreeNavMesh(navMesh);
             }
         }
 
-        // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
-        NavMeshQuerySet navMeshQueries; // instanceId to query
         dtNavMesh* navMesh;
+        uint32 serial;              // tells per thread queries initialized on an earlier navmesh of the same map apart
         MMapTileSet loadedTileRefs; // maps [map grid coords] to [dtTile]
+        std::shared_mutex tilesLock; // held shared while the navmesh is read, exclusively to add or remove tiles
+        std::mutex tileRefsLock;     // guards loadedTileRefs, taken after tilesLock when both are needed
     };
 
-    typedef std::unordered_map<uint32, MMapData*> MMapDataSet;
+    typedef std::unordered_map<uint32, std::shared_ptr<MMapData>> MMapDataSet;
+
+    /**
+     * Read access to the navmesh of a map through a dtNavMeshQuery owned by the calling thread.
+     * Tiles are neither added nor removed while a handle is locked, keep it for one path computation only
+     * and unlock it before anything that may load or unload tiles of the same map, like creating a grid.
+     */
+    class NavMeshQueryHandle
+    {
+    public:
+        NavMeshQueryHandle() = default;
+        NavMeshQueryHandle(std::shared_ptr<MMapData> data, std::shared_lock<std::shared_mutex> lock, dtNavMeshQuery const* query) :
+            _data(std::move(data)), _lock(std::move(lock)), _query(query) { }
+
+        explicit operator bool() const { return _query != nullptr; }
+
+        [[nodiscard]] dtNavMesh const* GetNavMesh() const { return _data ? _data->navMesh : nullptr; }
+        [[nodiscard]] dtNavMeshQuery const* GetQuery() const { return _query; }
+
+        // lets tiles be added and removed again, only the navmesh parameters may be read afterwards
+        void Unlock()
+        {
+            if (_lock.owns_lock())
+                _lock.unlock();
+
+            _query = nullptr;
+        }
+
+    private:
+        std::shared_ptr<MMapData> _data;
+        std::shared_lock<std::shared_mutex> _lock;
+        dtNavMeshQuery const* _query = nullptr;
+    };
 
     // singleton class
     // holds all all access to mmap loading unloading and meshes
+    // tiles are refcounted and can be loaded, unloaded and queried from any thread
     class MMapMgr
     {
     public:
@@ -83,22 +121,27 @@ namespace MMAP
         bool loadMap(uint32 mapId, int32 x, int32 y);
         bool unloadMap(uint32 mapId, int32 x, int32 y);
         bool unloadMap(uint32 mapId);
-        bool unloadMapInstance(uint32 mapId, uint32 instanceId);
 
-        // the returned [dtNavMeshQuery const*] is NOT threadsafe
-        dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
+        // query of the calling thread, created on first use for each map and freed when the thread exits
+        NavMeshQueryHandle GetNavMeshQuery(uint32 mapId);
+        // only tells whether the map has a navmesh, read it through GetNavMeshQuery
         dtNavMesh const* GetNavMesh(uint32 mapId);
 
         [[nodiscard]] uint32 getLoadedTilesCount() const { return loadedTiles; }
-        [[nodiscard]] uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
+        [[nodiscard]] uint32 getLoadedMapsCount() const;
+
+        // called with the navmesh tile coordinates of every tile removed from a navmesh, before the tile is removed
+        typedef void(*TileUnloadedFn)(uint32 mapId, int32 tileX, int32 tileY);
+        TileUnloadedFn TileUnloadedPtr{nullptr};
 
     private:
-        bool loadMapData(uint32 mapId);
+        std::shared_ptr<MMapData> loadMapData(uint32 mapId);
         uint32 packTileID(int32 x, int32 y);
-        [[nodiscard]] MMapDataSet::const_iterator GetMMapData(uint32 mapId) const;
+        [[nodiscard]] std::shared_ptr<MMapData> GetMMapData(uint32 mapId) const;
 
         MMapDataSet loadedMMaps;
-        uint32 loadedTiles{0};
+        mutable std::shared_mutex loadedMMapsLock;
+        std::atomic<uint32> loadedTiles{0};
         bool thread_safe_environment{true};
     };
 }
@@ -23,7 +23,9 @@
 #include "ModelInstance.h"
 #include "WorldModel.h"
 #include <G3D/Vector3.h>
+#include <algorithm>
 #include <iomanip>
+#include <memory>
 #include <sstream>
 #include <string>
 
@@ -194,6 +196,46 @@ namespace VMAP
         return true;
     }
 
+    void VMapMgr2::isInLineOfSight(unsigned int mapId, float x, float y, float z, G3D::Vector3 const* targets, bool* results, std::size_t count, ModelIgnoreFlags ignoreFlags)
+    {
+        std::fill(results, results + count, true);
+
+#if defined(ENABLE_VMAP_CHECKS)
+        if (!isLineOfSightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LOS))
+        {
+            return;
+        }
+#endif
+
+        InstanceTreeMap::const_iterator instanceTree = GetMapTree(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+        {
+            return;
+        }
+
+        Vector3 pos1 = convertPositionToInternalRep(x, y, z);
+        std::vector<Vector3> positions;
+        std::vector<std::size_t> indexes;
+        positions.reserve(count);
+        indexes.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Vector3 pos2 = convertPositionToInternalRep(targets[i].x, targets[i].y, targets[i].z);
+            if (pos1 != pos2)
+            {
+                positions.push_back(pos2);
+                indexes.push_back(i);
+            }
+        }
+
+        std::unique_ptr<bool[]> visible = std::make_unique<bool[]>(positions.size());
+        instanceTree->second->isInLineOfSight(pos1, positions.data(), visible.get(), positions.size(), ignoreFlags);
+        for (std::size_t i = 0; i < indexes.size(); ++i)
+        {
+            results[indexes[i]] = visible[i];
+        }
+    }
+
     /**
     get the hit position and return true if we hit something
     otherwise the result pos will be the dest pos
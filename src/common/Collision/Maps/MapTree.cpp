@@ -51,6 +51,23 @@ namespace VMAP
         bool hit;
     };
 
+    class MapPacketCallback
+    {
+    public:
+        MapPacketCallback(ModelInstance* val, ModelIgnoreFlags ignoreFlags): prims(val), flags(ignoreFlags), hits(0) { }
+        uint32 operator()(RayPacket const& packet, uint32 entry, float* distance, uint32 rayMask, bool StopAtFirstHit)
+        {
+            uint32 result = prims[entry].intersectRayPacket(packet, distance, rayMask, StopAtFirstHit, flags);
+            hits |= result;
+            return result;
+        }
+        uint32 getHits() const { return hits; }
+    protected:
+        ModelInstance* prims;
+        ModelIgnoreFlags flags;
+        uint32 hits;
+    };
+
     class LocationInfoCallback
     {
     public:
@@ -146,6 +163,54 @@ namespace VMAP
 
         return !GetIntersectionTime(ray, maxDist, true, ignoreFlags);
     }
+
+    void StaticMapTree::isInLineOfSight(const Vector3& pos1, const Vector3* targets, bool* results, std::size_t count, ModelIgnoreFlags ignoreFlags) const
+    {
+        for (std::size_t first = 0; first < count; first += RAY_PACKET_SIZE)
+        {
+            RayPacket packet;
+            float maxDist[RAY_PACKET_SIZE] = { };
+            uint32 rayMask = 0;
+            std::size_t const lanes = std::min<std::size_t>(RAY_PACKET_SIZE, count - first);
+            for (uint32 lane = 0; lane < lanes; ++lane)
+            {
+                // same early outs as for a single ray
+                Vector3 const& pos2 = targets[first + lane];
+                float distance = (pos2 - pos1).magnitude();
+                if (distance == std::numeric_limits<float>::max() || !std::isfinite(distance))
+                {
+                    results[first + lane] = false;
+                    continue;
+                }
+
+                ASSERT(distance < std::numeric_limits<float>::max());
+                if (distance < 1e-10f)
+                {
+                    results[first + lane] = true;
+                    continue;
+                }
+
+                packet.SetRay(lane, G3D::Ray::fromOriginAndDirection(pos1, (pos2 - pos1) / distance));
+                maxDist[lane] = distance;
+                rayMask |= 1 << lane;
+            }
+
+            if (!rayMask)
+            {
+                continue;
+            }
+
+            MapPacketCallback intersectionCallBack(iTreeValues, ignoreFlags);
+            iTree.intersectRayPacket(packet, intersectionCallBack, maxDist, rayMask, true);
+            for (uint32 lane = 0; lane < lanes; ++lane)
+            {
+                if (rayMask & (1 << lane))
+                {
+                    results[first + lane] = !(intersectionCallBack.getHits() & (1 << lane));
+                }
+            }
+        }
+    }
     //=========================================================
     /**
     When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
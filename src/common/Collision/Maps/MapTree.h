@@ -77,6 +77,8 @@ namespace VMAP
         ~StaticMapTree();
 
         [[nodiscard]] bool isInLineOfSight(const G3D::Vector3& pos1, const G3D::Vector3& pos2, ModelIgnoreFlags ignoreFlags) const;
+        //! Line of sight from pos1 to each of the count targets, traced in packets of RAY_PACKET_SIZE rays
+        void isInLineOfSight(const G3D::Vector3& pos1, const G3D::Vector3* targets, bool* results, std::size_t count, ModelIgnoreFlags ignoreFlags) const;
         bool GetObjectHitPos(const G3D::Vector3& pos1, const G3D::Vector3& pos2, G3D::Vector3& pResultHitPos, float pModifyDist) const;
         [[nodiscard]] float getHeight(const G3D::Vector3& pPos, float maxSearchDist) const;
         bool GetLocationInfo(const G3D::Vector3& pos, LocationInfo& info) const;
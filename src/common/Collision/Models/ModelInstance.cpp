@@ -63,6 +63,51 @@ namespace VMAP
         return hit;
     }
 
+    uint32 ModelInstance::intersectRayPacket(RayPacket const& packet, float* pMaxDist, uint32 rayMask, bool StopAtFirstHit, ModelIgnoreFlags ignoreFlags) const
+    {
+        if (!iModel)
+        {
+            return 0;
+        }
+
+        // same transform as intersectRay, lanes missing the bound are left out
+        RayPacket modPacket;
+        float distance[RAY_PACKET_SIZE] = { };
+        for (uint32 lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+        {
+            if (!(rayMask & (1 << lane)))
+            {
+                continue;
+            }
+
+            Ray const& ray = packet.Rays[lane];
+            if (ray.intersectionTime(iBound) == G3D::inf())
+            {
+                rayMask &= ~(1 << lane);
+                continue;
+            }
+
+            Vector3 p = iInvRot * (ray.origin() - iPos) * iInvScale;
+            modPacket.SetRay(lane, Ray(p, iInvRot * ray.direction()));
+            distance[lane] = pMaxDist[lane] * iInvScale;
+        }
+
+        if (!rayMask)
+        {
+            return 0;
+        }
+
+        uint32 hits = iModel->IntersectRayPacket(modPacket, distance, rayMask, StopAtFirstHit, ignoreFlags);
+        for (uint32 lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+        {
+            if (hits & (1 << lane))
+            {
+                pMaxDist[lane] = distance[lane] * iScale;
+            }
+        }
+        return hits;
+    }
+
     bool ModelInstance::GetLocationInfo(const G3D::Vector3& p, LocationInfo& info) const
     {
         if (!iModel)
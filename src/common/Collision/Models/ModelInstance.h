@@ -24,6 +24,8 @@
 #include <G3D/Ray.h>
 #include <G3D/Vector3.h>
 
+struct RayPacket;
+
 namespace VMAP
 {
     class WorldModel;
@@ -66,6 +68,7 @@ namespace VMAP
         ModelInstance(const ModelSpawn& spawn, WorldModel* model);
         void setUnloaded() { iModel = nullptr; }
         bool intersectRay(const G3D::Ray& pRay, float& pMaxDist, bool StopAtFirstHit, ModelIgnoreFlags ignoreFlags) const;
+        uint32 intersectRayPacket(RayPacket const& packet, float* pMaxDist, uint32 rayMask, bool StopAtFirstHit, ModelIgnoreFlags ignoreFlags) const;
         bool GetLocationInfo(const G3D::Vector3& p, LocationInfo& info) const;
         bool GetLiquidLevel(const G3D::Vector3& p, LocationInfo& info, float& liqHeight) const;
         WorldModel* getWorldModel() { return iModel; }
@@ -84,6 +84,57 @@ namespace VMAP
         return false;
     }
 
+    // IntersectTriangle for the lanes of a packet selected by rayMask, returns the lanes hitting it closer than their distance
+    uint32 IntersectTrianglePacket(MeshTriangle const& tri, std::vector<Vector3>::const_iterator points, RayPacket const& packet, float* distance, uint32 rayMask)
+    {
+        using namespace RayLanes;
+
+        static const float EPS = 1e-5f;
+
+        // same operations as IntersectTriangle, in the same order, so every lane gets the scalar result
+        const Vector3 e1 = points[tri.idx1] - points[tri.idx0];
+        const Vector3 e2 = points[tri.idx2] - points[tri.idx0];
+        const Vector3& p0 = points[tri.idx0];
+
+        const Lanes dirX = Load(packet.DirX);
+        const Lanes dirY = Load(packet.DirY);
+        const Lanes dirZ = Load(packet.DirZ);
+        const Lanes pX = Sub(Mul(dirY, Set(e2.z)), Mul(dirZ, Set(e2.y)));
+        const Lanes pY = Sub(Mul(dirZ, Set(e2.x)), Mul(dirX, Set(e2.z)));
+        const Lanes pZ = Sub(Mul(dirX, Set(e2.y)), Mul(dirY, Set(e2.x)));
+        const Lanes a = Add(Add(Mul(Set(e1.x), pX), Mul(Set(e1.y), pY)), Mul(Set(e1.z), pZ));
+        Lanes reject = Less(Abs(a), Set(EPS));
+
+        const Lanes f = Div(Set(1.0f), a);
+        const Lanes sX = Sub(Load(packet.OriginX), Set(p0.x));
+        const Lanes sY = Sub(Load(packet.OriginY), Set(p0.y));
+        const Lanes sZ = Sub(Load(packet.OriginZ), Set(p0.z));
+        const Lanes u = Mul(f, Add(Add(Mul(sX, pX), Mul(sY, pY)), Mul(sZ, pZ)));
+        reject = Or(reject, Or(Less(u, Set(0.0f)), Greater(u, Set(1.0f))));
+
+        const Lanes qX = Sub(Mul(sY, Set(e1.z)), Mul(sZ, Set(e1.y)));
+        const Lanes qY = Sub(Mul(sZ, Set(e1.x)), Mul(sX, Set(e1.z)));
+        const Lanes qZ = Sub(Mul(sX, Set(e1.y)), Mul(sY, Set(e1.x)));
+        const Lanes v = Mul(f, Add(Add(Mul(dirX, qX), Mul(dirY, qY)), Mul(dirZ, qZ)));
+        reject = Or(reject, Or(Less(v, Set(0.0f)), Greater(Add(u, v), Set(1.0f))));
+
+        const Lanes t = Mul(f, Add(Add(Mul(Set(e2.x), qX), Mul(Set(e2.y), qY)), Mul(Set(e2.z), qZ)));
+        uint32 hits = rayMask & Mask(AndNot(reject, Greater(t, Set(0.0f)))) & Mask(Less(t, Load(distance)));
+        if (hits)
+        {
+            alignas(16) float times[RAY_PACKET_SIZE];
+            Store(times, t);
+            for (uint32 lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+            {
+                if (hits & (1 << lane))
+                {
+                    distance[lane] = times[lane];
+                }
+            }
+        }
+        return hits;
+    }
+
     class TriBoundFunc
     {
     public:
@@ -451,6 +502,33 @@ namespace VMAP
         return callback.hit;
     }
 
+    struct GModelPacketCallback
+    {
+        GModelPacketCallback(const std::vector<MeshTriangle>& tris, const std::vector<Vector3>& vert):
+            vertices(vert.begin()), triangles(tris.begin()), hits(0) { }
+        uint32 operator()(RayPacket const& packet, uint32 entry, float* distance, uint32 rayMask, bool /*StopAtFirstHit*/)
+        {
+            uint32 result = IntersectTrianglePacket(triangles[entry], vertices, packet, distance, rayMask);
+            hits |= result;
+            return result;
+        }
+        std::vector<Vector3>::const_iterator vertices;
+        std::vector<MeshTriangle>::const_iterator triangles;
+        uint32 hits;
+    };
+
+    uint32 GroupModel::IntersectRayPacket(RayPacket const& packet, float* distance, uint32 rayMask, bool stopAtFirstHit) const
+    {
+        if (triangles.empty())
+        {
+            return 0;
+        }
+
+        GModelPacketCallback callback(triangles, vertices);
+        meshTree.intersectRayPacket(packet, callback, distance, rayMask, stopAtFirstHit);
+        return callback.hits;
+    }
+
     inline bool IsInsideOrAboveBound(G3D::AABox const& bounds, const G3D::Point3& point)
     {
         return point.x >= bounds.low().x
@@ -539,6 +617,19 @@ namespace VMAP
         bool hit;
     };
 
+    struct WModelPacketCallBack
+    {
+        WModelPacketCallBack(const std::vector<GroupModel>& mod): models(mod.begin()), hits(0) { }
+        uint32 operator()(RayPacket const& packet, uint32 entry, float* distance, uint32 rayMask, bool StopAtFirstHit)
+        {
+            uint32 result = models[entry].IntersectRayPacket(packet, distance, rayMask, StopAtFirstHit);
+            hits |= result;
+            return result;
+        }
+        std::vector<GroupModel>::const_iterator models;
+        uint32 hits;
+    };
+
     bool WorldModel::IntersectRay(const G3D::Ray& ray, float& distance, bool stopAtFirstHit, ModelIgnoreFlags ignoreFlags) const
     {
         // If the caller asked us to ignore certain objects we should check flags
@@ -563,6 +654,26 @@ namespace VMAP
         return isc.hit;
     }
 
+    uint32 WorldModel::IntersectRayPacket(RayPacket const& packet, float* distance, uint32 rayMask, bool stopAtFirstHit, ModelIgnoreFlags ignoreFlags) const
+    {
+        if ((ignoreFlags & ModelIgnoreFlags::M2) != ModelIgnoreFlags::Nothing)
+        {
+            if (Flags & MOD_M2)
+            {
+                return 0;
+            }
+        }
+
+        if (groupModels.size() == 1)
+        {
+            return groupModels[0].IntersectRayPacket(packet, distance, rayMask, stopAtFirstHit);
+        }
+
+        WModelPacketCallBack isc(groupModels);
+        groupTree.intersectRayPacket(packet, isc, distance, rayMask, stopAtFirstHit);
+        return isc.hits;
+    }
+
     class WModelAreaCallback
     {
     public:
@@ -82,6 +82,8 @@ namespace VMAP
         void setMeshData(std::vector<G3D::Vector3>& vert, std::vector<MeshTriangle>& tri);
         void setLiquidData(WmoLiquid*& liquid) { iLiquid = liquid; liquid = nullptr; }
         bool IntersectRay(const G3D::Ray& ray, float& distance, bool stopAtFirstHit) const;
+        //! IntersectRay for the lanes of rayMask, distance holds one value per lane, returns the lanes that hit
+        uint32 IntersectRayPacket(RayPacket const& packet, float* distance, uint32 rayMask, bool stopAtFirstHit) const;
         enum InsideResult { INSIDE = 0, MAYBE_INSIDE = 1, ABOVE = 2, OUT_OF_BOUNDS = -1 };
         InsideResult IsInsideObject(G3D::Ray const& ray, float& z_dist) const;
         bool GetLiquidLevel(const G3D::Vector3& pos, float& liqHeight) const;
@@ -112,6 +114,7 @@ namespace VMAP
         void setGroupModels(std::vector<GroupModel>& models);
         void setRootWmoID(uint32 id) { RootWMOID = id; }
         bool IntersectRay(const G3D::Ray& ray, float& distance, bool stopAtFirstHit, ModelIgnoreFlags ignoreFlags) const;
+        uint32 IntersectRayPacket(RayPacket const& packet, float* distance, uint32 rayMask, bool stopAtFirstHit, ModelIgnoreFlags ignoreFlags) const;
         bool GetLocationInfo(const G3D::Vector3& p, const G3D::Vector3& down, float& dist, GroupLocationInfo& info) const;
         bool writeFile(const std::string& filename);
         bool readFile(const std::string& filename);
@@ -0,0 +1,150 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _RAY_PACKET_H
+#define _RAY_PACKET_H
+
+#include "Define.h"
+#include "G3D/Ray.h"
+#include "G3D/Vector3.h"
+#include <array>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RAY_PACKET_SSE2
+#endif
+
+#define RAY_PACKET_SIZE 4
+
+/**
+ * Rays traced together through a BIH, each lane is one ray.
+ * Origins and directions are also kept per component so node and triangle
+ * tests process all lanes at once with SSE2.
+ */
+struct RayPacket
+{
+    void SetRay(uint32 lane, G3D::Ray const& ray)
+    {
+        Rays[lane] = ray;
+        OriginX[lane] = ray.origin().x;
+        OriginY[lane] = ray.origin().y;
+        OriginZ[lane] = ray.origin().z;
+        DirX[lane] = ray.direction().x;
+        DirY[lane] = ray.direction().y;
+        DirZ[lane] = ray.direction().z;
+    }
+
+    std::array<G3D::Ray, RAY_PACKET_SIZE> Rays;
+    alignas(16) float OriginX[RAY_PACKET_SIZE] = { };
+    alignas(16) float OriginY[RAY_PACKET_SIZE] = { };
+    alignas(16) float OriginZ[RAY_PACKET_SIZE] = { };
+    alignas(16) float DirX[RAY_PACKET_SIZE] = { };
+    alignas(16) float DirY[RAY_PACKET_SIZE] = { };
+    alignas(16) float DirZ[RAY_PACKET_SIZE] = { };
+};
+
+/**
+ * Four float lanes, SSE2 registers when available and plain arrays otherwise.
+ * Comparisons return lane masks usable by Select and Mask, min and max keep
+ * the second operand when the first one is NaN, like the ternaries of the scalar code.
+ */
+namespace RayLanes
+{
+#if defined(RAY_PACKET_SSE2)
+    using Lanes = __m128;
+
+    inline Lanes Load(float const* values) { return _mm_loadu_ps(values); }
+    inline void Store(float* values, Lanes lanes) { _mm_storeu_ps(values, lanes); }
+    inline Lanes Set(float value) { return _mm_set1_ps(value); }
+    inline Lanes Add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+    inline Lanes Sub(Lanes a, Lanes b) { return _mm_sub_ps(a, b); }
+    inline Lanes Mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+    inline Lanes Div(Lanes a, Lanes b) { return _mm_div_ps(a, b); }
+    inline Lanes Min(Lanes a, Lanes b) { return _mm_min_ps(a, b); }
+    inline Lanes Max(Lanes a, Lanes b) { return _mm_max_ps(a, b); }
+    inline Lanes Abs(Lanes a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    inline Lanes Less(Lanes a, Lanes b) { return _mm_cmplt_ps(a, b); }
+    inline Lanes LessEqual(Lanes a, Lanes b) { return _mm_cmple_ps(a, b); }
+    inline Lanes Greater(Lanes a, Lanes b) { return _mm_cmpgt_ps(a, b); }
+    inline Lanes Or(Lanes a, Lanes b) { return _mm_or_ps(a, b); }
+    inline Lanes AndNot(Lanes a, Lanes b) { return _mm_andnot_ps(a, b); }   // ~a & b
+    inline Lanes SignMask(Lanes a) { return _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(a), 31)); }
+    inline Lanes Select(Lanes mask, Lanes ifSet, Lanes ifNotSet) { return _mm_or_ps(_mm_and_ps(mask, ifSet), _mm_andnot_ps(mask, ifNotSet)); }
+    inline uint32 Mask(Lanes mask) { return uint32(_mm_movemask_ps(mask)); }
+#else
+    struct Lanes
+    {
+        float Values[RAY_PACKET_SIZE];
+    };
+
+    template<class Operation>
+    inline Lanes Apply(Lanes a, Lanes b, Operation operation)
+    {
+        Lanes result;
+        for (uint32 i = 0; i < RAY_PACKET_SIZE; ++i)
+            result.Values[i] = operation(a.Values[i], b.Values[i]);
+        return result;
+    }
+
+    template<class Comparison>
+    inline Lanes Compare(Lanes a, Lanes b, Comparison comparison)
+    {
+        return Apply(a, b, [comparison](float left, float right) { uint32 bits = comparison(left, right) ? ~0u : 0u; float result; std::memcpy(&result, &bits, sizeof(result)); return result; });
+    }
+
+    inline uint32 Bits(float value) { uint32 bits; std::memcpy(&bits, &value, sizeof(bits)); return bits; }
+    inline float Float(uint32 bits) { float value; std::memcpy(&value, &bits, sizeof(value)); return value; }
+
+    inline Lanes Load(float const* values) { Lanes lanes; std::memcpy(lanes.Values, values, sizeof(lanes.Values)); return lanes; }
+    inline void Store(float* values, Lanes lanes) { std::memcpy(values, lanes.Values, sizeof(lanes.Values)); }
+    inline Lanes Set(float value) { Lanes lanes; for (float& lane : lanes.Values) lane = value; return lanes; }
+    inline Lanes Add(Lanes a, Lanes b) { return Apply(a, b, [](float l, float r) { return l + r; }); }
+    inline Lanes Sub(Lanes a, Lanes b) { return Apply(a, b, [](float l, float r) { return l - r; }); }
+    inline Lanes Mul(Lanes a, Lanes b) { return Apply(a, b, [](float l, float r) { return l * r; }); }
+    inline Lanes Div(Lanes a, Lanes b) { return Apply(a, b, [](float l, float r) { return l / r; }); }
+    inline Lanes Min(Lanes a, Lanes b) { return Apply(a, b, [](float l, float r) { return l < r ? l : r; }); }
+    inline Lanes Max(Lanes a, Lanes b) { return Apply(a, b, [](float l, float r) { return l > r ? l : r; }); }
+    inline Lanes Abs(Lanes a) { return Apply(a, a, [](float l, float) { return Float(Bits(l) & 0x7FFFFFFFu); }); }
+    inline Lanes Less(Lanes a, Lanes b) { return Compare(a, b, [](float l, float r) { return l < r; }); }
+    inline Lanes LessEqual(Lanes a, Lanes b) { return Compare(a, b, [](float l, float r) { return l <= r; }); }
+    inline Lanes Greater(Lanes a, Lanes b) { return Compare(a, b, [](float l, float r) { return l > r; }); }
+    inline Lanes Or(Lanes a, Lanes b) { return Apply(a, b, [](float l, float r) { return Float(Bits(l) | Bits(r)); }); }
+    inline Lanes AndNot(Lanes a, Lanes b) { return Apply(a, b, [](float l, float r) { return Float(~Bits(l) & Bits(r)); }); }
+    inline Lanes SignMask(Lanes a) { return Apply(a, a, [](float l, float) { return Float((Bits(l) >> 31) ? ~0u : 0u); }); }
+
+    inline Lanes Select(Lanes mask, Lanes ifSet, Lanes ifNotSet)
+    {
+        Lanes result;
+        for (uint32 i = 0; i < RAY_PACKET_SIZE; ++i)
+            result.Values[i] = Bits(mask.Values[i]) ? ifSet.Values[i] : ifNotSet.Values[i];
+        return result;
+    }
+
+    inline uint32 Mask(Lanes mask)
+    {
+        uint32 result = 0;
+        for (uint32 i = 0; i < RAY_PACKET_SIZE; ++i)
+            if (Bits(mask.Values[i]))
+                result |= 1u << i;
+        return result;
+    }
+#endif
+}
+
+#endif // _RAY_PACKET_H
@@ -54,6 +54,9 @@ namespace Acore::Crypto
             return SHA1::GetDigestOf(A, clientM, K);
         }
 
+        // session key K derived from the shared secret S, the client side computes the same
+        static SessionKey SHA1Interleave(EphemeralKey const& S);
+
         SRP6(std::string const& username, Salt const& salt, Verifier const& verifier);
         std::optional<SessionKey> VerifyChallengeResponse(EphemeralKey const& A, SHA1::Digest const& clientM);
 
@@ -61,7 +64,6 @@ namespace Acore::Crypto
         bool _used = false; // a single instance can only be used to verify once
 
         static Verifier CalculateVerifier(std::string const& username, std::string const& password, Salt const& salt);
-        static SessionKey SHA1Interleave(EphemeralKey const& S);
 
         /* global algorithm parameters */
         static BigNumber const _g; // a [g]enerator for the ring of integers mod N, algorithm parameter
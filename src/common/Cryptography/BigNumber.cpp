@@ -22,6 +22,31 @@
 #include <memory>
 #include <openssl/bn.h>
 
+namespace
+{
+    // Scratch space of the BN_ functions, kept per thread instead of allocated for every operation
+    class BigNumberContext
+    {
+    public:
+        BigNumberContext() : _ctx(BN_CTX_new()) { }
+        ~BigNumberContext() { BN_CTX_free(_ctx); }
+
+        BigNumberContext(BigNumberContext const&) = delete;
+        BigNumberContext& operator=(BigNumberContext const&) = delete;
+
+        BN_CTX* Get() const { return _ctx; }
+
+    private:
+        BN_CTX* _ctx;
+    };
+
+    BN_CTX* GetThreadContext()
+    {
+        thread_local BigNumberContext context;
+        return context.Get();
+    }
+}
+
 BigNumber::BigNumber()
     : _bn(BN_new())
 { }
@@ -96,33 +121,21 @@ BigNumber& BigNumber::operator-=(BigNumber const& bn)
 
 BigNumber& BigNumber::operator*=(BigNumber const& bn)
 {
-    BN_CTX *bnctx;
-
-    bnctx = BN_CTX_new();
-    BN_mul(_bn, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
+    BN_mul(_bn, _bn, bn._bn, GetThreadContext());
 
     return *this;
 }
 
 BigNumber& BigNumber::operator/=(BigNumber const& bn)
 {
-    BN_CTX *bnctx;
-
-    bnctx = BN_CTX_new();
-    BN_div(_bn, nullptr, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
+    BN_div(_bn, nullptr, _bn, bn._bn, GetThreadContext());
 
     return *this;
 }
 
 BigNumber& BigNumber::operator%=(BigNumber const& bn)
 {
-    BN_CTX *bnctx;
-
-    bnctx = BN_CTX_new();
-    BN_mod(_bn, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
+    BN_mod(_bn, _bn, bn._bn, GetThreadContext());
 
     return *this;
 }
@@ -141,11 +154,7 @@ int BigNumber::CompareTo(BigNumber const& bn) const
 BigNumber BigNumber::Exp(BigNumber const& bn) const
 {
     BigNumber ret;
-    BN_CTX *bnctx;
-
-    bnctx = BN_CTX_new();
-    BN_exp(ret._bn, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
+    BN_exp(ret._bn, _bn, bn._bn, GetThreadContext());
 
     return ret;
 }
@@ -153,11 +162,7 @@ BigNumber BigNumber::Exp(BigNumber const& bn) const
 BigNumber BigNumber::ModExp(BigNumber const& bn1, BigNumber const& bn2) const
 {
     BigNumber ret;
-    BN_CTX *bnctx;
-
-    bnctx = BN_CTX_new();
-    BN_mod_exp(ret._bn, _bn, bn1._bn, bn2._bn, bnctx);
-    BN_CTX_free(bnctx);
+    BN_mod_exp(ret._bn, _bn, bn1._bn, bn2._bn, GetThreadContext());
 
     return ret;
 }
@@ -0,0 +1,160 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BUFFER_POOL_H
+#define _BUFFER_POOL_H
+
+#include "Define.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <iterator>
+#include <mutex>
+#include <vector>
+
+/**
+ * Free lists of byte buffers, so the storage of objects created at a high rate, like received
+ * packets, is reused with its capacity instead of coming from the heap every time.
+ *
+ * Buffers are sorted by capacity in SIZE_CLASSES, a buffer taken from the heap gets the capacity
+ * of its class so it fits any later request of that class. Every class has the design of
+ * ObjectPool: every thread keeps its own free list and hands buffers over to the others in
+ * batches of BATCH_SIZE through a shared list. Buffers larger than the last class are left to
+ * the heap.
+ */
+class BufferPool
+{
+public:
+    using Buffer = std::vector<uint8>;
+
+    static constexpr std::array<std::size_t, 3> SIZE_CLASSES = { 64, 256, 1024 };
+    static constexpr std::size_t BATCH_SIZE = 64;
+    static constexpr std::size_t MAX_SHARED_BATCHES = 64;
+
+    //! A buffer of size bytes, reused from the free lists when possible
+    static Buffer Acquire(std::size_t size)
+    {
+        Buffer buffer;
+        std::size_t const sizeClass = GetAcquireClass(size);
+        if (sizeClass < SIZE_CLASSES.size())
+        {
+            LocalList& local = GetLocalList(sizeClass);
+            if (local.Buffers.empty())
+                local.TakeBatch(GetSharedList(sizeClass));
+
+            if (!local.Buffers.empty())
+            {
+                buffer = std::move(local.Buffers.back());
+                local.Buffers.pop_back();
+            }
+            else
+            {
+                _heapAllocations.fetch_add(1, std::memory_order_relaxed);
+                buffer.reserve(SIZE_CLASSES[sizeClass]);
+            }
+        }
+
+        buffer.resize(size);
+        return buffer;
+    }
+
+    static void Release(Buffer&& buffer)
+    {
+        std::size_t const sizeClass = GetReleaseClass(buffer.capacity());
+        if (sizeClass >= SIZE_CLASSES.size())
+            return;
+
+        LocalList& local = GetLocalList(sizeClass);
+        buffer.clear();
+        local.Buffers.push_back(std::move(buffer));
+
+        if (local.Buffers.size() >= 2 * BATCH_SIZE)
+            local.GiveBatch(GetSharedList(sizeClass));
+    }
+
+    //! Buffers allocated from the heap since startup, buffers reused from the free lists are not counted
+    static uint64 GetHeapAllocations() { return _heapAllocations.load(std::memory_order_relaxed); }
+
+private:
+    using Batch = std::vector<Buffer>;
+
+    struct SharedList
+    {
+        std::mutex Lock;
+        std::vector<Batch> Batches;
+    };
+
+    struct LocalList
+    {
+        LocalList() { Buffers.reserve(2 * BATCH_SIZE); }
+
+        void TakeBatch(SharedList& shared)
+        {
+            std::lock_guard<std::mutex> guard(shared.Lock);
+            if (shared.Batches.empty())
+                return;
+
+            Buffers.swap(shared.Batches.back());
+            shared.Batches.pop_back();
+        }
+
+        void GiveBatch(SharedList& shared)
+        {
+            Batch batch;
+            batch.reserve(2 * BATCH_SIZE);
+            batch.insert(batch.end(), std::make_move_iterator(Buffers.end() - BATCH_SIZE), std::make_move_iterator(Buffers.end()));
+            Buffers.resize(Buffers.size() - BATCH_SIZE);
+
+            std::lock_guard<std::mutex> guard(shared.Lock);
+
+            // enough buffers are waiting to be reused already, the batch is freed
+            if (shared.Batches.size() < MAX_SHARED_BATCHES)
+                shared.Batches.push_back(std::move(batch));
+        }
+
+        Batch Buffers;
+    };
+
+    // smallest class holding size bytes, SIZE_CLASSES.size() when there is none
+    static std::size_t GetAcquireClass(std::size_t size)
+    {
+        return std::lower_bound(SIZE_CLASSES.begin(), SIZE_CLASSES.end(), size) - SIZE_CLASSES.begin();
+    }
+
+    // largest class a buffer of that capacity can serve, SIZE_CLASSES.size() when there is none
+    static std::size_t GetReleaseClass(std::size_t capacity)
+    {
+        if (capacity < SIZE_CLASSES.front() || capacity > SIZE_CLASSES.back())
+            return SIZE_CLASSES.size();
+
+        return std::upper_bound(SIZE_CLASSES.begin(), SIZE_CLASSES.end(), capacity) - SIZE_CLASSES.begin() - 1;
+    }
+
+    // function local, see ObjectPool::GetLocalList
+    static LocalList& GetLocalList(std::size_t sizeClass)
+    {
+        thread_local std::array<LocalList, SIZE_CLASSES.size()> locals;
+        return locals[sizeClass];
+    }
+
+    static SharedList& GetSharedList(std::size_t sizeClass) { return _shared[sizeClass]; }
+
+    static inline std::array<SharedList, SIZE_CLASSES.size()> _shared;
+    static inline std::atomic<uint64> _heapAllocations{0};
+};
+
+#endif
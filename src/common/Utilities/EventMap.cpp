@@ -17,6 +17,22 @@
 
 #include "EventMap.h"
 #include "Random.h"
+#include <algorithm>
+
+template<typename Predicate>
+void EventMap::ExtractEvents(EventStore& extracted, Predicate&& predicate)
+{
+    auto kept = _eventMap.begin();
+    for (auto itr = _eventMap.begin(); itr != _eventMap.end(); ++itr)
+    {
+        if (predicate(*itr))
+            extracted.push_back(*itr);
+        else
+            *kept++ = *itr;
+    }
+
+    _eventMap.erase(kept, _eventMap.end());
+}
 
 void EventMap::Reset()
 {
@@ -53,7 +69,7 @@ void EventMap::ScheduleEvent(EventId eventId, Milliseconds time, GroupIndex grou
     if (phase > sizeof(PhaseMask) * 8)
         return;
 
-    _eventMap.emplace(_time + time, Event(eventId, group, phase));
+    InsertEvent(_time + time, Event(eventId, group, phase));
 }
 
 void EventMap::ScheduleEvent(EventId eventId, Milliseconds minTime, Milliseconds maxTime, GroupIndex group /*= 0u*/, PhaseIndex phase /*= 0u*/)
@@ -75,7 +91,7 @@ void EventMap::RescheduleEvent(EventId eventId, Milliseconds time, GroupIndex gr
 
 void EventMap::Repeat(Milliseconds time)
 {
-    _eventMap.emplace(_time + time, _lastEvent);
+    InsertEvent(_time + time, _lastEvent);
 }
 
 void EventMap::Repeat(Milliseconds minTime, Milliseconds maxTime)
@@ -87,17 +103,17 @@ EventMap::EventId EventMap::ExecuteEvent()
 {
     while (!Empty())
     {
-        auto const& itr = _eventMap.begin();
+        auto const& [time, event] = _eventMap.back();
 
-        if (itr->first > _time)
+        if (time > _time)
             return 0;
-        else if (_phaseMask && itr->second._phaseMask && !(itr->second._phaseMask & _phaseMask))
-            _eventMap.erase(itr);
+        else if (_phaseMask && event._phaseMask && !(event._phaseMask & _phaseMask))
+            _eventMap.pop_back();
         else
         {
-            auto eventId = itr->second._id;
-            _lastEvent = itr->second;
-            _eventMap.erase(itr);
+            auto eventId = event._id;
+            _lastEvent = event;
+            _eventMap.pop_back();
             return eventId;
         }
     }
@@ -107,16 +123,9 @@ EventMap::EventId EventMap::ExecuteEvent()
 
 void EventMap::DelayEvents(Milliseconds delay)
 {
-    if (Empty())
-        return;
-
-    EventStore delayed = std::move(_eventMap);
-    for (auto itr = delayed.begin(); itr != delayed.end();)
-    {
-        auto node = delayed.extract(itr++);
-        node.key() = node.key() + delay;
-        _eventMap.insert(_eventMap.end(), std::move(node));
-    }
+    // every event is moved by the same amount, order is kept
+    for (auto& [time, event] : _eventMap)
+        time += delay;
 }
 
 void EventMap::DelayEvents(Milliseconds delay, GroupIndex group)
@@ -124,37 +133,35 @@ void EventMap::DelayEvents(Milliseconds delay, GroupIndex group)
     if (group > sizeof(GroupMask) * 8 || Empty())
         return;
 
+    if (!group)
+    {
+        DelayEvents(delay);
+        return;
+    }
+
     EventStore delayed;
 
-    for (auto itr = _eventMap.begin(); itr != _eventMap.end();)
+    ExtractEvents(delayed, [group](EventStore::value_type const& pair)
     {
-        if (!group || (itr->second._groupMask & GroupMask(1u << (group - 1u))))
-        {
-            delayed.emplace(itr->first + delay, itr->second);
-            itr = _eventMap.erase(itr);
-            continue;
-        }
-
-        ++itr;
-    }
+        return pair.second._groupMask & GroupMask(1u << (group - 1u));
+    });
 
-    _eventMap.insert(delayed.begin(), delayed.end());
+    // reinsert in execution order, after the events not delayed
+    for (auto delayedItr = delayed.rbegin(); delayedItr != delayed.rend(); ++delayedItr)
+        InsertEvent(delayedItr->first + delay, delayedItr->second);
 }
 
 void EventMap::DelayEventsToMax(Milliseconds delay, GroupIndex group)
 {
-    for (auto itr = _eventMap.begin(); itr != _eventMap.end();)
+    EventStore delayed;
+
+    ExtractEvents(delayed, [this, delay, group](EventStore::value_type const& pair)
     {
-        if (itr->first < _time + delay && (!group || (itr->second._groupMask & GroupMask(1u << (group - 1u)))))
-        {
-            ScheduleEvent(itr->second._id, delay, group);
-            _eventMap.erase(itr);
-            itr = _eventMap.begin();
-            continue;
-        }
+        return pair.first < _time + delay && (!group || (pair.second._groupMask & GroupMask(1u << (group - 1u))));
+    });
 
-        ++itr;
-    }
+    for (auto delayedItr = delayed.rbegin(); delayedItr != delayed.rend(); ++delayedItr)
+        ScheduleEvent(delayedItr->second._id, delay, group);
 }
 
 void EventMap::CancelEvent(EventId eventId)
@@ -162,16 +169,10 @@ void EventMap::CancelEvent(EventId eventId)
     if (Empty())
         return;
 
-    for (auto itr = _eventMap.begin(); itr != _eventMap.end();)
+    _eventMap.erase(std::remove_if(_eventMap.begin(), _eventMap.end(), [eventId](EventStore::value_type const& pair)
     {
-        if (eventId == itr->second._id)
-        {
-            itr = _eventMap.erase(itr);
-            continue;
-        }
-
-        ++itr;
-    }
+        return eventId == pair.second._id;
+    }), _eventMap.end());
 }
 
 void EventMap::CancelEventGroup(GroupIndex group)
@@ -179,17 +180,10 @@ void EventMap::CancelEventGroup(GroupIndex group)
     if (!group || group > sizeof(GroupMask) * 8 || Empty())
         return;
 
-    for (auto itr = _eventMap.begin(); itr != _eventMap.end();)
+    _eventMap.erase(std::remove_if(_eventMap.begin(), _eventMap.end(), [group](EventStore::value_type const& pair)
     {
-        if (itr->second._groupMask & GroupMask(1u << (group - 1u)))
-        {
-            _eventMap.erase(itr);
-            itr = _eventMap.begin();
-            continue;
-        }
-
-        ++itr;
-    }
+        return pair.second._groupMask & GroupMask(1u << (group - 1u));
+    }), _eventMap.end());
 }
 
 bool EventMap::IsInPhase(PhaseIndex phase) const
@@ -199,9 +193,9 @@ bool EventMap::IsInPhase(PhaseIndex phase) const
 
 Milliseconds EventMap::GetTimeUntilEvent(EventId eventId) const
 {
-    for (auto const& [time, event] : _eventMap)
-        if (eventId == event._id)
-            return std::chrono::duration_cast<Milliseconds>(time - _time);
+    for (auto itr = _eventMap.rbegin(); itr != _eventMap.rend(); ++itr)
+        if (eventId == itr->second._id)
+            return std::chrono::duration_cast<Milliseconds>(itr->first - _time);
 
     return Milliseconds::max();
 }
@@ -210,3 +204,14 @@ bool EventMap::HasTimeUntilEvent(EventId eventId) const
 {
     return GetTimeUntilEvent(eventId) != Milliseconds::max();
 }
+
+void EventMap::InsertEvent(TimePoint time, Event const& event)
+{
+    // first event not due later, the new event goes right before it so it executes after it
+    auto itr = std::partition_point(_eventMap.begin(), _eventMap.end(), [time](EventStore::value_type const& pair)
+    {
+        return pair.first > time;
+    });
+
+    _eventMap.emplace(itr, time, event);
+}
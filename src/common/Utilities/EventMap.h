@@ -20,7 +20,7 @@
 
 #include "Define.h"
 #include "Duration.h"
-#include <map>
+#include <boost/container/small_vector.hpp>
 
 class EventMap
 {
@@ -46,9 +46,14 @@ class EventMap
 
     /**
      * Internal storage type.
-     * Key: Time as TimePoint when the event should occur.
+     * First: Time as TimePoint when the event should occur.
+     *
+     * Kept sorted by descending time, the next event to execute is at the back.
+     * Events due at the same time execute in the order they were scheduled.
+     * Up to EVENT_MAP_INLINE_EVENTS events are stored inline, without allocating.
      */
-    using EventStore = std::multimap<TimePoint, Event>;
+    static constexpr std::size_t EVENT_MAP_INLINE_EVENTS = 32;
+    using EventStore = boost::container::small_vector<std::pair<TimePoint, Event>, EVENT_MAP_INLINE_EVENTS>;
 
 public:
     EventMap() { }
@@ -245,6 +250,23 @@ public:
     bool HasTimeUntilEvent(EventId eventId) const;
 
 private:
+    /**
+    * @name InsertEvent
+    * @brief Inserts an event, after the events already scheduled for the same time.
+    * @param time Time as TimePoint when the event should occur.
+    * @param event The event.
+    */
+    void InsertEvent(TimePoint time, Event const& event);
+
+    /**
+    * @name ExtractEvents
+    * @brief Moves the events matching the predicate to extracted, keeping their order.
+    * @param extracted Receives the matching events.
+    * @param predicate Called for every scheduled event.
+    */
+    template<typename Predicate>
+    void ExtractEvents(EventStore& extracted, Predicate&& predicate);
+
     /**
     * @name _time
     * @brief Internal timer.
@@ -17,6 +17,9 @@
 
 #include "EventProcessor.h"
 #include "Errors.h"
+#include <algorithm>
+#include <array>
+#include <vector>
 
 void BasicEvent::ScheduleAbort()
 {
@@ -32,9 +35,140 @@ void BasicEvent::SetAborted()
     m_abortState = AbortState::STATE_ABORTED;
 }
 
+namespace
+{
+    constexpr uint8 WHEEL_LEVELS = 4;
+    constexpr uint8 WHEEL_SLOT_BITS = 6;
+    constexpr uint32 WHEEL_SLOTS = 1 << WHEEL_SLOT_BITS;
+    constexpr uint64 WHEEL_SLOT_MASK = WHEEL_SLOTS - 1;
+    constexpr std::size_t MAX_POOLED_EVENT_NODES = 4096;
+    constexpr std::size_t MAX_POOLED_WHEELS = 64;
+
+    constexpr uint8 LevelShift(uint8 level) { return level * WHEEL_SLOT_BITS; }
+
+    // Index of the lowest set bit, mask must not be 0
+    inline uint32 LowestBit(uint64 mask)
+    {
+        uint32 index = 0;
+        while (!(mask & 1))
+        {
+            mask >>= 1;
+            ++index;
+        }
+
+        return index;
+    }
+
+    // Free objects of one thread, capped so a burst of events does not keep its memory forever
+    template<typename T, std::size_t MaxSize>
+    class FreeListPool
+    {
+    public:
+        ~FreeListPool()
+        {
+            for (T* object : _objects)
+                delete object;
+        }
+
+        T* Acquire()
+        {
+            if (_objects.empty())
+                return new T();
+
+            T* object = _objects.back();
+            _objects.pop_back();
+            return object;
+        }
+
+        void Release(T* object)
+        {
+            if (_objects.size() >= MaxSize)
+                delete object;
+            else
+                _objects.push_back(object);
+        }
+
+        // Returns nullptr once the pool of the calling thread was destroyed (processors destroyed at thread exit)
+        static FreeListPool* Instance()
+        {
+            // trivially destructible, so it can still be read after the holder was destroyed
+            thread_local bool destroyed = false;
+            if (destroyed)
+                return nullptr;
+
+            thread_local struct Holder
+            {
+                ~Holder() { *Destroyed = true; }
+
+                bool* Destroyed;
+                FreeListPool Pool;
+            } holder{ &destroyed, {} };
+
+            return &holder.Pool;
+        }
+
+        static T* AcquireObject()
+        {
+            if (FreeListPool* pool = Instance())
+                return pool->Acquire();
+
+            return new T();
+        }
+
+        static void ReleaseObject(T* object)
+        {
+            if (FreeListPool* pool = Instance())
+                pool->Release(object);
+            else
+                delete object;
+        }
+
+    private:
+        std::vector<T*> _objects;
+    };
+}
+
+struct EventProcessor::EventNode
+{
+    BasicEvent* Event;
+    uint64 Time;
+    uint64 Sequence;
+    EventNode* Next;
+};
+
+struct EventProcessor::TimingWheel
+{
+    std::array<std::array<EventNode*, WHEEL_SLOTS>, WHEEL_LEVELS> Slots{};
+    std::array<EventNode*, WHEEL_SLOTS> Tails{};    // last node of each level 0 slot
+    std::array<uint64, WHEEL_LEVELS> Occupied{};    // one bit per non empty slot
+    EventNode* Overflow{nullptr};
+};
+
+EventProcessor::EventNode* EventProcessor::AcquireNode()
+{
+    return FreeListPool<EventNode, MAX_POOLED_EVENT_NODES>::AcquireObject();
+}
+
+void EventProcessor::ReleaseNode(EventNode* node)
+{
+    FreeListPool<EventNode, MAX_POOLED_EVENT_NODES>::ReleaseObject(node);
+}
+
+void EventProcessor::ReleaseWheel()
+{
+    // only empty wheels are released, their slots are all cleared already
+    if (_wheel)
+        FreeListPool<TimingWheel, MAX_POOLED_WHEELS>::ReleaseObject(_wheel);
+
+    _wheel = nullptr;
+}
+
+EventProcessor::EventProcessor() = default;
+
 EventProcessor::~EventProcessor()
 {
     KillAllEvents(true);
+    ReleaseWheel();
 }
 
 void EventProcessor::Update(uint32 p_time)
@@ -42,95 +176,269 @@ void EventProcessor::Update(uint32 p_time)
     // update time
     m_time += p_time;
 
-    // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    // main event loop, walk the wheel up to the current time
+    while (_eventCount && _wheelTime <= m_time)
     {
-        // get and remove event from queue
-        BasicEvent* event = i->second;
-        m_events.erase(i);
+        if (!(_wheelTime & WHEEL_SLOT_MASK))
+            Cascade(_wheelTime);
+
+        uint32 const slot = uint32(_wheelTime & WHEEL_SLOT_MASK);
 
-        if (event->IsRunning())
+        // events added for the current time while executing are appended to this slot and run in this loop too
+        while (EventNode* node = _wheel->Slots[0][slot])
         {
-            if (event->Execute(m_time, p_time))
+            // get and remove event from queue
+            _wheel->Slots[0][slot] = node->Next;
+            if (!node->Next)
             {
-                // completely destroy event if it is not re-added
-                delete event;
+                _wheel->Tails[slot] = nullptr;
+                _wheel->Occupied[0] &= ~(uint64(1) << slot);
             }
-            continue;
-        }
 
-        if (event->IsAbortScheduled())
-        {
-            event->Abort(m_time);
-            // Mark the event as aborted
-            event->SetAborted();
+            --_eventCount;
+            BasicEvent* event = node->Event;
+            ReleaseNode(node);
+
+            ExecuteEvent(event, p_time);
         }
 
-        if (event->IsDeletable())
+        _wheelTime = std::min(NextWheelTime(), m_time + 1);
+    }
+
+    if (!_eventCount)
+    {
+        _wheelTime = m_time + 1;
+        ReleaseWheel();
+    }
+}
+
+uint64 EventProcessor::NextWheelTime() const
+{
+    // First slot after the current one holding events, on the lowest level having one.
+    // Higher level slots are cascaded when their block starts, so skipping to it is safe.
+    for (uint8 level = 0; level < WHEEL_LEVELS; ++level)
+    {
+        uint32 const index = uint32((_wheelTime >> LevelShift(level)) & WHEEL_SLOT_MASK);
+        if (index == WHEEL_SLOT_MASK)
+            continue;
+
+        uint64 const later = _wheel->Occupied[level] & (~uint64(0) << (index + 1));
+        if (!later)
+            continue;
+
+        uint64 const blockStart = (_wheelTime >> LevelShift(level + 1)) << LevelShift(level + 1);
+        return blockStart + (uint64(LowestBit(later)) << LevelShift(level));
+    }
+
+    // only overflow events left
+    return ((_wheelTime >> LevelShift(WHEEL_LEVELS)) + 1) << LevelShift(WHEEL_LEVELS);
+}
+
+void EventProcessor::ExecuteEvent(BasicEvent* event, uint32 p_time)
+{
+    if (event->IsRunning())
+    {
+        if (event->Execute(m_time, p_time))
         {
+            // completely destroy event if it is not re-added
             delete event;
-            continue;
         }
+        return;
+    }
 
-        // Reschedule non deletable events to be checked at
-        // the next update tick
-        AddEvent(event, CalculateTime(1), false);
+    if (event->IsAbortScheduled())
+    {
+        event->Abort(m_time);
+        // Mark the event as aborted
+        event->SetAborted();
+    }
+
+    if (event->IsDeletable())
+    {
+        delete event;
+        return;
     }
+
+    // Reschedule non deletable events to be checked at
+    // the next update tick
+    AddEvent(event, CalculateTime(1), false);
 }
 
-void EventProcessor::KillAllEvents(bool force)
+void EventProcessor::Schedule(EventNode* node)
 {
-    // first, abort all existing events
-    for (auto itr = m_events.begin(); itr != m_events.end();)
+    if (!_wheel)
+        _wheel = FreeListPool<TimingWheel, MAX_POOLED_WHEELS>::AcquireObject();
+
+    // events already due are executed at the next processed time
+    uint64 const time = std::max(node->Time, _wheelTime);
+
+    for (uint8 level = 0; level < WHEEL_LEVELS; ++level)
     {
-        // Abort events which weren't aborted already
-        if (!itr->second->IsAborted())
+        // lowest level whose current block contains the event
+        if ((time >> LevelShift(level + 1)) != (_wheelTime >> LevelShift(level + 1)))
+            continue;
+
+        uint32 const slot = uint32((time >> LevelShift(level)) & WHEEL_SLOT_MASK);
+        _wheel->Occupied[level] |= uint64(1) << slot;
+
+        if (level)
         {
-            itr->second->SetAborted();
-            itr->second->Abort(m_time);
+            node->Next = _wheel->Slots[level][slot];
+            _wheel->Slots[level][slot] = node;
+            return;
         }
 
-        // Skip non-deletable events when we are
-        // not forcing the event cancellation.
-        if (!force && !itr->second->IsDeletable())
+        // level 0 slots are executed in order, keep them sorted by sequence
+        EventNode*& tail = _wheel->Tails[slot];
+        if (!tail || tail->Sequence < node->Sequence)
         {
-            ++itr;
+            node->Next = nullptr;
+            (tail ? tail->Next : _wheel->Slots[0][slot]) = node;
+            tail = node;
+            return;
+        }
+
+        EventNode** link = &_wheel->Slots[0][slot];
+        while ((*link)->Sequence < node->Sequence)
+            link = &(*link)->Next;
+
+        node->Next = *link;
+        *link = node;
+        return;
+    }
+
+    node->Next = _wheel->Overflow;
+    _wheel->Overflow = node;
+}
+
+void EventProcessor::Cascade(uint64 wheelTime)
+{
+    // Entering a new block of a level, move its events down, highest level first
+    for (uint8 level = WHEEL_LEVELS; level > 0; --level)
+    {
+        if (wheelTime & ((uint64(1) << LevelShift(level)) - 1))
             continue;
+
+        EventNode* node;
+        if (level == WHEEL_LEVELS)
+        {
+            node = _wheel->Overflow;
+            _wheel->Overflow = nullptr;
+        }
+        else
+        {
+            uint32 const slot = uint32((wheelTime >> LevelShift(level)) & WHEEL_SLOT_MASK);
+            node = _wheel->Slots[level][slot];
+            _wheel->Slots[level][slot] = nullptr;
+            _wheel->Occupied[level] &= ~(uint64(1) << slot);
         }
 
-        delete itr->second;
+        // reschedule in insertion order, so level 0 slots are built by appending
+        std::vector<EventNode*>& nodes = _cascadeBuffer;
+        for (; node; node = node->Next)
+            nodes.push_back(node);
 
-        if (force)
-            ++itr; // Clear the whole container when forcing
+        auto const bySequence = [](EventNode const* left, EventNode const* right) { return left->Sequence < right->Sequence; };
+        if (std::is_sorted(nodes.rbegin(), nodes.rend(), bySequence))
+            std::reverse(nodes.begin(), nodes.end()); // plain head insertion, no need to sort
         else
-            itr = m_events.erase(itr);
+            std::sort(nodes.begin(), nodes.end(), bySequence);
+
+        for (EventNode* cascaded : nodes)
+            Schedule(cascaded);
+
+        nodes.clear();
+    }
+}
+
+template<typename Worker>
+void EventProcessor::RemoveNodesIf(Worker&& worker)
+{
+    if (!_wheel)
+        return;
+
+    // returns the last node kept in the list
+    auto removeFromList = [&](EventNode** link)
+    {
+        EventNode* last = nullptr;
+        while (EventNode* node = *link)
+        {
+            if (!worker(node))
+            {
+                last = node;
+                link = &node->Next;
+                continue;
+            }
+
+            *link = node->Next;
+            --_eventCount;
+            ReleaseNode(node);
+        }
+
+        return last;
+    };
+
+    for (uint8 level = 0; level < WHEEL_LEVELS; ++level)
+    {
+        for (uint32 slot = 0; slot < WHEEL_SLOTS; ++slot)
+        {
+            if (!(_wheel->Occupied[level] & (uint64(1) << slot)))
+                continue;
+
+            EventNode* last = removeFromList(&_wheel->Slots[level][slot]);
+            if (!level)
+                _wheel->Tails[slot] = last;
+
+            if (!last)
+                _wheel->Occupied[level] &= ~(uint64(1) << slot);
+        }
     }
 
-    if (force)
-        m_events.clear();
+    removeFromList(&_wheel->Overflow);
 }
 
-void EventProcessor::CancelEventGroup(uint8 group)
+void EventProcessor::KillAllEvents(bool force)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end();)
+    // first, abort all existing events
+    RemoveNodesIf([this, force](EventNode* node)
     {
-        if (itr->second->m_eventGroup != group)
+        BasicEvent* event = node->Event;
+
+        // Abort events which weren't aborted already
+        if (!event->IsAborted())
         {
-            ++itr;
-            continue;
+            event->SetAborted();
+            event->Abort(m_time);
         }
 
+        // Skip non-deletable events when we are
+        // not forcing the event cancellation.
+        if (!force && !event->IsDeletable())
+            return false;
+
+        delete event;
+        return true;
+    });
+}
+
+void EventProcessor::CancelEventGroup(uint8 group)
+{
+    RemoveNodesIf([this, group](EventNode* node)
+    {
+        BasicEvent* event = node->Event;
+        if (event->m_eventGroup != group)
+            return false;
+
         // Abort events which weren't aborted already
-        if (!itr->second->IsAborted())
+        if (!event->IsAborted())
         {
-            itr->second->SetAborted();
-            itr->second->Abort(m_time);
+            event->SetAborted();
+            event->Abort(m_time);
         }
 
-        delete itr->second;
-        itr = m_events.erase(itr);
-    }
+        delete event;
+        return true;
+    });
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime /*= true*/, uint8 eventGroup /*= 0*/)
@@ -139,21 +447,33 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
         Event->m_addTime = m_time;
     Event->m_execTime = e_time;
     Event->m_eventGroup = eventGroup;
-    m_events.emplace(e_time, Event);
+
+    EventNode* node = AcquireNode();
+    node->Event = Event;
+    node->Time = e_time;
+    node->Sequence = _nextSequence++;
+    node->Next = nullptr;
+
+    Schedule(node);
+    ++_eventCount;
 }
 
 void EventProcessor::ModifyEventTime(BasicEvent* event, Milliseconds newTime)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end(); ++itr)
+    bool found = false;
+    RemoveNodesIf([event, &found](EventNode* node)
     {
-        if (itr->second != event)
-            continue;
+        if (found || node->Event != event)
+            return false;
 
-        event->m_execTime = newTime.count();
-        m_events.erase(itr);
-        m_events.emplace(newTime.count(), event);
-        break;
-    }
+        found = true;
+        return true;
+    });
+
+    if (!found)
+        return;
+
+    AddEvent(event, newTime.count(), false, event->m_eventGroup);
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset) const
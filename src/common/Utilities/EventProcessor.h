@@ -21,7 +21,8 @@
 #include "Define.h"
 #include "Duration.h"
 #include "Random.h"
-#include <map>
+#include <memory>
+#include <vector>
 
 class EventProcessor;
 
@@ -90,14 +91,25 @@ class LambdaBasicEvent : public BasicEvent
 template<typename T>
 using is_lambda_event = std::enable_if_t<!std::is_base_of_v<BasicEvent, std::remove_pointer_t<std::remove_cvref_t<T>>>>;
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
-
+/**
+ * Schedules BasicEvents on a hierarchical timing wheel.
+ *
+ * Four levels of 64 slots cover 1ms, 64ms, ~4s and ~4.5min per slot, events further in
+ * the future wait in an overflow list. Scheduling is O(1) and events are kept in pooled
+ * nodes, so adding and executing an event does not allocate once the pool is warm.
+ * The wheel itself is taken from a per-thread pool with the first event and given back
+ * by Update once the processor is empty, so idle objects do not keep its slots.
+ * Events due at the same time execute in the order they were added.
+ */
 class EventProcessor
 {
     public:
-        EventProcessor()  = default;
+        EventProcessor();
         ~EventProcessor();
 
+        EventProcessor(EventProcessor const&) = delete;
+        EventProcessor& operator=(EventProcessor const&) = delete;
+
         void Update(uint32 p_time);
         void KillAllEvents(bool force);
 
@@ -120,12 +132,33 @@ class EventProcessor
         [[nodiscard]] uint64 CalculateQueueTime(uint64 delay) const;
 
         void CancelEventGroup(uint8 group);
-        bool HasEvents() const { return !m_events.empty(); }
+        bool HasEvents() const { return _eventCount != 0; }
 
     protected:
         uint64 m_time{0};
-        EventList m_events;
-        bool m_aborting;
+
+    private:
+        struct EventNode;
+        struct TimingWheel;
+
+        static EventNode* AcquireNode();
+        static void ReleaseNode(EventNode* node);
+        void ReleaseWheel();
+
+        void Schedule(EventNode* node);
+        void Cascade(uint64 wheelTime);
+        uint64 NextWheelTime() const;
+        void ExecuteEvent(BasicEvent* event, uint32 p_time);
+
+        // Calls worker(node) for every scheduled node, nodes for which it returns true are unlinked and released
+        template<typename Worker>
+        void RemoveNodesIf(Worker&& worker);
+
+        TimingWheel* _wheel{nullptr};              // acquired with the first event, released once empty
+        uint64 _wheelTime{0};                      // every event due before this time was executed
+        uint64 _nextSequence{0};
+        std::size_t _eventCount{0};
+        std::vector<EventNode*> _cascadeBuffer;
 };
 
 #endif
@@ -0,0 +1,55 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MappedFile.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+struct Acore::MappedFile::Region
+{
+    boost::interprocess::file_mapping File;
+    boost::interprocess::mapped_region Mapping;
+};
+
+Acore::MappedFile::MappedFile() : _data(nullptr), _size(0) { }
+
+Acore::MappedFile::~MappedFile() = default;
+
+bool Acore::MappedFile::Open(std::string const& fileName)
+{
+    _region.reset();
+    _data = nullptr;
+    _size = 0;
+
+    try
+    {
+        auto region = std::make_unique<Region>();
+        region->File = boost::interprocess::file_mapping(fileName.c_str(), boost::interprocess::read_only);
+        region->Mapping = boost::interprocess::mapped_region(region->File, boost::interprocess::read_only);
+
+        _data = static_cast<uint8 const*>(region->Mapping.get_address());
+        _size = region->Mapping.get_size();
+        _region = std::move(region);
+    }
+    catch (boost::interprocess::interprocess_exception const&)
+    {
+        // missing, empty or unreadable file
+        return false;
+    }
+
+    return true;
+}
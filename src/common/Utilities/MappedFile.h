@@ -0,0 +1,54 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _MAPPED_FILE_H
+#define _MAPPED_FILE_H
+
+#include "Define.h"
+#include <memory>
+#include <string>
+
+namespace Acore
+{
+    /// Read-only memory mapping of a whole file.
+    /// Pages are loaded on first access and shared with every other
+    /// mapping of the same file, in this process or any other one.
+    class AC_COMMON_API MappedFile
+    {
+    public:
+        MappedFile();
+        ~MappedFile();
+
+        MappedFile(MappedFile const&) = delete;
+        MappedFile& operator=(MappedFile const&) = delete;
+
+        /// Maps the file, returns false if it does not exist, is empty or cannot be mapped
+        bool Open(std::string const& fileName);
+
+        uint8 const* GetData() const { return _data; }
+        std::size_t GetSize() const { return _size; }
+
+    private:
+        struct Region;
+
+        std::unique_ptr<Region> _region;
+        uint8 const* _data;
+        std::size_t _size;
+    };
+}
+
+#endif
@@ -37,6 +37,8 @@ public:
         _storage.resize(initialSize);
     }
 
+    explicit MessageBuffer(std::vector<uint8>&& storage) : _wpos(0), _rpos(0), _storage(std::move(storage)) { }
+
     MessageBuffer(MessageBuffer const& right) :
         _wpos(right._wpos), _rpos(right._rpos), _storage(right._storage) { }
 
@@ -0,0 +1,223 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _OBJECT_POOL_H
+#define _OBJECT_POOL_H
+
+#include "Define.h"
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+/**
+ * Free lists of memory blocks for objects of one type, for objects created at a high rate,
+ * like database statements and received packets.
+ *
+ * Such objects are usually created by one thread and destroyed by another, so every thread
+ * keeps its own free list and hands blocks over to the others in batches through a shared list,
+ * taking the lock once per ObjectPool::BATCH_SIZE blocks.
+ */
+template<class Object>
+class ObjectPool
+{
+    static_assert(alignof(Object) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "pooled objects are allocated with the default new alignment");
+
+    struct Block
+    {
+        Block* Next;
+    };
+
+    static constexpr std::size_t BLOCK_SIZE = sizeof(Object) < sizeof(Block) ? sizeof(Block) : sizeof(Object);
+
+public:
+    static constexpr std::size_t BATCH_SIZE = 64;
+    static constexpr std::size_t MAX_SHARED_BATCHES = 64;
+
+    static void* Allocate()
+    {
+        LocalList& local = GetLocalList();
+        if (!local.Head)
+            local.TakeBatch();
+
+        if (Block* block = local.Head)
+        {
+            local.Head = block->Next;
+            --local.Count;
+            return block;
+        }
+
+        _heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(BLOCK_SIZE);
+    }
+
+    static void Deallocate(void* object)
+    {
+        LocalList& local = GetLocalList();
+        Block* block = static_cast<Block*>(object);
+        block->Next = local.Head;
+        local.Head = block;
+
+        if (++local.Count >= 2 * BATCH_SIZE)
+            local.GiveBatch();
+    }
+
+    //! Blocks allocated from the heap since startup, blocks reused from the free lists are not counted
+    static uint64 GetHeapAllocations() { return _heapAllocations.load(std::memory_order_relaxed); }
+
+private:
+    struct SharedList
+    {
+        ~SharedList()
+        {
+            for (Block* batch : Batches)
+                Free(batch);
+        }
+
+        std::mutex Lock;
+        std::vector<Block*> Batches;
+    };
+
+    struct LocalList
+    {
+        ~LocalList()
+        {
+            Free(Head);
+            Head = nullptr;
+            Count = 0;
+        }
+
+        void TakeBatch()
+        {
+            std::lock_guard<std::mutex> guard(_shared.Lock);
+            if (_shared.Batches.empty())
+                return;
+
+            Head = _shared.Batches.back();
+            Count = BATCH_SIZE;
+            _shared.Batches.pop_back();
+        }
+
+        void GiveBatch()
+        {
+            Block* batch = Head;
+            Block* last = Head;
+            for (std::size_t i = 1; i < BATCH_SIZE; ++i)
+                last = last->Next;
+
+            Head = last->Next;
+            Count -= BATCH_SIZE;
+            last->Next = nullptr;
+
+            {
+                std::lock_guard<std::mutex> guard(_shared.Lock);
+                if (_shared.Batches.size() < MAX_SHARED_BATCHES)
+                {
+                    _shared.Batches.push_back(batch);
+                    return;
+                }
+            }
+
+            // enough blocks are waiting to be reused already
+            Free(batch);
+        }
+
+        Block* Head = nullptr;
+        std::size_t Count = 0;
+    };
+
+    static void Free(Block* block)
+    {
+        while (block)
+        {
+            Block* next = block->Next;
+            ::operator delete(block);
+            block = next;
+        }
+    }
+
+    // function local, GCC 12 emits conflicting TLS guards for thread_local static members of several instantiations
+    static LocalList& GetLocalList()
+    {
+        thread_local LocalList local;
+        return local;
+    }
+
+    static inline SharedList _shared;
+    static inline std::atomic<uint64> _heapAllocations{0};
+};
+
+/// Base class making new and delete of Object use its ObjectPool, derived classes of other sizes use the heap
+template<class Object>
+class PooledObject
+{
+public:
+    static void* operator new(std::size_t size)
+    {
+        if (size != sizeof(Object))
+            return ::operator new(size);
+
+        return ObjectPool<Object>::Allocate();
+    }
+
+    static void operator delete(void* object, std::size_t size)
+    {
+        if (size != sizeof(Object))
+            ::operator delete(object);
+        else
+            ObjectPool<Object>::Deallocate(object);
+    }
+};
+
+/// Allocator using an ObjectPool for single objects, for the shared states of promises and shared pointers
+template<class T>
+class PoolAllocator
+{
+public:
+    using value_type = T;
+
+    PoolAllocator() = default;
+
+    template<class U>
+    PoolAllocator(PoolAllocator<U> const& /*other*/) { }
+
+    T* allocate(std::size_t count)
+    {
+        if (count != 1)
+            return static_cast<T*>(::operator new(count * sizeof(T)));
+
+        return static_cast<T*>(ObjectPool<T>::Allocate());
+    }
+
+    void deallocate(T* object, std::size_t count)
+    {
+        if (count != 1)
+            ::operator delete(object);
+        else
+            ObjectPool<T>::Deallocate(object);
+    }
+
+    template<class U>
+    bool operator==(PoolAllocator<U> const& /*other*/) const { return true; }
+
+    template<class U>
+    bool operator!=(PoolAllocator<U> const& /*other*/) const { return false; }
+};
+
+#endif
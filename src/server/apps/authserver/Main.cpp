@@ -25,6 +25,7 @@
 
 #include "AppenderDB.h"
 #include "AuthSocketMgr.h"
+#include "AuthWorkerPool.h"
 #include "Banner.h"
 #include "Config.h"
 #include "DatabaseEnv.h"
@@ -32,7 +33,9 @@
 #include "GitRevision.h"
 #include "IPLocation.h"
 #include "IoContext.h"
+#include "IpBanCache.h"
 #include "Log.h"
+#include "Metric.h"
 #include "MySQLThreading.h"
 #include "OpenSSLCrypto.h"
 #include "ProcessPriority.h"
@@ -65,6 +68,7 @@ void SignalHandler(std::weak_ptr<Acore::Asio::IoContext> ioContextRef, boost::sy
 void KeepDatabaseAliveHandler(std::weak_ptr<boost::asio::steady_timer> dbPingTimerRef, int32 dbPingInterval, boost::system::error_code const& error);
 void BanExpiryHandler(std::weak_ptr<boost::asio::steady_timer> banExpiryCheckTimerRef, int32 banExpiryCheckInterval, boost::system::error_code const& error);
 void PatchJobsHandler(std::weak_ptr<boost::asio::steady_timer> patchJobsTimerRef, int32 patchJobsInterval, boost::system::error_code const& error);
+void MetricUpdateHandler(std::weak_ptr<boost::asio::steady_timer> metricUpdateTimerRef, boost::system::error_code const& error);
 variables_map GetConsoleArguments(int argc, char** argv, fs::path& configFile);
 
 /// Launch the auth server
@@ -132,6 +136,9 @@ int main(int argc, char** argv)
     // Initialize Patch Manager
     sPatchMgr->Initialize();
 
+    // Load the banned IPs refused at connection
+    sIpBanCache->Load();
+
     std::shared_ptr<void> dbHandle(nullptr, [](void*) { StopDB(); });
 
     std::shared_ptr<Acore::Asio::IoContext> ioContext = std::make_shared<Acore::Asio::IoContext>();
@@ -164,6 +171,25 @@ int main(int argc, char** argv)
 
     std::string bindIp = sConfigMgr->GetOption<std::string>("BindIP", "0.0.0.0");
 
+    sMetric->Initialize("authserver", *ioContext, []()
+    {
+        AuthWorkerPoolStats stats = sAuthWorkerPool->ConsumeStats();
+        METRIC_VALUE("logon_count", stats.LogonLatency.Count);
+        METRIC_VALUE("logon_latency_p50", uint64(stats.LogonLatency.GetPercentile(50.0f).count()));
+        METRIC_VALUE("logon_latency_p95", uint64(stats.LogonLatency.GetPercentile(95.0f).count()));
+        METRIC_VALUE("logon_latency_p99", uint64(stats.LogonLatency.GetPercentile(99.0f).count()));
+        METRIC_VALUE("logon_task_wait_p99", uint64(stats.TaskWait.GetPercentile(99.0f).count()));
+        METRIC_VALUE("logon_queue", uint64(stats.Queued));
+        METRIC_VALUE("logon_rejected", stats.Rejected);
+    });
+
+    std::shared_ptr<void> sMetricHandle(nullptr, [](void*) { sMetric->Unload(); });
+
+    // Stopped after the network, no session is left waiting for a logon worker
+    sAuthWorkerPool->Start(sConfigMgr->GetOption<uint32>("LogonWorkerThreads", 1), sConfigMgr->GetOption<uint32>("LogonWorkerQueueSize", 1000));
+
+    std::shared_ptr<void> sAuthWorkerPoolHandle(nullptr, [](void*) { sAuthWorkerPool->Stop(); });
+
     if (!sAuthSocketMgr.StartNetwork(*ioContext, bindIp, port))
     {
         LOG_ERROR("server.authserver", "Failed to initialize network");
@@ -206,9 +232,15 @@ int main(int argc, char** argv)
     patchJobsTimer->expires_at(std::chrono::steady_clock::now() + std::chrono::milliseconds(patchJobsInterval));
     patchJobsTimer->async_wait(std::bind(&PatchJobsHandler, std::weak_ptr<boost::asio::steady_timer>(patchJobsTimer), patchJobsInterval, std::placeholders::_1));
 
+    std::shared_ptr<boost::asio::steady_timer> metricUpdateTimer = std::make_shared<boost::asio::steady_timer>(*ioContext);
+
+    metricUpdateTimer->expires_at(Acore::Asio::SteadyTimer::GetExpirationTime(1));
+    metricUpdateTimer->async_wait(std::bind(&MetricUpdateHandler, std::weak_ptr<boost::asio::steady_timer>(metricUpdateTimer), std::placeholders::_1));
+
     // Start the io service worker loop
     ioContext->run();
 
+    metricUpdateTimer->cancel();
     patchJobsTimer->cancel();
     banExpiryCheckTimer->cancel();
     dbPingTimer->cancel();
@@ -279,8 +311,12 @@ void BanExpiryHandler(std::weak_ptr<boost::asio::steady_timer> banExpiryCheckTim
     {
         if (std::shared_ptr<boost::asio::steady_timer> banExpiryCheckTimer = banExpiryCheckTimerRef.lock())
         {
+            // bans loaded since the previous check
+            sIpBanCache->ProcessQueryCallbacks();
+
             LoginDatabase.Execute(LoginDatabase.GetPreparedStatement(LOGIN_DEL_EXPIRED_IP_BANS));
             LoginDatabase.Execute(LoginDatabase.GetPreparedStatement(LOGIN_UPD_EXPIRED_ACCOUNT_BANS));
+            sIpBanCache->LoadAsync();
 
             banExpiryCheckTimer->expires_at(Acore::Asio::SteadyTimer::GetExpirationTime(banExpiryCheckInterval));
             banExpiryCheckTimer->async_wait(std::bind(&BanExpiryHandler, banExpiryCheckTimerRef, banExpiryCheckInterval, std::placeholders::_1));
@@ -303,6 +339,20 @@ void PatchJobsHandler(std::weak_ptr<boost::asio::steady_timer> patchJobsTimerRef
     }
 }
 
+void MetricUpdateHandler(std::weak_ptr<boost::asio::steady_timer> metricUpdateTimerRef, boost::system::error_code const& error)
+{
+    if (!error)
+    {
+        if (std::shared_ptr<boost::asio::steady_timer> metricUpdateTimer = metricUpdateTimerRef.lock())
+        {
+            sMetric->Update();
+
+            metricUpdateTimer->expires_at(Acore::Asio::SteadyTimer::GetExpirationTime(1));
+            metricUpdateTimer->async_wait(std::bind(&MetricUpdateHandler, metricUpdateTimerRef, std::placeholders::_1));
+        }
+    }
+}
+
 variables_map GetConsoleArguments(int argc, char** argv, fs::path& configFile)
 {
     options_description all("Allowed options");
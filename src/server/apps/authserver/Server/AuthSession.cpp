@@ -24,6 +24,7 @@
 #include "CryptoRandom.h"
 #include "DatabaseEnv.h"
 #include "IPLocation.h"
+#include "IpBanCache.h"
 #include "Log.h"
 #include "RealmList.h"
 #include "SecretMgr.h"
@@ -186,10 +187,18 @@ void AuthSession::Start()
     std::string ip_address = GetRemoteIpAddress().to_string();
     LOG_TRACE("session", "Accepted connection from {}", ip_address);
 
-    LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_IP_INFO);
-    stmt->SetData(0, ip_address);
+    if (sIpBanCache->IsBanned(ip_address))
+    {
+        ByteBuffer pkt;
+        pkt << uint8(AUTH_LOGON_CHALLENGE);
+        pkt << uint8(0x00);
+        pkt << uint8(WOW_FAIL_BANNED);
+        SendPacket(pkt);
+        LOG_DEBUG("session", "[AuthSession::Start] Banned ip '{}:{}' tries to login!", ip_address, GetRemotePort());
+        return;
+    }
 
-    _queryProcessor.AddCallback(LoginDatabase.AsyncQuery(stmt).WithPreparedCallback(std::bind(&AuthSession::CheckIpCallback, this, std::placeholders::_1)));
+    AsyncRead();
 }
 
 bool AuthSession::Update()
@@ -198,40 +207,11 @@ bool AuthSession::Update()
         return false;
 
     _queryProcessor.ProcessReadyCallbacks();
+    _logonTaskProcessor.ProcessReadyCallbacks();
 
     return true;
 }
 
-void AuthSession::CheckIpCallback(PreparedQueryResult result)
-{
-    if (result)
-    {
-        bool banned = false;
-
-        for (auto const& fields : *result)
-        {
-            if (fields[0].Get<uint64>() != 0)
-            {
-                banned = true;
-                break;
-            }
-        }
-
-        if (banned)
-        {
-            ByteBuffer pkt;
-            pkt << uint8(AUTH_LOGON_CHALLENGE);
-            pkt << uint8(0x00);
-            pkt << uint8(WOW_FAIL_BANNED);
-            SendPacket(pkt);
-            LOG_DEBUG("session", "[AuthSession::CheckIpCallback] Banned ip '{}:{}' tries to login!", GetRemoteIpAddress().to_string(), GetRemotePort());
-            return;
-        }
-    }
-
-    AsyncRead();
-}
-
 void AuthSession::ReadHandler()
 {
     MessageBuffer& packet = GetReadBuffer();
@@ -307,6 +287,8 @@ bool AuthSession::HandleLogonChallenge()
     std::string login((char const*)challenge->I, challenge->I_len);
     LOG_DEBUG("server.authserver", "[AuthChallenge] '{}'", login);
 
+    _logonStart = std::chrono::steady_clock::now();
+
     _build = challenge->build;
     _expversion = uint8(AuthHelper::IsPostBCAcceptedClientBuild(_build) ? POST_BC_EXP_FLAG : (AuthHelper::IsPreBCAcceptedClientBuild(_build) ? PRE_BC_EXP_FLAG : NO_VALID_EXP_FLAG));
     std::array<char, 5> os;
@@ -421,50 +403,70 @@ void AuthSession::LogonChallengeCallback(PreparedQueryResult result)
         }
     }
 
-    _srp6.emplace(_accountInfo.Login,
-        fields[12].Get<Binary, Acore::Crypto::SRP6::SALT_LENGTH>(),
-        fields[13].Get<Binary, Acore::Crypto::SRP6::VERIFIER_LENGTH>());
+    if (!AuthHelper::IsAcceptedClientBuild(_build))
+    {
+        pkt << uint8(WOW_FAIL_VERSION_INVALID);
+        SendPacket(pkt);
+        return;
+    }
 
-    // Fill the response packet with the result
-    if (AuthHelper::IsAcceptedClientBuild(_build))
+    // B = g^b mod N is computed by a logon worker, the challenge is sent once it is ready
+    bool queued = EnqueueLogonTask([login = _accountInfo.Login,
+        salt = fields[12].Get<Binary, Acore::Crypto::SRP6::SALT_LENGTH>(),
+        verifier = fields[13].Get<Binary, Acore::Crypto::SRP6::VERIFIER_LENGTH>()]()
     {
-        pkt << uint8(WOW_SUCCESS);
+        return std::make_shared<Acore::Crypto::SRP6>(login, salt, verifier);
+    }, [this, securityFlags](std::shared_ptr<Acore::Crypto::SRP6> srp6)
+    {
+        _srp6 = std::move(srp6);
+        SendLogonChallenge(securityFlags);
+    });
 
-        pkt.append(_srp6->B);
-        pkt << uint8(1);
-        pkt.append(_srp6->g);
-        pkt << uint8(32);
-        pkt.append(_srp6->N);
-        pkt.append(_srp6->s);
-        pkt.append(VersionChallenge.data(), VersionChallenge.size());
-        pkt << uint8(securityFlags);            // security flags (0x0...0x04)
-
-        if (securityFlags & 0x01)               // PIN input
-        {
-            pkt << uint32(0);
-            pkt << uint64(0) << uint64(0);      // 16 bytes hash?
-        }
+    if (!queued)
+    {
+        pkt << uint8(WOW_FAIL_DB_BUSY);
+        SendPacket(pkt);
+    }
+}
 
-        if (securityFlags & 0x02)               // Matrix input
-        {
-            pkt << uint8(0);
-            pkt << uint8(0);
-            pkt << uint8(0);
-            pkt << uint8(0);
-            pkt << uint64(0);
-        }
+void AuthSession::SendLogonChallenge(uint8 securityFlags)
+{
+    ByteBuffer pkt;
+    pkt << uint8(AUTH_LOGON_CHALLENGE);
+    pkt << uint8(0x00);
+    pkt << uint8(WOW_SUCCESS);
 
-        if (securityFlags & 0x04)               // Security token input
-            pkt << uint8(1);
+    pkt.append(_srp6->B);
+    pkt << uint8(1);
+    pkt.append(Acore::Crypto::SRP6::g);
+    pkt << uint8(32);
+    pkt.append(Acore::Crypto::SRP6::N);
+    pkt.append(_srp6->s);
+    pkt.append(VersionChallenge.data(), VersionChallenge.size());
+    pkt << uint8(securityFlags);            // security flags (0x0...0x04)
 
-        LOG_DEBUG("server.authserver", "'{}:{}' [AuthChallenge] account {} is using '{}' locale ({})",
-            ipAddress, port, _accountInfo.Login, _localizationName, GetLocaleByName(_localizationName));
+    if (securityFlags & 0x01)               // PIN input
+    {
+        pkt << uint32(0);
+        pkt << uint64(0) << uint64(0);      // 16 bytes hash?
+    }
 
-        _status = STATUS_LOGON_PROOF;
+    if (securityFlags & 0x02)               // Matrix input
+    {
+        pkt << uint8(0);
+        pkt << uint8(0);
+        pkt << uint8(0);
+        pkt << uint8(0);
+        pkt << uint64(0);
     }
-    else
-        pkt << uint8(WOW_FAIL_VERSION_INVALID);
 
+    if (securityFlags & 0x04)               // Security token input
+        pkt << uint8(1);
+
+    LOG_DEBUG("server.authserver", "'{}:{}' [AuthChallenge] account {} is using '{}' locale ({})",
+        GetRemoteIpAddress().to_string(), GetRemotePort(), _accountInfo.Login, _localizationName, GetLocaleByName(_localizationName));
+
+    _status = STATUS_LOGON_PROOF;
     SendPacket(pkt);
 }
 
@@ -484,99 +486,40 @@ bool AuthSession::HandleLogonProof()
         return false;
     }
 
-    // Check if SRP6 results match (password is correct), else send an error
-    if (Optional<SessionKey> K = _srp6->VerifyChallengeResponse(logonProof->A, logonProof->clientM))
+    // The security token follows the proof, read it before the proof is checked on a logon worker
+    Optional<std::string> token;
+    if ((logonProof->securityFlags & 0x04) && _totpSecret)
     {
-        _sessionKey = *K;
-        // Check auth token
-        bool tokenSuccess = false;
-        bool sentToken = (logonProof->securityFlags & 0x04);
-        if (sentToken && _totpSecret)
-        {
-            uint8 size = *(GetReadBuffer().GetReadPointer() + sizeof(sAuthLogonProof_C));
-            std::string token(reinterpret_cast<char*>(GetReadBuffer().GetReadPointer() + sizeof(sAuthLogonProof_C) + sizeof(size)), size);
-            GetReadBuffer().ReadCompleted(sizeof(size) + size);
-
-            uint32 incomingToken = *Acore::StringTo<uint32>(token);
-            tokenSuccess = Acore::Crypto::TOTP::ValidateToken(*_totpSecret, incomingToken);
-            memset(_totpSecret->data(), 0, _totpSecret->size());
-        }
-        else if (!sentToken && !_totpSecret)
-            tokenSuccess = true;
-
-        if (!tokenSuccess)
-        {
-            ByteBuffer packet;
-            packet << uint8(AUTH_LOGON_PROOF);
-            packet << uint8(WOW_FAIL_UNKNOWN_ACCOUNT);
-            packet << uint16(0);    // LoginFlags, 1 has account message
-            SendPacket(packet);
-            return true;
-        }
-
-        if (!VerifyVersion(logonProof->A.data(), logonProof->A.size(), logonProof->crc_hash, false))
-        {
-            ByteBuffer packet;
-            packet << uint8(AUTH_LOGON_PROOF);
-            packet << uint8(WOW_FAIL_VERSION_INVALID);
-            SendPacket(packet);
-            return true;
-        }
+        uint8 size = *(GetReadBuffer().GetReadPointer() + sizeof(sAuthLogonProof_C));
+        token.emplace(reinterpret_cast<char*>(GetReadBuffer().GetReadPointer() + sizeof(sAuthLogonProof_C) + sizeof(size)), size);
+        GetReadBuffer().ReadCompleted(sizeof(size) + size);
+    }
 
-        LOG_DEBUG("server.authserver", "'{}:{}' User '{}' successfully authenticated", GetRemoteIpAddress().to_string(), GetRemotePort(), _accountInfo.Login);
+    // Check if SRP6 results match (password is correct), the answer is sent by LogonProofCallback
+    sAuthLogonProof_C const proof = *logonProof;
+    bool queued = EnqueueLogonTask([srp6 = _srp6, A = proof.A, clientM = proof.clientM]()
+    {
+        return srp6->VerifyChallengeResponse(A, clientM);
+    }, [this, proof, token = std::move(token)](Optional<SessionKey> const& sessionKey)
+    {
+        LogonProofCallback(proof, token, sessionKey);
+    });
 
-        // Check if client needs patching (build below minimum)
-        if (CheckAndInitiatePatch())
-        {
-            LOG_INFO("server.authserver", "Client build {} requires patching, transfer initiated", _build);
-            return true; // Patch transfer initiated, keep connection open
-        }
+    if (!queued)
+    {
+        ByteBuffer packet;
+        packet << uint8(AUTH_LOGON_PROOF);
+        packet << uint8(WOW_FAIL_DB_BUSY);
+        packet << uint16(0);    // LoginFlags, 1 has account message
+        SendPacket(packet);
+    }
 
-        // Update the sessionkey, last_ip, last login time and reset number of failed logins in the account table for this account
-        // No SQL injection (escaped user name) and IP address as received by socket
-
-        std::string address = sConfigMgr->GetOption<bool>("AllowLoggingIPAddressesInDatabase", true, true) ? GetRemoteIpAddress().to_string() : "0.0.0.0";
-        LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_LOGONPROOF);
-        stmt->SetData(0, _sessionKey);
-        stmt->SetData(1, address);
-        stmt->SetData(2, GetLocaleByName(_localizationName));
-        stmt->SetData(3, _os);
-        stmt->SetData(4, _accountInfo.Login);
-        _queryProcessor.AddCallback(LoginDatabase.AsyncQuery(stmt)
-            .WithPreparedCallback([this, M2 = Acore::Crypto::SRP6::GetSessionVerifier(logonProof->A, logonProof->clientM, _sessionKey)](PreparedQueryResult const&)
-        {
-            // Finish SRP6 and send the final result to the client
-            ByteBuffer packet;
-            if (_expversion & POST_BC_EXP_FLAG)                 // 2.x and 3.x clients
-            {
-                sAuthLogonProof_S proof;
-                proof.M2 = M2;
-                proof.cmd = AUTH_LOGON_PROOF;
-                proof.error = 0;
-                proof.AccountFlags = ACCOUNT_FLAG_PROPASS_LOCK;    // enum AccountFlag
-                proof.SurveyId = 0;
-                proof.LoginFlags = 0;               // 0x1 = has account message
-
-                packet.resize(sizeof(proof));
-                std::memcpy(packet.contents(), &proof, sizeof(proof));
-            }
-            else
-            {
-                sAuthLogonProof_S_Old proof;
-                proof.M2 = M2;
-                proof.cmd = AUTH_LOGON_PROOF;
-                proof.error = 0;
-                proof.unk2 = 0x00;
-
-                packet.resize(sizeof(proof));
-                std::memcpy(packet.contents(), &proof, sizeof(proof));
-            }
+    return true;
+}
 
-            SendPacket(packet);
-            _status = STATUS_AUTHED;
-        }));
-    }
-    else
+void AuthSession::LogonProofCallback(sAuthLogonProof_C const& logonProof, Optional<std::string> const& token, Optional<SessionKey> const& sessionKey)
+{
+    if (!sessionKey)
     {
         ByteBuffer packet;
         packet << uint8(AUTH_LOGON_PROOF);
@@ -597,7 +540,7 @@ bool AuthSession::HandleLogonProof()
             logstmt->SetData(1, GetRemoteIpAddress().to_string());
             logstmt->SetData(2, "Login to WoW Failed - Incorrect Password");
 
-            LoginDatabase.Execute(logstmt);
+            LoginDatabase.Execute(logstmt, DatabaseLane::Background);
         }
 
         if (MaxWrongPassCount > 0)
@@ -634,9 +577,95 @@ bool AuthSession::HandleLogonProof()
                 }
             }
         }
+        return;
     }
 
-    return true;
+    _sessionKey = *sessionKey;
+    // Check auth token
+    bool tokenSuccess = false;
+    bool sentToken = (logonProof.securityFlags & 0x04);
+    if (sentToken && _totpSecret)
+    {
+        uint32 incomingToken = *Acore::StringTo<uint32>(*token);
+        tokenSuccess = Acore::Crypto::TOTP::ValidateToken(*_totpSecret, incomingToken);
+        memset(_totpSecret->data(), 0, _totpSecret->size());
+    }
+    else if (!sentToken && !_totpSecret)
+        tokenSuccess = true;
+
+    if (!tokenSuccess)
+    {
+        ByteBuffer packet;
+        packet << uint8(AUTH_LOGON_PROOF);
+        packet << uint8(WOW_FAIL_UNKNOWN_ACCOUNT);
+        packet << uint16(0);    // LoginFlags, 1 has account message
+        SendPacket(packet);
+        return;
+    }
+
+    if (!VerifyVersion(logonProof.A.data(), logonProof.A.size(), logonProof.crc_hash, false))
+    {
+        ByteBuffer packet;
+        packet << uint8(AUTH_LOGON_PROOF);
+        packet << uint8(WOW_FAIL_VERSION_INVALID);
+        SendPacket(packet);
+        return;
+    }
+
+    LOG_DEBUG("server.authserver", "'{}:{}' User '{}' successfully authenticated", GetRemoteIpAddress().to_string(), GetRemotePort(), _accountInfo.Login);
+
+    // Check if client needs patching (build below minimum)
+    if (CheckAndInitiatePatch())
+    {
+        LOG_INFO("server.authserver", "Client build {} requires patching, transfer initiated", _build);
+        return; // Patch transfer initiated, keep connection open
+    }
+
+    // Update the sessionkey, last_ip, last login time and reset number of failed logins in the account table for this account
+    // No SQL injection (escaped user name) and IP address as received by socket
+
+    std::string address = sConfigMgr->GetOption<bool>("AllowLoggingIPAddressesInDatabase", true, true) ? GetRemoteIpAddress().to_string() : "0.0.0.0";
+    LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_LOGONPROOF);
+    stmt->SetData(0, _sessionKey);
+    stmt->SetData(1, address);
+    stmt->SetData(2, GetLocaleByName(_localizationName));
+    stmt->SetData(3, _os);
+    stmt->SetData(4, _accountInfo.Login);
+    _queryProcessor.AddCallback(LoginDatabase.AsyncQuery(stmt)
+        .WithPreparedCallback([this, M2 = Acore::Crypto::SRP6::GetSessionVerifier(logonProof.A, logonProof.clientM, _sessionKey)](PreparedQueryResult const&)
+    {
+        // Finish SRP6 and send the final result to the client
+        ByteBuffer packet;
+        if (_expversion & POST_BC_EXP_FLAG)                 // 2.x and 3.x clients
+        {
+            sAuthLogonProof_S proof;
+            proof.M2 = M2;
+            proof.cmd = AUTH_LOGON_PROOF;
+            proof.error = 0;
+            proof.AccountFlags = ACCOUNT_FLAG_PROPASS_LOCK;    // enum AccountFlag
+            proof.SurveyId = 0;
+            proof.LoginFlags = 0;               // 0x1 = has account message
+
+            packet.resize(sizeof(proof));
+            std::memcpy(packet.contents(), &proof, sizeof(proof));
+        }
+        else
+        {
+            sAuthLogonProof_S_Old proof;
+            proof.M2 = M2;
+            proof.cmd = AUTH_LOGON_PROOF;
+            proof.error = 0;
+            proof.unk2 = 0x00;
+
+            packet.resize(sizeof(proof));
+            std::memcpy(packet.contents(), &proof, sizeof(proof));
+        }
+
+        SendPacket(packet);
+        _status = STATUS_AUTHED;
+
+        sAuthWorkerPool->AddLogonLatency(std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - _logonStart));
+    }));
 }
 
 bool AuthSession::HandleReconnectChallenge()
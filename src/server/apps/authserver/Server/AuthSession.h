@@ -19,6 +19,7 @@
 #define __AUTHSESSION_H__
 
 #include "AsyncCallbackProcessor.h"
+#include "AuthWorkerPool.h"
 #include "BigNumber.h"
 #include "ByteBuffer.h"
 #include "Common.h"
@@ -33,6 +34,7 @@ using boost::asio::ip::tcp;
 
 class Field;
 struct AuthHandler;
+struct AUTH_LOGON_PROOF_C;
 struct PatchInfo;
 
 enum AuthStatus
@@ -92,8 +94,9 @@ private:
     bool HandleXferResume();
     bool HandleXferCancel();
 
-    void CheckIpCallback(PreparedQueryResult result);
     void LogonChallengeCallback(PreparedQueryResult result);
+    void SendLogonChallenge(uint8 securityFlags);
+    void LogonProofCallback(AUTH_LOGON_PROOF_C const& logonProof, Optional<std::string> const& token, Optional<SessionKey> const& sessionKey);
     void ReconnectChallengeCallback(PreparedQueryResult result);
     void RealmListCallback(PreparedQueryResult result);
 
@@ -102,7 +105,20 @@ private:
     // Check if client needs patching and initiate if needed
     bool CheckAndInitiatePatch();
 
-    Optional<Acore::Crypto::SRP6> _srp6;
+    // Runs task on a logon worker and callback on this session once it is done, false when the workers are overloaded
+    template<class Task, class Callback>
+    bool EnqueueLogonTask(Task&& task, Callback&& callback)
+    {
+        Optional<AuthTaskCallback> taskCallback = sAuthWorkerPool->Enqueue(std::forward<Task>(task), std::forward<Callback>(callback));
+        if (!taskCallback)
+            return false;
+
+        _logonTaskProcessor.AddCallback(std::move(*taskCallback));
+        return true;
+    }
+
+    // shared with the logon worker verifying the proof
+    std::shared_ptr<Acore::Crypto::SRP6> _srp6;
     SessionKey _sessionKey = {};
     std::array<uint8, 16> _reconnectProof = {};
 
@@ -119,6 +135,8 @@ private:
     PatchInfo* _pendingPatch = nullptr;
 
     QueryCallbackProcessor _queryProcessor;
+    AsyncCallbackProcessor<AuthTaskCallback> _logonTaskProcessor;
+    TimePoint _logonStart;
 };
 
 #pragma pack(push, 1)
@@ -0,0 +1,116 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "AuthWorkerPool.h"
+#include "Log.h"
+
+AuthWorkerPool::AuthWorkerPool() : _maxQueued(0), _queued(0), _rejected(0),
+    _taskWait(std::make_unique<DatabaseLatencyHistogram>()), _logonLatency(std::make_unique<DatabaseLatencyHistogram>()) { }
+
+AuthWorkerPool* AuthWorkerPool::instance()
+{
+    static AuthWorkerPool instance;
+    return &instance;
+}
+
+void AuthWorkerPool::Start(uint32 threads, std::size_t maxQueued)
+{
+    _maxQueued = maxQueued;
+
+    for (uint32 i = 0; i < threads; ++i)
+        _workers.emplace_back(&AuthWorkerPool::WorkerThread, this);
+
+    if (threads)
+        LOG_INFO("server.authserver", "Started {} logon worker threads, at most {} queued logons.", threads, maxQueued);
+}
+
+void AuthWorkerPool::Stop()
+{
+    _queue.Cancel();
+
+    for (std::thread& worker : _workers)
+        worker.join();
+
+    _workers.clear();
+}
+
+bool AuthWorkerPool::Enqueue(std::function<void()>&& task)
+{
+    if (_workers.empty())
+    {
+        task();
+        return true;
+    }
+
+    // reserve the slot first, so concurrent producers cannot go past the limit together
+    if (_queued.fetch_add(1) >= _maxQueued)
+    {
+        --_queued;
+        ++_rejected;
+        return false;
+    }
+
+    _queue.Push(new Task{ std::move(task), std::chrono::steady_clock::now() });
+    return true;
+}
+
+void AuthWorkerPool::WorkerThread()
+{
+    for (;;)
+    {
+        Task* task = nullptr;
+        _queue.WaitAndPop(task);
+        if (!task)
+            return;
+
+        --_queued;
+
+        {
+            std::lock_guard<std::mutex> lock(_histogramLock);
+            _taskWait->Add(std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - task->QueueTime));
+        }
+
+        task->Run();
+        delete task;
+    }
+}
+
+void AuthWorkerPool::AddLogonLatency(Microseconds latency)
+{
+    std::lock_guard<std::mutex> lock(_histogramLock);
+    _logonLatency->Add(latency);
+}
+
+AuthWorkerPoolStats AuthWorkerPool::ConsumeStats()
+{
+    AuthWorkerPoolStats stats;
+    stats.Rejected = _rejected.exchange(0);
+    stats.Queued = _queued.load();
+
+    std::unique_ptr<DatabaseLatencyHistogram> taskWait = std::make_unique<DatabaseLatencyHistogram>();
+    std::unique_ptr<DatabaseLatencyHistogram> logonLatency = std::make_unique<DatabaseLatencyHistogram>();
+    {
+        std::lock_guard<std::mutex> lock(_histogramLock);
+        std::swap(taskWait, _taskWait);
+        std::swap(logonLatency, _logonLatency);
+    }
+
+    stats.TaskWait = taskWait->GetSnapshot();
+    stats.LogonLatency = logonLatency->GetSnapshot();
+    return stats;
+}
@@ -0,0 +1,129 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef AuthWorkerPool_h__
+#define AuthWorkerPool_h__
+
+#include "DatabaseLatencyHistogram.h"
+#include "Define.h"
+#include "Optional.h"
+#include "PCQueue.h"
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Result of a task run by the AuthWorkerPool, polled by the session that queued it
+ * through its AsyncCallbackProcessor, so the callback runs on the network thread.
+ */
+class AuthTaskCallback
+{
+public:
+    template<class Result, class Callback>
+    AuthTaskCallback(std::shared_future<Result> result, Callback&& callback)
+        : _invokeIfReady([result = std::move(result), callback = std::forward<Callback>(callback)]() mutable
+        {
+            if (result.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                return false;
+
+            callback(result.get());
+            return true;
+        }) { }
+
+    bool InvokeIfReady() { return _invokeIfReady(); }
+
+private:
+    std::function<bool()> _invokeIfReady;
+};
+
+struct AuthWorkerPoolStats
+{
+    uint64 Rejected = 0;
+    std::size_t Queued = 0;
+    DatabaseLatencyHistogram::Snapshot TaskWait;
+    DatabaseLatencyHistogram::Snapshot LogonLatency;
+};
+
+/**
+ * Runs the CPU heavy part of the logons (SRP6 ephemeral key and proof verification)
+ * out of the network thread, on LogonWorkerThreads threads.
+ *
+ * The queue is bounded by LogonWorkerQueueSize, a task queued past that limit is refused
+ * and the session answers the client that the server is busy. Without worker threads the
+ * tasks run on the calling thread, as before the pool existed.
+ */
+class AuthWorkerPool
+{
+public:
+    static AuthWorkerPool* instance();
+
+    void Start(uint32 threads, std::size_t maxQueued);
+    void Stop();
+
+    // Returns nothing when the queue is full
+    template<class Task, class Callback>
+    Optional<AuthTaskCallback> Enqueue(Task&& task, Callback&& callback)
+    {
+        using Result = std::invoke_result_t<Task>;
+
+        auto packagedTask = std::make_shared<std::packaged_task<Result()>>(std::forward<Task>(task));
+        std::shared_future<Result> result = packagedTask->get_future().share();
+        if (!Enqueue([packagedTask]() { (*packagedTask)(); }))
+            return {};
+
+        return AuthTaskCallback(std::move(result), std::forward<Callback>(callback));
+    }
+
+    // Time from the logon challenge to the logon proof answer, for successful logons
+    void AddLogonLatency(Microseconds latency);
+
+    // Counters since the previous call
+    AuthWorkerPoolStats ConsumeStats();
+
+private:
+    struct Task
+    {
+        std::function<void()> Run;
+        TimePoint QueueTime;
+    };
+
+    AuthWorkerPool();
+
+    bool Enqueue(std::function<void()>&& task);
+    void WorkerThread();
+
+    ProducerConsumerQueue<Task*> _queue;
+    std::vector<std::thread> _workers;
+    std::size_t _maxQueued;
+    std::atomic<std::size_t> _queued;
+    std::atomic<uint64> _rejected;
+
+    // replaced on every ConsumeStats, samples are rare enough for a lock
+    std::mutex _histogramLock;
+    std::unique_ptr<DatabaseLatencyHistogram> _taskWait;
+    std::unique_ptr<DatabaseLatencyHistogram> _logonLatency;
+};
+
+#define sAuthWorkerPool AuthWorkerPool::instance()
+
+#endif // AuthWorkerPool_h__
@@ -0,0 +1,70 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "IpBanCache.h"
+#include "DatabaseEnv.h"
+#include "Log.h"
+#include "QueryResult.h"
+#include <functional>
+#include <mutex>
+
+IpBanCache* IpBanCache::instance()
+{
+    static IpBanCache instance;
+    return &instance;
+}
+
+void IpBanCache::Load()
+{
+    // SELECT ip, bandate, unbandate, bannedby, banreason FROM ip_banned WHERE (bandate = unbandate OR unbandate > UNIX_TIMESTAMP())
+    SetBannedIps(LoginDatabase.Query(LoginDatabase.GetPreparedStatement(LOGIN_SEL_IP_BANNED_ALL)));
+}
+
+void IpBanCache::LoadAsync()
+{
+    _queryProcessor.AddCallback(LoginDatabase.AsyncQuery(LoginDatabase.GetPreparedStatement(LOGIN_SEL_IP_BANNED_ALL))
+        .WithPreparedCallback(std::bind(&IpBanCache::SetBannedIps, this, std::placeholders::_1)));
+}
+
+void IpBanCache::ProcessQueryCallbacks()
+{
+    _queryProcessor.ProcessReadyCallbacks();
+}
+
+void IpBanCache::SetBannedIps(PreparedQueryResult result)
+{
+    std::unordered_set<std::string> bannedIps;
+    if (result)
+    {
+        do
+        {
+            bannedIps.insert(result->Fetch()[0].Get<std::string>());
+        } while (result->NextRow());
+    }
+
+    LOG_DEBUG("server.authserver", "Loaded {} active IP bans.", bannedIps.size());
+
+    std::unique_lock<std::shared_mutex> lock(_lock);
+    _bannedIps.swap(bannedIps);
+}
+
+bool IpBanCache::IsBanned(std::string const& ip) const
+{
+    std::shared_lock<std::shared_mutex> lock(_lock);
+    return _bannedIps.count(ip) != 0;
+}
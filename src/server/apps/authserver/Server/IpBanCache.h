@@ -0,0 +1,62 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef IpBanCache_h__
+#define IpBanCache_h__
+
+#include "AsyncCallbackProcessor.h"
+#include "DatabaseEnvFwd.h"
+#include "Define.h"
+#include <shared_mutex>
+#include <string>
+#include <unordered_set>
+
+/**
+ * Active IP bans, reloaded with a single query every BanExpiryCheckInterval instead of
+ * querying ip_banned for every new connection.
+ *
+ * Only used to drop banned addresses early: the logon challenge query still checks
+ * ip_banned, so a ban added since the last reload is enforced when the account logs in.
+ */
+class IpBanCache
+{
+public:
+    static IpBanCache* instance();
+
+    // At startup, before connections are accepted
+    void Load();
+
+    // Reloads the bans on the database workers, the io thread only applies them in a later ProcessQueryCallbacks
+    void LoadAsync();
+    void ProcessQueryCallbacks();
+
+    bool IsBanned(std::string const& ip) const;
+
+private:
+    IpBanCache() = default;
+
+    void SetBannedIps(PreparedQueryResult result);
+
+    mutable std::shared_mutex _lock;
+    std::unordered_set<std::string> _bannedIps;
+    QueryCallbackProcessor _queryProcessor;
+};
+
+#define sIpBanCache IpBanCache::instance()
+
+#endif // IpBanCache_h__
@@ -32,6 +32,7 @@
 #include "DatabaseLoader.h"
 #include "GitRevision.h"
 #include "IoContext.h"
+#include "LineOfSightCache.h"
 #include "MapMgr.h"
 #include "Metric.h"
 #include "ModuleMgr.h"
@@ -39,12 +40,14 @@
 #include "MySQLThreading.h"
 #include "OpenSSLCrypto.h"
 #include "OutdoorPvPMgr.h"
+#include "Player.h"
 #include "ProcessPriority.h"
 #include "RASession.h"
 #include "RealmList.h"
 #include "Resolver.h"
 #include "ScriptLoader.h"
 #include "ScriptMgr.h"
+#include "SQLOperationQueue.h"
 #include "SecretMgr.h"
 #include "SharedDefines.h"
 #include "SteadyTimer.h"
@@ -113,6 +116,8 @@ void StopDB();
 bool LoadRealmInfo(Acore::Asio::IoContext& ioContext);
 AsyncAcceptor* StartRaSocketAcceptor(Acore::Asio::IoContext& ioContext);
 void ShutdownCLIThread(std::thread* cliThread);
+template<class T>
+void ReportDatabaseMetrics(std::string const& name, DatabaseWorkerPool<T> const& pool);
 void WorldUpdateLoop();
 variables_map GetConsoleArguments(int argc, char** argv, fs::path& configFile, [[maybe_unused]] std::string& cfg_service);
 
@@ -291,6 +296,29 @@ int main(int argc, char** argv)
         METRIC_VALUE("db_queue_login", uint64(LoginDatabase.QueueSize()));
         METRIC_VALUE("db_queue_character", uint64(CharacterDatabase.QueueSize()));
         METRIC_VALUE("db_queue_world", uint64(WorldDatabase.QueueSize()));
+
+        ReportDatabaseMetrics("login", LoginDatabase);
+        ReportDatabaseMetrics("character", CharacterDatabase);
+        ReportDatabaseMetrics("world", WorldDatabase);
+
+        MySQLTransactionBatchStats characterBatching = CharacterDatabase.ConsumeTransactionBatchStats();
+        METRIC_VALUE("db_transaction_statements_character", characterBatching.Statements);
+        METRIC_VALUE("db_transaction_executions_character", characterBatching.Executions);
+
+        UpdatePacketCompressionStats compression = EncryptableAndCompressiblePacket::ConsumeCompressionStats();
+        METRIC_VALUE("update_compression_packets", compression.Packets);
+        METRIC_VALUE("update_compression_bytes_in", compression.BytesIn);
+        METRIC_VALUE("update_compression_bytes_out", compression.BytesOut);
+        METRIC_VALUE("update_compression_time", uint64(compression.Time.count()));
+
+        LineOfSightCacheStats lineOfSight = LineOfSightCache::ConsumeStats();
+        METRIC_VALUE("los_cache_hits", lineOfSight.Hits);
+        METRIC_VALUE("los_cache_misses", lineOfSight.Misses);
+
+        std::array<uint64, MAX_PLAYER_SAVE_SECTIONS> saveStatements = Player::ConsumeSaveStatementCounts();
+        for (uint8 section = 0; section < MAX_PLAYER_SAVE_SECTIONS; ++section)
+            METRIC_VALUE("player_save_statements", saveStatements[section],
+                METRIC_TAG("section", Player::GetSaveSectionName(PlayerSaveSection(section))));
     });
 
     METRIC_EVENT("events", "Worldserver started", "");
@@ -554,6 +582,34 @@ void ShutdownCLIThread(std::thread* cliThread)
     }
 }
 
+/// Queue size and wait percentiles per lane, and latency percentiles of the statements taking the most time
+template<class T>
+void ReportDatabaseMetrics(std::string const& name, DatabaseWorkerPool<T> const& pool)
+{
+    for (uint8 i = 0; i < MAX_DATABASE_LANES; ++i)
+    {
+        DatabaseLane lane = DatabaseLane(i);
+        DatabaseLatencyHistogram::Snapshot wait = pool.GetQueueWaitTime(lane);
+        METRIC_VALUE("db_lane_queue", uint64(pool.QueueSize(lane)), METRIC_TAG("db", name), METRIC_TAG("lane", GetDatabaseLaneName(lane)));
+        METRIC_VALUE("db_lane_wait_p50", uint64(wait.GetPercentile(50.0f).count()), METRIC_TAG("db", name), METRIC_TAG("lane", GetDatabaseLaneName(lane)));
+        METRIC_VALUE("db_lane_wait_p99", uint64(wait.GetPercentile(99.0f).count()), METRIC_TAG("db", name), METRIC_TAG("lane", GetDatabaseLaneName(lane)));
+    }
+
+    std::vector<DatabaseStatementLatency> statements = pool.GetStatementLatencies();
+    std::size_t reported = std::min<std::size_t>(statements.size(), 5);
+    std::partial_sort(statements.begin(), statements.begin() + reported, statements.end(), [](DatabaseStatementLatency const& left, DatabaseStatementLatency const& right)
+    {
+        return left.Latency.Total > right.Latency.Total;
+    });
+
+    for (std::size_t i = 0; i < reported; ++i)
+    {
+        std::string index = std::to_string(statements[i].Index);
+        METRIC_VALUE("db_statement_count", statements[i].Latency.Count, METRIC_TAG("db", name), METRIC_TAG("statement", index));
+        METRIC_VALUE("db_statement_p99", uint64(statements[i].Latency.GetPercentile(99.0f).count()), METRIC_TAG("db", name), METRIC_TAG("statement", index));
+    }
+}
+
 void WorldUpdateLoop()
 {
     uint32 minUpdateDiff = uint32(sConfigMgr->GetOption<int32>("MinWorldUpdateTime", 1));
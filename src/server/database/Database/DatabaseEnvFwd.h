@@ -18,6 +18,7 @@
 #ifndef DatabaseEnvFwd_h__
 #define DatabaseEnvFwd_h__
 
+#include "Define.h"
 #include <future>
 
 struct QueryResultFieldMetadata;
@@ -46,6 +47,21 @@ using PreparedQueryResult = std::shared_ptr<PreparedResultSet>;
 using PreparedQueryResultFuture = std::future<PreparedQueryResult>;
 using PreparedQueryResultPromise = std::promise<PreparedQueryResult>;
 
+class PreparedBulkResultSet;
+using PreparedBulkQueryResult = std::shared_ptr<PreparedBulkResultSet>;
+
+//! Priority of an asynchronous database operation, lower values are executed first
+enum class DatabaseLane : uint8
+{
+    Interactive,    //! Default, everything players or the world wait on (logins, loading screens, saves)
+    Background,     //! Writes nothing waits on, like logs and statistics
+    Bulk,           //! Large maintenance work
+
+    Max
+};
+
+constexpr std::size_t MAX_DATABASE_LANES = static_cast<std::size_t>(DatabaseLane::Max);
+
 class QueryCallback;
 
 template<typename T>
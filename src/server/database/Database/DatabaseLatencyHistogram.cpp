@@ -0,0 +1,70 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DatabaseLatencyHistogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+void DatabaseLatencyHistogram::Add(Microseconds duration)
+{
+    uint64 const us = uint64(std::max<int64>(duration.count(), 0));
+    std::size_t const bucket = std::min<std::size_t>(std::bit_width(us), BUCKETS - 1);
+
+    _buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+    _total.fetch_add(us, std::memory_order_relaxed);
+
+    uint64 max = _max.load(std::memory_order_relaxed);
+    while (us > max && !_max.compare_exchange_weak(max, us, std::memory_order_relaxed))
+        ;
+}
+
+DatabaseLatencyHistogram::Snapshot DatabaseLatencyHistogram::GetSnapshot() const
+{
+    Snapshot snapshot;
+    snapshot.Count = _count.load(std::memory_order_relaxed);
+    snapshot.Total = Microseconds(_total.load(std::memory_order_relaxed));
+    snapshot.Max = Microseconds(_max.load(std::memory_order_relaxed));
+    for (std::size_t i = 0; i < BUCKETS; ++i)
+        snapshot.Buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+
+    return snapshot;
+}
+
+Microseconds DatabaseLatencyHistogram::Snapshot::GetPercentile(float percentile) const
+{
+    uint64 samples = 0;
+    for (uint64 count : Buckets)
+        samples += count;
+
+    if (!samples)
+        return 0us;
+
+    // rank of the sample at the percentile, 1 based
+    uint64 const rank = std::max<uint64>(1, uint64(std::ceil(samples * std::clamp(percentile, 0.0f, 100.0f) / 100.0f)));
+
+    uint64 seen = 0;
+    for (std::size_t i = 0; i < BUCKETS; ++i)
+    {
+        seen += Buckets[i];
+        if (seen >= rank)
+            return i + 1 < BUCKETS ? Microseconds(uint64(1) << i) : Max;
+    }
+
+    return Max;
+}
@@ -0,0 +1,63 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _DATABASE_LATENCY_HISTOGRAM_H
+#define _DATABASE_LATENCY_HISTOGRAM_H
+
+#include "Define.h"
+#include "Duration.h"
+#include <array>
+#include <atomic>
+
+/**
+ * Lock free histogram of durations with power of two microsecond buckets,
+ * bucket i counting durations in [2^(i-1), 2^i) microseconds, the last one everything above.
+ */
+class AC_DATABASE_API DatabaseLatencyHistogram
+{
+public:
+    static constexpr std::size_t BUCKETS = 24;
+
+    struct Snapshot
+    {
+        uint64 Count = 0;
+        Microseconds Total = 0us;
+        Microseconds Max = 0us;
+        std::array<uint64, BUCKETS> Buckets = {};
+
+        [[nodiscard]] Microseconds GetAverage() const { return Count ? Total / int64(Count) : 0us; }
+
+        //! Upper bound of the bucket holding the given percentile (0 to 100) of the samples
+        [[nodiscard]] Microseconds GetPercentile(float percentile) const;
+    };
+
+    DatabaseLatencyHistogram() = default;
+    DatabaseLatencyHistogram(DatabaseLatencyHistogram const&) = delete;
+    DatabaseLatencyHistogram& operator=(DatabaseLatencyHistogram const&) = delete;
+
+    void Add(Microseconds duration);
+
+    [[nodiscard]] Snapshot GetSnapshot() const;
+
+private:
+    std::array<std::atomic<uint64>, BUCKETS> _buckets{};
+    std::atomic<uint64> _count{0};
+    std::atomic<uint64> _total{0};
+    std::atomic<uint64> _max{0};
+};
+
+#endif
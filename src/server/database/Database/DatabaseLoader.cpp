@@ -21,6 +21,7 @@
 #include "DatabaseEnv.h"
 #include "Duration.h"
 #include "Log.h"
+#include "SQLOperationQueue.h"
 #include <errmsg.h>
 #include <mysqld_error.h>
 #include <thread>
@@ -74,7 +75,35 @@ DatabaseLoader& DatabaseLoader::AddDatabase(DatabaseWorkerPool<T>& pool, std::st
 
         uint8 const synchThreads = sConfigMgr->GetOption<uint8>(name + "Database.SynchThreads", 1);
 
+        uint8 const interactiveWorkers = sConfigMgr->GetOption<uint8>(name + "Database.InteractiveWorkers", 0);
+        if (interactiveWorkers >= asyncThreads)
+        {
+            LOG_ERROR(_logger, "{} database: {}Database.InteractiveWorkers must be lower than {}Database.WorkerThreads, "
+                      "other workers are needed for background and bulk operations.", name, name, name);
+            return false;
+        }
+
+        uint8 const bulkWorkers = sConfigMgr->GetOption<uint8>(name + "Database.BulkWorkers", 0);
+        Milliseconds const maxPriorityWait(sConfigMgr->GetOption<uint32>(name + "Database.MaxPriorityWait", uint32(SQLOperationQueue::DEFAULT_MAX_PRIORITY_WAIT.count())));
+
         pool.SetConnectionInfo(dbString, asyncThreads, synchThreads);
+        pool.SetWorkerLanes(interactiveWorkers, bulkWorkers, maxPriorityWait);
+
+        // Optional, only the character and world databases mark statements as readable from a replica
+        std::string const replicaString = sConfigMgr->GetOption<std::string>(name + "DatabaseReplicaInfo", "", false);
+        if (!replicaString.empty())
+        {
+            uint8 const replicaAsyncThreads = sConfigMgr->GetOption<uint8>(name + "Database.ReplicaWorkerThreads", 1);
+            uint8 const replicaSynchThreads = sConfigMgr->GetOption<uint8>(name + "Database.ReplicaSynchThreads", 1);
+            if (replicaAsyncThreads < 1 || replicaAsyncThreads > 32 || replicaSynchThreads < 1)
+            {
+                LOG_ERROR(_logger, "{} database: invalid number of replica threads specified. "
+                          "Please pick values between 1 and 32.", name);
+                return false;
+            }
+
+            pool.SetReplicaConnectionInfo(replicaString, replicaAsyncThreads, replicaSynchThreads);
+        }
 
         if (uint32 error = pool.Open())
         {
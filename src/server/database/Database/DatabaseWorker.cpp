@@ -16,13 +16,14 @@
  */
 
 #include "DatabaseWorker.h"
-#include "PCQueue.h"
+#include "MySQLConnection.h"
 #include "SQLOperation.h"
 
-DatabaseWorker::DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection)
+DatabaseWorker::DatabaseWorker(SQLOperationQueue* newQueue, MySQLConnection* connection)
 {
     _connection = connection;
     _queue = newQueue;
+    _lanes = _queue ? _queue->AssignWorkerLanes() : 0;
     _workerThread = std::thread(&DatabaseWorker::WorkerThread, this);
 }
 
@@ -38,13 +39,18 @@ void DatabaseWorker::WorkerThread()
 
     for (;;)
     {
-        SQLOperation* operation = nullptr;
-
-        _queue->WaitAndPop(operation);
+        SQLOperation* operation = _queue->WaitAndPop(_lanes);
 
         if (!operation)
             return;
 
+        // A replica that is down hands its operations over to the primary connections
+        if (_connection->IsReplica() && !_connection->TryReplicaReconnect())
+        {
+            _connection->GetFallbackQueue()->Push(operation, DatabaseLane::Interactive);
+            continue;
+        }
+
         operation->SetConnection(_connection);
         operation->call();
 
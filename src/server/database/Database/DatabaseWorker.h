@@ -19,23 +19,22 @@
 #define _WORKERTHREAD_H
 
 #include "Define.h"
+#include "SQLOperationQueue.h"
 #include <atomic>
 #include <thread>
 
-template <typename T>
-class ProducerConsumerQueue;
-
 class MySQLConnection;
 class SQLOperation;
 
 class AC_DATABASE_API DatabaseWorker
 {
 public:
-    DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection);
+    DatabaseWorker(SQLOperationQueue* newQueue, MySQLConnection* connection);
     ~DatabaseWorker();
 
 private:
-    ProducerConsumerQueue<SQLOperation*>* _queue;
+    SQLOperationQueue* _queue;
+    SQLOperationQueue::LaneMask _lanes;
     MySQLConnection* _connection;
 
     void WorkerThread();
@@ -23,12 +23,12 @@
 #include "LoginDatabase.h"
 #include "MySQLPreparedStatement.h"
 #include "MySQLWorkaround.h"
-#include "PCQueue.h"
 #include "PreparedStatement.h"
 #include "QueryCallback.h"
 #include "QueryHolder.h"
 #include "QueryResult.h"
 #include "SQLOperation.h"
+#include "SQLOperationQueue.h"
 #include "Transaction.h"
 #include "WorldDatabase.h"
 #include <limits>
@@ -53,9 +53,12 @@ class PingOperation : public SQLOperation
 
 template <class T>
 DatabaseWorkerPool<T>::DatabaseWorkerPool() :
-    _queue(new ProducerConsumerQueue<SQLOperation*>()),
+    _queue(new SQLOperationQueue()),
+    _replicaQueue(new SQLOperationQueue()),
     _async_threads(0),
-    _synch_threads(0)
+    _synch_threads(0),
+    _replica_async_threads(0),
+    _replica_synch_threads(0)
 {
     WPFatal(mysql_thread_safe(), "Used MySQL library isn't thread-safe.");
 
@@ -71,6 +74,7 @@ DatabaseWorkerPool<T>::DatabaseWorkerPool() :
 template <class T>
 DatabaseWorkerPool<T>::~DatabaseWorkerPool()
 {
+    _replicaQueue->Cancel();
     _queue->Cancel();
 }
 
@@ -83,6 +87,21 @@ void DatabaseWorkerPool<T>::SetConnectionInfo(std::string_view infoString, uint8
     _synch_threads = synchThreads;
 }
 
+template <class T>
+void DatabaseWorkerPool<T>::SetWorkerLanes(uint8 interactiveWorkers, uint8 bulkWorkers, Milliseconds maxPriorityWait)
+{
+    _queue->SetWorkerLanes(interactiveWorkers, bulkWorkers, maxPriorityWait);
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::SetReplicaConnectionInfo(std::string_view infoString, uint8 const asyncThreads, uint8 const synchThreads)
+{
+    _replicaConnectionInfo = std::make_unique<MySQLConnectionInfo>(infoString);
+
+    _replica_async_threads = asyncThreads;
+    _replica_synch_threads = synchThreads;
+}
+
 template <class T>
 uint32 DatabaseWorkerPool<T>::Open()
 {
@@ -100,8 +119,12 @@ uint32 DatabaseWorkerPool<T>::Open()
 
     if (!error)
     {
+        if (_replicaConnectionInfo)
+            OpenReplicaConnections();
+
         LOG_INFO("sql.driver", "DatabasePool '{}' opened successfully. {} total connections running.",
-            GetDatabaseName(), (_connections[IDX_SYNCH].size() + _connections[IDX_ASYNC].size()));
+            GetDatabaseName(), (_connections[IDX_SYNCH].size() + _connections[IDX_ASYNC].size() +
+                _connections[IDX_REPLICA_SYNCH].size() + _connections[IDX_REPLICA_ASYNC].size()));
     }
 
     LOG_INFO("sql.driver", " ");
@@ -109,11 +132,37 @@ uint32 DatabaseWorkerPool<T>::Open()
     return error;
 }
 
+template <class T>
+void DatabaseWorkerPool<T>::OpenReplicaConnections()
+{
+    LOG_INFO("sql.driver", "Opening replica connections of DatabasePool '{}' to {}:{}. Asynchronous connections: {}, synchronous connections: {}.",
+        GetDatabaseName(), _replicaConnectionInfo->host, _replicaConnectionInfo->port_or_socket, _replica_async_threads, _replica_synch_threads);
+
+    // the server runs without replica, reading everything from the primary, rather than not starting
+    if (OpenConnections(IDX_REPLICA_ASYNC, _replica_async_threads) || OpenConnections(IDX_REPLICA_SYNCH, _replica_synch_threads))
+    {
+        LOG_ERROR("sql.driver", "Could not open the replica connections of DatabasePool '{}', all reads use the primary connections.", GetDatabaseName());
+        CloseReplicaConnections();
+    }
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::CloseReplicaConnections()
+{
+    // operations queued for the replica still run, on the primary when the replica is down
+    _replicaQueue->Shutdown();
+    _connections[IDX_REPLICA_ASYNC].clear();
+    _connections[IDX_REPLICA_SYNCH].clear();
+    _replicaStatements.clear();
+}
+
 template <class T>
 void DatabaseWorkerPool<T>::Close()
 {
     LOG_INFO("sql.driver", "Closing down DatabasePool '{}'. Waiting for {} queries to finish...", GetDatabaseName(), _queue->Size());
 
+    CloseReplicaConnections();
+
     // Gracefully close async query queue, worker threads will block when the destructor
     // is called from the .clear() functions below until the queue is empty
     _queue->Shutdown();
@@ -152,7 +201,18 @@ bool DatabaseWorkerPool<T>::PrepareStatements()
 
             std::size_t const preparedSize = connection->m_stmts.size();
             if (_preparedStatementSize.size() < preparedSize)
+            {
                 _preparedStatementSize.resize(preparedSize);
+                _preparedStatementSql.resize(preparedSize);
+            }
+
+            if (connection->IsReplica())
+            {
+                _replicaStatements.resize(preparedSize);
+                for (std::size_t i = 0; i < preparedSize; ++i)
+                    if (connection->m_stmts[i])
+                        _replicaStatements[i] = true;
+            }
 
             for (std::size_t i = 0; i < preparedSize; ++i)
             {
@@ -169,11 +229,17 @@ bool DatabaseWorkerPool<T>::PrepareStatements()
                     ASSERT(paramCount < std::numeric_limits<uint8>::max());
 
                     _preparedStatementSize[i] = static_cast<uint8>(paramCount);
+                    _preparedStatementSql[i] = stmt->GetSql();
                 }
             }
         }
     }
 
+    _statementLatency = std::make_unique<DatabaseLatencyHistogram[]>(_preparedStatementSize.size());
+    for (auto const& connections : _connections)
+        for (auto const& connection : connections)
+            connection->m_statementLatency = _statementLatency.get();
+
     return true;
 }
 
@@ -197,8 +263,23 @@ QueryResult DatabaseWorkerPool<T>::Query(std::string_view sql)
 template <class T>
 PreparedQueryResult DatabaseWorkerPool<T>::Query(PreparedStatement<T>* stmt)
 {
-    auto connection = GetFreeConnection();
+    T* connection = nullptr;
+    if (IsReplicaStatement(stmt->GetIndex()))
+        connection = GetFreeReplicaConnection();
+
+    if (!connection)
+        connection = GetFreeConnection();
+
     PreparedResultSet* ret = connection->Query(stmt);
+
+    // the replica went down while running the query, run it again on the primary
+    if (!ret && !connection->IsReplicaAvailable())
+    {
+        connection->Unlock();
+        connection = GetFreeConnection();
+        ret = connection->Query(stmt);
+    }
+
     connection->Unlock();
 
     //! Delete proxy-class. Not needed anymore
@@ -213,6 +294,25 @@ PreparedQueryResult DatabaseWorkerPool<T>::Query(PreparedStatement<T>* stmt)
     return PreparedQueryResult(ret);
 }
 
+template <class T>
+PreparedBulkQueryResult DatabaseWorkerPool<T>::BulkQuery(PreparedStatement<T>* stmt)
+{
+    auto connection = GetFreeConnection();
+    PreparedBulkResultSet* ret = connection->BulkQuery(stmt);
+    connection->Unlock();
+
+    //! Delete proxy-class. Not needed anymore
+    delete stmt;
+
+    if (!ret || !ret->GetRowCount())
+    {
+        delete ret;
+        return PreparedBulkQueryResult(nullptr);
+    }
+
+    return PreparedBulkQueryResult(ret);
+}
+
 template <class T>
 QueryCallback DatabaseWorkerPool<T>::AsyncQuery(std::string_view sql)
 {
@@ -226,10 +326,16 @@ QueryCallback DatabaseWorkerPool<T>::AsyncQuery(std::string_view sql)
 template <class T>
 QueryCallback DatabaseWorkerPool<T>::AsyncQuery(PreparedStatement<T>* stmt)
 {
+    bool const replica = IsReplicaStatement(stmt->GetIndex()) && !_connections[IDX_REPLICA_ASYNC].empty();
     PreparedStatementTask* task = new PreparedStatementTask(stmt, true);
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
     PreparedQueryResultFuture result = task->GetFuture();
-    Enqueue(task);
+
+    if (replica)
+        _replicaQueue->Push(task, DatabaseLane::Interactive);
+    else
+        Enqueue(task);
+
     return QueryCallback(std::move(result));
 }
 
@@ -246,11 +352,11 @@ SQLQueryHolderCallback DatabaseWorkerPool<T>::DelayQueryHolder(std::shared_ptr<S
 template <class T>
 SQLTransaction<T> DatabaseWorkerPool<T>::BeginTransaction()
 {
-    return std::make_shared<Transaction<T>>();
+    return std::allocate_shared<Transaction<T>>(PoolAllocator<Transaction<T>>());
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction)
+void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction, DatabaseLane lane)
 {
 #ifdef ACORE_DEBUG
     //! Only analyze transaction weaknesses in Debug mode.
@@ -269,7 +375,7 @@ void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction)
     }
 #endif // ACORE_DEBUG
 
-    Enqueue(new TransactionTask(transaction));
+    Enqueue(new TransactionTask(transaction), lane);
 }
 
 template <class T>
@@ -368,6 +474,19 @@ void DatabaseWorkerPool<T>::KeepAlive()
 
     for (uint8 i = 0; i < count; ++i)
         Enqueue(new PingOperation);
+
+    //! Pinging replicas also reconnects the ones that are down
+    for (auto& connection : _connections[IDX_REPLICA_SYNCH])
+    {
+        if (connection->LockIfReady())
+        {
+            connection->Ping();
+            connection->Unlock();
+        }
+    }
+
+    for (std::size_t i = 0; i < _connections[IDX_REPLICA_ASYNC].size(); ++i)
+        _replicaQueue->Push(new PingOperation, DatabaseLane::Interactive);
 }
 
 /**
@@ -428,15 +547,26 @@ uint32 DatabaseWorkerPool<T>::OpenConnections(InternalIndex type, uint8 numConne
                 return std::make_unique<T>(_queue.get(), *_connectionInfo);
             case IDX_SYNCH:
                 return std::make_unique<T>(*_connectionInfo);
+            case IDX_REPLICA_ASYNC:
+                return std::make_unique<T>(_replicaQueue.get(), *_replicaConnectionInfo);
+            case IDX_REPLICA_SYNCH:
+                return std::make_unique<T>(*_replicaConnectionInfo);
             default:
                 ABORT();
             }
         }();
 
+        bool const replica = type == IDX_REPLICA_ASYNC || type == IDX_REPLICA_SYNCH;
+        if (replica)
+        {
+            connection->m_connectionFlags = ConnectionFlags(connection->m_connectionFlags | CONNECTION_REPLICA);
+            connection->m_fallbackQueue = _queue.get();
+        }
+
         if (uint32 error = connection->Open())
         {
             // Failed to open a connection or invalid version, abort and cleanup
-            _queue->Cancel();
+            (replica ? _replicaQueue : _queue)->Cancel();
             _connections[type].clear();
             return error;
         }
@@ -466,9 +596,9 @@ unsigned long DatabaseWorkerPool<T>::EscapeString(char* to, char const* from, un
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::Enqueue(SQLOperation* op)
+void DatabaseWorkerPool<T>::Enqueue(SQLOperation* op, DatabaseLane lane)
 {
-    _queue->Push(op);
+    _queue->Push(op, lane);
 }
 
 template <class T>
@@ -477,6 +607,52 @@ std::size_t DatabaseWorkerPool<T>::QueueSize() const
     return _queue->Size();
 }
 
+template <class T>
+std::size_t DatabaseWorkerPool<T>::QueueSize(DatabaseLane lane) const
+{
+    return _queue->Size(lane);
+}
+
+template <class T>
+DatabaseLatencyHistogram::Snapshot DatabaseWorkerPool<T>::GetQueueWaitTime(DatabaseLane lane) const
+{
+    return _queue->GetWaitTime(lane);
+}
+
+template <class T>
+std::vector<DatabaseStatementLatency> DatabaseWorkerPool<T>::GetStatementLatencies() const
+{
+    std::vector<DatabaseStatementLatency> latencies;
+    if (!_statementLatency)
+        return latencies;
+
+    for (std::size_t i = 0; i < _preparedStatementSize.size(); ++i)
+    {
+        DatabaseLatencyHistogram::Snapshot latency = _statementLatency[i].GetSnapshot();
+        if (latency.Count)
+            latencies.push_back({ uint32(i), _preparedStatementSql[i], latency });
+    }
+
+    return latencies;
+}
+
+template <class T>
+MySQLTransactionBatchStats DatabaseWorkerPool<T>::ConsumeTransactionBatchStats()
+{
+    MySQLTransactionBatchStats stats;
+    for (auto& connections : _connections)
+    {
+        for (auto& connection : connections)
+        {
+            MySQLTransactionBatchStats connectionStats = connection->ConsumeTransactionBatchStats();
+            stats.Statements += connectionStats.Statements;
+            stats.Executions += connectionStats.Executions;
+        }
+    }
+
+    return stats;
+}
+
 template <class T>
 T* DatabaseWorkerPool<T>::GetFreeConnection()
 {
@@ -505,6 +681,29 @@ T* DatabaseWorkerPool<T>::GetFreeConnection()
     return connection;
 }
 
+template <class T>
+T* DatabaseWorkerPool<T>::GetFreeReplicaConnection()
+{
+    for (auto const& connection : _connections[IDX_REPLICA_SYNCH])
+    {
+        if (!connection->LockIfReady())
+            continue;
+
+        if (connection->TryReplicaReconnect())
+            return connection.get();
+
+        connection->Unlock();
+    }
+
+    return nullptr;
+}
+
+template <class T>
+bool DatabaseWorkerPool<T>::IsReplicaStatement(uint32 index) const
+{
+    return index < _replicaStatements.size() && _replicaStatements[index];
+}
+
 template <class T>
 std::string_view DatabaseWorkerPool<T>::GetDatabaseName() const
 {
@@ -522,10 +721,10 @@ void DatabaseWorkerPool<T>::Execute(std::string_view sql)
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::Execute(PreparedStatement<T>* stmt)
+void DatabaseWorkerPool<T>::Execute(PreparedStatement<T>* stmt, DatabaseLane lane)
 {
     PreparedStatementTask* task = new PreparedStatementTask(stmt);
-    Enqueue(task);
+    Enqueue(task, lane);
 }
 
 template <class T>
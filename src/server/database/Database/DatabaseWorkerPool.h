@@ -19,11 +19,15 @@
 #define _DATABASEWORKERPOOL_H
 
 #include "DatabaseEnvFwd.h"
+#include "DatabaseLatencyHistogram.h"
 #include "Define.h"
 #include "StringFormat.h"
 #include <array>
+#include <memory>
 #include <vector>
 
+struct MySQLTransactionBatchStats;
+
 /** @file DatabaseWorkerPool.h */
 
 /**
@@ -38,12 +42,17 @@
 */
 #define MIN_MYSQL_SERVER_VERSION "8.0.0"
 
-template <typename T>
-class ProducerConsumerQueue;
-
 class SQLOperation;
+class SQLOperationQueue;
 struct MySQLConnectionInfo;
 
+struct DatabaseStatementLatency
+{
+    uint32 Index;
+    std::string Sql;
+    DatabaseLatencyHistogram::Snapshot Latency;
+};
+
 template <class T>
 class DatabaseWorkerPool
 {
@@ -52,6 +61,8 @@ private:
     {
         IDX_ASYNC,
         IDX_SYNCH,
+        IDX_REPLICA_ASYNC,
+        IDX_REPLICA_SYNCH,
         IDX_SIZE
     };
 
@@ -62,6 +73,16 @@ public:
 
     void SetConnectionInfo(std::string_view infoString, uint8 const asyncThreads, uint8 const synchThreads);
 
+    //! Reserves interactiveWorkers asynchronous connections for the interactive lane and lets only bulkWorkers
+    //! of the other ones run bulk operations (0 for all of them). Operations waiting longer than maxPriorityWait
+    //! go before those of the higher lanes (0 never). Must be called before Open.
+    void SetWorkerLanes(uint8 interactiveWorkers, uint8 bulkWorkers, Milliseconds maxPriorityWait);
+
+    //! Opens connections to a replica of the database along with the primary ones. Statements prepared
+    //! with CONNECTION_REPLICA are then read from the replica, or from the primary while it is down.
+    //! Must be called before Open.
+    void SetReplicaConnectionInfo(std::string_view infoString, uint8 const asyncThreads, uint8 const synchThreads);
+
     uint32 Open();
     void Close();
 
@@ -94,7 +115,8 @@ public:
 
     //! Enqueues a one-way SQL operation in prepared statement format that will be executed asynchronously.
     //! Statement must be prepared with CONNECTION_ASYNC flag.
-    void Execute(PreparedStatement<T>* stmt);
+    //! Operations of lower priority lanes may run after operations enqueued later in higher priority lanes.
+    void Execute(PreparedStatement<T>* stmt, DatabaseLane lane = DatabaseLane::Interactive);
 
     /**
         Direct synchronous one-way statement methods.
@@ -143,6 +165,10 @@ public:
     //! Statement must be prepared with CONNECTION_SYNCH flag.
     PreparedQueryResult Query(PreparedStatement<T>* stmt);
 
+    //! Same as Query, with the result stored column by column for bulk reads, see PreparedBulkResultSet.
+    //! Statement must be prepared with CONNECTION_SYNCH flag.
+    PreparedBulkQueryResult BulkQuery(PreparedStatement<T>* stmt);
+
     /**
         Asynchronous query (with resultset) methods.
     */
@@ -171,7 +197,7 @@ public:
 
     //! Enqueues a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
     //! were appended to the transaction will be respected during execution.
-    void CommitTransaction(SQLTransaction<T> transaction);
+    void CommitTransaction(SQLTransaction<T> transaction, DatabaseLane lane = DatabaseLane::Interactive);
 
     //! Enqueues a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
     //! were appended to the transaction will be respected during execution.
@@ -214,26 +240,53 @@ public:
     }
 
     [[nodiscard]] std::size_t QueueSize() const;
+    [[nodiscard]] std::size_t QueueSize(DatabaseLane lane) const;
+
+    //! Time asynchronous operations of a lane waited for a worker
+    [[nodiscard]] DatabaseLatencyHistogram::Snapshot GetQueueWaitTime(DatabaseLane lane) const;
+
+    //! Execution times of the prepared statements executed at least once, on any connection
+    [[nodiscard]] std::vector<DatabaseStatementLatency> GetStatementLatencies() const;
+
+    //! Prepared statements executed in transactions by all connections, and the statements sent
+    //! for them once consecutive executions were coalesced into multi-row statements. Resets the counts.
+    MySQLTransactionBatchStats ConsumeTransactionBatchStats();
 
 private:
     uint32 OpenConnections(InternalIndex type, uint8 numConnections);
+    void OpenReplicaConnections();
+    void CloseReplicaConnections();
+
+    //! True if the statement may be read from a replica and replica connections are open
+    [[nodiscard]] bool IsReplicaStatement(uint32 index) const;
 
     unsigned long EscapeString(char* to, char const* from, unsigned long length);
 
-    void Enqueue(SQLOperation* op);
+    void Enqueue(SQLOperation* op, DatabaseLane lane = DatabaseLane::Interactive);
 
     //! Gets a free connection in the synchronous connection pool.
     //! Caller MUST call t->Unlock() after touching the MySQL context to prevent deadlocks.
     T* GetFreeConnection();
 
+    //! Gets a free and available synchronous replica connection, without waiting. Returns nullptr if there is none.
+    //! Caller MUST call t->Unlock() after touching the MySQL context to prevent deadlocks.
+    T* GetFreeReplicaConnection();
+
     [[nodiscard]] std::string_view GetDatabaseName() const;
 
     //! Queue shared by async worker threads.
-    std::unique_ptr<ProducerConsumerQueue<SQLOperation*>> _queue;
+    std::unique_ptr<SQLOperationQueue> _queue;
     std::array<std::vector<std::unique_ptr<T>>, IDX_SIZE> _connections;
     std::unique_ptr<MySQLConnectionInfo> _connectionInfo;
+    //! Queue shared by async replica worker threads.
+    std::unique_ptr<SQLOperationQueue> _replicaQueue;
+    std::unique_ptr<MySQLConnectionInfo> _replicaConnectionInfo;
+    std::vector<bool> _replicaStatements;                               //! By statement index, prepared on replica connections
     std::vector<uint8> _preparedStatementSize;
+    std::vector<std::string> _preparedStatementSql;
+    std::unique_ptr<DatabaseLatencyHistogram[]> _statementLatency;     //! Shared by all connections, by statement index
     uint8 _async_threads, _synch_threads;
+    uint8 _replica_async_threads, _replica_synch_threads;
 #ifdef ACORE_DEBUG
     static inline thread_local bool _warnSyncQueries = false;
 #endif
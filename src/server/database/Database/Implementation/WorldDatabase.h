@@ -117,6 +117,8 @@ enum WorldDatabaseStatements : uint32
     WORLD_SEL_REQ_XP,
     WORLD_INS_GAMEOBJECT_ADDON,
     WORLD_UPD_VERSION,
+    WORLD_SEL_CREATURES,
+    WORLD_SEL_GAMEOBJECTS,
 
     MAX_WORLDDATABASE_STATEMENTS
 };
@@ -128,7 +130,7 @@ public:
 
     //- Constructors for sync and async connections
     WorldDatabaseConnection(MySQLConnectionInfo& connInfo);
-    WorldDatabaseConnection(ProducerConsumerQueue<SQLOperation*>* q, MySQLConnectionInfo& connInfo);
+    WorldDatabaseConnection(SQLOperationQueue* q, MySQLConnectionInfo& connInfo);
     ~WorldDatabaseConnection() override;
 
     //- Loads database type specific prepared statements
@@ -16,6 +16,7 @@
  */
 
 #include "MySQLConnection.h"
+#include "DatabaseLatencyHistogram.h"
 #include "DatabaseWorker.h"
 #include "Log.h"
 #include "MySQLHacks.h"
@@ -26,6 +27,9 @@
 #include "Timer.h"
 #include "Tokenize.h"
 #include "Transaction.h"
+#include "Util.h"
+#include <bit>
+#include <cctype>
 #include <errmsg.h>
 #include <mysql.h>
 #include <mysqld_error.h>
@@ -51,14 +55,24 @@ MySQLConnection::MySQLConnection(MySQLConnectionInfo& connInfo) :
     m_reconnecting(false),
     m_prepareError(false),
     m_Mysql(nullptr),
+    m_transactionStatements(0),
+    m_transactionExecutions(0),
+    m_statementLatency(nullptr),
+    m_replicaDown(false),
+    m_fallbackQueue(nullptr),
     m_queue(nullptr),
     m_connectionInfo(connInfo),
     m_connectionFlags(CONNECTION_SYNCH) { }
 
-MySQLConnection::MySQLConnection(ProducerConsumerQueue<SQLOperation*>* queue, MySQLConnectionInfo& connInfo) :
+MySQLConnection::MySQLConnection(SQLOperationQueue* queue, MySQLConnectionInfo& connInfo) :
     m_reconnecting(false),
     m_prepareError(false),
     m_Mysql(nullptr),
+    m_transactionStatements(0),
+    m_transactionExecutions(0),
+    m_statementLatency(nullptr),
+    m_replicaDown(false),
+    m_fallbackQueue(nullptr),
     m_queue(queue),
     m_connectionInfo(connInfo),
     m_connectionFlags(CONNECTION_ASYNC)
@@ -75,6 +89,7 @@ void MySQLConnection::Close()
 {
     // Stop the worker thread before the statements are cleared
     m_worker.reset();
+    m_batchStmts.clear();
     m_stmts.clear();
 
     if (m_Mysql)
@@ -168,6 +183,8 @@ uint32 MySQLConnection::Open()
 
 bool MySQLConnection::PrepareStatements()
 {
+    // multi-row statements are prepared again on first use
+    m_batchStmts.clear();
     DoPrepareStatements();
     return !m_prepareError;
 }
@@ -215,6 +232,7 @@ bool MySQLConnection::Execute(PreparedStatementBase* stmt)
     MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
 
     uint32 _s = getMSTime();
+    auto const start = std::chrono::steady_clock::now();
 
 #if MYSQL_VERSION_ID >= 80300
     if (mysql_stmt_bind_named_param(msql_STMT, msql_BIND, m_mStmt->GetParameterCount(), nullptr))
@@ -245,6 +263,7 @@ bool MySQLConnection::Execute(PreparedStatementBase* stmt)
     }
 
     LOG_DEBUG("sql.sql", "[{} ms] SQL(p): {}", getMSTimeDiff(_s, getMSTime()), m_mStmt->getQueryString());
+    RecordStatementLatency(index, start);
 
     m_mStmt->ClearParameters();
     return true;
@@ -267,6 +286,7 @@ bool MySQLConnection::_Query(PreparedStatementBase* stmt, MySQLPreparedStatement
     MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
 
     uint32 _s = getMSTime();
+    auto const start = std::chrono::steady_clock::now();
 
 #if MYSQL_VERSION_ID >= 80300
     if (mysql_stmt_bind_named_param(msql_STMT, msql_BIND, m_mStmt->GetParameterCount(), nullptr))
@@ -297,6 +317,7 @@ bool MySQLConnection::_Query(PreparedStatementBase* stmt, MySQLPreparedStatement
     }
 
     LOG_DEBUG("sql.sql", "[{} ms] SQL(p): {}", getMSTimeDiff(_s, getMSTime()), m_mStmt->getQueryString());
+    RecordStatementLatency(index, start);
 
     m_mStmt->ClearParameters();
 
@@ -387,8 +408,11 @@ int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transac
 
     BeginTransaction();
 
-    for (auto const& data : queries)
+    std::vector<PreparedStatementBase*> batch;
+
+    for (std::size_t i = 0; i < queries.size(); ++i)
     {
+        SQLElementData const& data = queries[i];
         switch (data.type)
         {
             case SQL_ELEMENT_PREPARED:
@@ -407,7 +431,25 @@ int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transac
 
                 ASSERT(stmt);
 
-                if (!Execute(stmt))
+                // consecutive executions of a multi-row capable statement are sent as one statement
+                uint32 rows = GetBatchRows(queries, i);
+                bool executed;
+                if (rows > 1)
+                {
+                    batch.clear();
+                    for (uint32 row = 0; row < rows; ++row)
+                        batch.push_back(std::get<PreparedStatementBase*>(queries[i + row].element));
+
+                    executed = ExecuteBatch(batch.data(), rows);
+                    i += rows - 1;
+                }
+                else
+                    executed = Execute(stmt);
+
+                m_transactionStatements += rows;
+                ++m_transactionExecutions;
+
+                if (!executed)
                 {
                     LOG_WARN("sql.sql", "Transaction aborted. {} queries not executed.", queries.size());
                     int errorCode = GetLastError();
@@ -453,6 +495,210 @@ int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transac
     return 0;
 }
 
+uint32 MySQLConnection::GetBatchRows(std::vector<SQLElementData> const& queries, std::size_t first) const
+{
+    // rows per multi-row statement, and placeholders the client protocol allows in one statement
+    static constexpr uint32 MAX_BATCH_ROWS = 64;
+    static constexpr uint32 MAX_BATCH_PARAMETERS = 65535;
+
+    uint32 const index = std::get<PreparedStatementBase*>(queries[first].element)->GetIndex();
+    if (index >= m_batchTemplates.size() || m_batchTemplates[index].Row.empty())
+        return 1;
+
+    uint32 const maxRows = std::min(MAX_BATCH_ROWS, MAX_BATCH_PARAMETERS / m_stmts[index]->GetParameterCount());
+
+    uint32 rows = 1;
+    while (rows < maxRows && first + rows < queries.size())
+    {
+        SQLElementData const& next = queries[first + rows];
+        if (next.type != SQL_ELEMENT_PREPARED || std::get<PreparedStatementBase*>(next.element)->GetIndex() != index)
+            break;
+
+        ++rows;
+    }
+
+    // only power of two row counts are prepared, to keep the number of server side statements low
+    return std::bit_floor(rows);
+}
+
+bool MySQLConnection::ExecuteBatch(PreparedStatementBase* const* stmts, uint32 rows)
+{
+    if (!m_Mysql)
+        return false;
+
+    MySQLPreparedStatement* m_mStmt = GetBatchStatement(stmts[0]->GetIndex(), rows);
+    if (!m_mStmt)
+    {
+        // the multi-row form could not be prepared, execute the rows one by one
+        for (uint32 row = 0; row < rows; ++row)
+            if (!Execute(stmts[row]))
+                return false;
+
+        return true;
+    }
+
+    m_mStmt->BindParameters(stmts, rows);
+
+    MYSQL_STMT* msql_STMT = m_mStmt->GetSTMT();
+    MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
+
+    uint32 _s = getMSTime();
+    auto const start = std::chrono::steady_clock::now();
+
+#if MYSQL_VERSION_ID >= 80300
+    if (mysql_stmt_bind_named_param(msql_STMT, msql_BIND, m_mStmt->GetParameterCount(), nullptr))
+#else
+    if (mysql_stmt_bind_param(msql_STMT, msql_BIND))
+#endif
+    {
+        uint32 lErrno = mysql_errno(m_Mysql);
+        LOG_ERROR("sql.sql", "SQL(p): {}\n [ERROR]: [{}] {}", m_mStmt->getQueryString(), lErrno, mysql_stmt_error(msql_STMT));
+
+        if (_HandleMySQLErrno(lErrno, mysql_stmt_error(msql_STMT)))  // If it returns true, an error was handled successfully (i.e. reconnection)
+            return ExecuteBatch(stmts, rows);       // Try again
+
+        m_mStmt->ClearParameters();
+        return false;
+    }
+
+    if (mysql_stmt_execute(msql_STMT))
+    {
+        uint32 lErrno = mysql_errno(m_Mysql);
+        LOG_ERROR("sql.sql", "SQL(p): {}\n [ERROR]: [{}] {}", m_mStmt->getQueryString(), lErrno, mysql_stmt_error(msql_STMT));
+
+        if (_HandleMySQLErrno(lErrno, mysql_stmt_error(msql_STMT)))  // If it returns true, an error was handled successfully (i.e. reconnection)
+            return ExecuteBatch(stmts, rows);       // Try again
+
+        m_mStmt->ClearParameters();
+        return false;
+    }
+
+    LOG_DEBUG("sql.sql", "[{} ms] SQL(p): {}", getMSTimeDiff(_s, getMSTime()), m_mStmt->getQueryString());
+    RecordStatementLatency(stmts[0]->GetIndex(), start);
+
+    m_mStmt->ClearParameters();
+    return true;
+}
+
+MySQLPreparedStatement* MySQLConnection::GetBatchStatement(uint32 index, uint32 rows)
+{
+    auto itr = m_batchStmts.find({ index, rows });
+    if (itr != m_batchStmts.end())
+        return itr->second.get();
+
+    BatchTemplate const& batch = m_batchTemplates[index];
+
+    std::string sql = batch.Prefix;
+    for (uint32 row = 0; row < rows; ++row)
+    {
+        if (row)
+            sql += ", ";
+
+        sql += batch.Row;
+    }
+    sql += batch.Suffix;
+
+    // a statement failing to prepare is remembered as null, its rows are then always executed one by one
+    std::unique_ptr<MySQLPreparedStatement>& batchStmt = m_batchStmts[{ index, rows }];
+
+    MYSQL_STMT* stmt = mysql_stmt_init(m_Mysql);
+    if (!stmt)
+    {
+        LOG_ERROR("sql.sql", "In mysql_stmt_init() id: {} ({} rows), sql: \"{}\"", index, rows, sql);
+        LOG_ERROR("sql.sql", "{}", mysql_error(m_Mysql));
+    }
+    else if (mysql_stmt_prepare(stmt, sql.c_str(), static_cast<unsigned long>(sql.size())))
+    {
+        LOG_ERROR("sql.sql", "In mysql_stmt_prepare() id: {} ({} rows), sql: \"{}\"", index, rows, sql);
+        LOG_ERROR("sql.sql", "{}", mysql_stmt_error(stmt));
+        mysql_stmt_close(stmt);
+    }
+    else
+        batchStmt = std::make_unique<MySQLPreparedStatement>(reinterpret_cast<MySQLStmt*>(stmt), sql);
+
+    return batchStmt.get();
+}
+
+bool MySQLConnection::ParseBatchTemplate(std::string_view sql, uint32 paramCount, BatchTemplate& batch)
+{
+    auto isIdentifier = [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$'; };
+
+    std::size_t const start = sql.find_first_not_of(" \t\r\n");
+    if (start == std::string_view::npos || (!StringStartsWithI(sql.substr(start), "INSERT") && !StringStartsWithI(sql.substr(start), "REPLACE")))
+        return false;
+
+    // find the row tuple following VALUES, skipping quoted strings and identifiers
+    std::size_t rowStart = std::string_view::npos;
+    std::size_t rowEnd = std::string_view::npos;
+    uint32 rowParams = 0;
+    uint32 depth = 0;
+    char quote = 0;
+    bool afterValues = false;
+    for (std::size_t i = start; i < sql.size(); ++i)
+    {
+        char const c = sql[i];
+        if (quote)
+        {
+            if (c == '\\' && quote != '`')
+                ++i;
+            else if (c == quote)
+                quote = 0;
+
+            continue;
+        }
+
+        switch (c)
+        {
+            case '\'':
+            case '"':
+            case '`':
+                quote = c;
+                break;
+            case '(':
+                if (afterValues && rowStart == std::string_view::npos && !depth)
+                    rowStart = i;
+                ++depth;
+                break;
+            case ')':
+                if (!depth)
+                    return false;
+                if (!--depth && rowStart != std::string_view::npos && rowEnd == std::string_view::npos)
+                    rowEnd = i + 1;
+                break;
+            case '?':
+                // placeholders outside of the row would have to be repeated in a different order
+                if (rowStart == std::string_view::npos || rowEnd != std::string_view::npos)
+                    return false;
+                ++rowParams;
+                break;
+            default:
+                if (!depth && !afterValues && StringStartsWithI(sql.substr(i), "VALUES")
+                    && !isIdentifier(sql[i - 1]) && (i + 6 == sql.size() || !isIdentifier(sql[i + 6])))
+                {
+                    afterValues = true;
+                    i += 5;
+                }
+                else if (afterValues && rowStart == std::string_view::npos && !std::isspace(static_cast<unsigned char>(c)))
+                    return false;
+                break;
+        }
+    }
+
+    if (rowEnd == std::string_view::npos || !rowParams || rowParams != paramCount)
+        return false;
+
+    // only a single row statement, optionally updating existing rows, can be repeated
+    std::string_view suffix = sql.substr(rowEnd);
+    std::size_t const suffixStart = suffix.find_first_not_of(" \t\r\n");
+    if (suffixStart != std::string_view::npos && !StringStartsWithI(suffix.substr(suffixStart), "ON DUPLICATE KEY UPDATE"))
+        return false;
+
+    batch.Prefix.assign(sql.substr(0, rowStart));
+    batch.Row.assign(sql.substr(rowStart, rowEnd - rowStart));
+    batch.Suffix.assign(suffix);
+    return true;
+}
+
 std::size_t MySQLConnection::EscapeString(char* to, const char* from, std::size_t length)
 {
     return mysql_real_escape_string(m_Mysql, to, from, length);
@@ -460,14 +706,71 @@ std::size_t MySQLConnection::EscapeString(char* to, const char* from, std::size_
 
 void MySQLConnection::Ping()
 {
+    if (IsReplica() && !TryReplicaReconnect())
+        return;
+
     mysql_ping(m_Mysql);
 }
 
+bool MySQLConnection::TryReplicaReconnect()
+{
+    if (!m_replicaDown)
+        return true;
+
+    auto const now = std::chrono::steady_clock::now();
+    if (now < m_replicaRetryTime)
+        return false;
+
+    m_replicaRetryTime = now + REPLICA_RETRY_INTERVAL;
+
+    if (m_Mysql)
+    {
+        mysql_close(m_Mysql);
+        m_Mysql = nullptr;
+    }
+
+    m_reconnecting = true;
+    bool const reconnected = !Open() && PrepareStatements();
+    m_reconnecting = false;
+
+    if (!reconnected)
+    {
+        if (m_Mysql)
+        {
+            mysql_close(m_Mysql);
+            m_Mysql = nullptr;
+        }
+
+        return false;
+    }
+
+    LOG_INFO("sql.sql", "Successfully reconnected to replica {} @{}:{} ({}).",
+        m_connectionInfo.database, m_connectionInfo.host, m_connectionInfo.port_or_socket,
+            (m_connectionFlags & CONNECTION_ASYNC) ? "asynchronous" : "synchronous");
+
+    m_replicaDown = false;
+    return true;
+}
+
 uint32 MySQLConnection::GetLastError()
 {
     return mysql_errno(m_Mysql);
 }
 
+void MySQLConnection::RecordStatementLatency(uint32 index, std::chrono::steady_clock::time_point start)
+{
+    if (m_statementLatency)
+        m_statementLatency[index].Add(std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - start));
+}
+
+MySQLTransactionBatchStats MySQLConnection::ConsumeTransactionBatchStats()
+{
+    MySQLTransactionBatchStats stats;
+    stats.Statements = m_transactionStatements.exchange(0);
+    stats.Executions = m_transactionExecutions.exchange(0);
+    return stats;
+}
+
 bool MySQLConnection::LockIfReady()
 {
     return m_Mutex.try_lock();
@@ -504,10 +807,16 @@ MySQLPreparedStatement* MySQLConnection::GetPreparedStatement(uint32 index)
 
 void MySQLConnection::PrepareStatement(uint32 index, std::string_view sql, ConnectionFlags flags)
 {
+    if (m_batchTemplates.size() < m_stmts.size())
+        m_batchTemplates.resize(m_stmts.size());
+
+    m_batchTemplates[index] = BatchTemplate();
+
     // Check if specified query should be prepared on this connection
     // i.e. don't prepare async statements on synchronous connections
     // to save memory that will not be used.
-    if (!(m_connectionFlags & flags))
+    // Replica connections only run the reads allowed on replicas.
+    if (!((IsReplica() ? CONNECTION_REPLICA : m_connectionFlags) & flags))
     {
         m_stmts[index].reset();
         return;
@@ -530,7 +839,10 @@ void MySQLConnection::PrepareStatement(uint32 index, std::string_view sql, Conne
             m_prepareError = true;
         }
         else
+        {
             m_stmts[index] = std::make_unique<MySQLPreparedStatement>(reinterpret_cast<MySQLStmt*>(stmt), sql);
+            ParseBatchTemplate(sql, m_stmts[index]->GetParameterCount(), m_batchTemplates[index]);
+        }
     }
 }
 
@@ -552,6 +864,24 @@ PreparedResultSet* MySQLConnection::Query(PreparedStatementBase* stmt)
     return new PreparedResultSet(mysqlStmt->GetSTMT(), result, rowCount, fieldCount);
 }
 
+PreparedBulkResultSet* MySQLConnection::BulkQuery(PreparedStatementBase* stmt)
+{
+    MySQLPreparedStatement* mysqlStmt = nullptr;
+    MySQLResult* result = nullptr;
+    uint64 rowCount = 0;
+    uint32 fieldCount = 0;
+
+    if (!_Query(stmt, &mysqlStmt, &result, &rowCount, &fieldCount))
+        return nullptr;
+
+    if (mysql_more_results(m_Mysql))
+    {
+        mysql_next_result(m_Mysql);
+    }
+
+    return new PreparedBulkResultSet(mysqlStmt->GetSTMT(), result, rowCount, fieldCount);
+}
+
 bool MySQLConnection::_HandleMySQLErrno(uint32 errNo, char const* err, uint8 attempts /*= 5*/)
 {
     std::string str = "";
@@ -572,6 +902,17 @@ bool MySQLConnection::_HandleMySQLErrno(uint32 errNo, char const* err, uint8 att
         }
         case CR_CONN_HOST_ERROR:
         {
+            // Losing a replica is not worth stopping the server, its reads fall back to the primary until it is back
+            if (IsReplica())
+            {
+                LOG_ERROR("sql.sql", "Lost the connection to replica {} @{}:{}, its reads run on the primary until it is back.",
+                    m_connectionInfo.database, m_connectionInfo.host, m_connectionInfo.port_or_socket);
+
+                m_replicaDown = true;
+                m_replicaRetryTime = {};
+                return TryReplicaReconnect();
+            }
+
             LOG_INFO("sql.sql", "Attempting to reconnect to the MySQL server...");
 
             m_reconnecting = true;
@@ -628,6 +969,13 @@ bool MySQLConnection::_HandleMySQLErrno(uint32 errNo, char const* err, uint8 att
         // Outdated table or database structure - terminate core
         case ER_BAD_FIELD_ERROR:
         case ER_NO_SUCH_TABLE:
+            if (IsReplica())
+            {
+                LOG_ERROR("sql.sql", "Replica {} @{}:{} is missing tables or columns, check its replication.",
+                    m_connectionInfo.database, m_connectionInfo.host, m_connectionInfo.port_or_socket);
+                return false;
+            }
+
             str = "Your database structure is not up to date. Please make sure you've executed all queries in the sql/updates folders.";
             LOG_FATAL("sql.sql", "{}", str);
             std::this_thread::sleep_for(10s);
@@ -20,23 +20,31 @@
 
 #include "DatabaseEnvFwd.h"
 #include "Define.h"
+#include <atomic>
+#include <chrono>
 #include <map>
 #include <mutex>
 #include <string>
 #include <vector>
 
-template <typename T>
-class ProducerConsumerQueue;
-
 class DatabaseWorker;
+class DatabaseLatencyHistogram;
 class MySQLPreparedStatement;
 class SQLOperation;
+class SQLOperationQueue;
+struct SQLElementData;
 
 enum ConnectionFlags
 {
     CONNECTION_ASYNC = 0x1,
     CONNECTION_SYNCH = 0x2,
-    CONNECTION_BOTH = CONNECTION_ASYNC | CONNECTION_SYNCH
+    CONNECTION_BOTH = CONNECTION_ASYNC | CONNECTION_SYNCH,
+
+    //! Reads allowed to be served by a replica, which may lag a few seconds behind the primary.
+    //! Replica connections only prepare these, synchronous and asynchronous alike.
+    CONNECTION_REPLICA = 0x4,
+    CONNECTION_ASYNC_REPLICA = CONNECTION_ASYNC | CONNECTION_REPLICA,
+    CONNECTION_SYNCH_REPLICA = CONNECTION_SYNCH | CONNECTION_REPLICA
 };
 
 struct AC_DATABASE_API MySQLConnectionInfo
@@ -51,6 +59,12 @@ struct AC_DATABASE_API MySQLConnectionInfo
     std::string ssl;
 };
 
+struct MySQLTransactionBatchStats
+{
+    uint64 Statements = 0;      //! Prepared statements executed in transactions
+    uint64 Executions = 0;      //! Statements sent to the server for them, after coalescing
+};
+
 class AC_DATABASE_API MySQLConnection
 {
 template <class T>
@@ -60,7 +74,7 @@ friend class PingOperation;
 
 public:
     MySQLConnection(MySQLConnectionInfo& connInfo);                               //! Constructor for synchronous connections.
-    MySQLConnection(ProducerConsumerQueue<SQLOperation*>* queue, MySQLConnectionInfo& connInfo);  //! Constructor for asynchronous connections.
+    MySQLConnection(SQLOperationQueue* queue, MySQLConnectionInfo& connInfo);  //! Constructor for asynchronous connections.
     virtual ~MySQLConnection();
 
     virtual uint32 Open();
@@ -72,6 +86,7 @@ public:
     bool Execute(PreparedStatementBase* stmt);
     ResultSet* Query(std::string_view sql);
     PreparedResultSet* Query(PreparedStatementBase* stmt);
+    PreparedBulkResultSet* BulkQuery(PreparedStatementBase* stmt);
     bool _Query(std::string_view sql, MySQLResult** pResult, MySQLField** pFields, uint64* pRowCount, uint32* pFieldCount);
     bool _Query(PreparedStatementBase* stmt, MySQLPreparedStatement** mysqlStmt, MySQLResult** pResult, uint64* pRowCount, uint32* pFieldCount);
 
@@ -84,6 +99,17 @@ public:
 
     uint32 GetLastError();
 
+    MySQLTransactionBatchStats ConsumeTransactionBatchStats();
+
+    [[nodiscard]] bool IsReplica() const { return (m_connectionFlags & CONNECTION_REPLICA) != 0; }
+    [[nodiscard]] bool IsReplicaAvailable() const { return !m_replicaDown; }
+
+    /// Reconnects a replica that went down, at most once per REPLICA_RETRY_INTERVAL. Returns true if the replica is available.
+    bool TryReplicaReconnect();
+
+    /// Queue of the primary connections, running the operations queued for a replica that is down
+    [[nodiscard]] SQLOperationQueue* GetFallbackQueue() const { return m_fallbackQueue; }
+
 protected:
     /// Tries to acquire lock. If lock is acquired by another thread
     /// the calling parent will just try another connection
@@ -100,15 +126,45 @@ protected:
     virtual void DoPrepareStatements() = 0;
     virtual bool _HandleMySQLErrno(uint32 errNo, char const* err = "", uint8 attempts = 5);
 
+    /// Multi-row form of a prepared INSERT/REPLACE: Prefix, Rows times Row separated by commas, Suffix.
+    /// Row is empty for statements that cannot be executed for several rows at once.
+    struct BatchTemplate
+    {
+        std::string Prefix;
+        std::string Row;
+        std::string Suffix;
+    };
+
+    static bool ParseBatchTemplate(std::string_view sql, uint32 paramCount, BatchTemplate& batch);
+
+    /// Number of queries starting at first executed as one multi-row statement
+    uint32 GetBatchRows(std::vector<SQLElementData> const& queries, std::size_t first) const;
+    bool ExecuteBatch(PreparedStatementBase* const* stmts, uint32 rows);
+    MySQLPreparedStatement* GetBatchStatement(uint32 index, uint32 rows);
+
     typedef std::vector<std::unique_ptr<MySQLPreparedStatement>> PreparedStatementContainer;
 
     PreparedStatementContainer m_stmts; //! PreparedStatements storage
+    std::vector<BatchTemplate> m_batchTemplates;                                                    //! Multi-row forms, by statement index
+    std::map<std::pair<uint32, uint32>, std::unique_ptr<MySQLPreparedStatement>> m_batchStmts;    //! Multi-row statements prepared so far, by statement index and row count
+    std::atomic<uint64> m_transactionStatements;
+    std::atomic<uint64> m_transactionExecutions;
+
+    /// Execution time histograms of the pool, by statement index, null until the pool prepared its statements
+    DatabaseLatencyHistogram* m_statementLatency;
+    void RecordStatementLatency(uint32 index, std::chrono::steady_clock::time_point start);
+    static constexpr std::chrono::seconds REPLICA_RETRY_INTERVAL{10};
+
+    std::atomic<bool> m_replicaDown;                            //! Replica lost and not reconnected yet
+    std::chrono::steady_clock::time_point m_replicaRetryTime;   //! No reconnection attempt before
+    SQLOperationQueue* m_fallbackQueue;
+
     bool m_reconnecting;  //! Are we reconnecting?
     bool m_prepareError;  //! Was there any error while preparing statements?
     MySQLHandle* m_Mysql; //! MySQL Handle.
 
 private:
-    ProducerConsumerQueue<SQLOperation*>* m_queue;      //! Queue shared with other asynchronous connections.
+    SQLOperationQueue* m_queue;      //! Queue shared with other asynchronous connections.
     std::unique_ptr<DatabaseWorker> m_worker;           //! Core worker task.
     MySQLConnectionInfo& m_connectionInfo;              //! Connection info (used for logging)
     ConnectionFlags m_connectionFlags;                  //! Connection flags (for preparing relevant statements)
@@ -37,6 +37,8 @@ template<> struct MySQLType<double> : std::integral_constant<enum_field_types, M
 
 MySQLPreparedStatement::MySQLPreparedStatement(MySQLStmt* stmt, std::string_view queryString) :
     m_stmt(nullptr),
+    m_batchStmts(nullptr),
+    m_batchRows(0),
     m_Mstmt(stmt),
     m_bind(nullptr),
     m_queryString(std::string(queryString))
@@ -68,8 +70,10 @@ MySQLPreparedStatement::~MySQLPreparedStatement()
 void MySQLPreparedStatement::BindParameters(PreparedStatementBase* stmt)
 {
     m_stmt = stmt;     // Cross reference them for debug output
+    m_batchStmts = nullptr;
+    m_batchRows = 0;
 
-    uint8 pos = 0;
+    uint32 pos = 0;
     for (PreparedStatementData const& data : stmt->GetParameters())
     {
         std::visit([&](auto&& param)
@@ -86,6 +90,27 @@ void MySQLPreparedStatement::BindParameters(PreparedStatementBase* stmt)
 #endif
 }
 
+void MySQLPreparedStatement::BindParameters(PreparedStatementBase* const* stmts, uint32 rows)
+{
+    m_stmt = stmts[0];
+    m_batchStmts = stmts;
+    m_batchRows = rows;
+
+    uint32 pos = 0;
+    for (uint32 row = 0; row < rows; ++row)
+    {
+        for (PreparedStatementData const& data : stmts[row]->GetParameters())
+        {
+            std::visit([&](auto&& param)
+            {
+                SetParameter(pos, param);
+            }, data.data);
+
+            ++pos;
+        }
+    }
+}
+
 void MySQLPreparedStatement::ClearParameters()
 {
     for (uint32 i=0; i < m_paramCount; ++i)
@@ -98,7 +123,7 @@ void MySQLPreparedStatement::ClearParameters()
     }
 }
 
-static bool ParamenterIndexAssertFail(uint32 stmtIndex, uint8 index, uint32 paramCount)
+static bool ParamenterIndexAssertFail(uint32 stmtIndex, uint32 index, uint32 paramCount)
 {
     LOG_ERROR("sql.driver", "Attempted to bind parameter {}{} on a PreparedStatement {} (statement has only {} parameters)",
         uint32(index) + 1, (index == 1 ? "st" : (index == 2 ? "nd" : (index == 3 ? "rd" : "nd"))), stmtIndex, paramCount);
@@ -107,7 +132,7 @@ static bool ParamenterIndexAssertFail(uint32 stmtIndex, uint8 index, uint32 para
 }
 
 //- Bind on mysql level
-void MySQLPreparedStatement::AssertValidIndex(uint8 index)
+void MySQLPreparedStatement::AssertValidIndex(uint32 index)
 {
     ASSERT(index < m_paramCount || ParamenterIndexAssertFail(m_stmt->GetIndex(), index, m_paramCount));
 
@@ -116,7 +141,7 @@ void MySQLPreparedStatement::AssertValidIndex(uint8 index)
 }
 
 template<typename T>
-void MySQLPreparedStatement::SetParameter(const uint8 index, T value)
+void MySQLPreparedStatement::SetParameter(const uint32 index, T value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -133,12 +158,12 @@ void MySQLPreparedStatement::SetParameter(const uint8 index, T value)
     memcpy(param->buffer, &value, len);
 }
 
-void MySQLPreparedStatement::SetParameter(const uint8 index, bool value)
+void MySQLPreparedStatement::SetParameter(const uint32 index, bool value)
 {
     SetParameter(index, uint8(value ? 1 : 0));
 }
 
-void MySQLPreparedStatement::SetParameter(const uint8 index, std::nullptr_t /*value*/)
+void MySQLPreparedStatement::SetParameter(const uint32 index, std::nullptr_t /*value*/)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -152,7 +177,7 @@ void MySQLPreparedStatement::SetParameter(const uint8 index, std::nullptr_t /*va
     param->length = nullptr;
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, std::string const& value)
+void MySQLPreparedStatement::SetParameter(uint32 index, std::string const& value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -169,7 +194,7 @@ void MySQLPreparedStatement::SetParameter(uint8 index, std::string const& value)
     memcpy(param->buffer, value.c_str(), len);
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, std::vector<uint8> const& value)
+void MySQLPreparedStatement::SetParameter(uint32 index, std::vector<uint8> const& value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -192,17 +217,22 @@ std::string MySQLPreparedStatement::getQueryString() const
 
     std::size_t pos = 0;
 
-    for (PreparedStatementData const& data : m_stmt->GetParameters())
+    PreparedStatementBase* const* stmts = m_batchStmts ? m_batchStmts : &m_stmt;
+    uint32 const rows = m_batchStmts ? m_batchRows : 1;
+    for (uint32 row = 0; row < rows; ++row)
     {
-        pos = queryString.find('?', pos);
-
-        std::string replaceStr = std::visit([&](auto&& data)
+        for (PreparedStatementData const& data : stmts[row]->GetParameters())
         {
-            return PreparedStatementData::ToString(data);
-        }, data.data);
+            pos = queryString.find('?', pos);
+
+            std::string replaceStr = std::visit([&](auto&& data)
+            {
+                return PreparedStatementData::ToString(data);
+            }, data.data);
 
-        queryString.replace(pos, 1, replaceStr);
-        pos += replaceStr.length();
+            queryString.replace(pos, 1, replaceStr);
+            pos += replaceStr.length();
+        }
     }
 
     return queryString;
@@ -40,23 +40,28 @@ public:
     ~MySQLPreparedStatement();
 
     void BindParameters(PreparedStatementBase* stmt);
+    // Binds the parameters of rows statements one after another, for multi-row statements
+    void BindParameters(PreparedStatementBase* const* stmts, uint32 rows);
 
     uint32 GetParameterCount() const { return m_paramCount; }
+    std::string const& GetSql() const { return m_queryString; }
 
 protected:
-    void SetParameter(const uint8 index, bool value);
-    void SetParameter(const uint8 index, std::nullptr_t /*value*/);
-    void SetParameter(const uint8 index, std::string const& value);
-    void SetParameter(const uint8 index, std::vector<uint8> const& value);
+    void SetParameter(const uint32 index, bool value);
+    void SetParameter(const uint32 index, std::nullptr_t /*value*/);
+    void SetParameter(const uint32 index, std::string const& value);
+    void SetParameter(const uint32 index, std::vector<uint8> const& value);
 
     template<typename T>
-    void SetParameter(const uint8 index, T value);
+    void SetParameter(const uint32 index, T value);
 
     MySQLStmt* GetSTMT() { return m_Mstmt; }
     MySQLBind* GetBind() { return m_bind; }
     PreparedStatementBase* m_stmt;
+    PreparedStatementBase* const* m_batchStmts;         // all bound statements of a multi-row statement
+    uint32 m_batchRows;
     void ClearParameters();
-    void AssertValidIndex(const uint8 index);
+    void AssertValidIndex(const uint32 index);
     std::string getQueryString() const;
 
 private:
@@ -64,21 +64,17 @@ template void PreparedStatementBase::SetValidData(const uint8 index, std::vector
 
 //- Execution
 PreparedStatementTask::PreparedStatementTask(PreparedStatementBase* stmt, bool async) :
-    m_stmt(stmt),
-    m_result(nullptr)
+    m_stmt(stmt)
 {
     m_has_result = async; // If it's async, then there's a result
 
     if (async)
-        m_result = new PreparedQueryResultPromise();
+        m_result.emplace(std::allocator_arg, PoolAllocator<PreparedQueryResult>());
 }
 
 PreparedStatementTask::~PreparedStatementTask()
 {
     delete m_stmt;
-
-    if (m_has_result && m_result)
-        delete m_result;
 }
 
 bool PreparedStatementTask::Execute()
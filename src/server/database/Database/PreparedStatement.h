@@ -20,8 +20,11 @@
 
 #include "Define.h"
 #include "Duration.h"
+#include "ObjectPool.h"
 #include "SQLOperation.h"
+#include <boost/container/small_vector.hpp>
 #include <future>
+#include <optional>
 #include <tuple>
 #include <variant>
 #include <vector>
@@ -69,6 +72,10 @@ class AC_DATABASE_API PreparedStatementBase
 friend class PreparedStatementTask;
 
 public:
+    //- Parameters are stored inline up to this count, statements with more allocate them
+    static constexpr std::size_t INLINE_PARAMETERS = 8;
+    using Parameters = boost::container::small_vector<PreparedStatementData, INLINE_PARAMETERS>;
+
     explicit PreparedStatementBase(uint32 index, uint8 capacity);
     virtual ~PreparedStatementBase();
 
@@ -121,7 +128,7 @@ public:
     }
 
     [[nodiscard]] uint32 GetIndex() const { return m_index; }
-    [[nodiscard]] std::vector<PreparedStatementData> const& GetParameters() const { return statement_data; }
+    [[nodiscard]] Parameters const& GetParameters() const { return statement_data; }
 
 protected:
     template<typename T>
@@ -146,14 +153,15 @@ protected:
     uint32 m_index;
 
     //- Buffer of parameters, not tied to MySQL in any way yet
-    std::vector<PreparedStatementData> statement_data;
+    Parameters statement_data;
 
     PreparedStatementBase(PreparedStatementBase const& right) = delete;
     PreparedStatementBase& operator=(PreparedStatementBase const& right) = delete;
 };
 
+//- Allocated from a pool per database, GetPreparedStatement is called for every query
 template<typename T>
-class PreparedStatement : public PreparedStatementBase
+class PreparedStatement : public PreparedStatementBase, public PooledObject<PreparedStatement<T>>
 {
 public:
     explicit PreparedStatement(uint32 index, uint8 capacity) : PreparedStatementBase(index, capacity)
@@ -166,7 +174,7 @@ private:
 };
 
 //- Lower-level class, enqueuable operation
-class AC_DATABASE_API PreparedStatementTask : public SQLOperation
+class AC_DATABASE_API PreparedStatementTask : public SQLOperation, public PooledObject<PreparedStatementTask>
 {
 public:
     PreparedStatementTask(PreparedStatementBase* stmt, bool async = false);
@@ -178,7 +186,7 @@ public:
 protected:
     PreparedStatementBase* m_stmt;
     bool m_has_result;
-    PreparedQueryResultPromise* m_result;
+    std::optional<PreparedQueryResultPromise> m_result;
 };
 
 #endif
@@ -434,3 +434,144 @@ void PreparedResultSet::AssertRows(std::size_t sizeRows)
     ASSERT(m_rowPosition < m_rowCount);
     ASSERT(sizeRows == m_fieldCount, "> Tuple size != count fields");
 }
+
+PreparedBulkResultSet::PreparedBulkResultSet(MySQLStmt* stmt, MySQLResult* result, uint64 rowCount, uint32 fieldCount) :
+    m_rowCount(rowCount),
+    m_fieldCount(fieldCount),
+    m_bufferSize(0)
+{
+    if (!result)
+        return;
+
+    // same ownership of the length and is_null arrays as in PreparedResultSet, they are freed when the statement is bound again
+    if (stmt->bind_result_done)
+    {
+        delete[] stmt->bind->length;
+        delete[] stmt->bind->is_null;
+    }
+
+    MySQLBool* isNull = new MySQLBool[m_fieldCount];
+    unsigned long* length = new unsigned long[m_fieldCount];
+    memset(isNull, 0, sizeof(MySQLBool) * m_fieldCount);
+    memset(length, 0, sizeof(unsigned long) * m_fieldCount);
+
+    if (mysql_stmt_store_result(stmt))
+    {
+        LOG_WARN("sql.sql", "{}:mysql_stmt_store_result, cannot bind result from MySQL server. Error: {}", __FUNCTION__, mysql_stmt_error(stmt));
+        delete[] isNull;
+        delete[] length;
+        mysql_free_result(result);
+        m_rowCount = 0;
+        return;
+    }
+
+    m_rowCount = mysql_stmt_num_rows(stmt);
+
+    MySQLField* field = reinterpret_cast<MySQLField*>(mysql_fetch_fields(result));
+    m_fieldMetadata.resize(m_fieldCount);
+    m_cellSizes.resize(m_fieldCount);
+    m_lengths.resize(m_fieldCount);
+
+    // columns start 8 byte aligned so that they can be read as arrays of their type
+    std::vector<std::size_t> offsets(m_fieldCount);
+    for (uint32 i = 0; i < m_fieldCount; ++i)
+    {
+        InitializeDatabaseFieldMetadata(&m_fieldMetadata[i], &field[i], i);
+        m_cellSizes[i] = SizeForType(&field[i]);
+        offsets[i] = m_bufferSize;
+        m_bufferSize += (m_cellSizes[i] * m_rowCount + 7) & ~std::size_t(7);
+
+        if (m_fieldMetadata[i].Type == DatabaseFieldTypes::Binary)
+            m_lengths[i].resize(m_rowCount);
+    }
+
+    m_buffer.reset(new char[m_bufferSize]);
+    m_columns.resize(m_fieldCount);
+    m_nulls.resize(m_rowCount * m_fieldCount);
+
+    std::vector<MySQLBind> bind(m_fieldCount);
+    memset(bind.data(), 0, sizeof(MySQLBind) * m_fieldCount);
+    for (uint32 i = 0; i < m_fieldCount; ++i)
+    {
+        m_columns[i] = m_buffer.get() + offsets[i];
+
+        bind[i].buffer_type = field[i].type;
+        bind[i].buffer = m_buffer.get() + offsets[i];
+        bind[i].buffer_length = m_cellSizes[i];
+        bind[i].length = &length[i];
+        bind[i].is_null = &isNull[i];
+        bind[i].error = nullptr;
+        bind[i].is_unsigned = field[i].flags & UNSIGNED_FLAG;
+    }
+
+    if (mysql_stmt_bind_result(stmt, bind.data()))
+    {
+        LOG_WARN("sql.sql", "{}:mysql_stmt_bind_result, cannot bind result from MySQL server. Error: {}", __FUNCTION__, mysql_stmt_error(stmt));
+        mysql_stmt_free_result(stmt);
+        mysql_free_result(result);
+        delete[] isNull;
+        delete[] length;
+        m_rowCount = 0;
+        return;
+    }
+
+    // mysql_stmt_bind_result copied the bindings, the buffers are moved through stmt->bind from now on
+    for (uint64 row = 0; row < m_rowCount; ++row)
+    {
+        int retval = mysql_stmt_fetch(stmt);
+        if (retval != 0 && retval != MYSQL_DATA_TRUNCATED)
+        {
+            LOG_WARN("sql.sql", "{}:mysql_stmt_fetch, cannot fetch row {} of {}. Error: {}", __FUNCTION__, row, m_rowCount, mysql_stmt_error(stmt));
+            m_rowCount = row;
+            break;
+        }
+
+        for (uint32 i = 0; i < m_fieldCount; ++i)
+        {
+            char* buffer = static_cast<char*>(stmt->bind[i].buffer);
+            unsigned long fetchedLength = *stmt->bind[i].length;
+
+            if (*stmt->bind[i].is_null)
+            {
+                m_nulls[row * m_fieldCount + i] = true;
+                memset(buffer, 0, m_cellSizes[i]);
+                fetchedLength = 0;
+            }
+
+            if (m_fieldMetadata[i].Type == DatabaseFieldTypes::Binary)
+            {
+                // truncated values keep the part that fit in the buffer
+                fetchedLength = std::min<unsigned long>(fetchedLength, m_cellSizes[i]);
+                m_lengths[i][row] = fetchedLength;
+            }
+
+            stmt->bind[i].buffer = buffer + m_cellSizes[i];
+        }
+    }
+
+    /// All data is buffered, let go of mysql c api structures
+    mysql_stmt_free_result(stmt);
+    mysql_free_result(result);
+}
+
+PreparedBulkResultSet::~PreparedBulkResultSet() = default;
+
+bool PreparedBulkResultSet::IsNull(uint64 row, uint32 index) const
+{
+    ASSERT(row < m_rowCount);
+    ASSERT(index < m_fieldCount);
+    return m_nulls[row * m_fieldCount + index];
+}
+
+std::string_view PreparedBulkResultSet::GetStringView(uint64 row, uint32 index) const
+{
+    ASSERT(row < m_rowCount);
+    AssertColumnType(index, DatabaseFieldTypes::Binary);
+    return { m_columns[index] + row * m_cellSizes[index], m_lengths[index][row] };
+}
+
+void PreparedBulkResultSet::AssertColumnType(uint32 index, DatabaseFieldTypes type) const
+{
+    ASSERT(index < m_fieldCount);
+    ASSERT(m_fieldMetadata[index].Type == type, "Column {} ({}) of type {} read as another type", index, m_fieldMetadata[index].Alias, m_fieldMetadata[index].TypeName);
+}
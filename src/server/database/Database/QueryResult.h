@@ -21,6 +21,9 @@
 #include "DatabaseEnvFwd.h"
 #include "Define.h"
 #include "Field.h"
+#include <memory>
+#include <span>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
@@ -148,4 +151,75 @@ private:
     PreparedResultSet& operator=(PreparedResultSet const& right) = delete;
 };
 
+/**
+ * Result of a prepared statement read column by column, for loaders going through large tables.
+ *
+ * The values are kept in the MySQL binary format in one buffer holding each column contiguously,
+ * numeric columns are read as typed spans without any per cell Field object.
+ * The span type must match the column type, as in the guideline of Field (e.g. uint32 for INT, uint8 for TINYINT).
+ * NULL cells read as 0 in numeric columns and as an empty string in the others.
+ */
+class AC_DATABASE_API PreparedBulkResultSet
+{
+public:
+    PreparedBulkResultSet(MySQLStmt* stmt, MySQLResult* result, uint64 rowCount, uint32 fieldCount);
+    ~PreparedBulkResultSet();
+
+    [[nodiscard]] uint64 GetRowCount() const { return m_rowCount; }
+    [[nodiscard]] uint32 GetFieldCount() const { return m_fieldCount; }
+
+    //! Size of the buffer holding all values, in bytes
+    [[nodiscard]] std::size_t GetBufferSize() const { return m_bufferSize; }
+
+    template<typename T>
+    [[nodiscard]] std::span<T const> FetchColumn(uint32 index) const
+    {
+        static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "only numeric columns can be read as arrays");
+
+        AssertColumnType(index, GetColumnType<T>());
+        return { reinterpret_cast<T const*>(m_columns[index]), std::size_t(m_rowCount) };
+    }
+
+    [[nodiscard]] bool IsNull(uint64 row, uint32 index) const;
+
+    //! Value of a CHAR, VARCHAR, TEXT or BLOB column, valid as long as the result set
+    [[nodiscard]] std::string_view GetStringView(uint64 row, uint32 index) const;
+    [[nodiscard]] std::string GetString(uint64 row, uint32 index) const { return std::string(GetStringView(row, index)); }
+
+protected:
+    std::vector<QueryResultFieldMetadata> m_fieldMetadata;
+    uint64 m_rowCount;
+    uint32 m_fieldCount;
+
+private:
+    template<typename T>
+    static constexpr DatabaseFieldTypes GetColumnType()
+    {
+        if constexpr (std::is_same_v<T, float>)
+            return DatabaseFieldTypes::Float;
+        else if constexpr (std::is_same_v<T, double>)
+            return DatabaseFieldTypes::Double;
+        else if constexpr (sizeof(T) == 1)
+            return DatabaseFieldTypes::Int8;
+        else if constexpr (sizeof(T) == 2)
+            return DatabaseFieldTypes::Int16;
+        else if constexpr (sizeof(T) == 4)
+            return DatabaseFieldTypes::Int32;
+        else
+            return DatabaseFieldTypes::Int64;
+    }
+
+    void AssertColumnType(uint32 index, DatabaseFieldTypes type) const;
+
+    std::unique_ptr<char[]> m_buffer;
+    std::size_t m_bufferSize;
+    std::vector<char const*> m_columns;             ///< First value of each column in m_buffer
+    std::vector<uint32> m_cellSizes;                ///< Bytes used by each value of a column
+    std::vector<std::vector<uint32>> m_lengths;     ///< Value lengths, for string and binary columns only
+    std::vector<bool> m_nulls;                      ///< Row major, one per cell
+
+    PreparedBulkResultSet(PreparedBulkResultSet const& right) = delete;
+    PreparedBulkResultSet& operator=(PreparedBulkResultSet const& right) = delete;
+};
+
 #endif
@@ -0,0 +1,197 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SQLOperationQueue.h"
+#include "SQLOperation.h"
+#include <bit>
+
+namespace
+{
+    constexpr SQLOperationQueue::LaneMask LaneBit(DatabaseLane lane)
+    {
+        return SQLOperationQueue::LaneMask(1 << static_cast<uint8>(lane));
+    }
+}
+
+char const* GetDatabaseLaneName(DatabaseLane lane)
+{
+    switch (lane)
+    {
+        case DatabaseLane::Interactive: return "interactive";
+        case DatabaseLane::Background:  return "background";
+        case DatabaseLane::Bulk:        return "bulk";
+        default:                        return "unknown";
+    }
+}
+
+void SQLOperationQueue::SetWorkerLanes(uint8 interactiveWorkers, uint8 bulkWorkers, Milliseconds maxPriorityWait)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _interactiveWorkers = interactiveWorkers;
+    _bulkWorkers = bulkWorkers;
+    _assignedWorkers = 0;
+    _maxPriorityWait = maxPriorityWait;
+}
+
+SQLOperationQueue::LaneMask SQLOperationQueue::AssignWorkerLanes()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    uint8 const worker = _assignedWorkers++;
+
+    if (worker < _interactiveWorkers)
+        return LaneBit(DatabaseLane::Interactive);
+
+    if (!_bulkWorkers || worker - _interactiveWorkers < _bulkWorkers)
+        return LaneBit(DatabaseLane::Interactive) | LaneBit(DatabaseLane::Background) | LaneBit(DatabaseLane::Bulk);
+
+    return LaneBit(DatabaseLane::Interactive) | LaneBit(DatabaseLane::Background);
+}
+
+void SQLOperationQueue::Push(SQLOperation* operation, DatabaseLane lane)
+{
+    IdleWorkers* woken = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _lanes[static_cast<std::size_t>(lane)].push({ operation, Clock::now() });
+
+        // wake an idle worker serving this lane, of those serving the fewest lanes so the others stay free for their other lanes
+        std::size_t wokenLanes = 0;
+        for (std::size_t mask = 1; mask < _idleWorkers.size(); ++mask)
+        {
+            IdleWorkers const& idle = _idleWorkers[mask];
+            if (!(mask & LaneBit(lane)) || idle.Waiting <= idle.Wakeups)
+                continue;
+
+            if (!wokenLanes || std::popcount(mask) < std::popcount(wokenLanes))
+                wokenLanes = mask;
+        }
+
+        if (!wokenLanes)
+            return;
+
+        woken = &_idleWorkers[wokenLanes];
+        ++woken->Wakeups;
+    }
+
+    woken->Condition.notify_one();
+}
+
+SQLOperation* SQLOperationQueue::WaitAndPop(LaneMask lanes)
+{
+    std::unique_lock<std::mutex> lock(_lock);
+
+    IdleWorkers& idle = _idleWorkers[lanes];
+    std::queue<QueuedOperation>* queue = nullptr;
+    std::size_t laneIndex = 0;
+
+    // Wait for one of our lanes to have an element or the cancel/shutdown flag
+    while (!_cancel && !(queue = FindLane(lanes, laneIndex)) && !_shutdown)
+    {
+        ++idle.Waiting;
+        idle.Condition.wait(lock, [&] { return idle.Wakeups || _cancel || _shutdown; });
+        --idle.Waiting;
+
+        if (idle.Wakeups)
+            --idle.Wakeups;
+    }
+
+    if (_cancel || !queue)
+        return nullptr;
+
+    QueuedOperation queued = queue->front();
+    queue->pop();
+
+    _waitTimes[laneIndex].Add(std::chrono::duration_cast<Microseconds>(Clock::now() - queued.QueuedTime));
+    return queued.Operation;
+}
+
+std::queue<SQLOperationQueue::QueuedOperation>* SQLOperationQueue::FindLane(LaneMask lanes, std::size_t& laneIndex)
+{
+    std::queue<QueuedOperation>* found = nullptr;
+    Clock::time_point overdue;
+    for (std::size_t lane = 0; lane < MAX_DATABASE_LANES; ++lane)
+    {
+        std::queue<QueuedOperation>& queue = _lanes[lane];
+        if (!(lanes & LaneBit(DatabaseLane(lane))) || queue.empty())
+            continue;
+
+        if (!found)
+        {
+            found = &queue;
+            laneIndex = lane;
+            if (_maxPriorityWait == Clock::duration::zero())
+                break;
+
+            overdue = Clock::now() - _maxPriorityWait;
+            continue;
+        }
+
+        // an operation of a lower lane waiting too long goes before the newer ones of the higher lanes
+        Clock::time_point const queuedTime = queue.front().QueuedTime;
+        if (queuedTime < overdue && queuedTime < found->front().QueuedTime)
+        {
+            found = &queue;
+            laneIndex = lane;
+        }
+    }
+
+    return found;
+}
+
+void SQLOperationQueue::Cancel()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    for (std::queue<QueuedOperation>& queue : _lanes)
+    {
+        while (!queue.empty())
+        {
+            delete queue.front().Operation;
+            queue.pop();
+        }
+    }
+
+    _cancel = true;
+    for (IdleWorkers& idle : _idleWorkers)
+        idle.Condition.notify_all();
+}
+
+void SQLOperationQueue::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _shutdown = true;
+    }
+
+    for (IdleWorkers& idle : _idleWorkers)
+        idle.Condition.notify_all();
+}
+
+std::size_t SQLOperationQueue::Size() const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    std::size_t size = 0;
+    for (std::queue<QueuedOperation> const& queue : _lanes)
+        size += queue.size();
+
+    return size;
+}
+
+std::size_t SQLOperationQueue::Size(DatabaseLane lane) const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return _lanes[static_cast<std::size_t>(lane)].size();
+}
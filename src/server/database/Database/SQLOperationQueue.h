@@ -0,0 +1,115 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SQL_OPERATION_QUEUE_H
+#define _SQL_OPERATION_QUEUE_H
+
+#include "DatabaseEnvFwd.h"
+#include "DatabaseLatencyHistogram.h"
+#include "Define.h"
+#include "Duration.h"
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+
+class SQLOperation;
+
+AC_DATABASE_API char const* GetDatabaseLaneName(DatabaseLane lane);
+
+/**
+ * Queue shared by the asynchronous connections of a database pool, with one FIFO per lane.
+ *
+ * Each worker serves a set of lanes, and takes the oldest operation of the highest priority
+ * lane it serves, unless an operation of a lower lane waited longer than the max priority
+ * wait: the oldest of the operations waiting that long then goes first, so a busy lane does
+ * not starve the lower ones. The first workers can be reserved for the interactive lane,
+ * and the bulk lane can be limited to a number of workers, see SetWorkerLanes.
+ * Operations of a same lane keep their order, operations of different lanes do not.
+ */
+class AC_DATABASE_API SQLOperationQueue
+{
+public:
+    using LaneMask = uint8;
+
+    static constexpr Milliseconds DEFAULT_MAX_PRIORITY_WAIT = 1s;
+
+    SQLOperationQueue() = default;
+    SQLOperationQueue(SQLOperationQueue const&) = delete;
+    SQLOperationQueue& operator=(SQLOperationQueue const&) = delete;
+
+    //! interactiveWorkers workers only serve the interactive lane, of the others the first bulkWorkers
+    //! serve all lanes and the rest the interactive and background lanes. bulkWorkers 0 means all of them.
+    //! maxPriorityWait 0 always serves the higher lanes first.
+    void SetWorkerLanes(uint8 interactiveWorkers, uint8 bulkWorkers, Milliseconds maxPriorityWait = DEFAULT_MAX_PRIORITY_WAIT);
+
+    //! Lanes served by the next worker, called once by each worker when it is created
+    LaneMask AssignWorkerLanes();
+
+    void Push(SQLOperation* operation, DatabaseLane lane = DatabaseLane::Interactive);
+
+    //! Blocks until an operation of one of the lanes is available, returns nullptr
+    //! once the queue is cancelled, or shut down and these lanes are empty.
+    SQLOperation* WaitAndPop(LaneMask lanes);
+
+    //! Deletes all queued operations and stops the workers
+    void Cancel();
+
+    //! Stops the workers once the queue is empty
+    void Shutdown();
+
+    [[nodiscard]] std::size_t Size() const;
+    [[nodiscard]] std::size_t Size(DatabaseLane lane) const;
+
+    //! Time operations of a lane spent in the queue
+    [[nodiscard]] DatabaseLatencyHistogram::Snapshot GetWaitTime(DatabaseLane lane) const { return _waitTimes[static_cast<std::size_t>(lane)].GetSnapshot(); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct QueuedOperation
+    {
+        SQLOperation* Operation;
+        Clock::time_point QueuedTime;
+    };
+
+    // Workers serving the same lanes wait together. Push wakes one of them per operation, and
+    // only counts wakeups not taken yet, so each operation gets its own worker while one is idle
+    struct IdleWorkers
+    {
+        std::condition_variable Condition;
+        uint32 Waiting = 0;
+        uint32 Wakeups = 0;
+    };
+
+    std::queue<QueuedOperation>* FindLane(LaneMask lanes, std::size_t& laneIndex);
+
+    mutable std::mutex _lock;
+    std::array<IdleWorkers, 1 << MAX_DATABASE_LANES> _idleWorkers;
+    std::array<std::queue<QueuedOperation>, MAX_DATABASE_LANES> _lanes;
+    std::array<DatabaseLatencyHistogram, MAX_DATABASE_LANES> _waitTimes;
+    bool _cancel = false;
+    bool _shutdown = false;
+
+    uint8 _interactiveWorkers = 0;
+    uint8 _bulkWorkers = 0;
+    uint8 _assignedWorkers = 0;
+    Clock::duration _maxPriorityWait = DEFAULT_MAX_PRIORITY_WAIT;
+};
+
+#endif
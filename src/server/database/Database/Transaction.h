@@ -20,6 +20,7 @@
 
 #include "DatabaseEnvFwd.h"
 #include "Define.h"
+#include "ObjectPool.h"
 #include "SQLOperation.h"
 #include "StringFormat.h"
 #include <functional>
@@ -71,7 +72,7 @@ public:
 };
 
 /*! Low level class*/
-class AC_DATABASE_API TransactionTask : public SQLOperation
+class AC_DATABASE_API TransactionTask : public SQLOperation, public PooledObject<TransactionTask>
 {
     template <class T>
     friend class DatabaseWorkerPool;
@@ -38,7 +38,7 @@ void AppenderDB::_write(LogMessage const* message)
     stmt->SetData(2, message->type);
     stmt->SetData(3, uint8(message->level));
     stmt->SetData(4, message->text);
-    LoginDatabase.Execute(stmt);
+    LoginDatabase.Execute(stmt, DatabaseLane::Background);
 }
 
 void AppenderDB::setRealmId(uint32 _realmId)
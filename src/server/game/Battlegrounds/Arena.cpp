@@ -272,7 +272,7 @@ void Arena::EndBattleground(TeamId winnerTeamId)
                 trans->Append(stmt2);
             }
 
-            CharacterDatabase.CommitTransaction(trans);
+            CharacterDatabase.CommitTransaction(trans, DatabaseLane::Background);
         };
 
         if (winnerArenaTeam && loserArenaTeam && winnerArenaTeam != loserArenaTeam)
@@ -103,6 +103,7 @@ HostileReference::HostileReference(Unit* refUnit, ThreatMgr* threatMgr, float th
 // Tell our refTo (target) object that we have a link
 void HostileReference::targetObjectBuildLink()
 {
+    EnterExclusiveRegionUpdate();
     getTarget()->addHatedBy(this);
 }
 
@@ -110,6 +111,7 @@ void HostileReference::targetObjectBuildLink()
 // Tell our refTo (taget) object, that the link is cut
 void HostileReference::targetObjectDestroyLink()
 {
+    EnterExclusiveRegionUpdate();
     getTarget()->removeHatedBy(this);
 }
 
@@ -127,7 +129,23 @@ void HostileReference::sourceObjectDestroyLink()
 void HostileReference::fireStatusChanged(ThreatRefStatusChangeEvent& threatRefStatusChangeEvent)
 {
     if (GetSource())
+    {
+        EnterExclusiveRegionUpdate();
         GetSource()->processThreatEvent(&threatRefStatusChangeEvent);
+    }
+}
+
+//============================================================
+// The source and the target are linked regardless of distance, both sides change either of them.
+// Stops the other map regions unless both are in the region updated by the calling thread.
+
+void HostileReference::EnterExclusiveRegionUpdate()
+{
+    if (Unit* target = getTarget())
+        Map::EnterExclusiveRegionUpdate(target);
+
+    if (ThreatMgr* source = GetSource())
+        Map::EnterExclusiveRegionUpdate(source->GetOwner());
 }
 
 // -- compatibility layer for combat rewrite
@@ -137,6 +155,7 @@ Unit* HostileReference::GetOwner() const { return GetSource()->GetOwner(); }
 
 void HostileReference::AddThreat(float modThreat)
 {
+    EnterExclusiveRegionUpdate();
     iThreat += modThreat;
     // the threat is changed. Source and target unit have to be available
     // if the link was cut before relink it again
@@ -228,6 +247,7 @@ void HostileReference::setOnlineOfflineState(bool isOnline)
 
 void HostileReference::removeReference()
 {
+    EnterExclusiveRegionUpdate();
     invalidate();
 
     ThreatRefStatusChangeEvent event(UEV_THREAT_REF_REMOVE_FROM_LIST, this, false);
@@ -128,6 +128,9 @@ private:
     // Inform the source, that the status of that reference was changed
     void fireStatusChanged(ThreatRefStatusChangeEvent& threatRefStatusChangeEvent);
 
+    // Before changing the source or the target, see Map::EnterExclusiveRegionUpdate
+    void EnterExclusiveRegionUpdate();
+
     Unit* GetSourceUnit();
 private:
     float iThreat;
@@ -198,11 +198,22 @@ void Corpse::ResetGhostTime()
 }
 
 void Corpse::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
+{
+    BuildValuesUpdate(updateType, data, target, nullptr);
+}
+
+void Corpse::BuildSharedValuesUpdate(ByteBuffer* data, Player* target, std::vector<ObserverField>& observerFields)
+{
+    BuildValuesUpdate(UPDATETYPE_VALUES, data, target, &observerFields);
+}
+
+void Corpse::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target, std::vector<ObserverField>* observerFields)
 {
     if (!target)
         return;
 
     ByteBuffer fieldBuffer;
+    std::vector<ObserverField> fieldBufferObserverFields;
     UpdateMask updateMask;
     updateMask.SetCount(m_valuesCount);
 
@@ -217,35 +228,8 @@ void Corpse::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* targe
 
             if (index == CORPSE_FIELD_BYTES_1 || index == CORPSE_FIELD_BYTES_2)
             {
-                Player* owner = ObjectAccessor::GetPlayer(*this, GetOwnerGUID());
-                if (owner && owner != target && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && owner->IsInRaidWith(target) && owner->GetTeamId() != target->GetTeamId())
-                {
-                    uint32 playerBytes = target->GetUInt32Value(PLAYER_BYTES);
-                    uint32 playerBytes2 = target->GetUInt32Value(PLAYER_BYTES_2);
-
-                    uint8 race = target->getRace();
-                    uint8 skin = (uint8)(playerBytes);
-                    uint8 face = (uint8)(playerBytes >> 8);
-                    uint8 hairstyle = (uint8)(playerBytes >> 16);
-                    uint8 haircolor = (uint8)(playerBytes >> 24);
-                    uint8 facialhair = (uint8)(playerBytes2);
-
-                    uint32 corpseBytes1 = ((0x00) | (race << 8) | (target->GetByteValue(PLAYER_BYTES_3, 0) << 16) | (skin << 24));
-                    uint32 corpseBytes2 = ((face) | (hairstyle << 8) | (haircolor << 16) | (facialhair << 24));
-
-                    if (index == CORPSE_FIELD_BYTES_1)
-                    {
-                        fieldBuffer << corpseBytes1;
-                    }
-                    else
-                    {
-                        fieldBuffer << corpseBytes2;
-                    }
-                }
-                else
-                {
-                    fieldBuffer << m_uint32Values[index];
-                }
+                fieldBufferObserverFields.push_back({ uint32(fieldBuffer.wpos()), index });
+                fieldBuffer << GetObserverFieldValue(index, target);
             }
             else
             {
@@ -256,5 +240,37 @@ void Corpse::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* targe
 
     *data << uint8(updateMask.GetBlockCount());
     updateMask.AppendToPacket(data);
+
+    if (observerFields)
+        for (ObserverField const& field : fieldBufferObserverFields)
+            observerFields->push_back({ uint32(data->wpos()) + field.Offset, field.Index });
+
     data->append(fieldBuffer);
 }
+
+uint32 Corpse::GetObserverFieldValue(uint16 index, Player* target)
+{
+    if (index != CORPSE_FIELD_BYTES_1 && index != CORPSE_FIELD_BYTES_2)
+        return WorldObject::GetObserverFieldValue(index, target);
+
+    Player* owner = ObjectAccessor::GetPlayer(*this, GetOwnerGUID());
+    if (owner && owner != target && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && owner->IsInRaidWith(target) && owner->GetTeamId() != target->GetTeamId())
+    {
+        uint32 playerBytes = target->GetUInt32Value(PLAYER_BYTES);
+        uint32 playerBytes2 = target->GetUInt32Value(PLAYER_BYTES_2);
+
+        uint8 race = target->getRace();
+        uint8 skin = (uint8)(playerBytes);
+        uint8 face = (uint8)(playerBytes >> 8);
+        uint8 hairstyle = (uint8)(playerBytes >> 16);
+        uint8 haircolor = (uint8)(playerBytes >> 24);
+        uint8 facialhair = (uint8)(playerBytes2);
+
+        uint32 corpseBytes1 = ((0x00) | (race << 8) | (target->GetByteValue(PLAYER_BYTES_3, 0) << 16) | (skin << 24));
+        uint32 corpseBytes2 = ((face) | (hairstyle << 8) | (haircolor << 16) | (facialhair << 24));
+
+        return index == CORPSE_FIELD_BYTES_1 ? corpseBytes1 : corpseBytes2;
+    }
+
+    return m_uint32Values[index];
+}
@@ -55,6 +55,8 @@ public:
     void RemoveFromWorld() override;
 
     void BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target) override;
+    void BuildSharedValuesUpdate(ByteBuffer* data, Player* target, std::vector<ObserverField>& observerFields) override;
+    uint32 GetObserverFieldValue(uint16 index, Player* target) override;
 
     bool Create(ObjectGuid::LowType guidlow);
     bool Create(ObjectGuid::LowType guidlow, Player* owner);
@@ -80,6 +82,9 @@ public:
     [[nodiscard]] bool IsExpired(time_t t) const;
 
 private:
+    // observerFields receives the positions of the fields given by GetObserverFieldValue when set
+    void BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target, std::vector<ObserverField>* observerFields);
+
     CorpseType m_type;
     time_t m_time;
     CellCoord _cellCoord;
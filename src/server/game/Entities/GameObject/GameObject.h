@@ -123,6 +123,8 @@ public:
     ~GameObject() override;
 
     void BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target) override;
+    void BuildSharedValuesUpdate(ByteBuffer* data, Player* target, std::vector<ObserverField>& observerFields) override;
+    uint32 GetObserverFieldValue(uint16 index, Player* target) override;
 
     void AddToWorld() override;
     void RemoveFromWorld() override;
@@ -412,6 +414,8 @@ private:
     void RemoveFromOwner();
     void SwitchDoorOrButton(bool activate, bool alternative = false);
     void UpdatePackedRotation();
+    // observerFields receives the positions of the fields given by GetObserverFieldValue when set
+    void BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target, std::vector<ObserverField>* observerFields);
 
     //! Object distance/size - overridden from Object::_IsWithinDist. Needs to take in account proper GO size.
     bool _IsWithinDist(WorldObject const* obj, float dist2compare, bool /*is3D*/, bool /*incOwnRadius = true*/, bool /*incTargetRadius = true*/) const override
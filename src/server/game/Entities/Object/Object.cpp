@@ -531,7 +531,7 @@ void Object::ClearUpdateMask(bool remove)
     }
 }
 
-void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map)
+void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map, UpdateBlockCache* blockCache /*= nullptr*/)
 {
     UpdateDataMapType::iterator iter = data_map.find(player);
 
@@ -542,7 +542,29 @@ void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map)
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    if (!blockCache || HasObserverDependentValues())
+    {
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+        return;
+    }
+
+    // Observers with the same visibility flags share the values block, only the observer fields are patched for each of them
+    uint32* flags = nullptr;
+    uint32 visibleFlag = GetUpdateFieldData(player, flags);
+    UpdateBlockCache::Block const* block = blockCache->Find(visibleFlag, flags);
+    if (!block)
+    {
+        ByteBuffer buf(500);
+        buf << (uint8) UPDATETYPE_VALUES;
+        buf << GetPackGUID();
+
+        std::vector<ObserverField> observerFields;
+        BuildSharedValuesUpdate(&buf, player, observerFields);
+
+        block = &blockCache->Store(std::move(buf), visibleFlag, flags, std::move(observerFields));
+    }
+
+    iter->second.AddSharedUpdateBlock(block->Data, block->BuildPatches([this, player](uint16 index) { return GetObserverFieldValue(index, player); }));
 }
 
 uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
@@ -1376,13 +1398,7 @@ bool WorldObject::IsWithinLOSInMap(WorldObject const* obj, VMAP::ModelIgnoreFlag
         return false;
 
     float ox, oy, oz;
-    if (obj->IsPlayer())
-    {
-        obj->GetPosition(ox, oy, oz);
-        oz += obj->GetCollisionHeight();
-    }
-    else
-        obj->GetHitSpherePointFor({ GetPositionX(), GetPositionY(), GetPositionZ() + (collisionHeight ? *collisionHeight : GetCollisionHeight()) }, ox, oy, oz);
+    GetLOSTargetPoint(obj, ox, oy, oz, collisionHeight);
 
     float x, y, z;
     if (IsPlayer())
@@ -1396,6 +1412,38 @@ bool WorldObject::IsWithinLOSInMap(WorldObject const* obj, VMAP::ModelIgnoreFlag
     return GetMap()->isInLineOfSight(x, y, z, ox, oy, oz, GetPhaseMask(), checks, ignoreFlags);
 }
 
+void WorldObject::PrefetchLOSInMap(std::list<WorldObject*> const& targets, VMAP::ModelIgnoreFlags ignoreFlags) const
+{
+    // the ray of a player starts at its eyes whatever the target, see IsWithinLOSInMap
+    if (!IsPlayer() || targets.size() < 2)
+        return;
+
+    std::vector<G3D::Vector3> points;
+    points.reserve(targets.size());
+    for (WorldObject const* target : targets)
+    {
+        if (!IsInMap(target))
+            continue;
+
+        G3D::Vector3 point;
+        GetLOSTargetPoint(target, point.x, point.y, point.z);
+        points.push_back(point);
+    }
+
+    GetMap()->PrefetchVMapLineOfSight(GetPositionX(), GetPositionY(), GetPositionZ() + GetCollisionHeight(), points, ignoreFlags);
+}
+
+void WorldObject::GetLOSTargetPoint(WorldObject const* obj, float& x, float& y, float& z, Optional<float> collisionHeight) const
+{
+    if (obj->IsPlayer())
+    {
+        obj->GetPosition(x, y, z);
+        z += obj->GetCollisionHeight();
+    }
+    else
+        obj->GetHitSpherePointFor({ GetPositionX(), GetPositionY(), GetPositionZ() + (collisionHeight ? *collisionHeight : GetCollisionHeight()) }, x, y, z);
+}
+
 void WorldObject::GetHitSpherePointFor(Position const& dest, float& x, float& y, float& z, Optional<float> collisionHeight, Optional<float> combatReach) const
 {
     Position pos = GetHitSpherePointFor(dest, collisionHeight, combatReach);
@@ -1577,7 +1625,7 @@ float WorldObject::GetMinHeightInWater() const
     return (height > heightInWater ? heightInWater : (height - (height / 3)));
 }
 
-void WorldObject::UpdateAllowedPositionZ(float x, float y, float& z, float* groundZ) const
+void WorldObject::UpdateAllowedPositionZ(float x, float y, float& z, float* groundZ, Optional<float> gridHeight) const
 {
     if (GetTransport())
     {
@@ -1596,9 +1644,9 @@ void WorldObject::UpdateAllowedPositionZ(float x, float y, float& z, float* grou
             float ground_z = z;
             float max_z;
             if (canSwim)
-                max_z = GetMapWaterOrGroundLevel(x, y, z, &ground_z);
+                max_z = GetMapWaterOrGroundLevel(x, y, z, &ground_z, gridHeight);
             else
-                max_z = ground_z = GetMapHeight(x, y, z);
+                max_z = ground_z = GetMapHeight(x, y, z, true, DEFAULT_HEIGHT_SEARCH, gridHeight);
 
             if (max_z > INVALID_HEIGHT)
             {
@@ -1627,7 +1675,7 @@ void WorldObject::UpdateAllowedPositionZ(float x, float y, float& z, float* grou
         }
         else
         {
-            float ground_z = GetMapHeight(x, y, z) + unit->GetHoverHeight();
+            float ground_z = GetMapHeight(x, y, z, true, DEFAULT_HEIGHT_SEARCH, gridHeight) + unit->GetHoverHeight();
             if (z < ground_z)
                 z = ground_z;
 
@@ -1637,7 +1685,7 @@ void WorldObject::UpdateAllowedPositionZ(float x, float y, float& z, float* grou
     }
     else
     {
-        float ground_z = GetMapHeight(x, y, z);
+        float ground_z = GetMapHeight(x, y, z, true, DEFAULT_HEIGHT_SEARCH, gridHeight);
         if (ground_z > INVALID_HEIGHT)
             z = ground_z;
 
@@ -2989,14 +3037,18 @@ void WorldObject::AddToNotify(uint16 f)
 
 void WorldObject::BuildUpdate(UpdateDataMapType& data_map)
 {
+    // Objects whose values a script patches per observer build them for each observer
+    UpdateBlockCache blockCache;
+    UpdateBlockCache* sharedBlocks = HasObserverDependentValues() ? nullptr : &blockCache;
+
     // Build update for self
     if (IsPlayer())
-        BuildFieldsUpdate(ToPlayer(), data_map);
+        BuildFieldsUpdate(ToPlayer(), data_map, sharedBlocks);
 
     // Build update for visible players
-    DoForAllVisiblePlayers([this, &data_map](Player* player)
+    DoForAllVisiblePlayers([this, &data_map, sharedBlocks](Player* player)
     {
-        BuildFieldsUpdate(player, data_map);
+        BuildFieldsUpdate(player, data_map, sharedBlocks);
     });
 
     ClearUpdateMask(false);
@@ -3027,19 +3079,19 @@ ObjectGuid WorldObject::GetTransGUID() const
     return ObjectGuid::Empty;
 }
 
-float WorldObject::GetMapHeight(float x, float y, float z, bool vmap/* = true*/, float distanceToSearch/* = DEFAULT_HEIGHT_SEARCH*/) const
+float WorldObject::GetMapHeight(float x, float y, float z, bool vmap/* = true*/, float distanceToSearch/* = DEFAULT_HEIGHT_SEARCH*/, Optional<float> gridHeight/* = {}*/) const
 {
     if (z != MAX_HEIGHT)
         z += std::max(GetCollisionHeight(), Z_OFFSET_FIND_HEIGHT);
 
-    return GetMap()->GetHeight(GetPhaseMask(), x, y, z, vmap, distanceToSearch);
+    return GetMap()->GetHeight(GetPhaseMask(), x, y, z, vmap, distanceToSearch, gridHeight);
 }
 
-float WorldObject::GetMapWaterOrGroundLevel(float x, float y, float z, float* ground/* = nullptr*/) const
+float WorldObject::GetMapWaterOrGroundLevel(float x, float y, float z, float* ground/* = nullptr*/, Optional<float> gridHeight/* = {}*/) const
 {
     return GetMap()->GetWaterOrGroundLevel(GetPhaseMask(), x, y, z, ground,
         IsUnit() ? !static_cast<Unit const*>(this)->HasWaterWalkAura() : false,
-        std::max(GetCollisionHeight(),  Z_OFFSET_FIND_HEIGHT));
+        std::max(GetCollisionHeight(),  Z_OFFSET_FIND_HEIGHT), gridHeight);
 }
 
 float WorldObject::GetFloorZ() const
@@ -189,7 +189,7 @@ public:
     [[nodiscard]] virtual bool hasQuest(uint32 /* quest_id */) const { return false; }
     [[nodiscard]] virtual bool hasInvolvedQuest(uint32 /* quest_id */) const { return false; }
     virtual void BuildUpdate(UpdateDataMapType&) {}
-    void BuildFieldsUpdate(Player*, UpdateDataMapType&);
+    void BuildFieldsUpdate(Player*, UpdateDataMapType&, UpdateBlockCache* blockCache = nullptr);
 
     void SetFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags |= flag; }
     void RemoveFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags &= ~flag; }
@@ -247,6 +247,13 @@ protected:
 
     void BuildMovementUpdate(ByteBuffer* data, uint16 flags) const;
     virtual void BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target);
+    // Values update shared by the observers with the same visibility flags from GetUpdateFieldData,
+    // observerFields receives the fields GetObserverFieldValue gives another value for other observers
+    virtual void BuildSharedValuesUpdate(ByteBuffer* data, Player* target, std::vector<ObserverField>& /*observerFields*/) { BuildValuesUpdate(UPDATETYPE_VALUES, data, target); }
+    // Value of a field returned by BuildSharedValuesUpdate in observerFields, for this target
+    virtual uint32 GetObserverFieldValue(uint16 index, Player* /*target*/) { return m_uint32Values[index]; }
+    // True when BuildValuesUpdate output depends on the target in a way observer fields do not describe
+    [[nodiscard]] virtual bool HasObserverDependentValues() const { return false; }
 
     uint16 m_objectType;
 
@@ -501,7 +508,7 @@ public:
 
     [[nodiscard]] virtual float GetCombatReach() const { return 0.0f; } // overridden (only) in Unit
     void UpdateGroundPositionZ(float x, float y, float& z) const;
-    void UpdateAllowedPositionZ(float x, float y, float& z, float* groundZ = nullptr) const;
+    void UpdateAllowedPositionZ(float x, float y, float& z, float* groundZ = nullptr, Optional<float> gridHeight = {}) const;
 
     void GetRandomPoint(const Position& srcPos, float distance, float& rand_x, float& rand_y, float& rand_z) const;
     [[nodiscard]] Position GetRandomPoint(const Position& srcPos, float distance) const;
@@ -544,8 +551,12 @@ public:
     bool IsWithinDistInMap(WorldObject const* obj, float dist2compare, bool is3D = true, bool incOwnRadius = true, bool incTargetRadius = true) const;
     [[nodiscard]] bool IsWithinLOS(float x, float y, float z, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS) const;
     [[nodiscard]] bool IsWithinLOSInMap(WorldObject const* obj, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS, Optional<float> collisionHeight = { }, Optional<float> combatReach = { }) const;
+    // Fills the vmap line of sight cache of the map for the IsWithinLOSInMap checks against all targets in one batch
+    void PrefetchLOSInMap(std::list<WorldObject*> const& targets, VMAP::ModelIgnoreFlags ignoreFlags) const;
     [[nodiscard]] Position GetHitSpherePointFor(Position const& dest, Optional<float> collisionHeight = { }, Optional<float> combatReach = { }) const;
     void GetHitSpherePointFor(Position const& dest, float& x, float& y, float& z, Optional<float> collisionHeight = { }, Optional<float> combatReach = { }) const;
+    // the point of obj the line of sight rays from this object aim at
+    void GetLOSTargetPoint(WorldObject const* obj, float& x, float& y, float& z, Optional<float> collisionHeight = { }) const;
     bool GetDistanceOrder(WorldObject const* obj1, WorldObject const* obj2, bool is3D = true) const;
     bool IsInRange(WorldObject const* obj, float minRange, float maxRange, bool is3D = true) const;
     [[nodiscard]] bool IsInRange2d(float x, float y, float minRange, float maxRange) const;
@@ -700,8 +711,8 @@ public:
     {
         return GetMapWaterOrGroundLevel(pos.GetPositionX(), pos.GetPositionY(), pos.GetPositionZ(), ground);
     };
-    [[nodiscard]] float GetMapWaterOrGroundLevel(float x, float y, float z, float* ground = nullptr) const;
-    [[nodiscard]] float GetMapHeight(float x, float y, float z, bool vmap = true, float distanceToSearch = 50.0f) const; // DEFAULT_HEIGHT_SEARCH in map.h
+    [[nodiscard]] float GetMapWaterOrGroundLevel(float x, float y, float z, float* ground = nullptr, Optional<float> gridHeight = {}) const;
+    [[nodiscard]] float GetMapHeight(float x, float y, float z, bool vmap = true, float distanceToSearch = 50.0f, Optional<float> gridHeight = {}) const; // DEFAULT_HEIGHT_SEARCH in map.h
 
     [[nodiscard]] float GetFloorZ() const;
     [[nodiscard]] float GetMinHeightInWater() const;
@@ -41,15 +41,28 @@ void UpdateData::AddUpdateBlock(const ByteBuffer& block)
 
 void UpdateData::AddUpdateBlock(const UpdateData& block)
 {
+    for (SharedBlock const& sharedBlock : block.m_sharedBlocks)
+        m_sharedBlocks.push_back({ m_data.wpos() + sharedBlock.Position, sharedBlock.Block, sharedBlock.Patches });
+
     m_data.append(block.m_data);
     m_blockCount += block.m_blockCount;
 }
 
+void UpdateData::AddSharedUpdateBlock(std::shared_ptr<ByteBuffer const> block, std::vector<UpdateFieldPatch> patches /*= {}*/)
+{
+    m_sharedBlocks.push_back({ m_data.wpos(), std::move(block), std::move(patches) });
+    ++m_blockCount;
+}
+
 bool UpdateData::BuildPacket(WorldPacket& packet)
 {
     ASSERT(packet.empty());
 
-    packet.reserve(4 + (m_outOfRangeGUIDs.empty() ? 0 : 1 + 4 + 9 * m_outOfRangeGUIDs.size()) + m_data.wpos());
+    std::size_t dataSize = m_data.wpos();
+    for (SharedBlock const& sharedBlock : m_sharedBlocks)
+        dataSize += sharedBlock.Block->wpos();
+
+    packet.reserve(4 + (m_outOfRangeGUIDs.empty() ? 0 : 1 + 4 + 9 * m_outOfRangeGUIDs.size()) + dataSize);
 
     packet << (uint32) (!m_outOfRangeGUIDs.empty() ? m_blockCount + 1 : m_blockCount);
 
@@ -62,7 +75,24 @@ bool UpdateData::BuildPacket(WorldPacket& packet)
             packet << guid.WriteAsPacked();
     }
 
-    packet.append(m_data);
+    // Splice shared blocks back at the position they were added at
+    std::size_t dataPos = 0;
+    for (SharedBlock const& sharedBlock : m_sharedBlocks)
+    {
+        if (sharedBlock.Position > dataPos)
+            packet.append(m_data.contents() + dataPos, sharedBlock.Position - dataPos);
+
+        std::size_t const blockPos = packet.wpos();
+        packet.append(*sharedBlock.Block);
+        for (UpdateFieldPatch const& patch : sharedBlock.Patches)
+            packet.put(blockPos + patch.Offset, patch.Value);
+
+        dataPos = sharedBlock.Position;
+    }
+
+    if (m_data.wpos() > dataPos)
+        packet.append(m_data.contents() + dataPos, m_data.wpos() - dataPos);
+
     packet.SetOpcode(SMSG_UPDATE_OBJECT);
 
     return true;
@@ -71,6 +101,22 @@ bool UpdateData::BuildPacket(WorldPacket& packet)
 void UpdateData::Clear()
 {
     m_data.clear();
+    m_sharedBlocks.clear();
     m_outOfRangeGUIDs.clear();
     m_blockCount = 0;
 }
+
+UpdateBlockCache::Block const* UpdateBlockCache::Find(uint32 visibleFlag, uint32 const* fieldFlags) const
+{
+    for (Entry const& entry : _entries)
+        if (entry.VisibleFlag == visibleFlag && entry.FieldFlags == fieldFlags)
+            return &entry.SharedBlock;
+
+    return nullptr;
+}
+
+UpdateBlockCache::Block const& UpdateBlockCache::Store(ByteBuffer&& block, uint32 visibleFlag, uint32 const* fieldFlags, std::vector<ObserverField> observerFields /*= {}*/)
+{
+    _entries.push_back({ visibleFlag, fieldFlags, { std::make_shared<ByteBuffer const>(std::move(block)), std::move(observerFields) } });
+    return _entries.back().SharedBlock;
+}
@@ -20,6 +20,8 @@
 
 #include "ByteBuffer.h"
 #include "ObjectGuid.h"
+#include <memory>
+#include <vector>
 
 class WorldPacket;
 
@@ -48,6 +50,20 @@ enum OBJECT_UPDATE_FLAGS
     UPDATEFLAG_ROTATION             = 0x0200
 };
 
+// Field of a shared values block whose value depends on the observer, see Object::GetObserverFieldValue
+struct ObserverField
+{
+    uint32 Offset;  // from the start of the block
+    uint16 Index;
+};
+
+// Value of an ObserverField for one observer, written over the shared block when the packet is built
+struct UpdateFieldPatch
+{
+    uint32 Offset;
+    uint32 Value;
+};
+
 class UpdateData
 {
 public:
@@ -56,13 +72,71 @@ public:
     void AddOutOfRangeGUID(ObjectGuid guid);
     void AddUpdateBlock(const ByteBuffer& block);
     void AddUpdateBlock(const UpdateData& block);
+    // Block shared with other UpdateData, only copied when the packet is built, with the patches written over it
+    void AddSharedUpdateBlock(std::shared_ptr<ByteBuffer const> block, std::vector<UpdateFieldPatch> patches = {});
     bool BuildPacket(WorldPacket& packet);
     [[nodiscard]] bool HasData() const { return m_blockCount > 0 || !m_outOfRangeGUIDs.empty(); }
     void Clear();
 
 protected:
+    struct SharedBlock
+    {
+        std::size_t Position;   // in m_data
+        std::shared_ptr<ByteBuffer const> Block;
+        std::vector<UpdateFieldPatch> Patches;
+    };
+
     uint32 m_blockCount;
     GuidVector m_outOfRangeGUIDs;
     ByteBuffer m_data;
+    std::vector<SharedBlock> m_sharedBlocks;
+};
+
+/**
+ * Values blocks of a single object built for all its observers during one update.
+ *
+ * A block is serialized once for all observers with the same visibility flags and field flags
+ * returned by Object::GetUpdateFieldData. The fields depending on the observer beyond these flags,
+ * like npc flags or dynamic flags, are listed with the block and patched for each observer.
+ * Blocks are only valid for the values they were built from, Clear() drops them.
+ */
+class UpdateBlockCache
+{
+public:
+    struct Block
+    {
+        std::shared_ptr<ByteBuffer const> Data;
+        std::vector<ObserverField> ObserverFields;
+
+        // values of the observer fields differing from the ones in the block, getValue(index) gives the value for the observer
+        template<class ValueGetter>
+        std::vector<UpdateFieldPatch> BuildPatches(ValueGetter&& getValue) const
+        {
+            std::vector<UpdateFieldPatch> patches;
+            for (ObserverField const& field : ObserverFields)
+            {
+                uint32 const value = getValue(field.Index);
+                if (value != Data->read<uint32>(field.Offset))
+                    patches.push_back({ field.Offset, value });
+            }
+
+            return patches;
+        }
+    };
+
+    [[nodiscard]] Block const* Find(uint32 visibleFlag, uint32 const* fieldFlags) const;
+    // the returned block stays valid until the next Store or Clear
+    Block const& Store(ByteBuffer&& block, uint32 visibleFlag, uint32 const* fieldFlags, std::vector<ObserverField> observerFields = {});
+    void Clear() { _entries.clear(); }
+
+private:
+    struct Entry
+    {
+        uint32 VisibleFlag;
+        uint32 const* FieldFlags;
+        Block SharedBlock;
+    };
+
+    std::vector<Entry> _entries;
 };
 #endif
@@ -1659,6 +1659,7 @@ void Player::ProcessDelayedOperations()
             }
             AddAura(m_entryPointData.mountSpell, this);
             m_entryPointData.mountSpell = 0;
+            SetSaveSectionChanged(PLAYER_SAVE_ENTRY_POINT);
         }
     }
 
@@ -1669,6 +1670,7 @@ void Player::ProcessDelayedOperations()
             m_taxi.AddTaxiDestination(m_entryPointData.taxiPath[0]);
             m_taxi.AddTaxiDestination(m_entryPointData.taxiPath[1]);
             m_entryPointData.ClearTaxiPath();
+            SetSaveSectionChanged(PLAYER_SAVE_ENTRY_POINT);
             ContinueTaxiFlight();
         }
     }
@@ -3529,7 +3531,8 @@ bool Player::Has310Flyer(bool checkAllSpells, uint32 excludeSpellId)
 
 void Player::RemoveSpellCooldown(uint32 spell_id, bool update /* = false */)
 {
-    m_spellCooldowns.erase(spell_id);
+    if (m_spellCooldowns.erase(spell_id))
+        SetSaveSectionChanged(PLAYER_SAVE_SPELL_COOLDOWNS);
 
     if (update)
         SendClearCooldown(spell_id, this);
@@ -3588,6 +3591,7 @@ void Player::RemoveAllSpellCooldown()
                 SendClearCooldown(itr->first, this);
 
         m_spellCooldowns.clear();
+        SetSaveSectionChanged(PLAYER_SAVE_SPELL_COOLDOWNS);
     }
 }
 
@@ -3629,6 +3633,11 @@ void Player::_LoadSpellCooldowns(PreparedQueryResult result)
 
 void Player::_SaveSpellCooldowns(CharacterDatabaseTransaction trans, bool logout)
 {
+    if (!IsSaveSectionChanged(PLAYER_SAVE_SPELL_COOLDOWNS))
+        return;
+
+    SetSaveSectionWritten(PLAYER_SAVE_SPELL_COOLDOWNS);
+
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_SPELL_COOLDOWN);
     stmt->SetData(0, GetGUID().GetCounter());
     trans->Append(stmt);
@@ -11123,6 +11132,7 @@ void Player::_AddSpellCooldown(uint32 spellid, uint16 categoryId, uint32 itemid,
     }
 
     m_spellCooldowns[spellid] = std::move(sc);
+    SetSaveSectionChanged(PLAYER_SAVE_SPELL_COOLDOWNS);
 }
 
 void Player::AddSpellCooldown(uint32 spellid, uint32 itemid, uint32 end_time, bool needSendToClient, bool forceSendToSpectator)
@@ -11137,6 +11147,7 @@ void Player::ModifySpellCooldown(uint32 spellId, int32 cooldown)
         return;
 
     itr->second.end += cooldown;
+    SetSaveSectionChanged(PLAYER_SAVE_SPELL_COOLDOWNS);
 
     WorldPacket data(SMSG_MODIFY_COOLDOWN, 4 + 8 + 4);
     data << uint32(spellId);            // Spell ID
@@ -11356,6 +11367,8 @@ void Player::SetEntryPoint()
 
     if (m_entryPointData.joinPos.m_mapId == MAPID_INVALID)
         m_entryPointData.joinPos = WorldLocation(m_homebindMapId, m_homebindX, m_homebindY, m_homebindZ, 0.0f);
+
+    SetSaveSectionChanged(PLAYER_SAVE_ENTRY_POINT);
 }
 
 void Player::LeaveBattleground(Battleground* bg)
@@ -14724,6 +14737,11 @@ void Player::_SaveEquipmentSets(CharacterDatabaseTransaction trans)
 
 void Player::_SaveEntryPoint(CharacterDatabaseTransaction trans)
 {
+    if (!IsSaveSectionChanged(PLAYER_SAVE_ENTRY_POINT))
+        return;
+
+    SetSaveSectionWritten(PLAYER_SAVE_ENTRY_POINT);
+
     // xinef: dont save joinpos with invalid mapid
     MapEntry const* mEntry = sMapStore.LookupEntry(m_entryPointData.joinPos.GetMapId());
     if (!mEntry)
@@ -15996,9 +16014,11 @@ void Player::_LoadPetStable(uint8 petStableSlots, PreparedQueryResult result)
 
 void Player::_SaveInstanceTimeRestrictions(CharacterDatabaseTransaction trans)
 {
-    if (_instanceResetTimes.empty())
+    if (_instanceResetTimes.empty() || !IsSaveSectionChanged(PLAYER_SAVE_INSTANCE_TIMES))
         return;
 
+    SetSaveSectionWritten(PLAYER_SAVE_INSTANCE_TIMES);
+
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ACCOUNT_INSTANCE_LOCK_TIMES);
     stmt->SetData(0, GetSession()->GetAccountId());
     trans->Append(stmt);
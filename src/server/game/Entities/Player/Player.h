@@ -988,6 +988,36 @@ enum AdditionalSaving
     ADDITIONAL_SAVING_QUEST_STATUS              = 0x02,
 };
 
+// Sections written by Player::SaveToDB
+enum PlayerSaveSection : uint8
+{
+    PLAYER_SAVE_CHARACTER,
+    PLAYER_SAVE_MAIL,
+    PLAYER_SAVE_ENTRY_POINT,                    // tracked
+    PLAYER_SAVE_INVENTORY,
+    PLAYER_SAVE_QUEST_STATUS,
+    PLAYER_SAVE_DAILY_QUESTS,
+    PLAYER_SAVE_WEEKLY_QUESTS,
+    PLAYER_SAVE_SEASONAL_QUESTS,
+    PLAYER_SAVE_MONTHLY_QUESTS,
+    PLAYER_SAVE_TALENTS,
+    PLAYER_SAVE_SPELLS,
+    PLAYER_SAVE_SPELL_COOLDOWNS,                // tracked
+    PLAYER_SAVE_ACTIONS,
+    PLAYER_SAVE_AURAS,                          // tracked
+    PLAYER_SAVE_SKILLS,
+    PLAYER_SAVE_ACHIEVEMENTS,
+    PLAYER_SAVE_REPUTATION,
+    PLAYER_SAVE_EQUIPMENT_SETS,
+    PLAYER_SAVE_TUTORIALS,
+    PLAYER_SAVE_GLYPHS,
+    PLAYER_SAVE_INSTANCE_TIMES,                 // tracked
+    PLAYER_SAVE_SETTINGS,                       // tracked
+    PLAYER_SAVE_STATS,
+
+    MAX_PLAYER_SAVE_SECTIONS
+};
+
 enum PlayerCommandStates
 {
     CHEAT_NONE = 0x00,
@@ -1574,6 +1604,17 @@ public:
 
     void SaveToDB(bool create, bool logout);
     void SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logout);
+
+    // Tracked sections are rewritten as a whole, so they are only saved when changed since their last
+    // committed save, or on logout. The other sections only write the rows flagged as changed in memory.
+    void SetSaveSectionChanged(PlayerSaveSection section);
+    [[nodiscard]] bool IsSaveSectionChanged(PlayerSaveSection section) const { return m_saveSectionGeneration[section] != m_savedSectionGeneration[section]; }
+    // section appended to the save transaction, it counts as saved once SaveToDB committed the transaction
+    void SetSaveSectionWritten(PlayerSaveSection section) { m_writtenSectionGeneration[section] = m_saveSectionGeneration[section]; }
+
+    // Statements appended by SaveToDB per section over all players since the last call
+    static std::array<uint64, MAX_PLAYER_SAVE_SECTIONS> ConsumeSaveStatementCounts();
+    static char const* GetSaveSectionName(PlayerSaveSection section);
     void SaveInventoryAndGoldToDB(CharacterDatabaseTransaction trans);                    // fast save function for item/money cheating preventing
     void SaveGoldToDB(CharacterDatabaseTransaction trans);
     void _SaveSkills(CharacterDatabaseTransaction trans);
@@ -1769,7 +1810,7 @@ public:
     PlayerSpellMap&       GetSpellMap()       { return m_spells; }
 
     [[nodiscard]] SpellCooldowns const& GetSpellCooldownMap() const { return m_spellCooldowns; }
-    SpellCooldowns&       GetSpellCooldownMap()       { return m_spellCooldowns; }
+    SpellCooldowns&       GetSpellCooldownMap()       { SetSaveSectionChanged(PLAYER_SAVE_SPELL_COOLDOWNS); return m_spellCooldowns; }
 
     SkillStatusMap const& GetSkillStatusMap() const { return mSkillStatus; }
     SkillStatusMap& GetSkillStatusMap() { return mSkillStatus; }
@@ -2464,7 +2505,10 @@ public:
     void AddInstanceEnterTime(uint32 instanceId, time_t enterTime)
     {
         if (_instanceResetTimes.find(instanceId) == _instanceResetTimes.end())
+        {
             _instanceResetTimes.insert(InstanceTimeMap::value_type(instanceId, enterTime + HOUR));
+            SetSaveSectionChanged(PLAYER_SAVE_INSTANCE_TIMES);
+        }
     }
 
     // last used pet number (for BG's)
@@ -2799,6 +2843,9 @@ protected:
     uint32 m_nextSave; // pussywizard
     uint16 m_additionalSaveTimer; // pussywizard
     uint8 m_additionalSaveMask; // pussywizard
+    std::array<uint64, MAX_PLAYER_SAVE_SECTIONS> m_saveSectionGeneration = { };
+    std::array<uint64, MAX_PLAYER_SAVE_SECTIONS> m_writtenSectionGeneration = { };
+    std::array<uint64, MAX_PLAYER_SAVE_SECTIONS> m_savedSectionGeneration = { };
     uint16 m_hostileReferenceCheckTimer; // pussywizard
     std::array<ChatFloodThrottle, ChatFloodThrottle::MAX> m_chatFloodData;
     Difficulty m_dungeonDifficulty;
@@ -143,9 +143,11 @@ PlayerSetting Player::GetPlayerSetting(std::string const& source, uint32 index)
 
 void Player::_SavePlayerSettings(CharacterDatabaseTransaction trans)
 {
-    if (!sWorld->getBoolConfig(CONFIG_PLAYER_SETTINGS_ENABLED))
+    if (!sWorld->getBoolConfig(CONFIG_PLAYER_SETTINGS_ENABLED) || !IsSaveSectionChanged(PLAYER_SAVE_SETTINGS))
         return;
 
+    SetSaveSectionWritten(PLAYER_SAVE_SETTINGS);
+
     for (auto const& [source, settings] : m_charSettingsMap)
     {
         if (settings.empty())
@@ -158,6 +160,8 @@ void Player::_SavePlayerSettings(CharacterDatabaseTransaction trans)
 
 void Player::UpdatePlayerSetting(std::string const& source, uint32 index, uint32 value)
 {
+    SetSaveSectionChanged(PLAYER_SAVE_SETTINGS);
+
     auto it = m_charSettingsMap.find(source);
     size_t const requiredSize = static_cast<size_t>(index) + 1;
 
@@ -5142,6 +5142,7 @@ bool Player::LoadFromDB(ObjectGuid playerGuid, CharacterDatabaseQueryHolder cons
                 m_taxi.AddTaxiDestination(m_entryPointData.taxiPath[0]);
                 m_taxi.AddTaxiDestination(m_entryPointData.taxiPath[1]);
                 m_entryPointData.ClearTaxiPath();
+                SetSaveSectionChanged(PLAYER_SAVE_ENTRY_POINT);
             }
         }
     }
@@ -7040,17 +7041,42 @@ bool Player::_LoadHomeBind(PreparedQueryResult result)
 /***                   SAVE SYSTEM                     ***/
 /*********************************************************/
 
+namespace
+{
+    std::array<std::atomic<uint64>, MAX_PLAYER_SAVE_SECTIONS> SaveStatementCounts;
+
+    // shared by all players, so a commit completing after a relog never matches the generations of the new player
+    std::atomic<uint64> SaveSectionGeneration{0};
+}
+
+void Player::SetSaveSectionChanged(PlayerSaveSection section)
+{
+    m_saveSectionGeneration[section] = ++SaveSectionGeneration;
+}
+
 void Player::SaveToDB(bool create, bool logout)
 {
     CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
 
     SaveToDB(trans, create, logout);
 
-    CharacterDatabase.CommitTransaction(trans);
+    // the written sections only count as saved when the commit succeeded, a failed one is retried on the next save
+    WorldSession* session = GetSession();
+    session->AddTransactionCallback(CharacterDatabase.AsyncCommitTransaction(trans)).AfterComplete([session, guid = GetGUID(), written = m_writtenSectionGeneration](bool success)
+    {
+        Player* player = session->GetPlayer();
+        if (!success || !player || player->GetGUID() != guid)
+            return;
+
+        for (uint8 section = 0; section < MAX_PLAYER_SAVE_SECTIONS; ++section)
+            player->m_savedSectionGeneration[section] = std::max(player->m_savedSectionGeneration[section], written[section]);
+    });
 }
 
 void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logout)
 {
+    m_writtenSectionGeneration.fill(0);
+
     // delay auto save at any saves (manual, in code, or autosave)
     m_nextSave = sWorld->getIntConfig(CONFIG_INTERVAL_SAVE);
 
@@ -7074,42 +7100,118 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logo
     if (!create)
         sScriptMgr->OnPlayerSave(this);
 
+    // logout and character creation write every tracked section, periodic saves only the changed ones
+    if (create || logout)
+        for (uint8 section = 0; section < MAX_PLAYER_SAVE_SECTIONS; ++section)
+            SetSaveSectionChanged(PlayerSaveSection(section));
+
+    std::size_t statements = trans->GetSize();
+    auto countStatements = [&](PlayerSaveSection section)
+    {
+        std::size_t const total = trans->GetSize();
+        SaveStatementCounts[section].fetch_add(total - statements, std::memory_order_relaxed);
+        statements = total;
+    };
+
     _SaveCharacter(create, trans);
+    countStatements(PLAYER_SAVE_CHARACTER);
 
     if (m_mailsUpdated)                                     //save mails only when needed
         _SaveMail(trans);
+    countStatements(PLAYER_SAVE_MAIL);
 
     _SaveEntryPoint(trans);
+    countStatements(PLAYER_SAVE_ENTRY_POINT);
     _SaveInventory(trans);
+    countStatements(PLAYER_SAVE_INVENTORY);
     _SaveQuestStatus(trans);
+    countStatements(PLAYER_SAVE_QUEST_STATUS);
     _SaveDailyQuestStatus(trans);
+    countStatements(PLAYER_SAVE_DAILY_QUESTS);
     _SaveWeeklyQuestStatus(trans);
+    countStatements(PLAYER_SAVE_WEEKLY_QUESTS);
     _SaveSeasonalQuestStatus(trans);
+    countStatements(PLAYER_SAVE_SEASONAL_QUESTS);
     _SaveMonthlyQuestStatus(trans);
+    countStatements(PLAYER_SAVE_MONTHLY_QUESTS);
     _SaveTalents(trans);
+    countStatements(PLAYER_SAVE_TALENTS);
     _SaveSpells(trans);
+    countStatements(PLAYER_SAVE_SPELLS);
     _SaveSpellCooldowns(trans, logout);
+    countStatements(PLAYER_SAVE_SPELL_COOLDOWNS);
     _SaveActions(trans);
+    countStatements(PLAYER_SAVE_ACTIONS);
     _SaveAuras(trans, logout);
+    countStatements(PLAYER_SAVE_AURAS);
     _SaveSkills(trans);
+    countStatements(PLAYER_SAVE_SKILLS);
     m_achievementMgr->SaveToDB(trans);
+    countStatements(PLAYER_SAVE_ACHIEVEMENTS);
     m_reputationMgr->SaveToDB(trans);
+    countStatements(PLAYER_SAVE_REPUTATION);
     _SaveEquipmentSets(trans);
+    countStatements(PLAYER_SAVE_EQUIPMENT_SETS);
     GetSession()->SaveTutorialsData(trans);                 // changed only while character in game
+    countStatements(PLAYER_SAVE_TUTORIALS);
     _SaveGlyphs(trans);
+    countStatements(PLAYER_SAVE_GLYPHS);
     _SaveInstanceTimeRestrictions(trans);
+    countStatements(PLAYER_SAVE_INSTANCE_TIMES);
     _SavePlayerSettings(trans);
+    countStatements(PLAYER_SAVE_SETTINGS);
 
     // check if stats should only be saved on logout
     // save stats can be out of transaction
     if (m_session->isLogingOut() || !sWorld->getBoolConfig(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT))
         _SaveStats(trans);
+    countStatements(PLAYER_SAVE_STATS);
 
     // save pet (hunter pet level and experience and all type pets health/mana).
     if (Pet* pet = GetPet())
         pet->SavePetToDB(PET_SAVE_AS_CURRENT);
 }
 
+std::array<uint64, MAX_PLAYER_SAVE_SECTIONS> Player::ConsumeSaveStatementCounts()
+{
+    std::array<uint64, MAX_PLAYER_SAVE_SECTIONS> counts;
+    for (uint8 section = 0; section < MAX_PLAYER_SAVE_SECTIONS; ++section)
+        counts[section] = SaveStatementCounts[section].exchange(0, std::memory_order_relaxed);
+
+    return counts;
+}
+
+char const* Player::GetSaveSectionName(PlayerSaveSection section)
+{
+    switch (section)
+    {
+        case PLAYER_SAVE_CHARACTER:         return "character";
+        case PLAYER_SAVE_MAIL:              return "mail";
+        case PLAYER_SAVE_ENTRY_POINT:       return "entry_point";
+        case PLAYER_SAVE_INVENTORY:         return "inventory";
+        case PLAYER_SAVE_QUEST_STATUS:      return "quest_status";
+        case PLAYER_SAVE_DAILY_QUESTS:      return "daily_quests";
+        case PLAYER_SAVE_WEEKLY_QUESTS:     return "weekly_quests";
+        case PLAYER_SAVE_SEASONAL_QUESTS:   return "seasonal_quests";
+        case PLAYER_SAVE_MONTHLY_QUESTS:    return "monthly_quests";
+        case PLAYER_SAVE_TALENTS:           return "talents";
+        case PLAYER_SAVE_SPELLS:            return "spells";
+        case PLAYER_SAVE_SPELL_COOLDOWNS:   return "spell_cooldowns";
+        case PLAYER_SAVE_ACTIONS:           return "actions";
+        case PLAYER_SAVE_AURAS:             return "auras";
+        case PLAYER_SAVE_SKILLS:            return "skills";
+        case PLAYER_SAVE_ACHIEVEMENTS:      return "achievements";
+        case PLAYER_SAVE_REPUTATION:        return "reputation";
+        case PLAYER_SAVE_EQUIPMENT_SETS:    return "equipment_sets";
+        case PLAYER_SAVE_TUTORIALS:         return "tutorials";
+        case PLAYER_SAVE_GLYPHS:            return "glyphs";
+        case PLAYER_SAVE_INSTANCE_TIMES:    return "instance_times";
+        case PLAYER_SAVE_SETTINGS:          return "settings";
+        case PLAYER_SAVE_STATS:             return "stats";
+        default:                            return "unknown";
+    }
+}
+
 // fast save function for item/money cheating preventing - save only inventory and money state
 void Player::SaveInventoryAndGoldToDB(CharacterDatabaseTransaction trans)
 {
@@ -7175,6 +7277,12 @@ void Player::_SaveActions(CharacterDatabaseTransaction trans)
 
 void Player::_SaveAuras(CharacterDatabaseTransaction trans, bool logout)
 {
+    // remaining durations alone do not mark the auras as changed, they are refreshed with the next change or on logout
+    if (!IsSaveSectionChanged(PLAYER_SAVE_AURAS))
+        return;
+
+    SetSaveSectionWritten(PLAYER_SAVE_AURAS);
+
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
     stmt->SetData(0, GetGUID().GetCounter());
     trans->Append(stmt);
@@ -378,7 +378,10 @@ void Player::Update(uint32 p_time)
              itr != _instanceResetTimes.end();)
         {
             if (itr->second < now)
+            {
                 _instanceResetTimes.erase(itr++);
+                SetSaveSectionChanged(PLAYER_SAVE_INSTANCE_TIMES);
+            }
             else
                 ++itr;
         }
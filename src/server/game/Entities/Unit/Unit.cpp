@@ -4541,6 +4541,9 @@ void Unit::_AddAura(UnitAura* aura, Unit* caster)
     ASSERT(!m_cleanupDone);
     m_ownedAuras.insert(AuraMap::value_type(aura->GetId(), aura));
 
+    if (Player* player = ToPlayer())
+        player->SetSaveSectionChanged(PLAYER_SAVE_AURAS);
+
     _RemoveNoStackAurasDueToAura(aura, true);
 
     if (aura->IsRemoved())
@@ -4820,12 +4823,22 @@ void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
         m_modAuras[aurEff->GetAuraType()].erase(std::remove(m_modAuras[aurEff->GetAuraType()].begin(), m_modAuras[aurEff->GetAuraType()].end(), aurEff), m_modAuras[aurEff->GetAuraType()].end());
 }
 
+Unit::AuraList& Unit::GetSingleCastAuras()
+{
+    // changed by the targets of the auras, which may be far away
+    Map::EnterExclusiveRegionUpdate(this);
+    return m_scAuras;
+}
+
 // All aura base removes should go threw this function!
 void Unit::RemoveOwnedAura(AuraMap::iterator& i, AuraRemoveMode removeMode)
 {
     Aura* aura = i->second;
     ASSERT(!aura->IsRemoved());
 
+    // the caster of a single target aura removes it from any distance
+    Map::EnterExclusiveRegionUpdate(this);
+
     // if unit currently update aura list then make safe update iterator shift to next
     if (m_auraUpdateIterator == i && m_auraUpdateIterator != m_ownedAuras.end())
         ++m_auraUpdateIterator;
@@ -4833,6 +4846,9 @@ void Unit::RemoveOwnedAura(AuraMap::iterator& i, AuraRemoveMode removeMode)
     m_ownedAuras.erase(i);
     m_removedAuras.push_back(aura);
 
+    if (Player* player = ToPlayer())
+        player->SetSaveSectionChanged(PLAYER_SAVE_AURAS);
+
     // Unregister single target aura
     if (aura->IsSingleTarget())
         aura->UnregisterSingleTarget();
@@ -14703,7 +14719,10 @@ void Unit::setDeathState(DeathState s, bool despawn)
 
         // players in instance don't have ZoneScript, but they have InstanceScript
         if (ZoneScript* zoneScript = GetZoneScript() ? GetZoneScript() : (ZoneScript*)GetInstanceScript())
+        {
+            GetMap()->EnterExclusiveRegionUpdate();
             zoneScript->OnUnitDeath(this);
+        }
     }
     else if (s == DeathState::JustRespawned)
     {
@@ -17963,6 +17982,9 @@ void Unit::Kill(Unit* killer, Unit* victim, bool durabilityLoss, WeaponAttackTyp
     if (!victim->GetHealth())
         return;
 
+    // rewards, instance binds, zone scripts, outdoor pvp and battlefields reach objects anywhere on the map
+    victim->GetMap()->EnterExclusiveRegionUpdate();
+
     if (killer && !killer->IsInMap(victim))
         killer = nullptr;
 
@@ -20801,6 +20823,53 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
     if (!target)
         return;
 
+    BuildValuesCachedBuffer const& cacheValue = GetValuesUpdateCache(updateType, target);
+
+    int32 cachePos = static_cast<int32>(data->wpos());
+    data->append(cacheValue.buffer);
+
+    BuildValuesCachePosPointers dataAdjustedPos = cacheValue.posPointers;
+    if (cachePos)
+        dataAdjustedPos.ApplyOffset(cachePos);
+
+    PatchValuesUpdate(*data, dataAdjustedPos, target);
+}
+
+void Unit::BuildSharedValuesUpdate(ByteBuffer* data, Player* target, std::vector<ObserverField>& observerFields)
+{
+    if (!target)
+        return;
+
+    BuildValuesCachedBuffer const& cacheValue = GetValuesUpdateCache(UPDATETYPE_VALUES, target);
+
+    uint32 cachePos = static_cast<uint32>(data->wpos());
+    data->append(cacheValue.buffer);
+
+    // the cached buffer holds the unpatched values, GetObserverFieldValue gives the patched ones
+    auto addObserverField = [&observerFields, cachePos](int32 pos, uint16 index)
+    {
+        if (pos >= 0)
+            observerFields.push_back({ cachePos + uint32(pos), index });
+    };
+
+    BuildValuesCachePosPointers const& posPointers = cacheValue.posPointers;
+    addObserverField(posPointers.UnitNPCFlagsPos, UNIT_NPC_FLAGS);
+    addObserverField(posPointers.UnitFieldAuraStatePos, UNIT_FIELD_AURASTATE);
+    addObserverField(posPointers.UnitFieldFlagsPos, UNIT_FIELD_FLAGS);
+    addObserverField(posPointers.UnitFieldDisplayPos, UNIT_FIELD_DISPLAYID);
+    addObserverField(posPointers.UnitDynamicFlagsPos, UNIT_DYNAMIC_FLAGS);
+    addObserverField(posPointers.UnitFieldBytes2Pos, UNIT_FIELD_BYTES_2);
+    addObserverField(posPointers.UnitFieldFactionTemplatePos, UNIT_FIELD_FACTIONTEMPLATE);
+}
+
+bool Unit::HasObserverDependentValues() const
+{
+    // scripts patch the values in place, they need a buffer of their own for each observer
+    return sScriptMgr->IsPatchingValuesUpdate();
+}
+
+BuildValuesCachedBuffer const& Unit::GetValuesUpdateCache(uint8 updateType, Player* target)
+{
     uint32* flags = UnitUpdateFieldFlags;
     uint32 visibleFlag = UF_FLAG_PUBLIC;
 
@@ -20822,18 +20891,7 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
 
     auto cacheIt = _valuesUpdateCache.find(cacheKey);
     if (cacheIt != _valuesUpdateCache.end())
-    {
-        int32 cachePos = static_cast<int32>(data->wpos());
-        data->append(cacheIt->second.buffer);
-
-        BuildValuesCachePosPointers dataAdjustedPos = cacheIt->second.posPointers;
-        if (cachePos)
-            dataAdjustedPos.ApplyOffset(cachePos);
-
-        PatchValuesUpdate(*data, dataAdjustedPos, target);
-
-        return;
-    }
+        return cacheIt->second;
 
     BuildValuesCachedBuffer cacheValue(500);
 
@@ -20920,158 +20978,164 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
     cacheValue.buffer.append(fieldBuffer);
     cacheValue.posPointers.ApplyOffset(fieldBufferPos);
 
-    int32 cachePos = static_cast<int32>(data->wpos());
-    data->append(cacheValue.buffer);
+    return _valuesUpdateCache.insert(std::pair<uint64, BuildValuesCachedBuffer>(cacheKey, std::move(cacheValue))).first->second;
+}
 
-    BuildValuesCachePosPointers dataAdjustedPos = cacheValue.posPointers;
-    if (cachePos)
-        dataAdjustedPos.ApplyOffset(cachePos);
+void Unit::PatchValuesUpdate(ByteBuffer& valuesUpdateBuf, BuildValuesCachePosPointers& posPointers, Player* target)
+{
+    auto patchField = [&](int32 pos, uint16 index)
+    {
+        if (pos >= 0)
+            valuesUpdateBuf.put(pos, GetObserverFieldValue(index, target));
+    };
 
-    PatchValuesUpdate(*data, dataAdjustedPos, target);
+    patchField(posPointers.UnitNPCFlagsPos, UNIT_NPC_FLAGS);
+    patchField(posPointers.UnitFieldAuraStatePos, UNIT_FIELD_AURASTATE);
+    patchField(posPointers.UnitFieldFlagsPos, UNIT_FIELD_FLAGS);
+    patchField(posPointers.UnitFieldDisplayPos, UNIT_FIELD_DISPLAYID);
+    patchField(posPointers.UnitDynamicFlagsPos, UNIT_DYNAMIC_FLAGS);
+    patchField(posPointers.UnitFieldBytes2Pos, UNIT_FIELD_BYTES_2);
+    patchField(posPointers.UnitFieldFactionTemplatePos, UNIT_FIELD_FACTIONTEMPLATE);
 
-    _valuesUpdateCache.insert(std::pair<uint64, BuildValuesCachedBuffer>(cacheKey, std::move(cacheValue)));
+    sScriptMgr->OnPatchValuesUpdate(this, valuesUpdateBuf, posPointers, target);
 }
 
-void Unit::PatchValuesUpdate(ByteBuffer& valuesUpdateBuf, BuildValuesCachePosPointers& posPointers, Player* target)
+uint32 Unit::GetObserverFieldValue(uint16 index, Player* target)
 {
     Creature const* creature = ToCreature();
 
-    // UNIT_NPC_FLAGS
-    if (creature && posPointers.UnitNPCFlagsPos >= 0)
+    switch (index)
     {
-        uint32 appendValue = m_uint32Values[UNIT_NPC_FLAGS];
-
-        if (sWorld->getIntConfig(CONFIG_INSTANT_TAXI) == 2 && appendValue & UNIT_NPC_FLAG_FLIGHTMASTER)
-            appendValue |= UNIT_NPC_FLAG_GOSSIP; // flight masters need NPC gossip flag to show instant flight toggle option
-
-        if (!target->CanSeeSpellClickOn(creature))
-            appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
-
-        if (!target->CanSeeVendor(creature))
+        case UNIT_NPC_FLAGS:
         {
-            appendValue &= ~UNIT_NPC_FLAG_REPAIR;
-            appendValue &= ~UNIT_NPC_FLAG_VENDOR_MASK;
-        }
+            uint32 appendValue = m_uint32Values[UNIT_NPC_FLAGS];
+            if (!creature)
+                return appendValue;
 
-        if (!creature->IsValidTrainerForPlayer(target, &appendValue))
-            appendValue &= ~UNIT_NPC_FLAG_TRAINER;
+            if (sWorld->getIntConfig(CONFIG_INSTANT_TAXI) == 2 && appendValue & UNIT_NPC_FLAG_FLIGHTMASTER)
+                appendValue |= UNIT_NPC_FLAG_GOSSIP; // flight masters need NPC gossip flag to show instant flight toggle option
 
-        valuesUpdateBuf.put(posPointers.UnitNPCFlagsPos, appendValue);
-    }
+            if (!target->CanSeeSpellClickOn(creature))
+                appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
 
-    // UNIT_FIELD_AURASTATE
-    if (posPointers.UnitFieldAuraStatePos >= 0)
-        valuesUpdateBuf.put(posPointers.UnitFieldAuraStatePos, uint32(BuildAuraStateUpdateForTarget(target)));
+            if (!target->CanSeeVendor(creature))
+            {
+                appendValue &= ~UNIT_NPC_FLAG_REPAIR;
+                appendValue &= ~UNIT_NPC_FLAG_VENDOR_MASK;
+            }
 
-    // UNIT_FIELD_FLAGS
-    if (posPointers.UnitFieldFlagsPos >= 0)
-    {
-        uint32 appendValue = m_uint32Values[UNIT_FIELD_FLAGS];
-        if (target->IsGameMaster() && target->GetSession()->IsGMAccount())
-            appendValue &= ~UNIT_FLAG_NOT_SELECTABLE;
+            if (!creature->IsValidTrainerForPlayer(target, &appendValue))
+                appendValue &= ~UNIT_NPC_FLAG_TRAINER;
 
-        valuesUpdateBuf.put(posPointers.UnitFieldFlagsPos, appendValue);
-    }
+            return appendValue;
+        }
+        case UNIT_FIELD_AURASTATE:
+            return BuildAuraStateUpdateForTarget(target);
+        case UNIT_FIELD_FLAGS:
+        {
+            uint32 appendValue = m_uint32Values[UNIT_FIELD_FLAGS];
+            if (target->IsGameMaster() && target->GetSession()->IsGMAccount())
+                appendValue &= ~UNIT_FLAG_NOT_SELECTABLE;
 
-    // UNIT_FIELD_DISPLAYID
-    // Use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures.
-    if (posPointers.UnitFieldDisplayPos >= 0)
-    {
-        uint32 displayId = m_uint32Values[UNIT_FIELD_DISPLAYID];
-        if (creature)
+            return appendValue;
+        }
+        // Use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures.
+        case UNIT_FIELD_DISPLAYID:
         {
-            CreatureTemplate const* cinfo = creature->GetCreatureTemplate();
+            uint32 displayId = m_uint32Values[UNIT_FIELD_DISPLAYID];
+            if (creature)
+            {
+                CreatureTemplate const* cinfo = creature->GetCreatureTemplate();
 
-            // this also applies for transform auras
-            if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(getTransForm()))
-                for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
-                    if (transform->Effects[i].IsAura(SPELL_AURA_TRANSFORM))
-                        if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(transform->Effects[i].MiscValue))
-                        {
-                            cinfo = transformInfo;
-                            break;
-                        }
+                // this also applies for transform auras
+                if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(getTransForm()))
+                    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+                        if (transform->Effects[i].IsAura(SPELL_AURA_TRANSFORM))
+                            if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(transform->Effects[i].MiscValue))
+                            {
+                                cinfo = transformInfo;
+                                break;
+                            }
 
-            if (cinfo->HasFlagsExtra(CREATURE_FLAG_EXTRA_TRIGGER))
-            {
-                if (target->IsGameMaster() && target->GetSession()->IsGMAccount())
-                    displayId = cinfo->GetFirstVisibleModel()->CreatureDisplayID;
-                else
-                    displayId = cinfo->GetFirstInvisibleModel()->CreatureDisplayID;
+                if (cinfo->HasFlagsExtra(CREATURE_FLAG_EXTRA_TRIGGER))
+                {
+                    if (target->IsGameMaster() && target->GetSession()->IsGMAccount())
+                        displayId = cinfo->GetFirstVisibleModel()->CreatureDisplayID;
+                    else
+                        displayId = cinfo->GetFirstInvisibleModel()->CreatureDisplayID;
+                }
             }
+
+            return displayId;
         }
+        // Hide lootable animation for unallowed players.
+        case UNIT_DYNAMIC_FLAGS:
+        {
+            uint32 dynamicFlags = m_uint32Values[UNIT_DYNAMIC_FLAGS] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
 
-        valuesUpdateBuf.put(posPointers.UnitFieldDisplayPos, uint32(displayId));
-    }
+            if (creature)
+            {
+                if (creature->hasLootRecipient())
+                {
+                    dynamicFlags |= UNIT_DYNFLAG_TAPPED;
+                    if (creature->isTappedBy(target))
+                        dynamicFlags |= UNIT_DYNFLAG_TAPPED_BY_PLAYER;
+                }
 
-    // UNIT_DYNAMIC_FLAGS
-    // Hide lootable animation for unallowed players.
-    if (posPointers.UnitDynamicFlagsPos >= 0)
-    {
-        uint32 dynamicFlags = m_uint32Values[UNIT_DYNAMIC_FLAGS] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
+                if (!target->isAllowedToLoot(creature))
+                    dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
+            }
 
-        if (creature)
+            // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
+            if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
+                if (!HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
+                    dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
+
+            return dynamicFlags;
+        }
+        case UNIT_FIELD_BYTES_2:
         {
-            if (creature->hasLootRecipient())
+            if (IsControlledByPlayer() && target != this && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && IsInRaidWith(target))
+            {
+                FactionTemplateEntry const* ft1 = GetFactionTemplateEntry();
+                FactionTemplateEntry const* ft2 = target->GetFactionTemplateEntry();
+                if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2))
+                    // Allow targetting opposite faction in party when enabled in config
+                    return m_uint32Values[UNIT_FIELD_BYTES_2] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8); // this flag is at uint8 offset 1 !!
+            }// pussywizard / Callmephil
+            else if (target->IsSpectator() && target->FindMap() && target->FindMap()->IsBattleArena() &&
+                        (this->IsPlayer() || this->IsCreature() || this->IsDynamicObject()))
             {
-                dynamicFlags |= UNIT_DYNFLAG_TAPPED;
-                if (creature->isTappedBy(target))
-                    dynamicFlags |= UNIT_DYNFLAG_TAPPED_BY_PLAYER;
+                return m_uint32Values[UNIT_FIELD_BYTES_2] & 0xFFFFF2FF; // clear UNIT_BYTE2_FLAG_PVP, UNIT_BYTE2_FLAG_FFA_PVP, UNIT_BYTE2_FLAG_SANCTUARY
             }
 
-            if (!target->isAllowedToLoot(creature))
-                dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
+            return m_uint32Values[UNIT_FIELD_BYTES_2];
         }
-
-        // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
-        if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
-            if (!HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
-                dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
-
-        valuesUpdateBuf.put(posPointers.UnitDynamicFlagsPos, dynamicFlags);
-    }
-
-    // UNIT_FIELD_BYTES_2
-    if (posPointers.UnitFieldBytes2Pos >= 0)
-    {
-        if (IsControlledByPlayer() && target != this && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && IsInRaidWith(target))
-        {
-            FactionTemplateEntry const* ft1 = GetFactionTemplateEntry();
-            FactionTemplateEntry const* ft2 = target->GetFactionTemplateEntry();
-            if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2))
-                // Allow targetting opposite faction in party when enabled in config
-                valuesUpdateBuf.put(posPointers.UnitFieldBytes2Pos, (m_uint32Values[UNIT_FIELD_BYTES_2] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8))); // this flag is at uint8 offset 1 !!
-        }// pussywizard / Callmephil
-        else if (target->IsSpectator() && target->FindMap() && target->FindMap()->IsBattleArena() &&
-                    (this->IsPlayer() || this->IsCreature() || this->IsDynamicObject()))
+        case UNIT_FIELD_FACTIONTEMPLATE:
         {
-                valuesUpdateBuf.put(posPointers.UnitFieldBytes2Pos, (m_uint32Values[UNIT_FIELD_BYTES_2] & 0xFFFFF2FF)); // clear UNIT_BYTE2_FLAG_PVP, UNIT_BYTE2_FLAG_FFA_PVP, UNIT_BYTE2_FLAG_SANCTUARY
-        }
-    }
+            if (IsControlledByPlayer() && target != this && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && IsInRaidWith(target))
+            {
+                FactionTemplateEntry const* ft1 = GetFactionTemplateEntry();
+                FactionTemplateEntry const* ft2 = target->GetFactionTemplateEntry();
+                if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2))
+                    // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
+                    return target->GetFaction();
+            }// pussywizard / Callmephil
+            else if (target->IsSpectator() && target->FindMap() && target->FindMap()->IsBattleArena() &&
+                        (this->IsPlayer() || this->IsCreature() || this->IsDynamicObject()))
+            {
+                return target->GetFaction();
+            }
+            else if (target->IsGMSpectator() && IsControlledByPlayer())
+            {
+                return target->GetFaction();
+            }
 
-    // UNIT_FIELD_FACTIONTEMPLATE
-    if (posPointers.UnitFieldFactionTemplatePos >= 0)
-    {
-        if (IsControlledByPlayer() && target != this && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && IsInRaidWith(target))
-        {
-            FactionTemplateEntry const* ft1 = GetFactionTemplateEntry();
-            FactionTemplateEntry const* ft2 = target->GetFactionTemplateEntry();
-            if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2))
-                // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
-                valuesUpdateBuf.put(posPointers.UnitFieldFactionTemplatePos, uint32(target->GetFaction()));
-        }// pussywizard / Callmephil
-        else if (target->IsSpectator() && target->FindMap() && target->FindMap()->IsBattleArena() &&
-                    (this->IsPlayer() || this->IsCreature() || this->IsDynamicObject()))
-        {
-            valuesUpdateBuf.put(posPointers.UnitFieldFactionTemplatePos, uint32(target->GetFaction()));
-        }
-        else if (target->IsGMSpectator() && IsControlledByPlayer())
-        {
-            valuesUpdateBuf.put(posPointers.UnitFieldFactionTemplatePos, uint32(target->GetFaction()));
+            return m_uint32Values[UNIT_FIELD_FACTIONTEMPLATE];
         }
+        default:
+            return WorldObject::GetObserverFieldValue(index, target);
     }
-
-    sScriptMgr->OnPatchValuesUpdate(this, valuesUpdateBuf, posPointers, target);
 }
 
 void Unit::BuildCooldownPacket(WorldPacket& data, uint8 flags, uint32 spellId, uint32 cooldown)
@@ -1411,7 +1411,7 @@ public:
     void _ApplyAllAuraStatMods();
 
     [[nodiscard]] AuraEffectList const& GetAuraEffectsByType(AuraType type) const { return m_modAuras[type]; }
-    AuraList&       GetSingleCastAuras()       { return m_scAuras; }
+    AuraList&       GetSingleCastAuras(); // the auras may belong to units anywhere on the map
     [[nodiscard]] AuraList const& GetSingleCastAuras() const { return m_scAuras; }
 
     [[nodiscard]] AuraEffect* GetAuraEffect(uint32 spellId, uint8 effIndex, ObjectGuid casterGUID = ObjectGuid::Empty) const;
@@ -2099,6 +2099,9 @@ protected:
     explicit Unit();
 
     void BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target) override;
+    void BuildSharedValuesUpdate(ByteBuffer* data, Player* target, std::vector<ObserverField>& observerFields) override;
+    uint32 GetObserverFieldValue(uint16 index, Player* target) override;
+    [[nodiscard]] bool HasObserverDependentValues() const override;
 
     void _UpdateSpells(uint32 time);
     void _DeleteRemovedAuras();
@@ -2203,6 +2206,8 @@ private:
     [[nodiscard]] float GetCombatRatingReduction(CombatRating cr) const;
     [[nodiscard]] uint32 GetCombatRatingDamageReduction(CombatRating cr, float rate, float cap, uint32 damage) const;
 
+    // unpatched values update for the visibility flags of target, built once per update type and flags
+    BuildValuesCachedBuffer const& GetValuesUpdateCache(uint8 updateType, Player* target);
     void PatchValuesUpdate(ByteBuffer& valuesUpdateBuf, BuildValuesCachePosPointers& posPointers, Player* target);
     void InvalidateValuesUpdateCache() { _valuesUpdateCache.clear(); }
 
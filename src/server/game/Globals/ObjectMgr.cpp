@@ -51,6 +51,7 @@
 #include "Util.h"
 #include "Vehicle.h"
 #include "World.h"
+#include "WorldSnapshot.h"
 #include <boost/algorithm/string.hpp>
 #include <numeric>
 
@@ -2254,15 +2255,32 @@ void ObjectMgr::LoadCreatures()
 {
     uint32 oldMSTime = getMSTime();
 
-    //                                                     0         1    2    3    4        5            6           7           8            9              10            11
-    QueryResult result = WorldDatabase.Query("SELECT creature.guid, id1, id2, id3, map, equipment_id, position_x, position_y, position_z, orientation, spawntimesecs, wander_distance, "
-                         //      12            13       14          15           16         17         18          19             20                 21                    22
-                         "currentwaypoint, curhealth, curmana, MovementType, spawnMask, phaseMask, eventEntry, pool_entry, creature.npcflag, creature.unit_flags, creature.dynamicflags, "
-                         //       23
-                         "creature.ScriptName "
-                         "FROM creature "
-                         "LEFT OUTER JOIN game_event_creature ON creature.guid = game_event_creature.guid "
-                         "LEFT OUTER JOIN pool_creature ON creature.guid = pool_creature.guid");
+    // spawns only depend on these tables, the checks against DBC data are covered by the core revision
+    WorldSnapshot snapshot("creature", { "creature", "creature_template", "creature_equip_template", "game_event_creature", "pool_creature" }, {}, true);
+    bool const useSnapshot = snapshot.IsEnabled() && !sWorld->getBoolConfig(CONFIG_CALCULATE_CREATURE_ZONE_AREA_DATA);
+
+    std::vector<CreatureSnapshotRecord> snapshotRecords;
+    if (useSnapshot && snapshot.Load(snapshotRecords))
+    {
+        _creatureDataStore.rehash(snapshotRecords.size());
+        for (CreatureSnapshotRecord const& record : snapshotRecords)
+        {
+            CreatureData& data = _creatureDataStore[record.SpawnId];
+            data = record.Data;
+            if (record.OnGrid)
+                AddCreatureToGrid(record.SpawnId, &data);
+        }
+
+        LOG_INFO("server.loading", ">> Loaded {} Creatures from snapshot in {} ms", snapshotRecords.size(), GetMSTimeDiffToNow(oldMSTime));
+        LOG_INFO("server.loading", " ");
+        return;
+    }
+
+    //       0              1    2    3    4    5             6           7           8           9            10             11
+    // SELECT creature.guid, id1, id2, id3, map, equipment_id, position_x, position_y, position_z, orientation, spawntimesecs, wander_distance,
+    //       12               13         14       15            16         17         18          19          20                21                   22                     23
+    //        currentwaypoint, curhealth, curmana, MovementType, spawnMask, phaseMask, eventEntry, pool_entry, creature.npcflag, creature.unit_flags, creature.dynamicflags, creature.ScriptName
+    PreparedBulkQueryResult result = WorldDatabase.BulkQuery(WorldDatabase.GetPreparedStatement(WORLD_SEL_CREATURES));
 
     if (!result)
     {
@@ -2282,16 +2300,38 @@ void ObjectMgr::LoadCreatures()
                 if (GetMapDifficultyData(i, Difficulty(k)))
                     spawnMasks[i] |= (1 << k);
 
+    std::span<uint32 const> spawnIds        = result->FetchColumn<uint32>(0);
+    std::span<uint32 const> ids1            = result->FetchColumn<uint32>(1);
+    std::span<uint32 const> ids2            = result->FetchColumn<uint32>(2);
+    std::span<uint32 const> ids3            = result->FetchColumn<uint32>(3);
+    std::span<uint16 const> mapIds          = result->FetchColumn<uint16>(4);
+    std::span<int8 const> equipmentIds      = result->FetchColumn<int8>(5);
+    std::span<float const> positionsX       = result->FetchColumn<float>(6);
+    std::span<float const> positionsY       = result->FetchColumn<float>(7);
+    std::span<float const> positionsZ       = result->FetchColumn<float>(8);
+    std::span<float const> orientations     = result->FetchColumn<float>(9);
+    std::span<uint32 const> spawnTimes      = result->FetchColumn<uint32>(10);
+    std::span<float const> wanderDistances  = result->FetchColumn<float>(11);
+    std::span<uint32 const> waypoints       = result->FetchColumn<uint32>(12);
+    std::span<uint32 const> healths         = result->FetchColumn<uint32>(13);
+    std::span<uint32 const> manas           = result->FetchColumn<uint32>(14);
+    std::span<uint8 const> movementTypes    = result->FetchColumn<uint8>(15);
+    std::span<uint8 const> spawnMaskValues  = result->FetchColumn<uint8>(16);
+    std::span<uint32 const> phaseMasks      = result->FetchColumn<uint32>(17);
+    std::span<int16 const> gameEvents       = result->FetchColumn<int16>(18);
+    std::span<uint32 const> poolIds         = result->FetchColumn<uint32>(19);
+    std::span<uint32 const> npcFlags        = result->FetchColumn<uint32>(20);
+    std::span<uint32 const> unitFlags       = result->FetchColumn<uint32>(21);
+    std::span<uint32 const> dynamicFlags    = result->FetchColumn<uint32>(22);
+
     _creatureDataStore.rehash(result->GetRowCount());
     uint32 count = 0;
-    do
+    for (uint64 row = 0; row < result->GetRowCount(); ++row)
     {
-        Field* fields = result->Fetch();
-
-        ObjectGuid::LowType spawnId     = fields[0].Get<uint32>();
-        uint32 id1                      = fields[1].Get<uint32>();
-        uint32 id2                      = fields[2].Get<uint32>();
-        uint32 id3                      = fields[3].Get<uint32>();
+        ObjectGuid::LowType spawnId     = spawnIds[row];
+        uint32 id1                      = ids1[row];
+        uint32 id2                      = ids2[row];
+        uint32 id3                      = ids3[row];
 
         CreatureTemplate const* cInfo = GetCreatureTemplate(id1);
         if (!cInfo)
@@ -2320,26 +2360,26 @@ void ObjectMgr::LoadCreatures()
         data.id1                = id1;
         data.id2                = id2;
         data.id3                = id3;
-        data.mapid              = fields[4].Get<uint16>();
-        data.equipmentId        = fields[5].Get<int8>();
-        data.posX               = fields[6].Get<float>();
-        data.posY               = fields[7].Get<float>();
-        data.posZ               = fields[8].Get<float>();
-        data.orientation        = fields[9].Get<float>();
-        data.spawntimesecs      = fields[10].Get<uint32>();
-        data.wander_distance    = fields[11].Get<float>();
-        data.currentwaypoint    = fields[12].Get<uint32>();
-        data.curhealth          = fields[13].Get<uint32>();
-        data.curmana            = fields[14].Get<uint32>();
-        data.movementType       = fields[15].Get<uint8>();
-        data.spawnMask          = fields[16].Get<uint8>();
-        data.phaseMask          = fields[17].Get<uint32>();
-        int16 gameEvent         = fields[18].Get<int16>();
-        uint32 PoolId           = fields[19].Get<uint32>();
-        data.npcflag            = fields[20].Get<uint32>();
-        data.unit_flags         = fields[21].Get<uint32>();
-        data.dynamicflags       = fields[22].Get<uint32>();
-        data.ScriptId           = GetScriptId(fields[23].Get<std::string>());
+        data.mapid              = mapIds[row];
+        data.equipmentId        = equipmentIds[row];
+        data.posX               = positionsX[row];
+        data.posY               = positionsY[row];
+        data.posZ               = positionsZ[row];
+        data.orientation        = orientations[row];
+        data.spawntimesecs      = spawnTimes[row];
+        data.wander_distance    = wanderDistances[row];
+        data.currentwaypoint    = waypoints[row];
+        data.curhealth          = healths[row];
+        data.curmana            = manas[row];
+        data.movementType       = movementTypes[row];
+        data.spawnMask          = spawnMaskValues[row];
+        data.phaseMask          = phaseMasks[row];
+        int16 gameEvent         = gameEvents[row];
+        uint32 PoolId           = poolIds[row];
+        data.npcflag            = npcFlags[row];
+        data.unit_flags         = unitFlags[row];
+        data.dynamicflags       = dynamicFlags[row];
+        data.ScriptId           = GetScriptId(result->GetString(row, 23));
 
         if (!data.ScriptId)
             data.ScriptId = cInfo->ScriptID;
@@ -2434,15 +2474,21 @@ void ObjectMgr::LoadCreatures()
             stmt->SetData(1, areaId);
             stmt->SetData(2, spawnId);
 
-            WorldDatabase.Execute(stmt);
+            WorldDatabase.Execute(stmt, DatabaseLane::Bulk);
         }
 
         // Add to grid if not managed by the game event or pool system
         if (gameEvent == 0 && PoolId == 0)
             AddCreatureToGrid(spawnId, &data);
 
+        if (useSnapshot)
+            snapshotRecords.push_back({ spawnId, gameEvent == 0 && PoolId == 0, data });
+
         ++count;
-    } while (result->NextRow());
+    }
+
+    if (useSnapshot)
+        snapshot.Save(snapshotRecords);
 
     LOG_INFO("server.loading", ">> Loaded {} Creatures in {} ms", count, GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("server.loading", " ");
@@ -2622,14 +2668,31 @@ void ObjectMgr::LoadGameobjects()
 {
     uint32 oldMSTime = getMSTime();
 
-    //                                                0                1   2    3           4           5           6
-    QueryResult result = WorldDatabase.Query("SELECT gameobject.guid, id, map, position_x, position_y, position_z, orientation, "
-                         //   7          8          9          10         11             12            13     14         15         16          17
-                         "rotation0, rotation1, rotation2, rotation3, spawntimesecs, animprogress, state, spawnMask, phaseMask, eventEntry, pool_entry, "
-                         //   18
-                         "ScriptName "
-                         "FROM gameobject LEFT OUTER JOIN game_event_gameobject ON gameobject.guid = game_event_gameobject.guid "
-                         "LEFT OUTER JOIN pool_gameobject ON gameobject.guid = pool_gameobject.guid");
+    WorldSnapshot snapshot("gameobject", { "gameobject", "gameobject_template", "game_event_gameobject", "pool_gameobject" }, {}, true);
+    bool const useSnapshot = snapshot.IsEnabled() && !sWorld->getBoolConfig(CONFIG_CALCULATE_GAMEOBJECT_ZONE_AREA_DATA);
+
+    std::vector<GameObjectSnapshotRecord> snapshotRecords;
+    if (useSnapshot && snapshot.Load(snapshotRecords))
+    {
+        _gameObjectDataStore.rehash(snapshotRecords.size());
+        for (GameObjectSnapshotRecord const& record : snapshotRecords)
+        {
+            GameObjectData& data = _gameObjectDataStore[record.SpawnId];
+            data = record.Data;
+            if (record.OnGrid)
+                AddGameobjectToGrid(record.SpawnId, &data);
+        }
+
+        LOG_INFO("server.loading", ">> Loaded {} Gameobjects from snapshot in {} ms", snapshotRecords.size(), GetMSTimeDiffToNow(oldMSTime));
+        LOG_INFO("server.loading", " ");
+        return;
+    }
+
+    //       0                1   2    3           4           5           6            7          8          9          10
+    // SELECT gameobject.guid, id, map, position_x, position_y, position_z, orientation, rotation0, rotation1, rotation2, rotation3,
+    //       11             12            13     14         15         16          17          18
+    //        spawntimesecs, animprogress, state, spawnMask, phaseMask, eventEntry, pool_entry, ScriptName
+    PreparedBulkQueryResult result = WorldDatabase.BulkQuery(WorldDatabase.GetPreparedStatement(WORLD_SEL_GAMEOBJECTS));
 
     if (!result)
     {
@@ -2649,13 +2712,30 @@ void ObjectMgr::LoadGameobjects()
                 if (GetMapDifficultyData(i, Difficulty(k)))
                     spawnMasks[i] |= (1 << k);
 
+    std::span<uint32 const> guids           = result->FetchColumn<uint32>(0);
+    std::span<uint32 const> entries         = result->FetchColumn<uint32>(1);
+    std::span<uint16 const> mapIds          = result->FetchColumn<uint16>(2);
+    std::span<float const> positionsX       = result->FetchColumn<float>(3);
+    std::span<float const> positionsY       = result->FetchColumn<float>(4);
+    std::span<float const> positionsZ       = result->FetchColumn<float>(5);
+    std::span<float const> orientations     = result->FetchColumn<float>(6);
+    std::span<float const> rotations0       = result->FetchColumn<float>(7);
+    std::span<float const> rotations1       = result->FetchColumn<float>(8);
+    std::span<float const> rotations2       = result->FetchColumn<float>(9);
+    std::span<float const> rotations3       = result->FetchColumn<float>(10);
+    std::span<int32 const> spawnTimes       = result->FetchColumn<int32>(11);
+    std::span<uint8 const> animProgresses   = result->FetchColumn<uint8>(12);
+    std::span<uint8 const> states           = result->FetchColumn<uint8>(13);
+    std::span<uint8 const> spawnMaskValues  = result->FetchColumn<uint8>(14);
+    std::span<uint32 const> phaseMasks      = result->FetchColumn<uint32>(15);
+    std::span<int16 const> gameEvents       = result->FetchColumn<int16>(16);
+    std::span<uint32 const> poolIds         = result->FetchColumn<uint32>(17);
+
     _gameObjectDataStore.rehash(result->GetRowCount());
-    do
+    for (uint64 row = 0; row < result->GetRowCount(); ++row)
     {
-        Field* fields = result->Fetch();
-
-        ObjectGuid::LowType guid    = fields[0].Get<uint32>();
-        uint32 entry                = fields[1].Get<uint32>();
+        ObjectGuid::LowType guid    = guids[row];
+        uint32 entry                = entries[row];
 
         GameObjectTemplate const* gInfo = GetGameObjectTemplate(entry);
         if (!gInfo)
@@ -2686,17 +2766,17 @@ void ObjectMgr::LoadGameobjects()
         GameObjectData& data = _gameObjectDataStore[guid];
 
         data.id             = entry;
-        data.mapid          = fields[2].Get<uint16>();
-        data.posX           = fields[3].Get<float>();
-        data.posY           = fields[4].Get<float>();
-        data.posZ           = fields[5].Get<float>();
-        data.orientation    = fields[6].Get<float>();
-        data.rotation.x     = fields[7].Get<float>();
-        data.rotation.y     = fields[8].Get<float>();
-        data.rotation.z     = fields[9].Get<float>();
-        data.rotation.w     = fields[10].Get<float>();
-        data.spawntimesecs  = fields[11].Get<int32>();
-        data.ScriptId       = GetScriptId(fields[18].Get<std::string>());
+        data.mapid          = mapIds[row];
+        data.posX           = positionsX[row];
+        data.posY           = positionsY[row];
+        data.posZ           = positionsZ[row];
+        data.orientation    = orientations[row];
+        data.rotation.x     = rotations0[row];
+        data.rotation.y     = rotations1[row];
+        data.rotation.z     = rotations2[row];
+        data.rotation.w     = rotations3[row];
+        data.spawntimesecs  = spawnTimes[row];
+        data.ScriptId       = GetScriptId(result->GetString(row, 18));
         if (!data.ScriptId)
             data.ScriptId = gInfo->ScriptId;
 
@@ -2712,10 +2792,10 @@ void ObjectMgr::LoadGameobjects()
             LOG_ERROR("sql.sql", "Table `gameobject` has gameobject (GUID: {} Entry: {}) with `spawntimesecs` (0) value, but the gameobejct is marked as despawnable at action.", guid, data.id);
         }
 
-        data.animprogress   = fields[12].Get<uint8>();
+        data.animprogress   = animProgresses[row];
         data.artKit         = 0;
 
-        uint32 go_state     = fields[13].Get<uint8>();
+        uint32 go_state     = states[row];
         if (go_state >= MAX_GO_STATE)
         {
             LOG_ERROR("sql.sql", "Table `gameobject` has gameobject (GUID: {} Entry: {}) with invalid `state` ({}) value, skip", guid, data.id, go_state);
@@ -2723,14 +2803,14 @@ void ObjectMgr::LoadGameobjects()
         }
         data.go_state       = GOState(go_state);
 
-        data.spawnMask      = fields[14].Get<uint8>();
+        data.spawnMask      = spawnMaskValues[row];
 
         if (!_transportMaps.count(data.mapid) && data.spawnMask & ~spawnMasks[data.mapid])
             LOG_ERROR("sql.sql", "Table `gameobject` has gameobject (GUID: {} Entry: {}) that has wrong spawn mask {} including not supported difficulty modes for map (Id: {}), skip", guid, data.id, data.spawnMask, data.mapid);
 
-        data.phaseMask      = fields[15].Get<uint32>();
-        int16 gameEvent     = fields[16].Get<int16>();
-        uint32 PoolId        = fields[17].Get<uint32>();
+        data.phaseMask      = phaseMasks[row];
+        int16 gameEvent     = gameEvents[row];
+        uint32 PoolId        = poolIds[row];
 
         if (data.rotation.x < -1.0f || data.rotation.x > 1.0f)
         {
@@ -2779,12 +2859,18 @@ void ObjectMgr::LoadGameobjects()
             stmt->SetData(1, areaId);
             stmt->SetData(2, guid);
 
-            WorldDatabase.Execute(stmt);
+            WorldDatabase.Execute(stmt, DatabaseLane::Bulk);
         }
 
         if (gameEvent == 0 && PoolId == 0)                      // if not this is to be managed by GameEvent System or Pool system
             AddGameobjectToGrid(guid, &data);
-    } while (result->NextRow());
+
+        if (useSnapshot)
+            snapshotRecords.push_back({ guid, gameEvent == 0 && PoolId == 0, data });
+    }
+
+    if (useSnapshot)
+        snapshot.Save(snapshotRecords);
 
     LOG_INFO("server.loading", ">> Loaded {} Gameobjects in {} ms", (unsigned long)_gameObjectDataStore.size(), GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("server.loading", " ");
@@ -2874,6 +2960,29 @@ void ObjectMgr::LoadItemTemplates()
 {
     uint32 oldMSTime = getMSTime();
 
+    // prices are multiplied by the rates while loading
+    std::string snapshotOptions = Acore::StringFormat("{}", sWorld->getBoolConfig(CONFIG_DBC_ENFORCE_ITEM_ATTRIBUTES));
+    for (uint8 quality = 0; quality < MAX_ITEM_QUALITY; ++quality)
+        snapshotOptions += Acore::StringFormat(" {} {}", sWorld->getRate(qualityToBuyValueConfig[quality]), sWorld->getRate(qualityToSellValueConfig[quality]));
+
+    // the checks below also drop the spells missing from the spell store unless they are disabled
+    WorldSnapshot snapshot("item_template", { "item_template", "disables", "spell_dbc" }, snapshotOptions, true);
+
+    std::vector<ItemTemplate> snapshotRecords;
+    if (snapshot.Load(snapshotRecords))
+    {
+        _itemTemplateStore.reserve(snapshotRecords.size());
+        for (ItemTemplate& record : snapshotRecords)
+            _itemTemplateStore.emplace(record.ItemId, std::move(record));
+
+        IndexItemTemplates();
+        CheckCharStartOutfitItems();
+
+        LOG_INFO("server.loading", ">> Loaded {} Item Templates from snapshot in {} ms", snapshotRecords.size(), GetMSTimeDiffToNow(oldMSTime));
+        LOG_INFO("server.loading", " ");
+        return;
+    }
+
     //                                                 0      1       2               3              4        5        6       7          8         9        10        11           12
     QueryResult result = WorldDatabase.Query("SELECT entry, class, subclass, SoundOverrideSubclass, name, displayid, Quality, Flags, FlagsExtra, BuyCount, BuyPrice, SellPrice, InventoryType, "
                          //     13              14           15          16             17               18                19              20
@@ -3426,38 +3535,29 @@ void ObjectMgr::LoadItemTemplates()
         itemTemplate.BuyPrice *= sWorld->getRate(qualityToBuyValueConfig[itemTemplate.Quality]);
         itemTemplate.SellPrice *= sWorld->getRate(qualityToSellValueConfig[itemTemplate.Quality]);
 
-        // Fill categories map
-        for (uint8 i = 0; i < MAX_ITEM_PROTO_SPELLS; ++i)
-            if (itemTemplate.Spells[i].SpellId && itemTemplate.Spells[i].SpellCategory && itemTemplate.Spells[i].SpellCategoryCooldown)
-            {
-                SpellCategoryStore::iterator ct = sSpellsByCategoryStore.find(itemTemplate.Spells[i].SpellCategory);
-                if (ct != sSpellsByCategoryStore.end())
-                {
-                    ct->second.emplace(true, itemTemplate.Spells[i].SpellId);
-                }
-                else
-                    sSpellsByCategoryStore[itemTemplate.Spells[i].SpellCategory].emplace(true, itemTemplate.Spells[i].SpellId);
-            }
-
         ++count;
     } while (result->NextRow());
 
-    // pussywizard:
+    IndexItemTemplates();
+
+    if (snapshot.IsEnabled())
     {
-        uint32 max = 0;
-        for (ItemTemplateContainer::const_iterator itr = _itemTemplateStore.begin(); itr != _itemTemplateStore.end(); ++itr)
-            if (itr->first > max)
-                max = itr->first;
-        if (max)
-        {
-            _itemTemplateStoreFast.clear();
-            _itemTemplateStoreFast.resize(max + 1, nullptr);
-            for (ItemTemplateContainer::iterator itr = _itemTemplateStore.begin(); itr != _itemTemplateStore.end(); ++itr)
-                _itemTemplateStoreFast[itr->first] = &(itr->second);
-        }
+        snapshotRecords.reserve(_itemTemplateStore.size());
+        for (auto const& [entry, itemTemplate] : _itemTemplateStore)
+            snapshotRecords.push_back(itemTemplate);
+
+        snapshot.Save(snapshotRecords);
     }
 
-    // Check if item templates for DBC referenced character start outfit are present
+    CheckCharStartOutfitItems();
+
+    LOG_INFO("server.loading", ">> Loaded {} Item Templates in {} ms", count, GetMSTimeDiffToNow(oldMSTime));
+    LOG_INFO("server.loading", " ");
+}
+
+// Check if item templates for DBC referenced character start outfit are present
+void ObjectMgr::CheckCharStartOutfitItems()
+{
     std::set<uint32> notFoundOutfit;
     for (uint32 i = 1; i < sCharStartOutfitStore.GetNumRows(); ++i)
     {
@@ -3479,9 +3579,30 @@ void ObjectMgr::LoadItemTemplates()
 
     for (std::set<uint32>::const_iterator itr = notFoundOutfit.begin(); itr != notFoundOutfit.end(); ++itr)
         LOG_ERROR("sql.sql", "Item (Entry: {}) does not exist in `item_template` but is referenced in `CharStartOutfit.dbc`", *itr);
+}
 
-    LOG_INFO("server.loading", ">> Loaded {} Item Templates in {} ms", count, GetMSTimeDiffToNow(oldMSTime));
-    LOG_INFO("server.loading", " ");
+void ObjectMgr::IndexItemTemplates()
+{
+    // pussywizard:
+    {
+        uint32 max = 0;
+        for (ItemTemplateContainer::const_iterator itr = _itemTemplateStore.begin(); itr != _itemTemplateStore.end(); ++itr)
+            if (itr->first > max)
+                max = itr->first;
+        if (max)
+        {
+            _itemTemplateStoreFast.clear();
+            _itemTemplateStoreFast.resize(max + 1, nullptr);
+            for (ItemTemplateContainer::iterator itr = _itemTemplateStore.begin(); itr != _itemTemplateStore.end(); ++itr)
+                _itemTemplateStoreFast[itr->first] = &(itr->second);
+        }
+    }
+
+    // Fill categories map
+    for (auto const& [entry, itemTemplate] : _itemTemplateStore)
+        for (uint8 i = 0; i < MAX_ITEM_PROTO_SPELLS; ++i)
+            if (itemTemplate.Spells[i].SpellId && itemTemplate.Spells[i].SpellCategory && itemTemplate.Spells[i].SpellCategoryCooldown)
+                sSpellsByCategoryStore[itemTemplate.Spells[i].SpellCategory].emplace(true, itemTemplate.Spells[i].SpellId);
 }
 
 ItemTemplate const* ObjectMgr::GetItemTemplate(uint32 entry)
@@ -4632,6 +4753,30 @@ void ObjectMgr::LoadQuests()
 
     mExclusiveQuestGroups.clear();
 
+    // the checks below use these tables, the spells and the max skill value
+    WorldSnapshot snapshot("quest_template", { "quest_template", "quest_details", "quest_request_items", "quest_offer_reward", "quest_template_addon",
+        "quest_mail_sender", "disables", "item_template", "creature_template", "gameobject_template", "spell_dbc" },
+        Acore::StringFormat("{}", sWorld->GetConfigMaxSkillValue()));
+
+    std::vector<std::unique_ptr<Quest>> snapshotRecords;
+    if (snapshot.Load(snapshotRecords))
+    {
+        for (std::unique_ptr<Quest>& record : snapshotRecords)
+        {
+            Quest* quest = record.release();
+            _questTemplates[quest->GetQuestId()] = quest;
+
+            if (quest->ExclusiveGroup && !sDisableMgr->IsDisabledFor(DISABLE_TYPE_QUEST, quest->GetQuestId(), nullptr))
+                mExclusiveQuestGroups.insert(std::pair<int32, uint32>(quest->ExclusiveGroup, quest->GetQuestId()));
+        }
+
+        IndexQuests();
+
+        LOG_INFO("server.loading", ">> Loaded {} Quests Definitions from snapshot in {} ms", (unsigned long)_questTemplates.size(), GetMSTimeDiffToNow(oldMSTime));
+        LOG_INFO("server.loading", " ");
+        return;
+    }
+
     QueryResult result = WorldDatabase.Query("SELECT "
                          //0      1         2           3           4           5             6                 7            8
                          "ID, QuestType, QuestLevel, MinLevel, QuestSortID, QuestInfoID, SuggestedGroupNum, TimeAllowed, AllowableRaces,"
@@ -4678,20 +4823,7 @@ void ObjectMgr::LoadQuests()
         _questTemplates[newQuest->GetQuestId()] = newQuest;
     } while (result->NextRow());
 
-    // pussywizard:
-    {
-        uint32 max = 0;
-        for (QuestMap::const_iterator itr = _questTemplates.begin(); itr != _questTemplates.end(); ++itr)
-            if (itr->first > max)
-                max = itr->first;
-        if (max)
-        {
-            _questTemplatesFast.clear();
-            _questTemplatesFast.resize(max + 1, nullptr);
-            for (QuestMap::iterator itr = _questTemplates.begin(); itr != _questTemplates.end(); ++itr)
-                _questTemplatesFast[itr->first] = itr->second;
-        }
-    }
+    IndexQuests();
 
     for (QuestMap::iterator itr = _questTemplates.begin(); itr != _questTemplates.end(); ++itr)
         itr->second->InitializeQueryData();
@@ -5354,6 +5486,16 @@ void ObjectMgr::LoadQuests()
             qinfo->SetSpecialFlag(QUEST_SPECIAL_FLAGS_PLAYER_KILL);
     }
 
+    if (snapshot.IsEnabled())
+    {
+        std::vector<Quest const*> quests;
+        quests.reserve(_questTemplates.size());
+        for (auto const& [questId, quest] : _questTemplates)
+            quests.push_back(quest);
+
+        snapshot.Save(quests);
+    }
+
     // check QUEST_SPECIAL_FLAGS_EXPLORATION_OR_EVENT for spell with SPELL_EFFECT_QUEST_COMPLETE
     for (uint32 i = 0; i < sSpellMgr->GetSpellInfoStoreSize(); ++i)
     {
@@ -5389,6 +5531,22 @@ void ObjectMgr::LoadQuests()
     LOG_INFO("server.loading", " ");
 }
 
+void ObjectMgr::IndexQuests()
+{
+    // pussywizard:
+    uint32 max = 0;
+    for (QuestMap::const_iterator itr = _questTemplates.begin(); itr != _questTemplates.end(); ++itr)
+        if (itr->first > max)
+            max = itr->first;
+    if (max)
+    {
+        _questTemplatesFast.clear();
+        _questTemplatesFast.resize(max + 1, nullptr);
+        for (QuestMap::iterator itr = _questTemplates.begin(); itr != _questTemplates.end(); ++itr)
+            _questTemplatesFast[itr->first] = itr->second;
+    }
+}
+
 void ObjectMgr::LoadQuestLocales()
 {
     uint32 oldMSTime = getMSTime();
@@ -1541,6 +1541,11 @@ private:
 
 private:
     void LoadScripts(ScriptsType type);
+    // lookups over the loaded stores, for the database and snapshot loads
+    void IndexItemTemplates();
+    void IndexQuests();
+    // reports of the database load, also run when the store is loaded from a snapshot
+    void CheckCharStartOutfitItems();
     void LoadQuestRelationsHelper(QuestRelations& map, std::string const& table, bool starter, bool go);
     void PlayerCreateInfoAddItemHelper(uint32 race_, uint32 class_, uint32 itemId, int32 count);
 
@@ -0,0 +1,555 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WorldSnapshot.h"
+#include "DatabaseEnv.h"
+#include "GitRevision.h"
+#include "Log.h"
+#include "ObjectMgr.h"
+#include "QueryResult.h"
+#include "QuestDef.h"
+#include "World.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+    constexpr uint32 SNAPSHOT_MAGIC = 0x50534341; // 'ACSP'
+    constexpr uint32 SNAPSHOT_VERSION = 2;
+
+    // magic, version, digest and payload size
+    constexpr std::size_t SNAPSHOT_HEADER_SIZE = 4 + 4 + WorldSnapshot::Digest().size() + 8;
+
+    // length prefixed, strings from the database are not always valid UTF-8
+    void WriteString(ByteBuffer& data, std::string const& value)
+    {
+        data << uint32(value.size());
+        data.append(value.data(), value.size());
+    }
+
+    void ReadString(ByteBuffer& data, std::string& value)
+    {
+        uint32 length = data.read<uint32>();
+        if (length > data.size() - data.rpos())
+            throw ByteBufferException();
+
+        value.resize(length);
+        if (length)
+            data.read(reinterpret_cast<uint8*>(value.data()), length);
+    }
+
+    template<class T, std::size_t Size>
+    void WriteArray(ByteBuffer& data, T const (&values)[Size])
+    {
+        for (T const& value : values)
+            data << value;
+    }
+
+    template<class T, std::size_t Size>
+    void ReadArray(ByteBuffer& data, T (&values)[Size])
+    {
+        for (T& value : values)
+            value = data.read<T>();
+    }
+
+    // CHECKSUM TABLE returns a NULL checksum, read as an empty string, for tables that do not exist
+    void UpdateTableChecksums(Acore::Crypto::SHA1& hash, std::string const& tableList)
+    {
+        if (tableList.empty())
+            return;
+
+        if (QueryResult result = WorldDatabase.Query("CHECKSUM TABLE {}", tableList))
+        {
+            do
+            {
+                Field* fields = result->Fetch();
+                hash.UpdateData(fields[0].Get<std::string>());
+                hash.UpdateData("\n");
+                hash.UpdateData(fields[1].Get<std::string>());
+            } while (result->NextRow());
+        }
+    }
+
+    // The DBC files, localized ones included, and the world database tables overriding them.
+    // Validation reads the DBC stores, so every snapshot depends on them. Hashed once, they do not change while running.
+    WorldSnapshot::Digest const& GetDBCDigest()
+    {
+        static WorldSnapshot::Digest const digest = []()
+        {
+            std::vector<std::filesystem::path> files;
+            std::error_code error;
+            for (std::filesystem::directory_entry const& entry : std::filesystem::recursive_directory_iterator(sWorld->GetDataPath() + "dbc/", error))
+                if (entry.is_regular_file())
+                    files.push_back(entry.path());
+
+            std::sort(files.begin(), files.end());
+
+            Acore::Crypto::SHA1 hash;
+            std::vector<uint8> buffer(1 << 16);
+            for (std::filesystem::path const& path : files)
+            {
+                hash.UpdateData(path.lexically_relative(sWorld->GetDataPath()).generic_string());
+                hash.UpdateData("\n");
+
+                uint64 size = 0;
+                std::ifstream file(path, std::ios::binary);
+                while (file)
+                {
+                    file.read(reinterpret_cast<char*>(buffer.data()), buffer.size());
+                    std::size_t const read = std::size_t(file.gcount());
+                    hash.UpdateData(buffer.data(), read);
+                    size += read;
+                }
+
+                hash.UpdateData(std::to_string(size));
+                hash.UpdateData("\n");
+            }
+
+            std::string tableList;
+            if (QueryResult result = WorldDatabase.Query("SELECT TABLE_NAME FROM information_schema.TABLES WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME LIKE '%\\_dbc' ORDER BY TABLE_NAME"))
+            {
+                do
+                {
+                    if (!tableList.empty())
+                        tableList += ", ";
+
+                    tableList += (*result)[0].Get<std::string>();
+                } while (result->NextRow());
+            }
+
+            UpdateTableChecksums(hash, tableList);
+
+            hash.Finalize();
+            return hash.GetDigest();
+        }();
+
+        return digest;
+    }
+}
+
+WorldSnapshot::WorldSnapshot(std::string name, std::initializer_list<char const*> tables, std::string_view options, bool scriptIds)
+{
+    std::string_view path = sWorld->getStringConfig(CONFIG_STARTUP_SNAPSHOT_PATH);
+    if (path.empty())
+        return;
+
+    _path = (std::filesystem::path(path) / (name + ".snapshot")).string();
+
+    Acore::Crypto::SHA1 hash;
+    hash.UpdateData(name);
+    hash.UpdateData("\n");
+    hash.UpdateData(options);
+    hash.UpdateData("\n");
+    UpdateDigest(hash, tables, scriptIds);
+    hash.Finalize();
+    _digest = hash.GetDigest();
+}
+
+WorldSnapshot::WorldSnapshot(std::string path, Digest const& digest) : _path(std::move(path)), _digest(digest) { }
+
+void WorldSnapshot::UpdateDigest(Acore::Crypto::SHA1& hash, std::initializer_list<char const*> tables, bool scriptIds)
+{
+    hash.UpdateData(GitRevision::GetHash());
+    hash.UpdateData(GetDBCDigest());
+
+    // stores reference scripts by their index in the sorted script name list
+    if (scriptIds)
+    {
+        for (std::string const& scriptName : sObjectMgr->GetScriptNames())
+        {
+            hash.UpdateData(scriptName);
+            hash.UpdateData("\n");
+        }
+    }
+
+    std::string tableList;
+    for (char const* table : tables)
+    {
+        if (!tableList.empty())
+            tableList += ", ";
+
+        tableList += table;
+    }
+
+    UpdateTableChecksums(hash, tableList);
+}
+
+bool WorldSnapshot::Read(ByteBuffer& payload) const
+{
+    if (!IsEnabled())
+        return false;
+
+    std::ifstream file(_path, std::ios::binary);
+    if (!file)
+        return false;
+
+    ByteBuffer header;
+    header.resize(SNAPSHOT_HEADER_SIZE);
+    if (!file.read(reinterpret_cast<char*>(header.contents()), SNAPSHOT_HEADER_SIZE))
+        return LoadFailed();
+
+    uint32 magic = header.read<uint32>();
+    uint32 version = header.read<uint32>();
+    Digest digest;
+    header.read(digest);
+    uint64 size = header.read<uint64>();
+
+    if (magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION)
+    {
+        LOG_INFO("server.loading", "Snapshot {} was written by another build, loading from the database.", _path);
+        return false;
+    }
+
+    if (digest != _digest)
+    {
+        LOG_INFO("server.loading", "Snapshot {} is outdated, loading from the database.", _path);
+        return false;
+    }
+
+    std::error_code error;
+    uintmax_t fileSize = std::filesystem::file_size(_path, error);
+    if (error || fileSize != SNAPSHOT_HEADER_SIZE + size)
+        return LoadFailed();
+
+    payload.resize(size);
+    if (size && !file.read(reinterpret_cast<char*>(payload.contents()), size))
+        return LoadFailed();
+
+    return true;
+}
+
+bool WorldSnapshot::LoadFailed() const
+{
+    LOG_ERROR("server.loading", "Snapshot {} is damaged, loading from the database.", _path);
+    return false;
+}
+
+void WorldSnapshot::Write(ByteBuffer const& payload) const
+{
+    ByteBuffer header(SNAPSHOT_HEADER_SIZE);
+    header << uint32(SNAPSHOT_MAGIC);
+    header << uint32(SNAPSHOT_VERSION);
+    header.append(_digest);
+    header << uint64(payload.size());
+
+    // write aside and swap, a crash while writing must not leave a valid looking snapshot behind
+    std::string const tempPath = _path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.write(reinterpret_cast<char const*>(header.contents()), header.size())
+            || (payload.size() && !file.write(reinterpret_cast<char const*>(payload.contents()), payload.size()))
+            || !file.flush())
+        {
+            LOG_ERROR("server.loading", "Could not write snapshot {}, check Startup.SnapshotPath.", tempPath);
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, _path, error);
+    if (error)
+        LOG_ERROR("server.loading", "Could not replace snapshot {}: {}", _path, error.message());
+}
+
+void WorldSnapshot::WriteRecord(ByteBuffer& data, CreatureSnapshotRecord const& record)
+{
+    CreatureData const& creature = record.Data;
+    data << record.SpawnId << record.OnGrid;
+    data << creature.id1 << creature.id2 << creature.id3 << creature.mapid << creature.phaseMask << creature.displayid << creature.equipmentId;
+    data << creature.posX << creature.posY << creature.posZ << creature.orientation;
+    data << creature.spawntimesecs << creature.wander_distance << creature.currentwaypoint << creature.curhealth << creature.curmana;
+    data << creature.movementType << creature.spawnMask << creature.npcflag << creature.unit_flags << creature.dynamicflags << creature.ScriptId << creature.dbData;
+}
+
+void WorldSnapshot::ReadRecord(ByteBuffer& data, CreatureSnapshotRecord& record)
+{
+    CreatureData& creature = record.Data;
+    data >> record.SpawnId >> record.OnGrid;
+    data >> creature.id1 >> creature.id2 >> creature.id3 >> creature.mapid >> creature.phaseMask >> creature.displayid >> creature.equipmentId;
+    data >> creature.posX >> creature.posY >> creature.posZ >> creature.orientation;
+    data >> creature.spawntimesecs >> creature.wander_distance >> creature.currentwaypoint >> creature.curhealth >> creature.curmana;
+    data >> creature.movementType >> creature.spawnMask >> creature.npcflag >> creature.unit_flags >> creature.dynamicflags >> creature.ScriptId >> creature.dbData;
+}
+
+void WorldSnapshot::WriteRecord(ByteBuffer& data, GameObjectSnapshotRecord const& record)
+{
+    GameObjectData const& gameObject = record.Data;
+    data << record.SpawnId << record.OnGrid;
+    data << gameObject.id << gameObject.mapid << gameObject.phaseMask;
+    data << gameObject.posX << gameObject.posY << gameObject.posZ << gameObject.orientation;
+    data << gameObject.rotation.x << gameObject.rotation.y << gameObject.rotation.z << gameObject.rotation.w;
+    data << gameObject.spawntimesecs << gameObject.ScriptId << gameObject.animprogress << uint32(gameObject.go_state);
+    data << gameObject.spawnMask << gameObject.artKit << gameObject.dbData;
+}
+
+void WorldSnapshot::ReadRecord(ByteBuffer& data, GameObjectSnapshotRecord& record)
+{
+    GameObjectData& gameObject = record.Data;
+    data >> record.SpawnId >> record.OnGrid;
+    data >> gameObject.id >> gameObject.mapid >> gameObject.phaseMask;
+    data >> gameObject.posX >> gameObject.posY >> gameObject.posZ >> gameObject.orientation;
+    data >> gameObject.rotation.x >> gameObject.rotation.y >> gameObject.rotation.z >> gameObject.rotation.w;
+    data >> gameObject.spawntimesecs >> gameObject.ScriptId >> gameObject.animprogress;
+    gameObject.go_state = GOState(data.read<uint32>());
+    data >> gameObject.spawnMask >> gameObject.artKit >> gameObject.dbData;
+}
+
+void WorldSnapshot::WriteRecord(ByteBuffer& data, ItemTemplate const& record)
+{
+    data << record.ItemId << record.Class << record.SubClass << record.SoundOverrideSubclass;
+    WriteString(data, record.Name1);
+    data << record.DisplayInfoID << record.Quality << uint32(record.Flags) << uint32(record.Flags2);
+    data << record.BuyCount << record.BuyPrice << record.SellPrice << record.InventoryType << record.AllowableClass << record.AllowableRace;
+    data << record.ItemLevel << record.RequiredLevel << record.RequiredSkill << record.RequiredSkillRank << record.RequiredSpell;
+    data << record.RequiredHonorRank << record.RequiredCityRank << record.RequiredReputationFaction << record.RequiredReputationRank;
+    data << record.MaxCount << record.Stackable << record.ContainerSlots << record.StatsCount;
+
+    // the sub structures are packed, their fields are copied out
+    for (_ItemStat const& stat : record.ItemStat)
+        data << uint32(stat.ItemStatType) << int32(stat.ItemStatValue);
+
+    data << record.ScalingStatDistribution << record.ScalingStatValue;
+
+    for (_Damage const& damage : record.Damage)
+        data << float(damage.DamageMin) << float(damage.DamageMax) << uint32(damage.DamageType);
+
+    data << record.Armor << record.HolyRes << record.FireRes << record.NatureRes << record.FrostRes << record.ShadowRes << record.ArcaneRes;
+    data << record.Delay << record.AmmoType << record.RangedModRange;
+
+    for (_Spell const& spell : record.Spells)
+    {
+        data << int32(spell.SpellId) << uint32(spell.SpellTrigger) << int32(spell.SpellCharges) << float(spell.SpellPPMRate);
+        data << int32(spell.SpellCooldown) << uint32(spell.SpellCategory) << int32(spell.SpellCategoryCooldown);
+    }
+
+    data << record.Bonding;
+    WriteString(data, record.Description);
+    data << record.PageText << record.LanguageID << record.PageMaterial << record.StartQuest << record.LockID << record.Material << record.Sheath;
+    data << record.RandomProperty << record.RandomSuffix << record.Block << record.ItemSet << record.MaxDurability << record.Area << record.Map;
+    data << record.BagFamily << record.TotemCategory;
+
+    for (_Socket const& socket : record.Socket)
+        data << uint32(socket.Color) << uint32(socket.Content);
+
+    data << record.socketBonus << record.GemProperties << record.RequiredDisenchantSkill << record.ArmorDamageModifier << record.Duration;
+    data << record.ItemLimitCategory << record.HolidayId << record.ScriptId << record.DisenchantID << record.FoodType;
+    data << record.MinMoneyLoot << record.MaxMoneyLoot << uint32(record.FlagsCu);
+}
+
+void WorldSnapshot::ReadRecord(ByteBuffer& data, ItemTemplate& record)
+{
+    data >> record.ItemId >> record.Class >> record.SubClass >> record.SoundOverrideSubclass;
+    ReadString(data, record.Name1);
+    data >> record.DisplayInfoID >> record.Quality;
+    record.Flags = ItemFlags(data.read<uint32>());
+    record.Flags2 = ItemFlags2(data.read<uint32>());
+    data >> record.BuyCount >> record.BuyPrice >> record.SellPrice >> record.InventoryType >> record.AllowableClass >> record.AllowableRace;
+    data >> record.ItemLevel >> record.RequiredLevel >> record.RequiredSkill >> record.RequiredSkillRank >> record.RequiredSpell;
+    data >> record.RequiredHonorRank >> record.RequiredCityRank >> record.RequiredReputationFaction >> record.RequiredReputationRank;
+    data >> record.MaxCount >> record.Stackable >> record.ContainerSlots >> record.StatsCount;
+
+    for (_ItemStat& stat : record.ItemStat)
+    {
+        stat.ItemStatType = data.read<uint32>();
+        stat.ItemStatValue = data.read<int32>();
+    }
+
+    data >> record.ScalingStatDistribution >> record.ScalingStatValue;
+
+    for (_Damage& damage : record.Damage)
+    {
+        damage.DamageMin = data.read<float>();
+        damage.DamageMax = data.read<float>();
+        damage.DamageType = data.read<uint32>();
+    }
+
+    data >> record.Armor >> record.HolyRes >> record.FireRes >> record.NatureRes >> record.FrostRes >> record.ShadowRes >> record.ArcaneRes;
+    data >> record.Delay >> record.AmmoType >> record.RangedModRange;
+
+    for (_Spell& spell : record.Spells)
+    {
+        spell.SpellId = data.read<int32>();
+        spell.SpellTrigger = data.read<uint32>();
+        spell.SpellCharges = data.read<int32>();
+        spell.SpellPPMRate = data.read<float>();
+        spell.SpellCooldown = data.read<int32>();
+        spell.SpellCategory = data.read<uint32>();
+        spell.SpellCategoryCooldown = data.read<int32>();
+    }
+
+    data >> record.Bonding;
+    ReadString(data, record.Description);
+    data >> record.PageText >> record.LanguageID >> record.PageMaterial >> record.StartQuest >> record.LockID >> record.Material >> record.Sheath;
+    data >> record.RandomProperty >> record.RandomSuffix >> record.Block >> record.ItemSet >> record.MaxDurability >> record.Area >> record.Map;
+    data >> record.BagFamily >> record.TotemCategory;
+
+    for (_Socket& socket : record.Socket)
+    {
+        socket.Color = data.read<uint32>();
+        socket.Content = data.read<uint32>();
+    }
+
+    data >> record.socketBonus >> record.GemProperties >> record.RequiredDisenchantSkill >> record.ArmorDamageModifier >> record.Duration;
+    data >> record.ItemLimitCategory >> record.HolidayId >> record.ScriptId >> record.DisenchantID >> record.FoodType;
+    data >> record.MinMoneyLoot >> record.MaxMoneyLoot;
+    record.FlagsCu = ItemFlagsCustom(data.read<uint32>());
+}
+
+void WorldSnapshot::WriteRecord(ByteBuffer& data, Quest const* record)
+{
+    Quest const& quest = *record;
+    data << quest._reqItemsCount << quest._reqCreatureOrGOcount << quest._rewChoiceItemsCount << quest._rewItemsCount << quest._eventIdForQuest;
+
+    data << quest.Id << quest.Method << quest.ZoneOrSort << quest.MinLevel << quest.Level << quest.Type << quest.AllowableRaces;
+    data << quest.RequiredFactionId1 << quest.RequiredFactionValue1 << quest.RequiredFactionId2 << quest.RequiredFactionValue2;
+    data << quest.SuggestedPlayers << quest.TimeAllowed << quest.Flags << quest.RewardTitleId << quest.RequiredPlayerKills << quest.RewardTalents;
+    data << quest.RewardArenaPoints << quest.RewardNextQuest << quest.RewardXPDifficulty << quest.StartItem;
+    WriteString(data, quest.Title);
+    WriteString(data, quest.Details);
+    WriteString(data, quest.Objectives);
+    WriteString(data, quest.OfferRewardText);
+    WriteString(data, quest.RequestItemsText);
+    WriteString(data, quest.AreaDescription);
+    WriteString(data, quest.CompletedText);
+    data << quest.RewardHonor << quest.RewardKillHonor << quest.RewardMoney << quest.RewardMoneyDifficulty << quest.RewardDisplaySpell << quest.RewardSpell;
+    data << quest.POIContinent << quest.POIx << quest.POIy << quest.POIPriority << quest.EmoteOnIncomplete << quest.EmoteOnComplete;
+
+    data << quest.MaxLevel << quest.RequiredClasses << quest.SourceSpellid << quest.PrevQuestId << quest.NextQuestId << quest.ExclusiveGroup;
+    data << quest.RewardMailTemplateId << quest.RewardMailDelay << quest.RequiredSkillId << quest.RequiredSkillPoints;
+    data << quest.RequiredMinRepFaction << quest.RequiredMinRepValue << quest.RequiredMaxRepFaction << quest.RequiredMaxRepValue;
+    data << quest.StartItemCount << quest.RewardMailSenderEntry << quest.SpecialFlags;
+
+    for (std::string const& text : quest.ObjectiveText)
+        WriteString(data, text);
+
+    WriteArray(data, quest.RequiredItemId);
+    WriteArray(data, quest.RequiredItemCount);
+    WriteArray(data, quest.ItemDrop);
+    WriteArray(data, quest.ItemDropQuantity);
+    WriteArray(data, quest.RequiredNpcOrGo);
+    WriteArray(data, quest.RequiredNpcOrGoCount);
+    WriteArray(data, quest.RewardChoiceItemId);
+    WriteArray(data, quest.RewardChoiceItemCount);
+    WriteArray(data, quest.RewardItemId);
+    WriteArray(data, quest.RewardItemIdCount);
+    WriteArray(data, quest.RewardFactionId);
+    WriteArray(data, quest.RewardFactionValueId);
+    WriteArray(data, quest.RewardFactionValueIdOverride);
+    WriteArray(data, quest.DetailsEmote);
+    WriteArray(data, quest.DetailsEmoteDelay);
+    WriteArray(data, quest.OfferRewardEmote);
+    WriteArray(data, quest.OfferRewardEmoteDelay);
+
+    data << uint32(quest.prevQuests.size());
+    for (int32 prevQuest : quest.prevQuests)
+        data << prevQuest;
+
+    data << uint32(quest.prevChainQuests.size());
+    for (uint32 prevChainQuest : quest.prevChainQuests)
+        data << prevChainQuest;
+
+    // built before the checks of LoadQuests, it may differ from the fields
+    data << uint32(quest.queryData.wpos());
+    data.append(static_cast<ByteBuffer const&>(quest.queryData));
+}
+
+void WorldSnapshot::ReadRecord(ByteBuffer& data, std::unique_ptr<Quest>& record)
+{
+    record.reset(new Quest());
+    Quest& quest = *record;
+    data >> quest._reqItemsCount >> quest._reqCreatureOrGOcount >> quest._rewChoiceItemsCount >> quest._rewItemsCount >> quest._eventIdForQuest;
+
+    data >> quest.Id >> quest.Method >> quest.ZoneOrSort >> quest.MinLevel >> quest.Level >> quest.Type >> quest.AllowableRaces;
+    data >> quest.RequiredFactionId1 >> quest.RequiredFactionValue1 >> quest.RequiredFactionId2 >> quest.RequiredFactionValue2;
+    data >> quest.SuggestedPlayers >> quest.TimeAllowed >> quest.Flags >> quest.RewardTitleId >> quest.RequiredPlayerKills >> quest.RewardTalents;
+    data >> quest.RewardArenaPoints >> quest.RewardNextQuest >> quest.RewardXPDifficulty >> quest.StartItem;
+    ReadString(data, quest.Title);
+    ReadString(data, quest.Details);
+    ReadString(data, quest.Objectives);
+    ReadString(data, quest.OfferRewardText);
+    ReadString(data, quest.RequestItemsText);
+    ReadString(data, quest.AreaDescription);
+    ReadString(data, quest.CompletedText);
+    data >> quest.RewardHonor >> quest.RewardKillHonor >> quest.RewardMoney >> quest.RewardMoneyDifficulty >> quest.RewardDisplaySpell >> quest.RewardSpell;
+    data >> quest.POIContinent >> quest.POIx >> quest.POIy >> quest.POIPriority >> quest.EmoteOnIncomplete >> quest.EmoteOnComplete;
+
+    data >> quest.MaxLevel >> quest.RequiredClasses >> quest.SourceSpellid >> quest.PrevQuestId >> quest.NextQuestId >> quest.ExclusiveGroup;
+    data >> quest.RewardMailTemplateId >> quest.RewardMailDelay >> quest.RequiredSkillId >> quest.RequiredSkillPoints;
+    data >> quest.RequiredMinRepFaction >> quest.RequiredMinRepValue >> quest.RequiredMaxRepFaction >> quest.RequiredMaxRepValue;
+    data >> quest.StartItemCount >> quest.RewardMailSenderEntry >> quest.SpecialFlags;
+
+    for (std::string& text : quest.ObjectiveText)
+        ReadString(data, text);
+
+    ReadArray(data, quest.RequiredItemId);
+    ReadArray(data, quest.RequiredItemCount);
+    ReadArray(data, quest.ItemDrop);
+    ReadArray(data, quest.ItemDropQuantity);
+    ReadArray(data, quest.RequiredNpcOrGo);
+    ReadArray(data, quest.RequiredNpcOrGoCount);
+    ReadArray(data, quest.RewardChoiceItemId);
+    ReadArray(data, quest.RewardChoiceItemCount);
+    ReadArray(data, quest.RewardItemId);
+    ReadArray(data, quest.RewardItemIdCount);
+    ReadArray(data, quest.RewardFactionId);
+    ReadArray(data, quest.RewardFactionValueId);
+    ReadArray(data, quest.RewardFactionValueIdOverride);
+    ReadArray(data, quest.DetailsEmote);
+    ReadArray(data, quest.DetailsEmoteDelay);
+    ReadArray(data, quest.OfferRewardEmote);
+    ReadArray(data, quest.OfferRewardEmoteDelay);
+
+    uint32 count = data.read<uint32>();
+    if (count > data.size() - data.rpos())
+        throw ByteBufferException();
+
+    quest.prevQuests.resize(count);
+    for (int32& prevQuest : quest.prevQuests)
+        data >> prevQuest;
+
+    count = data.read<uint32>();
+    if (count > data.size() - data.rpos())
+        throw ByteBufferException();
+
+    quest.prevChainQuests.resize(count);
+    for (uint32& prevChainQuest : quest.prevChainQuests)
+        data >> prevChainQuest;
+
+    count = data.read<uint32>();
+    if (count > data.size() - data.rpos())
+        throw ByteBufferException();
+
+    quest.queryData.Initialize(SMSG_QUEST_QUERY_RESPONSE, count);
+    if (count)
+    {
+        quest.queryData.append(data.contents() + data.rpos(), count);
+        data.read_skip(count);
+    }
+}
+
+void WorldSnapshot::WriteRecord(ByteBuffer& data, LootSnapshotRecord const& record)
+{
+    data << record.Entry << record.ItemId << record.Reference << record.Chance << record.NeedsQuest;
+    data << record.LootMode << record.GroupId << record.MinCount << record.MaxCount;
+}
+
+void WorldSnapshot::ReadRecord(ByteBuffer& data, LootSnapshotRecord& record)
+{
+    data >> record.Entry >> record.ItemId >> record.Reference >> record.Chance >> record.NeedsQuest;
+    data >> record.LootMode >> record.GroupId >> record.MinCount >> record.MaxCount;
+}
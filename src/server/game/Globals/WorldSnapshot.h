@@ -0,0 +1,161 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _WORLD_SNAPSHOT_H
+#define _WORLD_SNAPSHOT_H
+
+#include "ByteBuffer.h"
+#include "CreatureData.h"
+#include "CryptoHash.h"
+#include "Define.h"
+#include "G3D/Quat.h"
+#include "GameObjectData.h"
+#include "ItemTemplate.h"
+#include "ObjectGuid.h"
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Quest;
+
+struct CreatureSnapshotRecord
+{
+    ObjectGuid::LowType SpawnId = 0;
+    bool OnGrid = false;
+    CreatureData Data;
+};
+
+struct GameObjectSnapshotRecord
+{
+    ObjectGuid::LowType SpawnId = 0;
+    bool OnGrid = false;
+    GameObjectData Data;
+};
+
+// a row of a loot table which passed LootStoreItem::IsValid
+struct LootSnapshotRecord
+{
+    uint32 Entry = 0;
+    uint32 ItemId = 0;
+    int32 Reference = 0;
+    float Chance = 0.0f;
+    bool NeedsQuest = false;
+    uint16 LootMode = 0;
+    uint8 GroupId = 0;
+    uint8 MinCount = 0;
+    uint8 MaxCount = 0;
+};
+
+/**
+ * On-disk copy of a store built from world database tables, used to skip the
+ * queries and validation of that store on the next startup.
+ *
+ * A snapshot is a header followed by the records of the store, written field by
+ * field in little endian by ByteBuffer. It is only used when its header matches
+ * the core revision, the DBC files, the script names, the options the store depends
+ * on and the checksums of every source table, otherwise the store is loaded from the
+ * database as usual and the snapshot is rewritten.
+ *
+ * Snapshots are disabled unless Startup.SnapshotPath is set.
+ */
+class WorldSnapshot
+{
+public:
+    using Digest = Acore::Crypto::SHA1::Digest;
+
+    // options are the config values the store depends on, like rates applied while loading,
+    // scriptIds is set for the stores keeping indices in the script name list
+    WorldSnapshot(std::string name, std::initializer_list<char const*> tables, std::string_view options = {}, bool scriptIds = false);
+    // a snapshot at path, for the tests
+    WorldSnapshot(std::string path, Digest const& digest);
+
+    bool IsEnabled() const { return !_path.empty(); }
+
+    template<class Record>
+    bool Load(std::vector<Record>& records) const
+    {
+        ByteBuffer payload;
+        if (!Read(payload))
+            return false;
+
+        try
+        {
+            uint32 count = payload.read<uint32>();
+
+            // every record takes a byte at least, a larger count comes from a damaged file
+            if (count > payload.size() - payload.rpos())
+                throw ByteBufferException();
+
+            records.resize(count);
+            for (Record& record : records)
+                ReadRecord(payload, record);
+        }
+        catch (ByteBufferException const&)
+        {
+            records.clear();
+            return LoadFailed();
+        }
+
+        if (payload.rpos() != payload.size())
+        {
+            records.clear();
+            return LoadFailed();
+        }
+
+        return true;
+    }
+
+    template<class Records>
+    void Save(Records const& records) const
+    {
+        if (!IsEnabled())
+            return;
+
+        ByteBuffer payload;
+        payload << uint32(records.size());
+        for (auto const& record : records)
+            WriteRecord(payload, record);
+
+        Write(payload);
+    }
+
+    static void WriteRecord(ByteBuffer& data, CreatureSnapshotRecord const& record);
+    static void ReadRecord(ByteBuffer& data, CreatureSnapshotRecord& record);
+    static void WriteRecord(ByteBuffer& data, GameObjectSnapshotRecord const& record);
+    static void ReadRecord(ByteBuffer& data, GameObjectSnapshotRecord& record);
+    static void WriteRecord(ByteBuffer& data, ItemTemplate const& record);
+    static void ReadRecord(ByteBuffer& data, ItemTemplate& record);
+    static void WriteRecord(ByteBuffer& data, Quest const* record);
+    static void ReadRecord(ByteBuffer& data, std::unique_ptr<Quest>& record);
+    static void WriteRecord(ByteBuffer& data, LootSnapshotRecord const& record);
+    static void ReadRecord(ByteBuffer& data, LootSnapshotRecord& record);
+
+private:
+    // core revision, DBC files, script names and checksums of the tables
+    static void UpdateDigest(Acore::Crypto::SHA1& hash, std::initializer_list<char const*> tables, bool scriptIds);
+
+    bool Read(ByteBuffer& payload) const;
+    bool LoadFailed() const;
+    void Write(ByteBuffer const& payload) const;
+
+    std::string _path;
+    Digest _digest{};
+};
+
+#endif
@@ -3,32 +3,118 @@
 #include "GridTerrainData.h"
 #include "Log.h"
 #include "MapDefines.h"
+#include "MappedFile.h"
+#include <cstring>
 #include <filesystem>
+#include <optional>
 #include <G3D/Ray.h>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
 uint16 const holetab_h[4] = { 0x1111, 0x2222, 0x4444, 0x8888 };
 uint16 const holetab_v[4] = { 0x000F, 0x00F0, 0x0F00, 0xF000 };
 
+// Reads map file sections either from a stream, copying them, or from a memory mapping,
+// pointing the terrain arrays into the mapping whenever they are suitably aligned
+class TerrainFileReader
+{
+public:
+    explicit TerrainFileReader(std::ifstream& fileStream) : _fileStream(&fileStream), _mappedFile(nullptr), _offset(0) { }
+    explicit TerrainFileReader(Acore::MappedFile const& mappedFile) : _fileStream(nullptr), _mappedFile(&mappedFile), _offset(0) { }
+
+    bool Seek(uint32 offset)
+    {
+        if (_fileStream)
+            return bool(_fileStream->seekg(offset));
+
+        _offset = offset;
+        return _offset <= _mappedFile->GetSize();
+    }
+
+    bool Read(void* data, std::size_t size)
+    {
+        if (_fileStream)
+            return bool(_fileStream->read(reinterpret_cast<char*>(data), size));
+
+        if (_mappedFile->GetSize() - _offset < size)
+            return false;
+
+        std::memcpy(data, _mappedFile->GetData() + _offset, size);
+        _offset += size;
+        return true;
+    }
+
+    template<typename T>
+    bool Read(TerrainView<T>& view, std::size_t count)
+    {
+        std::size_t const size = count * sizeof(T);
+        if (_mappedFile)
+        {
+            if (_mappedFile->GetSize() - _offset < size)
+                return false;
+
+            uint8 const* data = _mappedFile->GetData() + _offset;
+            if (reinterpret_cast<std::uintptr_t>(data) % alignof(T) == 0)
+            {
+                view.Reference(reinterpret_cast<T const*>(data));
+                _offset += size;
+                return true;
+            }
+        }
+
+        std::unique_ptr<T[]> storage(new T[count]);
+        if (!Read(storage.get(), size))
+            return false;
+
+        view.Own(std::move(storage));
+        return true;
+    }
+
+private:
+    std::ifstream* _fileStream;
+    Acore::MappedFile const* _mappedFile;
+    std::size_t _offset;
+};
+
 GridTerrainData::GridTerrainData()
 {
     _gridGetHeight = &GridTerrainData::getHeightFromFlat;
 }
 
-TerrainMapDataReadResult GridTerrainData::Load(std::string const& mapFileName)
+GridTerrainData::~GridTerrainData() = default;
+
+TerrainMapDataReadResult GridTerrainData::Load(std::string const& mapFileName, bool memoryMapped)
 {
     // Check if file exists, we do this first as we need to
     // differentiate between file existing and any other file errors
     if (!std::filesystem::exists(mapFileName))
         return TerrainMapDataReadResult::NotFound;
 
-    // Start the input stream and check for any errors
-    std::ifstream fileStream(mapFileName, std::ios::binary);
-    if (fileStream.fail())
-        return TerrainMapDataReadResult::ReadError;
+    std::ifstream fileStream;
+    std::optional<TerrainFileReader> reader;
+    if (memoryMapped)
+    {
+        _mappedFile = std::make_unique<Acore::MappedFile>();
+        if (!_mappedFile->Open(mapFileName))
+            return TerrainMapDataReadResult::ReadError;
+
+        reader.emplace(*_mappedFile);
+    }
+    else
+    {
+        // Start the input stream and check for any errors
+        fileStream.open(mapFileName, std::ios::binary);
+        if (fileStream.fail())
+            return TerrainMapDataReadResult::ReadError;
+
+        reader.emplace(fileStream);
+    }
 
     // Read the map header
     map_fileheader header;
-    if (!fileStream.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    if (!reader->Read(&header, sizeof(header)))
         return TerrainMapDataReadResult::ReadError;
 
     // Check for valid map and version magics
@@ -36,49 +122,44 @@ TerrainMapDataReadResult GridTerrainData::Load(std::string const& mapFileName)
         return TerrainMapDataReadResult::InvalidMagic;
 
     // Load area data
-    if (header.areaMapOffset && !LoadAreaData(fileStream, header.areaMapOffset))
+    if (header.areaMapOffset && !LoadAreaData(*reader, header.areaMapOffset))
         return TerrainMapDataReadResult::InvalidAreaData;
 
     // Load height data
-    if (header.heightMapOffset && !LoadHeightData(fileStream, header.heightMapOffset))
+    if (header.heightMapOffset && !LoadHeightData(*reader, header.heightMapOffset))
         return TerrainMapDataReadResult::InvalidHeightData;
 
     // Load liquid data
-    if (header.liquidMapOffset && !LoadLiquidData(fileStream, header.liquidMapOffset))
+    if (header.liquidMapOffset && !LoadLiquidData(*reader, header.liquidMapOffset))
         return TerrainMapDataReadResult::InvalidLiquidData;
 
     // Load hole data
-    if (header.holesSize && !LoadHolesData(fileStream, header.holesOffset))
+    if (header.holesSize && !LoadHolesData(*reader, header.holesOffset))
         return TerrainMapDataReadResult::InvalidHoleData;
 
     return TerrainMapDataReadResult::Success;
 }
 
-bool GridTerrainData::LoadAreaData(std::ifstream& fileStream, uint32 const offset)
+bool GridTerrainData::LoadAreaData(TerrainFileReader& reader, uint32 const offset)
 {
-    fileStream.seekg(offset);
-
     map_areaHeader header;
-    if (!fileStream.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.fourcc != MapAreaMagic.asUInt)
+    if (!reader.Seek(offset) || !reader.Read(&header, sizeof(header)) || header.fourcc != MapAreaMagic.asUInt)
         return false;
 
     _loadedAreaData = std::make_unique<LoadedAreaData>();
     _loadedAreaData->gridArea = header.gridArea;
     if (!(header.flags & MAP_AREA_NO_AREA))
     {
-        _loadedAreaData->areaMap = std::make_unique<LoadedAreaData::AreaMapType>();
-        if (!fileStream.read(reinterpret_cast<char*>(_loadedAreaData->areaMap.get()), sizeof(LoadedAreaData::AreaMapType)))
+        if (!reader.Read(_loadedAreaData->areaMap, LoadedAreaData::AreaMapSize))
             return false;
     }
     return true;
 }
 
-bool GridTerrainData::LoadHeightData(std::ifstream& fileStream, uint32 const offset)
+bool GridTerrainData::LoadHeightData(TerrainFileReader& reader, uint32 const offset)
 {
-    fileStream.seekg(offset);
-
     map_heightHeader header;
-    if (!fileStream.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.fourcc != MapHeightMagic.asUInt)
+    if (!reader.Seek(offset) || !reader.Read(&header, sizeof(header)) || header.fourcc != MapHeightMagic.asUInt)
         return false;
 
     _loadedHeightData = std::make_unique<LoadedHeightData>();
@@ -88,8 +169,8 @@ bool GridTerrainData::LoadHeightData(std::ifstream& fileStream, uint32 const off
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
             _loadedHeightData->uint16HeightData = std::make_unique<LoadedHeightData::Uint16HeightData>();
-            if (!fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->uint16HeightData->v9), sizeof(_loadedHeightData->uint16HeightData->v9))
-                || !fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->uint16HeightData->v8), sizeof(_loadedHeightData->uint16HeightData->v8)))
+            if (!reader.Read(_loadedHeightData->uint16HeightData->v9, LoadedHeightData::V9Size)
+                || !reader.Read(_loadedHeightData->uint16HeightData->v8, LoadedHeightData::V8Size))
                 return false;
 
             _loadedHeightData->uint16HeightData->gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
@@ -98,8 +179,8 @@ bool GridTerrainData::LoadHeightData(std::ifstream& fileStream, uint32 const off
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
             _loadedHeightData->uint8HeightData = std::make_unique<LoadedHeightData::Uint8HeightData>();
-            if (!fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->uint8HeightData->v9), sizeof(_loadedHeightData->uint8HeightData->v9))
-                || !fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->uint8HeightData->v8), sizeof(_loadedHeightData->uint8HeightData->v8)))
+            if (!reader.Read(_loadedHeightData->uint8HeightData->v9, LoadedHeightData::V9Size)
+                || !reader.Read(_loadedHeightData->uint8HeightData->v8, LoadedHeightData::V8Size))
                 return false;
 
             _loadedHeightData->uint8HeightData->gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
@@ -108,8 +189,8 @@ bool GridTerrainData::LoadHeightData(std::ifstream& fileStream, uint32 const off
         else
         {
             _loadedHeightData->floatHeightData = std::make_unique<LoadedHeightData::FloatHeightData>();
-            if (!fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->floatHeightData->v9), sizeof(_loadedHeightData->floatHeightData->v9))
-                || !fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->floatHeightData->v8), sizeof(_loadedHeightData->floatHeightData->v8)))
+            if (!reader.Read(_loadedHeightData->floatHeightData->v9, LoadedHeightData::V9Size)
+                || !reader.Read(_loadedHeightData->floatHeightData->v8, LoadedHeightData::V8Size))
                 return false;
 
             _gridGetHeight = &GridTerrainData::getHeightFromFloat;
@@ -122,8 +203,8 @@ bool GridTerrainData::LoadHeightData(std::ifstream& fileStream, uint32 const off
     {
         std::array<int16, 9> maxHeights;
         std::array<int16, 9> minHeights;
-        if (!fileStream.read(reinterpret_cast<char*>(maxHeights.data()), sizeof(maxHeights)) ||
-            !fileStream.read(reinterpret_cast<char*>(minHeights.data()), sizeof(minHeights)))
+        if (!reader.Read(maxHeights.data(), sizeof(maxHeights)) ||
+            !reader.Read(minHeights.data(), sizeof(minHeights)))
             return false;
 
         static uint32 constexpr indices[8][3] =
@@ -163,12 +244,10 @@ bool GridTerrainData::LoadHeightData(std::ifstream& fileStream, uint32 const off
     return true;
 }
 
-bool GridTerrainData::LoadLiquidData(std::ifstream& fileStream, uint32 const offset)
+bool GridTerrainData::LoadLiquidData(TerrainFileReader& reader, uint32 const offset)
 {
-    fileStream.seekg(offset);
-
     map_liquidHeader header;
-    if (!fileStream.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.fourcc != MapLiquidMagic.asUInt)
+    if (!reader.Seek(offset) || !reader.Read(&header, sizeof(header)) || header.fourcc != MapLiquidMagic.asUInt)
         return false;
 
     _loadedLiquidData = std::make_unique<LoadedLiquidData>();
@@ -182,30 +261,24 @@ bool GridTerrainData::LoadLiquidData(std::ifstream& fileStream, uint32 const off
 
     if (!(header.flags & MAP_LIQUID_NO_TYPE))
     {
-        _loadedLiquidData->liquidEntry = std::make_unique<LoadedLiquidData::LiquidEntryType>();
-        if (!fileStream.read(reinterpret_cast<char*>(_loadedLiquidData->liquidEntry.get()), sizeof(LoadedLiquidData::LiquidEntryType)))
+        if (!reader.Read(_loadedLiquidData->liquidEntry, LoadedLiquidData::LiquidEntrySize))
             return false;
 
-        _loadedLiquidData->liquidFlags = std::make_unique<LoadedLiquidData::LiquidFlagsType>();
-        if (!fileStream.read(reinterpret_cast<char*>(_loadedLiquidData->liquidFlags.get()), sizeof(LoadedLiquidData::LiquidFlagsType)))
+        if (!reader.Read(_loadedLiquidData->liquidFlags, LoadedLiquidData::LiquidFlagsSize))
             return false;
     }
     if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
     {
-        _loadedLiquidData->liquidMap = std::make_unique<LoadedLiquidData::LiquidMapType>();
-        _loadedLiquidData->liquidMap->resize(_loadedLiquidData->liquidWidth * _loadedLiquidData->liquidHeight);
-        if (!fileStream.read(reinterpret_cast<char*>(_loadedLiquidData->liquidMap->data()), _loadedLiquidData->liquidMap->size() * sizeof(float)))
+        if (!reader.Read(_loadedLiquidData->liquidMap, _loadedLiquidData->liquidWidth * _loadedLiquidData->liquidHeight))
             return false;
     }
     return true;
 }
 
-bool GridTerrainData::LoadHolesData(std::ifstream& fileStream, uint32 const offset)
+bool GridTerrainData::LoadHolesData(TerrainFileReader& reader, uint32 const offset)
 {
-    fileStream.seekg(offset);
-
     _loadedHoleData = std::make_unique<LoadedHoleData>();
-    if (!fileStream.read(reinterpret_cast<char*>(&_loadedHoleData->holes), sizeof(_loadedHoleData->holes)))
+    if (!reader.Seek(offset) || !reader.Read(_loadedHoleData->holes, LoadedHoleData::HolesSize))
         return false;
 
     return true;
@@ -223,7 +296,7 @@ uint16 GridTerrainData::getArea(float x, float y) const
     y = 16 * (32 - y / SIZE_OF_GRIDS);
     int lx = (int)x & 15;
     int ly = (int)y & 15;
-    return _loadedAreaData->areaMap->at(lx * 16 + ly);
+    return _loadedAreaData->areaMap[lx * 16 + ly];
 }
 
 float GridTerrainData::getHeightFromFlat(float /*x*/, float /*y*/) const
@@ -338,7 +411,7 @@ float GridTerrainData::getHeightFromUint8(float x, float y) const
         return INVALID_HEIGHT;
 
     int32 a, b, c;
-    uint8* V9_h1_ptr = &_loadedHeightData->uint8HeightData->v9[x_int * 128 + x_int + y_int];
+    uint8 const* V9_h1_ptr = &_loadedHeightData->uint8HeightData->v9[x_int * 128 + x_int + y_int];
     if (x + y < 1)
     {
         if (x > y)
@@ -408,7 +481,7 @@ float GridTerrainData::getHeightFromUint16(float x, float y) const
         return INVALID_HEIGHT;
 
     int32 a, b, c;
-    uint16* V9_h1_ptr = &_loadedHeightData->uint16HeightData->v9[x_int * 128 + x_int + y_int];
+    uint16 const* V9_h1_ptr = &_loadedHeightData->uint16HeightData->v9[x_int * 128 + x_int + y_int];
     if (x + y < 1)
     {
         if (x > y)
@@ -459,6 +532,108 @@ float GridTerrainData::getHeightFromUint16(float x, float y) const
     return (float)((a * x) + (b * y) + c) * _loadedHeightData->uint16HeightData->gridIntHeightMultiplier + _loadedHeightData->gridHeight;
 }
 
+void GridTerrainData::getHeights(G3D::Vector3 const* points, float* heights, std::size_t count) const
+{
+    if (_loadedHeightData)
+    {
+        if (_loadedHeightData->floatHeightData)
+            return getHeightsFromGrid<float, false>(_loadedHeightData->floatHeightData->v9.data(), _loadedHeightData->floatHeightData->v8.data(), 1.0f, points, heights, count);
+
+        if (_loadedHeightData->uint16HeightData)
+            return getHeightsFromGrid<uint16, true>(_loadedHeightData->uint16HeightData->v9.data(), _loadedHeightData->uint16HeightData->v8.data(),
+                _loadedHeightData->uint16HeightData->gridIntHeightMultiplier, points, heights, count);
+
+        if (_loadedHeightData->uint8HeightData)
+            return getHeightsFromGrid<uint8, true>(_loadedHeightData->uint8HeightData->v9.data(), _loadedHeightData->uint8HeightData->v8.data(),
+                _loadedHeightData->uint8HeightData->gridIntHeightMultiplier, points, heights, count);
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+        heights[i] = getHeight(points[i].x, points[i].y);
+}
+
+template<typename T, bool Scaled>
+void GridTerrainData::getHeightsFromGrid(T const* v9, T const* v8, float multiplier, G3D::Vector3 const* points, float* heights, std::size_t count) const
+{
+    std::size_t i = 0;
+
+#if defined(__SSE2__) || defined(_M_X64)
+    // Same interpolation as getHeightFromFloat/Uint16/Uint8, see there for the triangle layout.
+    // Only the fetches are done per point, the triangle selection and the plane equation
+    // are evaluated for four points at once, in the same order to give the same results.
+    __m128 const resolution = _mm_set1_ps(float(MAP_RESOLUTION));
+    __m128 const gridSize = _mm_set1_ps(SIZE_OF_GRIDS);
+    __m128 const center = _mm_set1_ps(32.0f);
+    __m128 const one = _mm_set1_ps(1.0f);
+    __m128 const two = _mm_set1_ps(2.0f);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 x = _mm_mul_ps(resolution, _mm_sub_ps(center, _mm_div_ps(_mm_set_ps(points[i + 3].x, points[i + 2].x, points[i + 1].x, points[i].x), gridSize)));
+        __m128 y = _mm_mul_ps(resolution, _mm_sub_ps(center, _mm_div_ps(_mm_set_ps(points[i + 3].y, points[i + 2].y, points[i + 1].y, points[i].y), gridSize)));
+
+        __m128i xInt = _mm_cvttps_epi32(x);
+        __m128i yInt = _mm_cvttps_epi32(y);
+        x = _mm_sub_ps(x, _mm_cvtepi32_ps(xInt));
+        y = _mm_sub_ps(y, _mm_cvtepi32_ps(yInt));
+
+        __m128i const cellMask = _mm_set1_epi32(MAP_RESOLUTION - 1);
+        alignas(16) int32 xCell[4];
+        alignas(16) int32 yCell[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(xCell), _mm_and_si128(xInt, cellMask));
+        _mm_store_si128(reinterpret_cast<__m128i*>(yCell), _mm_and_si128(yInt, cellMask));
+
+        alignas(16) float h1[4], h2[4], h3[4], h4[4], h5[4];
+        for (uint32 lane = 0; lane < 4; ++lane)
+        {
+            T const* v9Cell = &v9[xCell[lane] * 129 + yCell[lane]];
+            h1[lane] = float(v9Cell[0]);
+            h2[lane] = float(v9Cell[129]);
+            h3[lane] = float(v9Cell[1]);
+            h4[lane] = float(v9Cell[130]);
+            h5[lane] = float(v8[xCell[lane] * 128 + yCell[lane]]);
+        }
+
+        __m128 const v1 = _mm_load_ps(h1);
+        __m128 const v2 = _mm_load_ps(h2);
+        __m128 const v3 = _mm_load_ps(h3);
+        __m128 const v4 = _mm_load_ps(h4);
+        __m128 const v5 = _mm_mul_ps(two, _mm_load_ps(h5));
+
+        __m128 const upper = _mm_cmplt_ps(_mm_add_ps(x, y), one);   // triangles 1 and 2
+        __m128 const right = _mm_cmpgt_ps(x, y);                    // triangles 1 and 3
+
+        auto select = [](__m128 mask, __m128 ifTrue, __m128 ifFalse) { return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse)); };
+
+        __m128 const a = select(upper,
+            select(right, _mm_sub_ps(v2, v1), _mm_sub_ps(_mm_sub_ps(v5, v1), v3)),
+            select(right, _mm_sub_ps(_mm_add_ps(v2, v4), v5), _mm_sub_ps(v4, v3)));
+        __m128 const b = select(upper,
+            select(right, _mm_sub_ps(_mm_sub_ps(v5, v1), v2), _mm_sub_ps(v3, v1)),
+            select(right, _mm_sub_ps(v4, v2), _mm_sub_ps(_mm_add_ps(v3, v4), v5)));
+        __m128 const c = select(upper, v1, _mm_sub_ps(v5, v4));
+
+        __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, x), _mm_mul_ps(b, y)), c);
+        if constexpr (Scaled)
+            result = _mm_add_ps(_mm_mul_ps(result, _mm_set1_ps(multiplier)), _mm_set1_ps(_loadedHeightData->gridHeight));
+
+        _mm_storeu_ps(&heights[i], result);
+
+        if (_loadedHoleData)
+            for (uint32 lane = 0; lane < 4; ++lane)
+                if (isHole(xCell[lane], yCell[lane]))
+                    heights[i + lane] = INVALID_HEIGHT;
+    }
+#else
+    (void)v9;
+    (void)v8;
+    (void)multiplier;
+#endif
+
+    for (; i < count; ++i)
+        heights[i] = getHeight(points[i].x, points[i].y);
+}
+
 bool GridTerrainData::isHole(int row, int col) const
 {
     if (!_loadedHoleData)
@@ -523,7 +698,7 @@ float GridTerrainData::getLiquidLevel(float x, float y) const
     if (cy_int < 0 || cy_int >= _loadedLiquidData->liquidWidth)
         return INVALID_HEIGHT;
 
-    return _loadedLiquidData->liquidMap->at(cx_int * _loadedLiquidData->liquidWidth + cy_int);
+    return _loadedLiquidData->liquidMap[cx_int * _loadedLiquidData->liquidWidth + cy_int];
 }
 
 // Get water state on map
@@ -547,8 +722,8 @@ LiquidData const GridTerrainData::GetLiquidData(float x, float y, float z, float
 
         // Check water type in cell
         int idx = (x_int >> 3) * 16 + (y_int >> 3);
-        uint8 type = _loadedLiquidData->liquidFlags ? _loadedLiquidData->liquidFlags->at(idx) : _loadedLiquidData->liquidGlobalFlags;
-        uint32 entry = _loadedLiquidData->liquidEntry ? _loadedLiquidData->liquidEntry->at(idx) : _loadedLiquidData->liquidGlobalEntry;
+        uint8 type = _loadedLiquidData->liquidFlags ? _loadedLiquidData->liquidFlags[idx] : _loadedLiquidData->liquidGlobalFlags;
+        uint32 entry = _loadedLiquidData->liquidEntry ? _loadedLiquidData->liquidEntry[idx] : _loadedLiquidData->liquidGlobalEntry;
         if (LiquidTypeEntry const* liquidEntry = sLiquidTypeStore.LookupEntry(entry))
         {
             type &= MAP_LIQUID_TYPE_DARK_WATER;
@@ -586,7 +761,7 @@ LiquidData const GridTerrainData::GetLiquidData(float x, float y, float z, float
             if (lx_int >= 0 && lx_int < _loadedLiquidData->liquidHeight && ly_int >= 0 && ly_int < _loadedLiquidData->liquidWidth)
             {
                 // Get water level
-                float liquid_level = _loadedLiquidData->liquidMap ? _loadedLiquidData->liquidMap->at(lx_int * _loadedLiquidData->liquidWidth + ly_int) : _loadedLiquidData->liquidLevel;
+                float liquid_level = _loadedLiquidData->liquidMap ? _loadedLiquidData->liquidMap[lx_int * _loadedLiquidData->liquidWidth + ly_int] : _loadedLiquidData->liquidLevel;
                 // Get ground level
                 float ground_level = getHeight(x, y);
 
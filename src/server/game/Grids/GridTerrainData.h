@@ -19,6 +19,7 @@
 #define GRID_TERRAIN_DATA_H
 
 #include "Common.h"
+#include "Optional.h"
 #include <fstream>
 #include <G3D/Plane.h>
 #include <memory>
@@ -113,45 +114,53 @@ struct map_liquidHeader
 // Loaded map data structures
 // ******************************************
 
+// Array of terrain values, either owned or pointing into the memory mapped map file
+template<typename T>
+class TerrainView
+{
+public:
+    T const& operator[](std::size_t index) const { return _data[index]; }
+    T const* data() const { return _data; }
+    explicit operator bool() const { return _data != nullptr; }
+
+    void Own(std::unique_ptr<T[]> storage) { _storage = std::move(storage); _data = _storage.get(); }
+    void Reference(T const* data) { _storage.reset(); _data = data; }
+
+private:
+    T const* _data = nullptr;
+    std::unique_ptr<T[]> _storage;
+};
+
 struct LoadedAreaData
 {
-    typedef std::array<uint16, 16 * 16> AreaMapType;
+    static constexpr std::size_t AreaMapSize = 16 * 16;
 
     uint16 gridArea;
-    std::unique_ptr<AreaMapType> areaMap;
+    TerrainView<uint16> areaMap;
 };
 
 struct LoadedHeightData
 {
     typedef std::array<G3D::Plane, 8> HeightPlanesType;
 
-    struct Uint16HeightData
-    {
-        typedef std::array<uint16, 129 * 129> V9Type;
-        typedef std::array<uint16, 128 * 128> V8Type;
-
-        V9Type v9;
-        V8Type v8;
-        float gridIntHeightMultiplier;
-    };
+    static constexpr std::size_t V9Size = 129 * 129;
+    static constexpr std::size_t V8Size = 128 * 128;
 
-    struct Uint8HeightData
+    template<typename T>
+    struct IntHeightData
     {
-        typedef std::array<uint8, 129 * 129> V9Type;
-        typedef std::array<uint8, 128 * 128> V8Type;
-
-        V9Type v9;
-        V8Type v8;
+        TerrainView<T> v9;
+        TerrainView<T> v8;
         float gridIntHeightMultiplier;
     };
 
+    typedef IntHeightData<uint16> Uint16HeightData;
+    typedef IntHeightData<uint8> Uint8HeightData;
+
     struct FloatHeightData
     {
-        typedef std::array<float, 129 * 129> V9Type;
-        typedef std::array<float, 128 * 128> V8Type;
-
-        V9Type v9;
-        V8Type v8;
+        TerrainView<float> v9;
+        TerrainView<float> v8;
     };
 
     float gridHeight;
@@ -163,9 +172,8 @@ struct LoadedHeightData
 
 struct LoadedLiquidData
 {
-    typedef std::array<uint16, 16 * 16> LiquidEntryType;
-    typedef std::array<uint8, 16 * 16> LiquidFlagsType;
-    typedef std::vector<float> LiquidMapType;
+    static constexpr std::size_t LiquidEntrySize = 16 * 16;
+    static constexpr std::size_t LiquidFlagsSize = 16 * 16;
 
     uint16 liquidGlobalEntry;
     uint8 liquidGlobalFlags;
@@ -174,16 +182,16 @@ struct LoadedLiquidData
     uint8 liquidWidth;
     uint8 liquidHeight;
     float liquidLevel;
-    std::unique_ptr<LiquidEntryType> liquidEntry;
-    std::unique_ptr<LiquidFlagsType> liquidFlags;
-    std::unique_ptr<LiquidMapType> liquidMap;
+    TerrainView<uint16> liquidEntry;
+    TerrainView<uint8> liquidFlags;
+    TerrainView<float> liquidMap;
 };
 
 struct LoadedHoleData
 {
-    typedef std::array<uint16, 16 * 16> HolesType;
+    static constexpr std::size_t HolesSize = 16 * 16;
 
-    HolesType holes;
+    TerrainView<uint16> holes;
 };
 
 enum LiquidStatus : uint32
@@ -218,12 +226,22 @@ enum class TerrainMapDataReadResult
     InvalidHoleData
 };
 
+class TerrainFileReader;
+
+namespace Acore
+{
+    class MappedFile;
+}
+
 class GridTerrainData
 {
-    bool LoadAreaData(std::ifstream& fileStream, uint32 const offset);
-    bool LoadHeightData(std::ifstream& fileStream, uint32 const offset);
-    bool LoadLiquidData(std::ifstream& fileStream, uint32 const offset);
-    bool LoadHolesData(std::ifstream& fileStream, uint32 const offset);
+    bool LoadAreaData(TerrainFileReader& reader, uint32 const offset);
+    bool LoadHeightData(TerrainFileReader& reader, uint32 const offset);
+    bool LoadLiquidData(TerrainFileReader& reader, uint32 const offset);
+    bool LoadHolesData(TerrainFileReader& reader, uint32 const offset);
+
+    // keeps the file mapped while the loaded data points into it
+    std::unique_ptr<Acore::MappedFile> _mappedFile;
 
     std::unique_ptr<LoadedAreaData> _loadedAreaData;
     std::unique_ptr<LoadedHeightData> _loadedHeightData;
@@ -240,13 +258,20 @@ class GridTerrainData
     float getHeightFromUint8(float x, float y) const;
     float getHeightFromFlat(float x, float y) const;
 
+    template<typename T, bool Scaled>
+    void getHeightsFromGrid(T const* v9, T const* v8, float multiplier, G3D::Vector3 const* points, float* heights, std::size_t count) const;
+
 public:
     GridTerrainData();
-    ~GridTerrainData() { };
-    TerrainMapDataReadResult Load(std::string const& mapFileName);
+    ~GridTerrainData();
+
+    // with memoryMapped the file is mapped and the terrain arrays are read in place instead of being copied
+    TerrainMapDataReadResult Load(std::string const& mapFileName, bool memoryMapped = false);
 
     uint16 getArea(float x, float y) const;
     inline float getHeight(float x, float y) const { return (this->*_gridGetHeight)(x, y); }
+    // Same as getHeight for each point, interpolating four points at once when SSE2 is available
+    void getHeights(G3D::Vector3 const* points, float* heights, std::size_t count) const;
     float getMinHeight(float x, float y) const;
     float getLiquidLevel(float x, float y) const;
     LiquidData const GetLiquidData(float x, float y, float z, float collisionHeight, Optional<uint8> ReqLiquidType) const;
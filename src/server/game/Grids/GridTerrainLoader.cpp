@@ -35,7 +35,7 @@ void GridTerrainLoader::LoadMap()
     // loading data
     LOG_DEBUG("maps", "Loading map {}", mapFileName);
     std::unique_ptr<GridTerrainData> terrainData = std::make_unique<GridTerrainData>();
-    TerrainMapDataReadResult loadResult = terrainData->Load(mapFileName);
+    TerrainMapDataReadResult loadResult = terrainData->Load(mapFileName, sWorld->getBoolConfig(CONFIG_MEMORY_MAPPED_MAP_FILES));
     if (loadResult == TerrainMapDataReadResult::Success)
         _grid.SetTerrainData(std::move(terrainData));
     else
@@ -52,6 +52,7 @@ void GridTerrainLoader::LoadMap()
 void GridTerrainLoader::LoadVMap()
 {
     int vmapLoadResult = VMAP::VMapFactory::createOrGetVMapMgr()->loadMap((sWorld->GetDataPath() + "vmaps").c_str(), _map->GetId(), _grid.GetX(), _grid.GetY());
+    _map->InvalidateLineOfSightCache(false);
     switch (vmapLoadResult)
     {
     case VMAP::VMAP_LOAD_RESULT_OK:
@@ -153,5 +154,6 @@ void GridTerrainUnloader::UnloadTerrain()
         return;
 
     VMAP::VMapFactory::createOrGetVMapMgr()->unloadMap(_map->GetId(), _grid.GetX(), _grid.GetY());
+    _map->InvalidateLineOfSightCache(false);
     MMAP::MMapFactory::createOrGetMMapMgr()->unloadMap(_map->GetId(), _grid.GetX(), _grid.GetY());
 }
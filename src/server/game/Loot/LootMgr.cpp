@@ -29,6 +29,7 @@
 #include "SpellMgr.h"
 #include "Util.h"
 #include "World.h"
+#include "WorldSnapshot.h"
 
 ServerConfigs const qualityToRate[] =
 {
@@ -142,11 +143,23 @@ void LootStore::Verify() const
 // All checks of the loaded template are called from here, no error reports at loot generation required
 uint32 LootStore::LoadLootTable()
 {
-    LootTemplateMap::const_iterator tab;
-
     // Clearing store (for reloading case)
     Clear();
 
+    // IsValid checks the items
+    WorldSnapshot snapshot(GetName(), { GetName(), "item_template" });
+
+    std::vector<LootSnapshotRecord> snapshotRecords;
+    if (snapshot.Load(snapshotRecords))
+    {
+        for (LootSnapshotRecord const& record : snapshotRecords)
+            AddEntry(record.Entry, new LootStoreItem(record.ItemId, record.Reference, record.Chance, record.NeedsQuest, record.LootMode, record.GroupId, record.MinCount, record.MaxCount));
+
+        Verify();                                       // the templates are checked as a whole, unlike the snapshot records
+
+        return uint32(snapshotRecords.size());
+    }
+
     //                                                  0     1            2               3         4         5             6
     QueryResult result = WorldDatabase.Query("SELECT Entry, Item, Reference, Chance, QuestRequired, LootMode, GroupId, MinCount, MaxCount FROM {}", GetName());
 
@@ -189,32 +202,28 @@ uint32 LootStore::LoadLootTable()
             continue;
         }
 
-        // Looking for the template of the entry
-        // often entries are put together
-        // cppcheck-suppress eraseDereference
-        if (m_LootTemplates.empty() || tab->first != entry)
-        {
-            // Searching the template (in case template Id changed)
-            tab = m_LootTemplates.find(entry);
-            if (tab == m_LootTemplates.end())
-            {
-                std::pair< LootTemplateMap::iterator, bool > pr = m_LootTemplates.insert(LootTemplateMap::value_type(entry, new LootTemplate()));
-                tab = pr.first;
-            }
-        }
-        // else is empty - template Id and iter are the same
-        // finally iter refers to already existed or just created <entry, LootTemplate>
+        AddEntry(entry, storeitem);
+        if (snapshot.IsEnabled())
+            snapshotRecords.push_back({ entry, item, reference, chance, needsquest, lootmode, groupid, uint8(mincount), uint8(maxcount) });
 
-        // Adds current row to the template
-        tab->second->AddEntry(storeitem);
         ++count;
     } while (result->NextRow());
 
     Verify();                                           // Checks validity of the loot store
 
+    snapshot.Save(snapshotRecords);
     return count;
 }
 
+void LootStore::AddEntry(uint32 entry, LootStoreItem* item)
+{
+    LootTemplate*& lootTemplate = m_LootTemplates[entry];
+    if (!lootTemplate)
+        lootTemplate = new LootTemplate();
+
+    lootTemplate->AddEntry(item);
+}
+
 bool LootStore::HaveQuestLootFor(uint32 loot_id) const
 {
     LootTemplateMap::const_iterator itr = m_LootTemplates.find(loot_id);
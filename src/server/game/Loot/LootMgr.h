@@ -235,6 +235,8 @@ protected:
     uint32 LoadLootTable();
     void Clear();
 private:
+    void AddEntry(uint32 entry, LootStoreItem* item);
+
     LootTemplateMap m_LootTemplates;
     char const* m_name;
     char const* m_entryName;
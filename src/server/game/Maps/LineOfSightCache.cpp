@@ -0,0 +1,109 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "LineOfSightCache.h"
+#include <cmath>
+
+std::atomic<uint64> LineOfSightCache::_totalHits;
+std::atomic<uint64> LineOfSightCache::_totalMisses;
+
+LineOfSightCache::Key LineOfSightCache::MakeKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phaseMask, uint32 flags)
+{
+    auto quantize = [](float value) { return int32(std::floor(value * QUANTIZATION)); };
+
+    Key key;
+    key.Coords = { quantize(x1), quantize(y1), quantize(z1), quantize(x2), quantize(y2), quantize(z2) };
+    key.PhaseMask = phaseMask;
+    key.Flags = flags;
+    return key;
+}
+
+std::size_t LineOfSightCache::GetSlot(Key const& key)
+{
+    uint64 hash = 14695981039346656037ULL;
+    auto mix = [&hash](uint32 value)
+    {
+        hash ^= value;
+        hash *= 1099511628211ULL;
+    };
+
+    for (int32 coord : key.Coords)
+        mix(uint32(coord));
+
+    mix(key.PhaseMask);
+    mix(key.Flags);
+    return std::size_t(hash ^ (hash >> 32)) % SIZE;
+}
+
+Optional<bool> LineOfSightCache::Get(Key const& key)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_entries)
+    {
+        Entry const& entry = (*_entries)[GetSlot(key)];
+        if (entry.Generation == _generation && entry.EntryKey == key)
+        {
+            ++_stats.Hits;
+            return entry.InLineOfSight;
+        }
+    }
+
+    ++_stats.Misses;
+    return {};
+}
+
+void LineOfSightCache::Set(Key const& key, bool inLineOfSight)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (!_entries)
+        _entries = std::make_unique<std::array<Entry, SIZE>>();
+
+    Entry& entry = (*_entries)[GetSlot(key)];
+    entry.EntryKey = key;
+    entry.Generation = _generation;
+    entry.InLineOfSight = inLineOfSight;
+}
+
+void LineOfSightCache::Invalidate()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_stats.Hits || _stats.Misses)
+    {
+        _totalHits.fetch_add(_stats.Hits, std::memory_order_relaxed);
+        _totalMisses.fetch_add(_stats.Misses, std::memory_order_relaxed);
+        _stats = LineOfSightCacheStats();
+    }
+
+    if (!_entries)
+        return;
+
+    // entries of older generations are ignored, they are overwritten as new results come in
+    if (++_generation == 0)
+    {
+        _entries->fill(Entry());
+        _generation = 1;
+    }
+}
+
+LineOfSightCacheStats LineOfSightCache::ConsumeStats()
+{
+    LineOfSightCacheStats stats;
+    stats.Hits = _totalHits.exchange(0, std::memory_order_relaxed);
+    stats.Misses = _totalMisses.exchange(0, std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,87 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _LINE_OF_SIGHT_CACHE_H
+#define _LINE_OF_SIGHT_CACHE_H
+
+#include "Define.h"
+#include "Optional.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+struct LineOfSightCacheStats
+{
+    uint64 Hits = 0;
+    uint64 Misses = 0;
+};
+
+/**
+ * Line of sight results of one map, so the rays cast several times per update between
+ * the same positions (spell and AoE targets, aggro and follow checks) are traced once.
+ *
+ * Endpoints are quantized to 1/QUANTIZATION yard. The cache is direct mapped: a result
+ * replaces whatever was stored in its slot. Invalidate() drops every result at once,
+ * it is called at the start of each map update and whenever the collision it caches changes.
+ */
+class LineOfSightCache
+{
+public:
+    static constexpr float QUANTIZATION = 8.0f;
+    static constexpr std::size_t SIZE = 1024;
+
+    struct Key
+    {
+        std::array<int32, 6> Coords;
+        uint32 PhaseMask;
+        uint32 Flags;
+
+        bool operator==(Key const& right) const { return Coords == right.Coords && PhaseMask == right.PhaseMask && Flags == right.Flags; }
+    };
+
+    static Key MakeKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phaseMask, uint32 flags);
+
+    Optional<bool> Get(Key const& key);
+    void Set(Key const& key, bool inLineOfSight);
+    void Invalidate();
+
+    // Hits and misses of all caches since the previous call, counted when the caches are invalidated
+    static LineOfSightCacheStats ConsumeStats();
+
+private:
+    struct Entry
+    {
+        Key EntryKey;
+        uint32 Generation = 0;
+        bool InLineOfSight = false;
+    };
+
+    static std::size_t GetSlot(Key const& key);
+
+    // maps may be updated by several threads at once, see Map::UpdateNonPlayerObjectsInRegions
+    std::mutex _lock;
+    std::unique_ptr<std::array<Entry, SIZE>> _entries;  // allocated on first use, most maps never cast a ray
+    uint32 _generation = 1;
+    LineOfSightCacheStats _stats;
+
+    static std::atomic<uint64> _totalHits;
+    static std::atomic<uint64> _totalMisses;
+};
+
+#endif
@@ -30,6 +30,7 @@
 #include "LFGMgr.h"
 #include "MapGrid.h"
 #include "MapInstanced.h"
+#include "MapMgr.h"
 #include "Metric.h"
 #include "MiscPackets.h"
 #include "MMapFactory.h"
@@ -62,14 +63,13 @@ Map::~Map()
 
     if (!m_scriptSchedule.empty())
         sScriptMgr->DecreaseScheduledScriptCount(m_scriptSchedule.size());
-
-    MMAP::MMapFactory::createOrGetMMapMgr()->unloadMapInstance(GetId(), i_InstanceId);
 }
 
 Map::Map(uint32 id, uint32 InstanceId, uint8 SpawnMode, Map* _parent) :
     _mapGridManager(this), i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(InstanceId),
     m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), _instanceResetPeriod(0),
-    _transportsUpdateIter(_transports.end()), i_scriptLock(false), _defaultLight(GetDefaultMapLight(id))
+    _transportsUpdateIter(_transports.end()), i_scriptLock(false), _defaultLight(GetDefaultMapLight(id)), _lastUpdateDuration(0),
+    _parallelRegionUpdate(false), _regionExclusiveWaiters(0), _regionExclusiveUpdates(0)
 {
     m_parentMap = (_parent ? _parent : this);
 
@@ -180,11 +180,19 @@ void Map::DeleteFromWorld(Player* player)
 
 void Map::EnsureGridCreated(GridCoord const& gridCoord)
 {
+    if (_mapGridManager.IsGridCreated(gridCoord.x_coord, gridCoord.y_coord))
+        return;
+
+    EnterExclusiveRegionUpdate();
     _mapGridManager.CreateGrid(gridCoord.x_coord, gridCoord.y_coord);
 }
 
 bool Map::EnsureGridLoaded(Cell const& cell)
 {
+    if (_mapGridManager.IsGridLoaded(cell.GridX(), cell.GridY()))
+        return false;
+
+    EnterExclusiveRegionUpdate();
     EnsureGridCreated(GridCoord(cell.GridX(), cell.GridY()));
 
     if (_mapGridManager.LoadGrid(cell.GridX(), cell.GridY()))
@@ -304,6 +312,9 @@ void Map::InitializeObject(GameObject*  /*obj*/)
 template<class T>
 bool Map::AddToMap(T* obj, bool checkTransport)
 {
+    EnterExclusiveRegionUpdate();
+    std::unique_lock<std::recursive_mutex> guard = AcquireParallelUpdateGuard();
+
     //TODO: Needs clean up. An object should not be added to map twice.
     if (obj->IsInWorld())
     {
@@ -431,6 +442,12 @@ void Map::UpdatePlayerZoneStats(uint32 oldZone, uint32 newZone)
 
 void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
 {
+    // line of sight results are only reused within one update, units move in between
+    InvalidateLineOfSightCache(false);
+
+    // paths requested during the previous update, before anything moves
+    ProcessPathRequests();
+
     if (t_diff)
         _dynamicTree.update(t_diff);
 
@@ -519,12 +536,73 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
         METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
 }
 
+void Map::QueuePathRequest(PathRequestPtr request)
+{
+    std::unique_lock<std::recursive_mutex> guard = AcquireParallelUpdateGuard();
+    _pathRequests.push_back(std::move(request));
+}
+
+void Map::ProcessPathRequests()
+{
+    if (_pathRequests.empty())
+        return;
+
+    std::vector<PathRequestPtr> requests;
+    requests.swap(_pathRequests);
+
+    // the requester holding no reference anymore cancels the request too, its owner may be gone
+    TimePoint oldestRequest = TimePoint::max();
+    std::vector<MapRegionUpdater::RegionTask> tasks;
+    tasks.reserve(requests.size());
+    for (PathRequestPtr const& request : requests)
+    {
+        if (request->IsCanceled() || request.use_count() == 1)
+            continue;
+
+        WorldObject const* owner = request->GetOwner();
+        if (!owner->IsInWorld() || owner->FindMap() != this)
+        {
+            request->Fail();
+            continue;
+        }
+
+        oldestRequest = std::min(oldestRequest, request->GetRequestTime());
+        tasks.emplace_back([&request]() { request->Compute(); });
+    }
+
+    if (tasks.empty())
+        return;
+
+    {
+        METRIC_TIMER("pathfinding_batch_time",
+            METRIC_TAG("map_id", std::to_string(GetId())),
+            METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+        // the objects of this map are not updated meanwhile, same guarantees as UpdateNonPlayerObjectsInRegions
+        sMapMgr->GetPathfindingUpdater()->Execute(tasks);
+    }
+
+    METRIC_VALUE("pathfinding_queue_depth", uint64(tasks.size()),
+        METRIC_TAG("map_id", std::to_string(GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    METRIC_VALUE("pathfinding_request_latency", std::chrono::steady_clock::now() - oldestRequest,
+        METRIC_TAG("map_id", std::to_string(GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+}
+
 void Map::UpdateNonPlayerObjects(uint32 const diff)
 {
     for (WorldObject* obj : _pendingAddUpdatableObjectList)
         _AddObjectToUpdateList(obj);
     _pendingAddUpdatableObjectList.clear();
 
+    if (CanUpdateRegionsInParallel())
+    {
+        UpdateNonPlayerObjectsInRegions(diff);
+        return;
+    }
+
     if (_updatableObjectListRecheckTimer.Passed())
     {
         for (uint32 i = 0; i < _updatableObjectList.size();)
@@ -562,11 +640,214 @@ void Map::UpdateNonPlayerObjects(uint32 const diff)
     }
 }
 
+bool Map::CanUpdateRegionsInParallel() const
+{
+    if (!sMapMgr->GetMapRegionUpdater()->IsActive())
+        return false;
+
+    return _updatableObjectList.size() >= sWorld->getIntConfig(CONFIG_MAP_UPDATE_REGION_MIN_OBJECTS);
+}
+
+void Map::UpdateNonPlayerObjectsInRegions(uint32 const diff)
+{
+    // Regions are squares of cells at least MAP_REGION_SIZE_IN_BORDERS visibility ranges wide, updated in four phases
+    // so that regions updated at the same time are never adjacent. Objects within one visibility range of a region edge
+    // are buffered and updated serially afterwards, so objects updated at the same time never see the same cells.
+    // Objects that can see or move other objects further away (transports, passengers, far visible objects) are serial too.
+    uint32 const borderCells = std::max<uint32>(1, uint32(std::ceil(GetVisibilityRange() / SIZE_OF_GRID_CELL)));
+    uint32 const regionCells = std::max<uint32>(MAX_NUMBER_OF_CELLS, borderCells * MAP_REGION_SIZE_IN_BORDERS);
+    uint32 const regionsPerSide = (TOTAL_NUMBER_OF_CELLS_PER_MAP + regionCells - 1) / regionCells;
+
+    std::array<std::unordered_map<uint32 /*regionId*/, std::vector<uint32>>, MAP_REGION_UPDATE_PHASES> phaseRegions;
+    std::vector<uint32> serialObjects;
+
+    for (uint32 i = 0; i < _updatableObjectList.size(); ++i)
+    {
+        WorldObject* obj = _updatableObjectList[i];
+        if (!obj->IsInWorld())
+            continue;
+
+        CellCoord const cellCoord = Acore::ComputeCellCoord(obj->GetPositionX(), obj->GetPositionY());
+        if (!cellCoord.IsCoordValid() || obj->IsVisibilityOverridden() || obj->GetTransport() ||
+            (obj->IsGameObject() && obj->ToGameObject()->IsTransport()))
+        {
+            serialObjects.push_back(i);
+            continue;
+        }
+
+        uint32 const regionX = cellCoord.x_coord / regionCells;
+        uint32 const regionY = cellCoord.y_coord / regionCells;
+        uint32 const cellX = cellCoord.x_coord % regionCells;
+        uint32 const cellY = cellCoord.y_coord % regionCells;
+
+        if (cellX < borderCells || cellX >= regionCells - borderCells || cellY < borderCells || cellY >= regionCells - borderCells ||
+            !IsGridLoaded(GridCoord(cellCoord.x_coord / MAX_NUMBER_OF_CELLS, cellCoord.y_coord / MAX_NUMBER_OF_CELLS)))
+        {
+            serialObjects.push_back(i);
+            continue;
+        }
+
+        uint32 const phase = (regionX & 1) | ((regionY & 1) << 1);
+        phaseRegions[phase][regionY * regionsPerSide + regionX].push_back(i);
+    }
+
+    // Stays set until the merge phase is done, removals from the update list must keep indexes stable
+    _parallelRegionUpdate = true;
+
+    std::size_t parallelObjects = 0;
+    std::vector<MapRegionUpdater::RegionTask> tasks;
+    for (std::unordered_map<uint32, std::vector<uint32>> const& regions : phaseRegions)
+    {
+        tasks.clear();
+        for (auto const& [regionId, indexes] : regions)
+        {
+            parallelObjects += indexes.size();
+            uint32 const regionX = regionId % regionsPerSide;
+            uint32 const regionY = regionId / regionsPerSide;
+            CellCoord const regionLow(regionX * regionCells, regionY * regionCells);
+            CellCoord const regionHigh(std::min<uint32>((regionX + 1) * regionCells, TOTAL_NUMBER_OF_CELLS_PER_MAP) - 1,
+                std::min<uint32>((regionY + 1) * regionCells, TOTAL_NUMBER_OF_CELLS_PER_MAP) - 1);
+            tasks.emplace_back([this, &indexes, regionLow, regionHigh, diff]() { UpdateRegionObjects(indexes, regionLow, regionHigh, diff); });
+        }
+
+        sMapMgr->GetMapRegionUpdater()->Execute(tasks);
+    }
+
+    // Merge phase, everything that could not be isolated in a region
+    for (uint32 index : serialObjects)
+    {
+        // Slots of objects removed from the update list during the parallel phase are cleared, not reused
+        WorldObject* obj = _updatableObjectList[index];
+        if (obj && obj->IsInWorld())
+            obj->Update(diff);
+    }
+
+    _parallelRegionUpdate = false;
+
+    bool const recheck = _updatableObjectListRecheckTimer.Passed();
+    CompactUpdatableObjectList(recheck);
+    if (recheck)
+        _updatableObjectListRecheckTimer.Reset();
+
+    METRIC_VALUE("map_region_parallel_objects", uint64(parallelObjects),
+        METRIC_TAG("map_id", std::to_string(GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    METRIC_VALUE("map_region_serial_objects", uint64(serialObjects.size()),
+        METRIC_TAG("map_id", std::to_string(GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    METRIC_VALUE("map_region_exclusive_updates", uint64(_regionExclusiveUpdates.exchange(0, std::memory_order_relaxed)),
+        METRIC_TAG("map_id", std::to_string(GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+}
+
+namespace
+{
+    // Map whose region the current thread updates, and whether the object it updates stopped the other regions
+    thread_local Map* t_regionUpdateMap = nullptr;
+    thread_local bool t_regionUpdateExclusive = false;
+    // cells of the region the current thread updates, both included
+    thread_local CellCoord t_regionLow;
+    thread_local CellCoord t_regionHigh;
+}
+
+void Map::UpdateRegionObjects(std::vector<uint32> const& indexes, CellCoord const& regionLow, CellCoord const& regionHigh, uint32 const diff)
+{
+    t_regionUpdateMap = this;
+    t_regionLow = regionLow;
+    t_regionHigh = regionHigh;
+
+    for (uint32 index : indexes)
+    {
+        // let a region waiting for exclusive access go first, the shared side of the lock would starve it
+        while (_regionExclusiveWaiters.load(std::memory_order_acquire))
+            std::this_thread::yield();
+
+        _regionUpdateLock.lock_shared();
+
+        // Slots of objects removed from the update list during the parallel phase are cleared, not reused
+        WorldObject* obj = _updatableObjectList[index];
+        if (obj && obj->IsInWorld())
+            obj->Update(diff);
+
+        if (t_regionUpdateExclusive)
+        {
+            t_regionUpdateExclusive = false;
+            _regionUpdateLock.unlock();
+        }
+        else
+            _regionUpdateLock.unlock_shared();
+    }
+
+    t_regionUpdateMap = nullptr;
+}
+
+void Map::EnterExclusiveRegionUpdate()
+{
+    if (t_regionUpdateMap != this || t_regionUpdateExclusive)
+        return;
+
+    // the other regions finish the object they are updating, then wait until this object is updated
+    _regionExclusiveWaiters.fetch_add(1, std::memory_order_acq_rel);
+    _regionUpdateLock.unlock_shared();
+    _regionUpdateLock.lock();
+    _regionExclusiveWaiters.fetch_sub(1, std::memory_order_acq_rel);
+
+    t_regionUpdateExclusive = true;
+    _regionExclusiveUpdates.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Map::EnterExclusiveRegionUpdate(WorldObject const* obj)
+{
+    if (!t_regionUpdateMap || t_regionUpdateExclusive)
+        return;
+
+    // objects away from the region, on transports or out of the world may be used by any other region
+    if (obj->FindMap() == t_regionUpdateMap && obj->IsInWorld() && !obj->GetTransport())
+    {
+        CellCoord const cellCoord = Acore::ComputeCellCoord(obj->GetPositionX(), obj->GetPositionY());
+        if (cellCoord.IsCoordValid() &&
+            cellCoord.x_coord >= t_regionLow.x_coord && cellCoord.x_coord <= t_regionHigh.x_coord &&
+            cellCoord.y_coord >= t_regionLow.y_coord && cellCoord.y_coord <= t_regionHigh.y_coord)
+            return;
+    }
+
+    t_regionUpdateMap->EnterExclusiveRegionUpdate();
+}
+
+void Map::CompactUpdatableObjectList(bool removeNotNeeded)
+{
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < _updatableObjectList.size(); ++i)
+    {
+        WorldObject* obj = _updatableObjectList[i];
+        if (!obj)
+            continue;
+
+        UpdatableMapObject* mapUpdatableObject = dynamic_cast<UpdatableMapObject*>(obj);
+        if (removeNotNeeded && obj->IsInWorld() && !obj->IsUpdateNeeded())
+        {
+            mapUpdatableObject->SetUpdateState(UpdatableMapObject::UpdateState::NotUpdating);
+            continue;
+        }
+
+        _updatableObjectList[kept] = obj;
+        mapUpdatableObject->SetMapUpdateListOffset(kept);
+        ++kept;
+    }
+
+    _updatableObjectList.resize(kept);
+}
+
 void Map::AddObjectToPendingUpdateList(WorldObject* obj)
 {
     if (!obj->CanBeAddedToMapUpdateList())
         return;
 
+    std::unique_lock<std::recursive_mutex> guard = AcquireParallelUpdateGuard();
+
+
     UpdatableMapObject* mapUpdatableObject = dynamic_cast<UpdatableMapObject*>(obj);
     if (mapUpdatableObject->GetUpdateState() != UpdatableMapObject::UpdateState::NotUpdating)
         return;
@@ -592,6 +873,14 @@ void Map::_RemoveObjectFromUpdateList(WorldObject* obj)
     UpdatableMapObject* mapUpdatableObject = dynamic_cast<UpdatableMapObject*>(obj);
     ASSERT(mapUpdatableObject && mapUpdatableObject->GetUpdateState() == UpdatableMapObject::UpdateState::Updating);
 
+    // Indexes must stay stable while regions are updated, the list is compacted once they are done
+    if (_parallelRegionUpdate)
+    {
+        _updatableObjectList[mapUpdatableObject->GetMapUpdateListOffset()] = nullptr;
+        mapUpdatableObject->SetUpdateState(UpdatableMapObject::UpdateState::NotUpdating);
+        return;
+    }
+
     if (obj != _updatableObjectList.back())
     {
         dynamic_cast<UpdatableMapObject*>(_updatableObjectList.back())->SetMapUpdateListOffset(mapUpdatableObject->GetMapUpdateListOffset());
@@ -607,6 +896,8 @@ void Map::RemoveObjectFromMapUpdateList(WorldObject* obj)
     if (!obj->CanBeAddedToMapUpdateList())
         return;
 
+    std::unique_lock<std::recursive_mutex> guard = AcquireParallelUpdateGuard();
+
     UpdatableMapObject* mapUpdatableObject = dynamic_cast<UpdatableMapObject*>(obj);
     if (mapUpdatableObject->GetUpdateState() == UpdatableMapObject::UpdateState::PendingAdd)
         _pendingAddUpdatableObjectList.erase(obj);
@@ -656,11 +947,13 @@ void Map::RemoveWorldObjectFromFarVisibleMap(WorldObject* obj)
 // Used in VisibilityDistanceType::Infinite
 void Map::AddWorldObjectToZoneWideVisibleMap(uint32 zoneId, WorldObject* obj)
 {
+    std::unique_lock<std::recursive_mutex> guard = AcquireParallelUpdateGuard();
     _zoneWideVisibleWorldObjectsMap[zoneId].insert(obj);
 }
 
 void Map::RemoveWorldObjectFromZoneWideVisibleMap(uint32 zoneId, WorldObject* obj)
 {
+    std::unique_lock<std::recursive_mutex> guard = AcquireParallelUpdateGuard();
     ZoneWideVisibleWorldObjectsMap::iterator itr = _zoneWideVisibleWorldObjectsMap.find(zoneId);
     if (itr == _zoneWideVisibleWorldObjectsMap.end())
         return;
@@ -726,6 +1019,9 @@ void Map::AfterPlayerUnlinkFromMap()
 template<class T>
 void Map::RemoveFromMap(T* obj, bool remove)
 {
+    EnterExclusiveRegionUpdate();
+    std::unique_lock<std::recursive_mutex> guard = AcquireParallelUpdateGuard();
+
     obj->RemoveFromWorld();
 
     obj->RemoveFromGrid();
@@ -868,6 +1164,7 @@ void Map::DynamicObjectRelocation(DynamicObject* dynObj, float x, float y, float
 
 void Map::AddCreatureToMoveList(Creature* c)
 {
+    std::unique_lock<std::recursive_mutex> guard = AcquireParallelUpdateGuard();
     if (c->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
         _creaturesToMove.push_back(c);
     c->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
@@ -881,6 +1178,7 @@ void Map::RemoveCreatureFromMoveList(Creature* c)
 
 void Map::AddGameObjectToMoveList(GameObject* go)
 {
+    std::unique_lock<std::recursive_mutex> guard = AcquireParallelUpdateGuard();
     if (go->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
         _gameObjectsToMove.push_back(go);
     go->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
@@ -894,6 +1192,7 @@ void Map::RemoveGameObjectFromMoveList(GameObject* go)
 
 void Map::AddDynamicObjectToMoveList(DynamicObject* dynObj)
 {
+    std::unique_lock<std::recursive_mutex> guard = AcquireParallelUpdateGuard();
     if (dynObj->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
         _dynamicObjectsToMove.push_back(dynObj);
     dynObj->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
@@ -1094,10 +1393,10 @@ GridTerrainData* Map::GetGridTerrainData(float x, float y)
     return GetGridTerrainData(gridCoord);
 }
 
-float Map::GetWaterOrGroundLevel(uint32 phasemask, float x, float y, float z, float* ground /*= nullptr*/, bool /*swim = false*/, float collisionHeight) const
+float Map::GetWaterOrGroundLevel(uint32 phasemask, float x, float y, float z, float* ground /*= nullptr*/, bool /*swim = false*/, float collisionHeight, Optional<float> gridHeight /*= {}*/) const
 {
     // we need ground level (including grid height version) for proper return water level in point
-    float ground_z = GetHeight(phasemask, x, y, z + Z_OFFSET_FIND_HEIGHT, true, 50.0f);
+    float ground_z = GetHeight(phasemask, x, y, z + Z_OFFSET_FIND_HEIGHT, true, 50.0f, gridHeight);
     if (ground)
         *ground = ground_z;
 
@@ -1142,13 +1441,15 @@ Transport* Map::GetTransportForPos(uint32 phase, float x, float y, float z, Worl
     return nullptr;
 }
 
-float Map::GetHeight(float x, float y, float z, bool checkVMap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/) const
+float Map::GetHeight(float x, float y, float z, bool checkVMap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/, Optional<float> gridHeight /*= {}*/) const
 {
     // find raw .map surface under Z coordinates
     float mapHeight = VMAP_INVALID_HEIGHT_VALUE;
-    float gridHeight = GetGridHeight(x, y);
-    if (G3D::fuzzyGe(z, gridHeight - GROUND_HEIGHT_TOLERANCE))
-        mapHeight = gridHeight;
+    if (!gridHeight)
+        gridHeight = GetGridHeight(x, y);
+
+    if (G3D::fuzzyGe(z, *gridHeight - GROUND_HEIGHT_TOLERANCE))
+        mapHeight = *gridHeight;
 
     float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;
     if (checkVMap)
@@ -1187,6 +1488,26 @@ float Map::GetGridHeight(float x, float y) const
     return INVALID_HEIGHT;
 }
 
+void Map::GetGridHeights(G3D::Vector3 const* points, float* heights, std::size_t count) const
+{
+    std::size_t first = 0;
+    while (first < count)
+    {
+        GridCoord const gridCoord = Acore::ComputeGridCoord(points[first].x, points[first].y);
+
+        std::size_t last = first + 1;
+        while (last < count && Acore::ComputeGridCoord(points[last].x, points[last].y) == gridCoord)
+            ++last;
+
+        if (GridTerrainData* gmap = const_cast<Map*>(this)->GetGridTerrainData(gridCoord))
+            gmap->getHeights(&points[first], &heights[first], last - first);
+        else
+            std::fill(&heights[first], &heights[last], INVALID_HEIGHT);
+
+        first = last;
+    }
+}
+
 float Map::GetMinHeight(float x, float y) const
 {
     if (GridTerrainData const* grid = const_cast<Map*>(this)->GetGridTerrainData(x, y))
@@ -1529,7 +1850,7 @@ float Map::GetWaterLevel(float x, float y) const
     return INVALID_HEIGHT;
 }
 
-bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
+VMAP::ModelIgnoreFlags Map::GetVMapLineOfSightIgnoreFlags(VMAP::ModelIgnoreFlags ignoreFlags) const
 {
     if (!sWorld->getBoolConfig(CONFIG_VMAP_BLIZZLIKE_PVP_LOS))
     {
@@ -1547,9 +1868,31 @@ bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, floa
         }
     }
 
-    if ((checks & LINEOFSIGHT_CHECK_VMAP) && !VMAP::VMapFactory::createOrGetVMapMgr()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2, ignoreFlags))
+    return ignoreFlags;
+}
+
+bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
+{
+    ignoreFlags = GetVMapLineOfSightIgnoreFlags(ignoreFlags);
+
+    bool const useCache = sWorld->getBoolConfig(CONFIG_VMAP_LOS_CACHE);
+
+    if (checks & LINEOFSIGHT_CHECK_VMAP)
     {
-        return false;
+        // vmaps do not depend on the phase, results are shared by all phases
+        LineOfSightCache::Key key = LineOfSightCache::MakeKey(x1, y1, z1, x2, y2, z2, 0, uint32(ignoreFlags));
+        Optional<bool> inLineOfSight = useCache ? _vmapLosCache.Get(key) : Optional<bool>();
+        if (!inLineOfSight)
+        {
+            inLineOfSight = VMAP::VMapFactory::createOrGetVMapMgr()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2, ignoreFlags);
+            if (useCache)
+                _vmapLosCache.Set(key, *inLineOfSight);
+        }
+
+        if (!*inLineOfSight)
+        {
+            return false;
+        }
     }
 
     if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT_ALL))
@@ -1560,7 +1903,16 @@ bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, floa
             ignoreFlags = VMAP::ModelIgnoreFlags::M2;
         }
 
-        if (!_dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask, ignoreFlags))
+        LineOfSightCache::Key key = LineOfSightCache::MakeKey(x1, y1, z1, x2, y2, z2, phasemask, uint32(ignoreFlags));
+        Optional<bool> inLineOfSight = useCache ? _dynamicLosCache.Get(key) : Optional<bool>();
+        if (!inLineOfSight)
+        {
+            inLineOfSight = _dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask, ignoreFlags);
+            if (useCache)
+                _dynamicLosCache.Set(key, *inLineOfSight);
+        }
+
+        if (!*inLineOfSight)
         {
             return false;
         }
@@ -1569,6 +1921,42 @@ bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, floa
     return true;
 }
 
+void Map::PrefetchVMapLineOfSight(float x, float y, float z, std::vector<G3D::Vector3> const& targets, VMAP::ModelIgnoreFlags ignoreFlags) const
+{
+    if (targets.empty() || !sWorld->getBoolConfig(CONFIG_VMAP_LOS_CACHE))
+        return;
+
+    ignoreFlags = GetVMapLineOfSightIgnoreFlags(ignoreFlags);
+
+    std::vector<LineOfSightCache::Key> keys;
+    std::vector<G3D::Vector3> missing;
+    for (G3D::Vector3 const& target : targets)
+    {
+        LineOfSightCache::Key key = LineOfSightCache::MakeKey(x, y, z, target.x, target.y, target.z, 0, uint32(ignoreFlags));
+        if (_vmapLosCache.Get(key))
+            continue;
+
+        keys.push_back(key);
+        missing.push_back(target);
+    }
+
+    if (missing.empty())
+        return;
+
+    std::unique_ptr<bool[]> results = std::make_unique<bool[]>(missing.size());
+    VMAP::VMapFactory::createOrGetVMapMgr()->isInLineOfSight(GetId(), x, y, z, missing.data(), results.get(), missing.size(), ignoreFlags);
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        _vmapLosCache.Set(keys[i], results[i]);
+}
+
+void Map::InvalidateLineOfSightCache(bool gameObjectsOnly) const
+{
+    if (!gameObjectsOnly)
+        _vmapLosCache.Invalidate();
+
+    _dynamicLosCache.Invalidate();
+}
+
 bool Map::GetObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist)
 {
     G3D::Vector3 startPos(x1, y1, z1);
@@ -1583,10 +1971,10 @@ bool Map::GetObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float
     return result;
 }
 
-float Map::GetHeight(uint32 phasemask, float x, float y, float z, bool vmap/*=true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/) const
+float Map::GetHeight(uint32 phasemask, float x, float y, float z, bool vmap/*=true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/, Optional<float> gridHeight /*= {}*/) const
 {
     float h1, h2;
-    h1 = GetHeight(x, y, z, vmap, maxSearchDist);
+    h1 = GetHeight(x, y, z, vmap, maxSearchDist, gridHeight);
     h2 = _dynamicTree.getHeight(x, y, z, maxSearchDist, phasemask);
     return std::max<float>(h1, h2);
 }
@@ -1786,6 +2174,7 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 
     obj->CleanupsBeforeDelete(false);                            // remove or simplify at least cross referenced links
 
+    std::unique_lock<std::recursive_mutex> guard = AcquireParallelUpdateGuard();
     i_objectsToRemove.insert(obj);
     //LOG_DEBUG("maps", "Object ({}) added to removing list.", obj->GetGUID().ToString());
 }
@@ -2402,7 +2791,10 @@ void Map::SaveCreatureRespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTi
     if (GetInstanceResetPeriod() > 0 && respawnTime - now + 5 >= GetInstanceResetPeriod())
         respawnTime = now + YEAR;
 
-    _creatureRespawnTimes[spawnId] = respawnTime;
+    {
+        std::unique_lock<std::recursive_mutex> guard = AcquireParallelUpdateGuard();
+        _creatureRespawnTimes[spawnId] = respawnTime;
+    }
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CREATURE_RESPAWN);
     stmt->SetData(0, spawnId);
@@ -2414,6 +2806,7 @@ void Map::SaveCreatureRespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTi
 
 void Map::RemoveCreatureRespawnTime(ObjectGuid::LowType spawnId)
 {
+    std::unique_lock<std::recursive_mutex> guard = AcquireParallelUpdateGuard();
     _creatureRespawnTimes.erase(spawnId);
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CREATURE_RESPAWN);
@@ -2436,7 +2829,10 @@ void Map::SaveGORespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTime)
     if (GetInstanceResetPeriod() > 0 && respawnTime - now + 5 >= GetInstanceResetPeriod())
         respawnTime = now + YEAR;
 
-    _goRespawnTimes[spawnId] = respawnTime;
+    {
+        std::unique_lock<std::recursive_mutex> guard = AcquireParallelUpdateGuard();
+        _goRespawnTimes[spawnId] = respawnTime;
+    }
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_GO_RESPAWN);
     stmt->SetData(0, spawnId);
@@ -2448,6 +2844,7 @@ void Map::SaveGORespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTime)
 
 void Map::RemoveGORespawnTime(ObjectGuid::LowType spawnId)
 {
+    std::unique_lock<std::recursive_mutex> guard = AcquireParallelUpdateGuard();
     _goRespawnTimes.erase(spawnId);
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GO_RESPAWN);
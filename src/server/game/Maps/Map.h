@@ -27,18 +27,22 @@
 #include "GameObjectModel.h"
 #include "GridDefines.h"
 #include "GridRefMgr.h"
+#include "LineOfSightCache.h"
 #include "MapGridManager.h"
 #include "MapRefMgr.h"
 #include "ObjectDefines.h"
 #include "ObjectGuid.h"
 #include "PathGenerator.h"
+#include "PathRequest.h"
 #include "Position.h"
 #include "SharedDefines.h"
 #include "Timer.h"
 #include "GridTerrainData.h"
+#include <atomic>
 #include <bitset>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
 
 class Unit;
@@ -89,6 +93,8 @@ struct ScriptAction
 #define DEFAULT_HEIGHT_SEARCH     50.0f                     // default search distance to find height at nearby locations
 #define MIN_UNLOAD_DELAY      1                             // immediate unload
 #define UPDATABLE_OBJECT_LIST_RECHECK_TIMER 30 * IN_MILLISECONDS // Time to recheck update object list
+#define MAP_REGION_UPDATE_PHASES  4                         // regions updated in parallel never share an edge or a corner
+#define MAP_REGION_SIZE_IN_BORDERS 4                        // width of a region in visibility ranges, objects within one range of its edge are updated serially
 
 struct PositionFullTerrainStatus
 {
@@ -238,8 +244,11 @@ public:
 
     // some calls like isInWater should not use vmaps due to processor power
     // can return INVALID_HEIGHT if under z+2 z coord not found height
-    [[nodiscard]] float GetHeight(float x, float y, float z, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
+    // gridHeight: result of GetGridHeight for x, y when already known, e.g. from GetGridHeights
+    [[nodiscard]] float GetHeight(float x, float y, float z, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH, Optional<float> gridHeight = {}) const;
     [[nodiscard]] float GetGridHeight(float x, float y) const;
+    // GetGridHeight for count points at once, consecutive points in the same grid are batched
+    void GetGridHeights(G3D::Vector3 const* points, float* heights, std::size_t count) const;
     [[nodiscard]] float GetMinHeight(float x, float y) const;
     Transport* GetTransportForPos(uint32 phase, float x, float y, float z, WorldObject* worldobject = nullptr);
 
@@ -345,7 +354,12 @@ public:
     DynamicObject* GetDynamicObject(ObjectGuid const& guid);
     Pet* GetPet(ObjectGuid const& guid);
 
-    MapStoredObjectTypesContainer& GetObjectsStore() { return _objectsStore; }
+    // for adding and removing objects, lookups go through the getters above
+    MapStoredObjectTypesContainer& GetObjectsStore()
+    {
+        EnterExclusiveRegionUpdate();
+        return _objectsStore;
+    }
 
     typedef std::unordered_multimap<ObjectGuid::LowType, Creature*> CreatureBySpawnIdContainer;
     CreatureBySpawnIdContainer& GetCreatureBySpawnIdStore() { return _creatureBySpawnIdStore; }
@@ -380,16 +394,22 @@ public:
     BattlegroundMap* ToBattlegroundMap() { if (IsBattlegroundOrArena()) return reinterpret_cast<BattlegroundMap*>(this); else return nullptr;  }
     [[nodiscard]] BattlegroundMap const* ToBattlegroundMap() const { if (IsBattlegroundOrArena()) return reinterpret_cast<BattlegroundMap const*>(this); return nullptr; }
 
-    float GetWaterOrGroundLevel(uint32 phasemask, float x, float y, float z, float* ground = nullptr, bool swim = false, float collisionHeight = DEFAULT_COLLISION_HEIGHT) const;
-    [[nodiscard]] float GetHeight(uint32 phasemask, float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
+    float GetWaterOrGroundLevel(uint32 phasemask, float x, float y, float z, float* ground = nullptr, bool swim = false, float collisionHeight = DEFAULT_COLLISION_HEIGHT, Optional<float> gridHeight = {}) const;
+    [[nodiscard]] float GetHeight(uint32 phasemask, float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH, Optional<float> gridHeight = {}) const;
     [[nodiscard]] bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
+    // Traces the vmap rays from one position to all targets at once into the line of sight cache, for the isInLineOfSight calls that follow
+    void PrefetchVMapLineOfSight(float x, float y, float z, std::vector<G3D::Vector3> const& targets, VMAP::ModelIgnoreFlags ignoreFlags) const;
     bool CanReachPositionAndGetValidCoords(WorldObject const* source, PathGenerator *path, float &destX, float &destY, float &destZ, bool failOnCollision = true, bool failOnSlopes = true) const;
     bool CanReachPositionAndGetValidCoords(WorldObject const* source, float &destX, float &destY, float &destZ, bool failOnCollision = true, bool failOnSlopes = true) const;
     bool CanReachPositionAndGetValidCoords(WorldObject const* source, float startX, float startY, float startZ, float &destX, float &destY, float &destZ, bool failOnCollision = true, bool failOnSlopes = true) const;
     bool CheckCollisionAndGetValidCoords(WorldObject const* source, float startX, float startY, float startZ, float &destX, float &destY, float &destZ, bool failOnCollision = true) const;
+    // Computed at the start of the next update, see PathRequest
+    void QueuePathRequest(PathRequestPtr request);
     void Balance() { _dynamicTree.balance(); }
-    void RemoveGameObjectModel(const GameObjectModel& model) { _dynamicTree.remove(model); }
-    void InsertGameObjectModel(const GameObjectModel& model) { _dynamicTree.insert(model); }
+    void RemoveGameObjectModel(const GameObjectModel& model) { _dynamicTree.remove(model); _dynamicLosCache.Invalidate(); }
+    void InsertGameObjectModel(const GameObjectModel& model) { _dynamicTree.insert(model); _dynamicLosCache.Invalidate(); }
+    // Drops the cached line of sight results, for collision changes made outside of this map (vmap tiles, gameobject collision toggles)
+    void InvalidateLineOfSightCache(bool gameObjectsOnly) const;
     [[nodiscard]] bool ContainsGameObjectModel(const GameObjectModel& model) const { return _dynamicTree.contains(model);}
     [[nodiscard]] DynamicMapTree const& GetDynamicMapTree() const { return _dynamicTree; }
     bool GetObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist);
@@ -480,21 +500,28 @@ public:
     inline ObjectGuid::LowType GenerateLowGuid()
     {
         static_assert(ObjectGuidTraits<high>::MapSpecific, "Only map specific guid can be generated in Map context");
+        std::unique_lock<std::recursive_mutex> guard = AcquireParallelUpdateGuard();
         return GetGuidSequenceGenerator<high>().Generate();
     }
 
     void AddUpdateObject(Object* obj)
     {
+        std::unique_lock<std::recursive_mutex> guard = AcquireParallelUpdateGuard();
         _updateObjects.insert(obj);
     }
 
     void RemoveUpdateObject(Object* obj)
     {
+        std::unique_lock<std::recursive_mutex> guard = AcquireParallelUpdateGuard();
         _updateObjects.erase(obj);
     }
 
     size_t GetUpdatableObjectsCount() const { return _updatableObjectList.size(); }
 
+    // Smoothed duration of the previous updates of this map, used by MapUpdater to schedule expensive maps first
+    [[nodiscard]] Microseconds GetLastUpdateDuration() const { return _lastUpdateDuration; }
+    void SetLastUpdateDuration(Microseconds duration) { _lastUpdateDuration = (_lastUpdateDuration * 3 + duration) / 4; }
+
     virtual std::string GetDebugInfo() const;
 
     uint32 GetCreatedGridsCount();
@@ -522,6 +549,15 @@ public:
         return 0;
     };
 
+    // Stops the updates of the other regions until the object updated by the calling region thread is done, no-op outside of region threads.
+    // Called before changing what other regions may read: adding or removing objects, creating or loading grids, scheduling scripts,
+    // and before the callbacks of a death or a kill, which reach objects anywhere on the map.
+    // Must not be called while holding the guard of AcquireParallelUpdateGuard, the other regions may be waiting for it.
+    void EnterExclusiveRegionUpdate();
+    // Same, unless obj lies in the region updated by the calling thread. Called before changing an object linked to the
+    // updated one regardless of distance, like the other side of a threat reference or a single target aura.
+    static void EnterExclusiveRegionUpdate(WorldObject const* obj);
+
 private:
 
     template<class T> void InitializeObject(T* obj);
@@ -543,6 +579,9 @@ private:
 
     void SendObjectUpdates();
 
+    // the model flags ignored by the vmap line of sight checks on this map
+    VMAP::ModelIgnoreFlags GetVMapLineOfSightIgnoreFlags(VMAP::ModelIgnoreFlags ignoreFlags) const;
+
 protected:
     // Type specific code for add/remove to/from grid
     template<class T>
@@ -558,6 +597,8 @@ protected:
     uint32 m_unloadTimer;
     float m_VisibleDistance;
     DynamicMapTree _dynamicTree;
+    mutable LineOfSightCache _vmapLosCache;
+    mutable LineOfSightCache _dynamicLosCache;
     time_t _instanceResetPeriod; // pussywizard
 
     MapRefMgr m_mapRefMgr;
@@ -592,6 +633,23 @@ private:
     void DeleteFromWorld(T*);
 
     void UpdateNonPlayerObjects(uint32 const diff);
+    void ProcessPathRequests();
+
+    // Parallel update of non player objects, see MapUpdate.ParallelRegions.Threads
+    [[nodiscard]] bool CanUpdateRegionsInParallel() const;
+    void UpdateNonPlayerObjectsInRegions(uint32 const diff);
+    void CompactUpdatableObjectList(bool removeNotNeeded);
+
+    void UpdateRegionObjects(std::vector<uint32> const& indexes, CellCoord const& regionLow, CellCoord const& regionHigh, uint32 const diff);
+
+    // Serializes access to map wide containers while regions are updated in parallel, no-op otherwise
+    std::unique_lock<std::recursive_mutex> AcquireParallelUpdateGuard()
+    {
+        if (!_parallelRegionUpdate)
+            return std::unique_lock<std::recursive_mutex>();
+
+        return std::unique_lock<std::recursive_mutex>(_parallelUpdateLock);
+    }
 
     void _AddObjectToUpdateList(WorldObject* obj);
     void _RemoveObjectFromUpdateList(WorldObject* obj);
@@ -631,6 +689,16 @@ private:
     PendingAddUpdatableObjectList _pendingAddUpdatableObjectList;
     IntervalTimer _updatableObjectListRecheckTimer;
     ZoneWideVisibleWorldObjectsMap _zoneWideVisibleWorldObjectsMap;
+
+    Microseconds _lastUpdateDuration;
+
+    std::vector<PathRequestPtr> _pathRequests;
+
+    bool _parallelRegionUpdate;
+    std::recursive_mutex _parallelUpdateLock;
+    std::shared_mutex _regionUpdateLock;                // shared by region threads while they update one object, see EnterExclusiveRegionUpdate
+    std::atomic<uint32> _regionExclusiveWaiters;
+    std::atomic<uint32> _regionExclusiveUpdates;
 };
 
 enum InstanceResetMethod
@@ -59,6 +59,12 @@ void MapMgr::Initialize()
     // Start mtmaps if needed
     if (num_threads > 0)
         m_updater.activate(num_threads);
+
+    if (uint32 regionThreads = sWorld->getIntConfig(CONFIG_MAP_UPDATE_REGION_THREADS))
+        m_regionUpdater.Activate(regionThreads);
+
+    if (uint32 pathfindingThreads = sWorld->getIntConfig(CONFIG_MMAP_ASYNC_PATHFINDING_THREADS))
+        m_pathfindingUpdater.Activate(pathfindingThreads);
 }
 
 void MapMgr::InitializeVisibilityDistanceInfo()
@@ -335,6 +341,12 @@ void MapMgr::UnloadAll()
 
     if (m_updater.activated())
         m_updater.deactivate();
+
+    if (m_regionUpdater.IsActive())
+        m_regionUpdater.Deactivate();
+
+    if (m_pathfindingUpdater.IsActive())
+        m_pathfindingUpdater.Deactivate();
 }
 
 void MapMgr::GetNumInstances(uint32& dungeons, uint32& battlegrounds, uint32& arenas)
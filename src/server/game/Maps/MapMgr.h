@@ -22,6 +22,7 @@
 #include "Define.h"
 #include "Map.h"
 #include "MapInstanced.h"
+#include "MapRegionUpdater.h"
 #include "MapUpdater.h"
 #include "Object.h"
 #include "Timer.h"
@@ -151,6 +152,9 @@ public:
     uint32 GenerateInstanceId();
 
     MapUpdater* GetMapUpdater() { return &m_updater; }
+    MapRegionUpdater* GetMapRegionUpdater() { return &m_regionUpdater; }
+    // Computes the queued PathRequest of a map at the start of its update
+    MapRegionUpdater* GetPathfindingUpdater() { return &m_pathfindingUpdater; }
 
     template<typename Worker>
     void DoForAllMaps(Worker&& worker);
@@ -176,6 +180,8 @@ private:
     InstanceIds _instanceIds;
     uint32 _nextInstanceId;
     MapUpdater m_updater;
+    MapRegionUpdater m_regionUpdater;
+    MapRegionUpdater m_pathfindingUpdater;
 };
 
 template<typename Worker>
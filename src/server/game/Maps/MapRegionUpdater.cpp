@@ -0,0 +1,108 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapRegionUpdater.h"
+#include "DatabaseEnv.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+struct MapRegionUpdater::TaskBatch
+{
+    explicit TaskBatch(std::vector<RegionTask> const& tasks) : Tasks(tasks), TaskCount(tasks.size()), NextTask(0), FinishedTasks(0) { }
+
+    // Only valid while the batch is not finished, Execute() returns right after
+    std::vector<RegionTask> const& Tasks;
+    std::size_t const TaskCount;
+    std::atomic<std::size_t> NextTask;
+    std::atomic<std::size_t> FinishedTasks;
+    std::mutex Lock;
+    std::condition_variable Finished;
+};
+
+void MapRegionUpdater::Activate(std::size_t numThreads)
+{
+    _workerThreads.reserve(numThreads);
+    for (std::size_t i = 0; i < numThreads; ++i)
+        _workerThreads.emplace_back(&MapRegionUpdater::WorkerThread, this);
+}
+
+void MapRegionUpdater::Deactivate()
+{
+    _queue.Cancel();
+
+    for (std::thread& thread : _workerThreads)
+        if (thread.joinable())
+            thread.join();
+
+    _workerThreads.clear();
+}
+
+void MapRegionUpdater::Execute(std::vector<RegionTask> const& tasks)
+{
+    if (tasks.empty())
+        return;
+
+    std::shared_ptr<TaskBatch> batch = std::make_shared<TaskBatch>(tasks);
+
+    // The calling thread runs tasks too, so only wake up as many workers as there are remaining tasks
+    std::size_t const helpers = std::min(_workerThreads.size(), tasks.size() - 1);
+    for (std::size_t i = 0; i < helpers; ++i)
+        _queue.Push(batch);
+
+    RunTasks(*batch);
+
+    std::unique_lock<std::mutex> guard(batch->Lock);
+    batch->Finished.wait(guard, [&batch]
+    {
+        return batch->FinishedTasks.load(std::memory_order_acquire) == batch->TaskCount;
+    });
+}
+
+void MapRegionUpdater::RunTasks(TaskBatch& batch)
+{
+    std::size_t const count = batch.TaskCount;
+    for (std::size_t i = batch.NextTask.fetch_add(1); i < count; i = batch.NextTask.fetch_add(1))
+    {
+        batch.Tasks[i]();
+
+        if (batch.FinishedTasks.fetch_add(1, std::memory_order_acq_rel) + 1 == count)
+        {
+            std::lock_guard<std::mutex> guard(batch.Lock);
+            batch.Finished.notify_all();
+        }
+    }
+}
+
+void MapRegionUpdater::WorkerThread()
+{
+    LoginDatabase.WarnAboutSyncQueries(true);
+    CharacterDatabase.WarnAboutSyncQueries(true);
+    WorldDatabase.WarnAboutSyncQueries(true);
+
+    for (;;)
+    {
+        std::shared_ptr<TaskBatch> batch;
+        _queue.WaitAndPop(batch);
+
+        // Queue was canceled
+        if (!batch)
+            break;
+
+        RunTasks(*batch);
+    }
+}
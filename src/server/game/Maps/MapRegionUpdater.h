@@ -0,0 +1,60 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _MAP_REGION_UPDATER_H_INCLUDED
+#define _MAP_REGION_UPDATER_H_INCLUDED
+
+#include "Define.h"
+#include "PCQueue.h"
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/**
+ * Thread pool used to update spatially disjoint regions of a single map in parallel.
+ * A second instance computes the path requests queued on a map, see PathRequest.
+ *
+ * The thread calling Execute() takes part in the work, so several maps updated at once
+ * by MapUpdater workers can share the pool without waiting on each other.
+ */
+class MapRegionUpdater
+{
+public:
+    typedef std::function<void()> RegionTask;
+
+    MapRegionUpdater() = default;
+    ~MapRegionUpdater() = default;
+
+    void Activate(std::size_t numThreads);
+    void Deactivate();
+    [[nodiscard]] bool IsActive() const { return !_workerThreads.empty(); }
+
+    // Runs all tasks and returns once every one of them has finished
+    void Execute(std::vector<RegionTask> const& tasks);
+
+private:
+    struct TaskBatch;
+
+    static void RunTasks(TaskBatch& batch);
+    void WorkerThread();
+
+    ProducerConsumerQueue<std::shared_ptr<TaskBatch>> _queue;
+    std::vector<std::thread> _workerThreads;
+};
+
+#endif //_MAP_REGION_UPDATER_H_INCLUDED
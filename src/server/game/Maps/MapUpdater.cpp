@@ -22,6 +22,15 @@
 #include "Map.h"
 #include "MapMgr.h"
 #include "Metric.h"
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    // Index of the MapUpdater worker queue owned by the current thread, if any
+    thread_local MapUpdater const* t_updater = nullptr;
+    thread_local std::size_t t_workerIndex = 0;
+}
 
 class UpdateRequest
 {
@@ -30,8 +39,25 @@ public:
     virtual ~UpdateRequest() = default;
 
     virtual void call() = 0;
+
+    // Estimated execution time in microseconds, used to schedule the most expensive requests first
+    [[nodiscard]] virtual uint64 GetEstimatedCost() const { return 0; }
+    // Requests which have to start before the map updates, whatever their cost
+    [[nodiscard]] virtual bool IsScheduledFirst() const { return false; }
 };
 
+namespace
+{
+    // Requests scheduled first keep their order, the other ones are sorted by descending estimated cost
+    bool RunsBefore(UpdateRequest const* left, UpdateRequest const* right)
+    {
+        if (left->IsScheduledFirst() != right->IsScheduledFirst())
+            return left->IsScheduledFirst();
+
+        return !left->IsScheduledFirst() && left->GetEstimatedCost() > right->GetEstimatedCost();
+    }
+}
+
 class MapUpdateRequest : public UpdateRequest
 {
 public:
@@ -42,11 +68,25 @@ public:
 
     void call() override
     {
-        METRIC_TIMER("map_update_time_diff", METRIC_TAG("map_id", std::to_string(m_map.GetId())));
+        TimePoint const start = std::chrono::steady_clock::now();
+
         m_map.Update(m_diff, s_diff);
+
+        Microseconds const duration = std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - start);
+        m_map.SetLastUpdateDuration(duration);
+
+        METRIC_VALUE("map_update_time_diff", std::chrono::nanoseconds(duration),
+            METRIC_TAG("map_id", std::to_string(m_map.GetId())),
+            METRIC_TAG("map_instanceid", std::to_string(m_map.GetInstanceId())));
+
         m_updater.update_finished();
     }
 
+    [[nodiscard]] uint64 GetEstimatedCost() const override
+    {
+        return uint64(m_map.GetLastUpdateDuration().count());
+    }
+
 private:
     Map& m_map;
     MapUpdater& m_updater;
@@ -85,31 +125,37 @@ public:
         sLFGMgr->Update(m_diff, 1);
         m_updater.update_finished();
     }
+
+    // lfg compatibles are processed from the very beginning of the map updates, see MapMgr::Update
+    [[nodiscard]] bool IsScheduledFirst() const override { return true; }
 private:
     MapUpdater& m_updater;
     uint32 m_diff;
 };
 
-MapUpdater::MapUpdater() : pending_requests(0), _cancelationToken(false)
+MapUpdater::MapUpdater() : _queuedRequests(0), _stolenRequests(0), pending_requests(0), _cancelationToken(false)
 {
 }
 
 void MapUpdater::activate(std::size_t num_threads)
 {
+    _workerQueues.reserve(num_threads);
+    for (std::size_t i = 0; i < num_threads; ++i)
+        _workerQueues.push_back(std::make_unique<WorkerQueue>());
+
     _workerThreads.reserve(num_threads);
     for (std::size_t i = 0; i < num_threads; ++i)
     {
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, i));
     }
 }
 
 void MapUpdater::deactivate()
 {
-    _cancelationToken = true;
-
     wait();  // This is where we wait for tasks to complete
 
-    _queue.Cancel();  // Cancel the queue to prevent further task processing
+    _cancelationToken = true;
+    NotifyWorkers(true);
 
     // Join all worker threads
     for (auto& thread : _workerThreads)
@@ -119,23 +165,45 @@ void MapUpdater::deactivate()
             thread.join();
         }
     }
+
+    for (std::unique_ptr<WorkerQueue>& queue : _workerQueues)
+    {
+        for (UpdateRequest* request : queue->Requests)
+            delete request;
+
+        queue->Requests.clear();
+    }
 }
 
 void MapUpdater::wait()
 {
+    Dispatch();
+
     std::unique_lock<std::mutex> guard(_lock);  // Guard lock for safe waiting
 
     // Wait until there are no pending requests
     _condition.wait(guard, [this] {
         return pending_requests.load(std::memory_order_acquire) == 0;
     });
+
+    METRIC_VALUE("map_updater_stolen_requests", _stolenRequests.exchange(0));
 }
 
 void MapUpdater::schedule_task(UpdateRequest* request)
 {
     // Atomic increment for pending_requests
     pending_requests.fetch_add(1, std::memory_order_release);
-    _queue.Push(request);
+
+    // Requests spawned by a running request (instances of a MapInstanced) start right away on the current worker
+    if (t_updater == this)
+    {
+        Enqueue(t_workerIndex, request);
+        NotifyWorkers(false);
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(_stagedLock);
+    _stagedRequests.push_back(request);
 }
 
 void MapUpdater::schedule_update(Map& map, uint32 diff, uint32 s_diff)
@@ -169,22 +237,128 @@ void MapUpdater::update_finished()
     }
 }
 
-void MapUpdater::WorkerThread()
+void MapUpdater::Dispatch()
+{
+    std::vector<UpdateRequest*> requests;
+    {
+        std::lock_guard<std::mutex> guard(_stagedLock);
+        requests.swap(_stagedRequests);
+    }
+
+    if (requests.empty())
+        return;
+
+    // Longest processing time first: hand out the most expensive requests first, each to the least loaded worker
+    std::stable_sort(requests.begin(), requests.end(), RunsBefore);
+
+    for (UpdateRequest* request : requests)
+    {
+        std::size_t target = 0;
+        uint64 lowestCost = std::numeric_limits<uint64>::max();
+        for (std::size_t i = 0; i < _workerQueues.size(); ++i)
+        {
+            std::lock_guard<std::mutex> guard(_workerQueues[i]->Lock);
+            if (_workerQueues[i]->QueuedCost < lowestCost)
+            {
+                lowestCost = _workerQueues[i]->QueuedCost;
+                target = i;
+            }
+        }
+
+        Enqueue(target, request);
+    }
+
+    NotifyWorkers(true);
+}
+
+void MapUpdater::Enqueue(std::size_t workerIndex, UpdateRequest* request)
+{
+    WorkerQueue& queue = *_workerQueues[workerIndex];
+    uint64 const cost = request->GetEstimatedCost();
+
+    // counted before the request can be popped, a worker decrementing first would underflow the count
+    _queuedRequests.fetch_add(1, std::memory_order_release);
+
+    {
+        std::lock_guard<std::mutex> guard(queue.Lock);
+        auto itr = std::find_if(queue.Requests.begin(), queue.Requests.end(), [request](UpdateRequest const* queued)
+        {
+            return RunsBefore(request, queued);
+        });
+
+        queue.Requests.insert(itr, request);
+        // Requests without history still count as one unit so that they are spread across workers
+        queue.QueuedCost += std::max<uint64>(cost, 1);
+    }
+}
+
+UpdateRequest* MapUpdater::PopRequestFrom(WorkerQueue& queue)
+{
+    std::lock_guard<std::mutex> guard(queue.Lock);
+    if (queue.Requests.empty())
+        return nullptr;
+
+    UpdateRequest* request = queue.Requests.front();
+    queue.Requests.pop_front();
+    queue.QueuedCost -= std::min<uint64>(queue.QueuedCost, std::max<uint64>(request->GetEstimatedCost(), 1));
+    _queuedRequests.fetch_sub(1, std::memory_order_acq_rel);
+    return request;
+}
+
+UpdateRequest* MapUpdater::PopRequest(std::size_t workerIndex)
+{
+    if (UpdateRequest* request = PopRequestFrom(*_workerQueues[workerIndex]))
+        return request;
+
+    // Own queue is drained, steal the most expensive pending request of another worker
+    for (std::size_t i = 1; i < _workerQueues.size(); ++i)
+    {
+        if (UpdateRequest* request = PopRequestFrom(*_workerQueues[(workerIndex + i) % _workerQueues.size()]))
+        {
+            _stolenRequests.fetch_add(1, std::memory_order_relaxed);
+            return request;
+        }
+    }
+
+    return nullptr;
+}
+
+void MapUpdater::NotifyWorkers(bool all)
+{
+    {
+        // Synchronize with workers checking the predicate so the notification cannot be lost
+        std::lock_guard<std::mutex> guard(_workLock);
+    }
+
+    if (all)
+        _workCondition.notify_all();
+    else
+        _workCondition.notify_one();
+}
+
+void MapUpdater::WorkerThread(std::size_t workerIndex)
 {
     LoginDatabase.WarnAboutSyncQueries(true);
     CharacterDatabase.WarnAboutSyncQueries(true);
     WorldDatabase.WarnAboutSyncQueries(true);
 
+    t_updater = this;
+    t_workerIndex = workerIndex;
+
     while (!_cancelationToken)
     {
-        UpdateRequest* request = nullptr;
-
-        _queue.WaitAndPop(request);  // Wait for and pop a request from the queue
-
-        if (!_cancelationToken && request)
+        if (UpdateRequest* request = PopRequest(workerIndex))
         {
             request->call();  // Execute the request
             delete request;  // Clean up after processing
+            continue;
         }
+
+        std::unique_lock<std::mutex> guard(_workLock);
+        _workCondition.wait(guard, [this] {
+            return _queuedRequests.load(std::memory_order_acquire) > 0 || _cancelationToken;
+        });
     }
+
+    t_updater = nullptr;
 }
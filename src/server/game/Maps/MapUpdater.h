@@ -19,14 +19,27 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Define.h"
-#include "PCQueue.h"
+#include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <thread>
-#include <atomic>
+#include <vector>
 
 class Map;
 class UpdateRequest;
 
+/**
+ * Work-stealing map update scheduler.
+ *
+ * Requests scheduled from outside the worker threads are staged and dispatched in wait(),
+ * sorted by their estimated cost (previous update duration of the map, longest first) and
+ * assigned to the least loaded worker queue. Requests scheduled from a worker thread (e.g.
+ * instances scheduled by MapInstanced::Update) go to that worker's own queue. Idle workers
+ * steal queued requests from other workers, so the tick length follows total work / workers
+ * instead of the single most expensive map.
+ */
 class MapUpdater
 {
 public:
@@ -44,13 +57,32 @@ public:
     void update_finished();
 
 private:
-    void WorkerThread();
-    ProducerConsumerQueue<UpdateRequest*> _queue;
+    struct WorkerQueue
+    {
+        std::mutex Lock;
+        std::deque<UpdateRequest*> Requests; // requests scheduled first, then by descending estimated cost
+        uint64 QueuedCost = 0;
+    };
+
+    void WorkerThread(std::size_t workerIndex);
+    void Dispatch();
+    void Enqueue(std::size_t workerIndex, UpdateRequest* request);
+    UpdateRequest* PopRequest(std::size_t workerIndex);
+    UpdateRequest* PopRequestFrom(WorkerQueue& queue);
+    void NotifyWorkers(bool all);
+
+    std::vector<std::unique_ptr<WorkerQueue>> _workerQueues;
+    std::vector<UpdateRequest*> _stagedRequests;  // scheduled outside of the workers, dispatched longest-first in wait()
+    std::mutex _stagedLock;
+    std::atomic<std::size_t> _queuedRequests;
+    std::atomic<uint32> _stolenRequests;
     std::atomic<int> pending_requests;  // Use std::atomic for pending_requests to avoid lock contention
     std::atomic<bool> _cancelationToken;  // Atomic flag for cancellation to avoid race conditions
     std::vector<std::thread> _workerThreads;
     std::mutex _lock; // Mutex and condition variable for synchronization
     std::condition_variable _condition;
+    std::mutex _workLock; // Mutex and condition variable used to park idle workers
+    std::condition_variable _workCondition;
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
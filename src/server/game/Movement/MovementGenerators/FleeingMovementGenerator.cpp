@@ -37,6 +37,7 @@ void FleeingMovementGenerator<T>::DoInitialize(T* owner)
 
     owner->StopMoving();
     _path = nullptr;
+    _pathRequest = nullptr;
     owner->SetUnitFlag(UNIT_FLAG_FLEEING);
     owner->AddUnitState(UNIT_STATE_FLEEING);
     SetTargetLocation(owner);
@@ -84,6 +85,7 @@ bool FleeingMovementGenerator<T>::DoUpdate(T* owner, uint32 diff)
     if (owner->HasUnitState(UNIT_STATE_NOT_MOVE) || owner->IsMovementPreventedByCasting())
     {
         _path = nullptr;
+        _pathRequest = nullptr;
         _interrupt = true;
         owner->StopMoving();
         return true;
@@ -91,6 +93,18 @@ bool FleeingMovementGenerator<T>::DoUpdate(T* owner, uint32 diff)
     else
         _interrupt = false;
 
+    // wait for the path requested in an earlier update
+    if (_pathRequest)
+    {
+        if (!_pathRequest->IsReady())
+            return true;
+
+        PathRequestPtr request = std::move(_pathRequest);
+        _path = request->TakePath();
+        LaunchPath(owner, request->Succeeded());
+        return true;
+    }
+
     _timer.Update(diff);
     if (!_interrupt && _timer.Passed() && owner->movespline->Finalized())
     {
@@ -111,6 +125,7 @@ void FleeingMovementGenerator<T>::SetTargetLocation(T* owner)
     if (owner->HasUnitState(UNIT_STATE_NOT_MOVE) || owner->IsMovementPreventedByCasting())
     {
         _path = nullptr;
+        _pathRequest = nullptr;
         _interrupt = true;
         owner->StopMoving();
         return;
@@ -128,7 +143,8 @@ void FleeingMovementGenerator<T>::SetTargetLocation(T* owner)
         return;
     }
 
-    if (!_path)
+    bool async = PathRequest::IsAsyncEnabled();
+    if (!_path || async)
     {
         _path = std::make_unique<PathGenerator>(owner);
     }
@@ -141,8 +157,22 @@ void FleeingMovementGenerator<T>::SetTargetLocation(T* owner)
         _path->SetSlopeCheck(true);
 
     _path->SetPathLengthLimit(30.0f);
+
+    if (async)
+    {
+        // launched by DoUpdate once computed
+        _pathRequest = PathRequest::Queue(owner, std::move(_path), G3D::Vector3(destination.GetPositionX(), destination.GetPositionY(), destination.GetPositionZ()), false);
+        return;
+    }
+
     bool result = _path->CalculatePath(destination.GetPositionX(), destination.GetPositionY(), destination.GetPositionZ());
-    if (!result || (_path->GetPathType() & PathType(PATHFIND_NOPATH | PATHFIND_SHORTCUT | PATHFIND_FARFROMPOLY | PATHFIND_NOT_USING_PATH)))
+    LaunchPath(owner, result);
+}
+
+template<class T>
+void FleeingMovementGenerator<T>::LaunchPath(T* owner, bool pathFound)
+{
+    if (!pathFound || (_path->GetPathType() & PathType(PATHFIND_NOPATH | PATHFIND_SHORTCUT | PATHFIND_FARFROMPOLY | PATHFIND_NOT_USING_PATH)))
     {
         if (_fleeTargetGUID)
             ++_invalidPathsCount;
@@ -232,6 +262,8 @@ template void FleeingMovementGenerator<Player>::SetTargetLocation(Player*);
 template void FleeingMovementGenerator<Creature>::SetTargetLocation(Creature*);
 template void FleeingMovementGenerator<Player>::GetPoint(Player*, Position&);
 template void FleeingMovementGenerator<Creature>::GetPoint(Creature*, Position&);
+template void FleeingMovementGenerator<Player>::LaunchPath(Player*, bool);
+template void FleeingMovementGenerator<Creature>::LaunchPath(Creature*, bool);
 
 void TimedFleeingMovementGenerator::Finalize(Unit* owner)
 {
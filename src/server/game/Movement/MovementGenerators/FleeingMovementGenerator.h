@@ -20,6 +20,7 @@
 
 #include "Creature.h"
 #include "MovementGenerator.h"
+#include "PathRequest.h"
 #include "Timer.h"
 
 template<class T>
@@ -38,8 +39,10 @@ class FleeingMovementGenerator : public MovementGeneratorMedium< T, FleeingMovem
     private:
         void SetTargetLocation(T*);
         void GetPoint(T*, Position& position);
+        void LaunchPath(T*, bool pathFound);
 
         std::unique_ptr<PathGenerator> _path;
+        PathRequestPtr _pathRequest;
         ObjectGuid _fleeTargetGUID;
         TimeTracker _timer;
         bool _interrupt;
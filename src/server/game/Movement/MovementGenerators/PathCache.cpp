@@ -0,0 +1,180 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PathCache.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+PathCache* PathCache::instance()
+{
+    static PathCache instance;
+    return &instance;
+}
+
+PathCache::Key PathCache::MakeKey(uint32 mapId, uint32 instanceId, G3D::Vector3 const& start, G3D::Vector3 const& end, uint32 phaseMask, uint32 flags, float collisionHeight, float collisionWidth, float hoverHeight)
+{
+    auto quantize = [](float value) { return int32(std::floor(value * QUANTIZATION)); };
+    auto quantizeSize = [](float value) { return int32(std::lround(value * 16.0f)); };
+
+    Key key;
+    key.MapId = mapId;
+    key.InstanceId = instanceId;
+    key.Coords = { quantize(start.x), quantize(start.y), quantize(start.z), quantize(end.x), quantize(end.y), quantize(end.z) };
+    key.PhaseMask = phaseMask;
+    key.Flags = flags;
+    key.Sizes = { quantizeSize(collisionHeight), quantizeSize(collisionWidth), quantizeSize(hoverHeight) };
+    return key;
+}
+
+std::size_t PathCache::KeyHash::operator()(Key const& key) const
+{
+    uint64 hash = 14695981039346656037ULL;
+    auto mix = [&hash](uint32 value)
+    {
+        hash ^= value;
+        hash *= 1099511628211ULL;
+    };
+
+    mix(key.MapId);
+    mix(key.InstanceId);
+    for (int32 coord : key.Coords)
+        mix(uint32(coord));
+
+    mix(key.PhaseMask);
+    mix(key.Flags);
+    for (int32 size : key.Sizes)
+        mix(uint32(size));
+
+    return std::size_t(hash ^ (hash >> 32));
+}
+
+void PathCache::SetCapacity(std::size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _capacity.store(capacity, std::memory_order_relaxed);
+    Trim();
+}
+
+bool PathCache::Get(Key const& key, Result& result)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    auto itr = _index.find(key);
+    if (itr == _index.end())
+    {
+        ++_misses;
+        return false;
+    }
+
+    _entries.splice(_entries.begin(), _entries, itr->second);
+    result = itr->second->EntryResult;
+    ++_hits;
+    return true;
+}
+
+void PathCache::Store(Key const& key, Result result, std::vector<uint32> tiles)
+{
+    std::sort(tiles.begin(), tiles.end());
+    tiles.erase(std::unique(tiles.begin(), tiles.end()), tiles.end());
+
+    std::lock_guard<std::mutex> lock(_lock);
+    if (!_capacity.load(std::memory_order_relaxed))
+        return;
+
+    auto itr = _index.find(key);
+    if (itr != _index.end())
+    {
+        // built again by another unit since it missed, keep the newest path
+        Entry* entry = &*itr->second;
+        UnlinkTiles(entry);
+        entry->EntryResult = std::move(result);
+        entry->Tiles = std::move(tiles);
+        LinkTiles(entry);
+        _entries.splice(_entries.begin(), _entries, itr->second);
+        return;
+    }
+
+    _entries.push_front({ key, std::move(result), std::move(tiles) });
+    _index.emplace(key, _entries.begin());
+    LinkTiles(&_entries.front());
+    Trim();
+}
+
+void PathCache::InvalidateTile(uint32 mapId, int32 tileX, int32 tileY)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    auto tileItr = _tileIndex.find(MakeTileKey(mapId, MakeTileId(tileX, tileY)));
+    if (tileItr == _tileIndex.end())
+        return;
+
+    // the paths crossing the tile are unlinked from it by Erase
+    std::vector<Entry*> entries(tileItr->second.begin(), tileItr->second.end());
+    for (Entry* entry : entries)
+    {
+        Erase(_index.at(entry->EntryKey));
+        ++_invalidations;
+    }
+}
+
+PathCacheStats PathCache::GetStats()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    PathCacheStats stats;
+    stats.Hits = _hits;
+    stats.Misses = _misses;
+    stats.Invalidations = _invalidations;
+    stats.Entries = _entries.size();
+    stats.Capacity = _capacity.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void PathCache::OnTileUnloaded(uint32 mapId, int32 tileX, int32 tileY)
+{
+    sPathCache->InvalidateTile(mapId, tileX, tileY);
+}
+
+void PathCache::LinkTiles(Entry* entry)
+{
+    for (uint32 tileId : entry->Tiles)
+        _tileIndex[MakeTileKey(entry->EntryKey.MapId, tileId)].insert(entry);
+}
+
+void PathCache::UnlinkTiles(Entry* entry)
+{
+    for (uint32 tileId : entry->Tiles)
+    {
+        auto tileItr = _tileIndex.find(MakeTileKey(entry->EntryKey.MapId, tileId));
+        tileItr->second.erase(entry);
+        if (tileItr->second.empty())
+            _tileIndex.erase(tileItr);
+    }
+}
+
+void PathCache::Erase(EntryList::iterator itr)
+{
+    UnlinkTiles(&*itr);
+    _index.erase(itr->EntryKey);
+    _entries.erase(itr);
+}
+
+void PathCache::Trim()
+{
+    std::size_t capacity = _capacity.load(std::memory_order_relaxed);
+    while (_entries.size() > capacity)
+        Erase(std::prev(_entries.end()));
+}
@@ -0,0 +1,138 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PATH_CACHE_H
+#define _PATH_CACHE_H
+
+#include "Define.h"
+#include "MoveSplineInitArgs.h"
+#include <array>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+struct PathCacheStats
+{
+    uint64 Hits = 0;
+    uint64 Misses = 0;
+    uint64 Invalidations = 0;
+    std::size_t Entries = 0;
+    std::size_t Capacity = 0;
+};
+
+/**
+ * Paths built by PathGenerator, shared by all maps, so the units chasing, following or
+ * roaming between the same positions (packs, escorts, units running back to their spawn)
+ * query the navmesh once. See MoveMaps.PathCache.Size.
+ *
+ * Endpoints are quantized to 1/QUANTIZATION yard. The least recently used path is dropped
+ * when the cache is full, and the paths crossing a navmesh tile are dropped when MMapMgr
+ * unloads that tile, found through an index of the paths by tile.
+ */
+class PathCache
+{
+public:
+    static constexpr float QUANTIZATION = 2.0f;
+
+    struct Key
+    {
+        uint32 MapId;
+        uint32 InstanceId;
+        std::array<int32, 6> Coords;
+        uint32 PhaseMask;
+        uint32 Flags;                   // filter, path options and movement capabilities of the unit
+        std::array<int32, 3> Sizes;     // collision height and width and hover height of the unit, they adjust the heights of the path
+
+        bool operator==(Key const& right) const
+        {
+            return MapId == right.MapId && InstanceId == right.InstanceId && Coords == right.Coords &&
+                PhaseMask == right.PhaseMask && Flags == right.Flags && Sizes == right.Sizes;
+        }
+    };
+
+    struct Result
+    {
+        std::shared_ptr<Movement::PointsArray const> Points;
+        G3D::Vector3 ActualEndPosition;
+    };
+
+    explicit PathCache(std::size_t capacity = 0) : _capacity(capacity) { }
+    PathCache(PathCache const&) = delete;
+    PathCache& operator=(PathCache const&) = delete;
+
+    static PathCache* instance();
+
+    static Key MakeKey(uint32 mapId, uint32 instanceId, G3D::Vector3 const& start, G3D::Vector3 const& end, uint32 phaseMask, uint32 flags, float collisionHeight, float collisionWidth, float hoverHeight);
+
+    // navmesh tile coordinates as stored in Store()
+    static uint32 MakeTileId(int32 tileX, int32 tileY) { return (uint32(tileX) << 16) | (uint32(tileY) & 0xFFFF); }
+
+    // 0 disables the cache, shrinking it drops the least recently used paths
+    void SetCapacity(std::size_t capacity);
+    [[nodiscard]] bool IsEnabled() const { return _capacity.load(std::memory_order_relaxed) != 0; }
+
+    bool Get(Key const& key, Result& result);
+    // tiles are the navmesh tiles the path crosses, see MakeTileId
+    void Store(Key const& key, Result result, std::vector<uint32> tiles);
+
+    void InvalidateTile(uint32 mapId, int32 tileX, int32 tileY);
+
+    [[nodiscard]] PathCacheStats GetStats();
+
+    // MMapMgr::TileUnloadedPtr
+    static void OnTileUnloaded(uint32 mapId, int32 tileX, int32 tileY);
+
+private:
+    struct KeyHash
+    {
+        std::size_t operator()(Key const& key) const;
+    };
+
+    struct Entry
+    {
+        Key EntryKey;
+        Result EntryResult;
+        std::vector<uint32> Tiles;
+    };
+
+    typedef std::list<Entry> EntryList;
+
+    static uint64 MakeTileKey(uint32 mapId, uint32 tileId) { return (uint64(mapId) << 32) | tileId; }
+
+    // add or remove the entry in the sets of its tiles
+    void LinkTiles(Entry* entry);
+    void UnlinkTiles(Entry* entry);
+    void Erase(EntryList::iterator itr);
+    void Trim();
+
+    std::mutex _lock;
+    std::atomic<std::size_t> _capacity;     // read without the lock by IsEnabled
+    EntryList _entries;                     // most recently used first
+    std::unordered_map<Key, EntryList::iterator, KeyHash> _index;
+    std::unordered_map<uint64, std::unordered_set<Entry*>> _tileIndex;  // MakeTileKey
+    uint64 _hits = 0;
+    uint64 _misses = 0;
+    uint64 _invalidations = 0;
+};
+
+#define sPathCache PathCache::instance()
+
+#endif
@@ -24,6 +24,7 @@
 #include "MMapMgr.h"
 #include "Map.h"
 #include "Metric.h"
+#include "PathCache.h"
 
  ////////////////// PathGenerator //////////////////
 PathGenerator::PathGenerator(WorldObject const* owner) :
@@ -34,14 +35,6 @@ PathGenerator::PathGenerator(WorldObject const* owner) :
 {
     memset(_pathPolyRefs, 0, sizeof(_pathPolyRefs));
 
-    uint32 mapId = _source->GetMapId();
-    //if (sDisableMgr->IsPathfindingEnabled(_sourceUnit->FindMap()))
-    {
-        MMAP::MMapMgr* mmap = MMAP::MMapFactory::createOrGetMMapMgr();
-        _navMesh = mmap->GetNavMesh(mapId);
-        _navMeshQuery = mmap->GetNavMeshQuery(mapId, _source->GetInstanceId());
-    }
-
     CreateFilter();
 }
 
@@ -72,6 +65,11 @@ bool PathGenerator::CalculatePath(float x, float y, float z, float destX, float
 
     _forceDestination = forceDest;
 
+    // query of this thread, tiles of the map are not loaded or unloaded until NormalizePath unlocks it
+    _navMeshHandle = MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMeshQuery(_source->GetMapId());
+    _navMesh = _navMeshHandle.GetNavMesh();
+    _navMeshQuery = _navMeshHandle.GetQuery();
+
     // make sure navMesh works - we can run on map w/o mmap
     // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
     Unit const* _sourceUnit = _source->ToUnit();
@@ -80,12 +78,38 @@ bool PathGenerator::CalculatePath(float x, float y, float z, float destX, float
     {
         BuildShortcut();
         _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
-        return true;
     }
+    else
+    {
+        UpdateFilter();
 
-    UpdateFilter();
+        // units on transports move in its space, their paths are not shared
+        Optional<PathCache::Key> cacheKey;
+        if (sPathCache->IsEnabled() && !_source->GetTransport())
+            cacheKey = MakeCacheKey();
+
+        PathCache::Result cached;
+        if (cacheKey && sPathCache->Get(*cacheKey, cached))
+        {
+            // the polygons of the previous path do not lead along the cached one
+            _polyLength = 0;
+            _pathPoints = *cached.Points;
+            SetActualEndPosition(cached.ActualEndPosition);
+            _type = PATHFIND_NORMAL;
+        }
+        else
+        {
+            BuildPolyPath(start, dest);
+
+            // shortcuts, partial and forced paths depend on how far the unit is from the navmesh, only complete paths are shared
+            if (cacheKey && _type == PATHFIND_NORMAL)
+                sPathCache->Store(*cacheKey, { std::make_shared<Movement::PointsArray const>(_pathPoints), _actualEndPosition }, GetPathTiles());
+        }
+    }
 
-    BuildPolyPath(start, dest);
+    _navMeshHandle = MMAP::NavMeshQueryHandle();
+    _navMesh = nullptr;
+    _navMeshQuery = nullptr;
     return true;
 }
 
@@ -625,9 +649,18 @@ void PathGenerator::BuildPointPath(const float* startPoint, const float* endPoin
 
 void PathGenerator::NormalizePath()
 {
+    // the path is built once its points are normalized, and the height lookup may create grids
+    // which load navmesh tiles of this map
+    _navMeshHandle.Unlock();
+    _navMeshQuery = nullptr;
+
+    // the .map heights of all points are looked up at once, path points mostly share a grid
+    std::vector<float> gridHeights(_pathPoints.size());
+    _source->GetMap()->GetGridHeights(_pathPoints.data(), gridHeights.data(), _pathPoints.size());
+
     for (uint32 i = 0; i < _pathPoints.size(); ++i)
     {
-        _source->UpdateAllowedPositionZ(_pathPoints[i].x, _pathPoints[i].y, _pathPoints[i].z);
+        _source->UpdateAllowedPositionZ(_pathPoints[i].x, _pathPoints[i].y, _pathPoints[i].z, nullptr, gridHeights[i]);
     }
 }
 
@@ -715,6 +748,79 @@ NavTerrain PathGenerator::GetNavTerrain(float x, float y, float z) const
     }
 }
 
+PathCache::Key PathGenerator::MakeCacheKey() const
+{
+    enum
+    {
+        CACHE_FLAG_STRAIGHT_PATH    = 0x00010000,
+        CACHE_FLAG_SLOPE_CHECK      = 0x00020000,
+        CACHE_FLAG_RAYCAST          = 0x00040000,
+        CACHE_FLAG_FORCE_DEST       = 0x00080000,
+        CACHE_FLAG_UNIT             = 0x00100000,
+        CACHE_FLAG_CREATURE         = 0x00200000,
+        CACHE_FLAG_CAN_FLY          = 0x00400000,
+        CACHE_FLAG_CAN_SWIM         = 0x00800000,
+        CACHE_FLAG_FALLING          = 0x01000000,
+    };
+
+    // low bits are the filter, high bits the point path limit (at most MAX_POINT_PATH_LENGTH)
+    uint32 flags = (_filter.getIncludeFlags() & 0xFF) | ((_filter.getExcludeFlags() & 0xFF) << 8) | (_pointPathLimit << 25);
+    if (_useStraightPath)
+        flags |= CACHE_FLAG_STRAIGHT_PATH;
+    if (_slopeCheck)
+        flags |= CACHE_FLAG_SLOPE_CHECK;
+    if (_useRaycast)
+        flags |= CACHE_FLAG_RAYCAST;
+    if (_forceDestination)
+        flags |= CACHE_FLAG_FORCE_DEST;
+
+    float hoverHeight = 0.0f;
+    if (Unit const* unit = _source->ToUnit())
+    {
+        flags |= CACHE_FLAG_UNIT;
+        if (unit->IsCreature())
+            flags |= CACHE_FLAG_CREATURE;
+        if (unit->CanFly())
+            flags |= CACHE_FLAG_CAN_FLY;
+        if (unit->CanSwim())
+            flags |= CACHE_FLAG_CAN_SWIM;
+        if (unit->IsFalling())
+            flags |= CACHE_FLAG_FALLING;
+
+        hoverHeight = unit->GetHoverHeight();
+    }
+
+    return PathCache::MakeKey(_source->GetMapId(), _source->GetInstanceId(), GetStartPosition(), GetEndPosition(), _source->GetPhaseMask(), flags,
+        _source->GetCollisionHeight(), _source->GetCollisionWidth(), hoverHeight);
+}
+
+std::vector<uint32> PathGenerator::GetPathTiles() const
+{
+    std::vector<uint32> tiles;
+    auto addTiles = [this, &tiles](G3D::Vector3 const& from, G3D::Vector3 const& to)
+    {
+        float fromPoint[VERTEX_SIZE] = { from.y, from.z, from.x };
+        float toPoint[VERTEX_SIZE] = { to.y, to.z, to.x };
+        int fromX, fromY, toX, toY;
+        _navMesh->calcTileLoc(fromPoint, &fromX, &fromY);
+        _navMesh->calcTileLoc(toPoint, &toX, &toY);
+
+        // every tile of the rectangle, long straight segments may cross several tiles
+        for (int x = std::min(fromX, toX); x <= std::max(fromX, toX); ++x)
+            for (int y = std::min(fromY, toY); y <= std::max(fromY, toY); ++y)
+                tiles.push_back(PathCache::MakeTileId(x, y));
+    };
+
+    // the tiles of the requested endpoints decide whether a path is built at all
+    addTiles(GetStartPosition(), GetStartPosition());
+    addTiles(GetEndPosition(), GetEndPosition());
+
+    for (std::size_t i = 1; i < _pathPoints.size(); ++i)
+        addTiles(_pathPoints[i - 1], _pathPoints[i]);
+
+    return tiles;
+}
+
 bool PathGenerator::HaveTile(const G3D::Vector3& p) const
 {
     int tx = -1, ty = -1;
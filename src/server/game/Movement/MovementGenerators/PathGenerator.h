@@ -23,6 +23,7 @@
 #include "MMapMgr.h"
 #include "MapDefines.h"
 #include "MoveSplineInitArgs.h"
+#include "PathCache.h"
 #include "SharedDefines.h"
 #include <G3D/Vector3.h>
 
@@ -145,8 +146,9 @@ class PathGenerator
         G3D::Vector3 _actualEndPosition;    // {x, y, z} of the closest possible point to given destination
 
         WorldObject const* const _source;       // the object that is moving
-        dtNavMesh const* _navMesh;              // the nav mesh
-        dtNavMeshQuery const* _navMeshQuery;    // the nav mesh query used to find the path
+        dtNavMesh const* _navMesh;              // the nav mesh, only set while CalculatePath runs
+        dtNavMeshQuery const* _navMeshQuery;    // the nav mesh query used to find the path, only set while CalculatePath runs
+        MMAP::NavMeshQueryHandle _navMeshHandle; // keeps the tiles read by _navMeshQuery loaded
 
         dtQueryFilterExt _filter;  // use single filter for all movements, update it when needed
 
@@ -163,6 +165,9 @@ class PathGenerator
         dtPolyRef GetPolyByLocation(float const* Point, float* Distance) const;
         [[nodiscard]] bool HaveTile(G3D::Vector3 const& p) const;
 
+        [[nodiscard]] PathCache::Key MakeCacheKey() const;
+        [[nodiscard]] std::vector<uint32> GetPathTiles() const;   // navmesh tiles crossed by the path, see PathCache::MakeTileId
+
         void BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos);
         void BuildPointPath(float const* startPoint, float const* endPoint);
         void BuildShortcut();
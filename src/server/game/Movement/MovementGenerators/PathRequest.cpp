@@ -0,0 +1,70 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PathRequest.h"
+#include "Map.h"
+#include "MapMgr.h"
+#include "Metric.h"
+
+PathRequest::PathRequest(WorldObject const* owner, std::unique_ptr<PathGenerator> path, G3D::Vector3 const& dest, bool forceDest) :
+    _owner(owner), _path(std::move(path)), _dest(dest), _forceDest(forceDest), _result(false),
+    _requestTime(std::chrono::steady_clock::now()), _canceled(false), _ready(false)
+{
+}
+
+bool PathRequest::IsAsyncEnabled()
+{
+    return sMapMgr->GetPathfindingUpdater()->IsActive();
+}
+
+PathRequestPtr PathRequest::Queue(WorldObject* owner, std::unique_ptr<PathGenerator> path, G3D::Vector3 const& dest, bool forceDest)
+{
+    PathRequestPtr request = std::make_shared<PathRequest>(owner, std::move(path), dest, forceDest);
+    owner->GetMap()->QueuePathRequest(request);
+    return request;
+}
+
+std::unique_ptr<PathGenerator> PathRequest::ReusePath(WorldObject const* owner, std::unique_ptr<PathGenerator> path, PathRequestPtr& pending)
+{
+    if (pending)
+    {
+        PathRequestPtr superseded = std::move(pending);
+        if (!path)
+            path = superseded->Withdraw();
+        else
+            superseded->Cancel();
+    }
+
+    if (!path)
+        path = std::make_unique<PathGenerator>(owner);
+
+    return path;
+}
+
+std::unique_ptr<PathGenerator> PathRequest::Withdraw()
+{
+    Cancel();
+    return std::move(_path);
+}
+
+void PathRequest::Compute()
+{
+    METRIC_DETAILED_TIMER("pathfinding_path_time");
+
+    _result = _path->CalculatePath(_dest.x, _dest.y, _dest.z, _forceDest);
+    _ready.store(true, std::memory_order_release);
+}
@@ -0,0 +1,85 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PATH_REQUEST_H
+#define _PATH_REQUEST_H
+
+#include "Duration.h"
+#include "PathGenerator.h"
+#include <atomic>
+#include <memory>
+
+class PathRequest;
+typedef std::shared_ptr<PathRequest> PathRequestPtr;
+
+/**
+ * A path computed asynchronously, see MoveMaps.AsyncPathfinding.Threads.
+ *
+ * Requests queued on a map during an update are computed on the pathfinding workers at the
+ * start of its next update, while the map's own objects are not updated. The requester keeps
+ * the request, moves along its current spline meanwhile and polls IsReady() in its following updates.
+ *
+ * Calling Cancel() or dropping the last reference held by the requester cancels the request,
+ * it is then not computed.
+ */
+class PathRequest
+{
+public:
+    PathRequest(WorldObject const* owner, std::unique_ptr<PathGenerator> path, G3D::Vector3 const& dest, bool forceDest);
+
+    // Whether the movement generators request their paths asynchronously
+    [[nodiscard]] static bool IsAsyncEnabled();
+
+    // Queues a path from the current position of owner to dest on its map, path is configured by the caller
+    static PathRequestPtr Queue(WorldObject* owner, std::unique_ptr<PathGenerator> path, G3D::Vector3 const& dest, bool forceDest);
+
+    // The generator for the next request of owner: path, the generator of its last path, else the one of
+    // the pending request the next one supersedes, else a new one. A reused generator keeps the polygons of
+    // its previous path, CalculatePath starts from them while the unit is still on that path
+    [[nodiscard]] static std::unique_ptr<PathGenerator> ReusePath(WorldObject const* owner, std::unique_ptr<PathGenerator> path, PathRequestPtr& pending);
+
+    void Cancel() { _canceled.store(true, std::memory_order_relaxed); }
+    [[nodiscard]] bool IsCanceled() const { return _canceled.load(std::memory_order_relaxed); }
+    [[nodiscard]] bool IsReady() const { return _ready.load(std::memory_order_acquire); }
+
+    [[nodiscard]] WorldObject const* GetOwner() const { return _owner; }
+    [[nodiscard]] G3D::Vector3 const& GetDestination() const { return _dest; }
+    [[nodiscard]] TimePoint GetRequestTime() const { return _requestTime; }
+
+    // Result of PathGenerator::CalculatePath, only valid once ready
+    [[nodiscard]] bool Succeeded() const { return _result; }
+    [[nodiscard]] std::unique_ptr<PathGenerator> TakePath() { return std::move(_path); }
+    // Cancels the request and hands its generator back, the workers never compute a request during the updates of its requester
+    [[nodiscard]] std::unique_ptr<PathGenerator> Withdraw();
+
+    // Called by the pathfinding workers
+    void Compute();
+    // Completes the request without a path, its owner left the map it was queued on
+    void Fail() { _ready.store(true, std::memory_order_release); }
+
+private:
+    WorldObject const* _owner;
+    std::unique_ptr<PathGenerator> _path;
+    G3D::Vector3 _dest;
+    bool _forceDest;
+    bool _result;
+    TimePoint _requestTime;
+    std::atomic<bool> _canceled;
+    std::atomic<bool> _ready;
+};
+
+#endif
@@ -32,6 +32,86 @@ RandomMovementGenerator<T>::~RandomMovementGenerator() { }
 
 template RandomMovementGenerator<Creature>::~RandomMovementGenerator();
 
+template<>
+bool RandomMovementGenerator<Creature>::_checkGroundPath(Creature* creature, bool pathFound, float x, float y, float z, Movement::PointsArray& finalPath)
+{
+    if (!pathFound || (_pathGenerator->GetPathType() & PATHFIND_NOPATH))
+        return false;
+
+    // generated path is too long
+    float pathLen = _pathGenerator->getPathLength();
+    if (pathLen * pathLen > creature->GetExactDistSq(x, y, z) * MAX_PATH_LENGHT_FACTOR * MAX_PATH_LENGHT_FACTOR)
+        return false;
+
+    finalPath = _pathGenerator->GetPath();
+    Movement::PointsArray::iterator itr = finalPath.begin();
+    Movement::PointsArray::iterator itrNext = finalPath.begin() + 1;
+    float zDiff, distDiff;
+
+    for (; itrNext != finalPath.end(); ++itr, ++itrNext)
+    {
+        distDiff = std::sqrt(((*itr).x - (*itrNext).x) * ((*itr).x - (*itrNext).x) + ((*itr).y - (*itrNext).y) * ((*itr).y - (*itrNext).y));
+        zDiff = std::fabs((*itr).z - (*itrNext).z);
+
+        // Xinef: tree climbing, cut as much as we can
+        if (zDiff > 2.0f ||
+                (G3D::fuzzyNe(zDiff, 0.0f) && distDiff / zDiff < 2.15f)) // ~25˚
+            return false;
+
+        if (!creature->GetMap()->isInLineOfSight((*itr).x, (*itr).y, (*itr).z + 2.f, (*itrNext).x, (*itrNext).y, (*itrNext).z + 2.f, creature->GetPhaseMask(),
+            LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags::Nothing))
+            return false;
+    }
+
+    // no valid path
+    if (finalPath.size() < 2)
+        return false;
+
+    return true;
+}
+
+template<>
+void RandomMovementGenerator<Creature>::_moveAlongPath(Creature* creature, uint8 newPoint, uint16 pathIdx)
+{
+    Movement::PointsArray& finalPath = _preComputedPaths[pathIdx];
+
+    _currentPoint = newPoint;
+    G3D::Vector3& finalPoint = finalPath[finalPath.size() - 1];
+    _currDestPosition.Relocate(finalPoint.x, finalPoint.y, finalPoint.z);
+
+    creature->AddUnitState(UNIT_STATE_ROAMING_MOVE);
+    bool walk = true;
+    switch (creature->GetMovementTemplate().GetRandom())
+    {
+    case CreatureRandomMovementType::CanRun:
+        walk = creature->IsWalking();
+        break;
+    case CreatureRandomMovementType::AlwaysRun:
+        walk = false;
+        break;
+    default:
+        break;
+    }
+
+    Movement::MoveSplineInit init(creature);
+    init.MovebyPath(finalPath);
+    init.SetWalk(walk);
+    init.Launch();
+
+    ++_moveCount;
+    if (roll_chance_i((int32) _moveCount * 25 + 10))
+    {
+        _moveCount = 0;
+        _nextMoveTime.Reset(urand(4000, 8000));
+    }
+    if (sWorld->getBoolConfig(CONFIG_DONT_CACHE_RANDOM_MOVEMENT_PATHS))
+        _preComputedPaths.erase(pathIdx);
+
+    //Call for creature group update
+    if (creature->GetFormation() && creature->GetFormation()->GetLeader() == creature)
+        creature->GetFormation()->LeaderMoveTo(finalPoint.x, finalPoint.y, finalPoint.z, 0);
+}
+
 template<>
 void RandomMovementGenerator<Creature>::_setRandomLocation(Creature* creature)
 {
@@ -41,6 +121,30 @@ void RandomMovementGenerator<Creature>::_setRandomLocation(Creature* creature)
     if (creature->_moveState != MAP_OBJECT_CELL_MOVE_NONE)
         return;
 
+    // ground path requested by an earlier call
+    if (_pathRequest)
+    {
+        if (!_pathRequest->IsReady())
+            return;
+
+        PathRequestPtr request = std::move(_pathRequest);
+        _pathGenerator = request->TakePath();
+
+        uint8 newPoint = _requestedPoint;
+        uint16 pathIdx = uint16(_currentPoint * RANDOM_POINTS_NUMBER + newPoint);
+        G3D::Vector3 const& dest = request->GetDestination();
+        if (!_checkGroundPath(creature, request->Succeeded(), dest.x, dest.y, dest.z, _preComputedPaths[pathIdx]))
+        {
+            std::vector<uint8>& validPoints = _validPointsVector[_currentPoint];
+            validPoints.erase(std::remove(validPoints.begin(), validPoints.end(), newPoint), validPoints.end());
+            _preComputedPaths.erase(pathIdx);
+            return;
+        }
+
+        _moveAlongPath(creature, newPoint, pathIdx);
+        return;
+    }
+
     if (_validPointsVector[_currentPoint].empty())
     {
         if (_currentPoint == RANDOM_POINTS_NUMBER) // cant go anywhere from initial position, lets stay
@@ -87,7 +191,6 @@ void RandomMovementGenerator<Creature>::_setRandomLocation(Creature* creature)
     Movement::PointsArray& finalPath = _preComputedPaths[pathIdx];
     if (finalPath.empty())
     {
-        Map* map = creature->GetMap();
         float x = _destinationPoints[newPoint].x, y = _destinationPoints[newPoint].y, z = _destinationPoints[newPoint].z;
         // invalid coordinates
         if (!Acore::IsValidMapCoord(x, y))
@@ -98,7 +201,7 @@ void RandomMovementGenerator<Creature>::_setRandomLocation(Creature* creature)
         }
 
         float ground = INVALID_HEIGHT;
-        float levelZ = creature->GetMapWaterOrGroundLevel(x, y, z, &ground);
+        float levelZ = creature->GetMapWaterOrGroundLevel(x, y, z, &ground, _destinationGridHeights[newPoint]);
         float newZ = INVALID_HEIGHT;
 
         // flying creature
@@ -131,7 +234,7 @@ void RandomMovementGenerator<Creature>::_setRandomLocation(Creature* creature)
             }
         }
 
-        creature->UpdateAllowedPositionZ(x, y, newZ);
+        creature->UpdateAllowedPositionZ(x, y, newZ, nullptr, _destinationGridHeights[newPoint]);
 
         if (newZ > INVALID_HEIGHT)
         {
@@ -148,60 +251,21 @@ void RandomMovementGenerator<Creature>::_setRandomLocation(Creature* creature)
         }
         else // ground
         {
+            if (PathRequest::IsAsyncEnabled())
+            {
+                // checked and launched by a later call once computed
+                _pathRequest = PathRequest::Queue(creature, PathRequest::ReusePath(creature, std::move(_pathGenerator), _pathRequest), G3D::Vector3(x, y, levelZ), false);
+                _requestedPoint = newPoint;
+                return;
+            }
+
             if (!_pathGenerator)
                 _pathGenerator = std::make_unique<PathGenerator>(creature);
             else
                 _pathGenerator->Clear();
 
             bool result = _pathGenerator->CalculatePath(x, y, levelZ, false);
-            if (result && !(_pathGenerator->GetPathType() & PATHFIND_NOPATH))
-            {
-                // generated path is too long
-                float pathLen = _pathGenerator->getPathLength();
-                if (pathLen * pathLen > creature->GetExactDistSq(x, y, levelZ) * MAX_PATH_LENGHT_FACTOR * MAX_PATH_LENGHT_FACTOR)
-                {
-                    _validPointsVector[_currentPoint].erase(randomIter);
-                    _preComputedPaths.erase(pathIdx);
-                    return;
-                }
-
-                finalPath = _pathGenerator->GetPath();
-                Movement::PointsArray::iterator itr = finalPath.begin();
-                Movement::PointsArray::iterator itrNext = finalPath.begin() + 1;
-                float zDiff, distDiff;
-
-                for (; itrNext != finalPath.end(); ++itr, ++itrNext)
-                {
-                    distDiff = std::sqrt(((*itr).x - (*itrNext).x) * ((*itr).x - (*itrNext).x) + ((*itr).y - (*itrNext).y) * ((*itr).y - (*itrNext).y));
-                    zDiff = std::fabs((*itr).z - (*itrNext).z);
-
-                    // Xinef: tree climbing, cut as much as we can
-                    if (zDiff > 2.0f ||
-                            (G3D::fuzzyNe(zDiff, 0.0f) && distDiff / zDiff < 2.15f)) // ~25˚
-                    {
-                        _validPointsVector[_currentPoint].erase(randomIter);
-                        _preComputedPaths.erase(pathIdx);
-                        return;
-                    }
-
-                    if (!map->isInLineOfSight((*itr).x, (*itr).y, (*itr).z + 2.f, (*itrNext).x, (*itrNext).y, (*itrNext).z + 2.f, creature->GetPhaseMask(),
-                        LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags::Nothing))
-                    {
-                        _validPointsVector[_currentPoint].erase(randomIter);
-                        _preComputedPaths.erase(pathIdx);
-                        return;
-                    }
-                }
-
-                // no valid path
-                if (finalPath.size() < 2)
-                {
-                    _validPointsVector[_currentPoint].erase(randomIter);
-                    _preComputedPaths.erase(pathIdx);
-                    return;
-                }
-            }
-            else
+            if (!_checkGroundPath(creature, result, x, y, levelZ, finalPath))
             {
                 _validPointsVector[_currentPoint].erase(randomIter);
                 _preComputedPaths.erase(pathIdx);
@@ -210,41 +274,7 @@ void RandomMovementGenerator<Creature>::_setRandomLocation(Creature* creature)
         }
     }
 
-    _currentPoint = newPoint;
-    G3D::Vector3& finalPoint = finalPath[finalPath.size() - 1];
-    _currDestPosition.Relocate(finalPoint.x, finalPoint.y, finalPoint.z);
-
-    creature->AddUnitState(UNIT_STATE_ROAMING_MOVE);
-    bool walk = true;
-    switch (creature->GetMovementTemplate().GetRandom())
-    {
-    case CreatureRandomMovementType::CanRun:
-        walk = creature->IsWalking();
-        break;
-    case CreatureRandomMovementType::AlwaysRun:
-        walk = false;
-        break;
-    default:
-        break;
-    }
-
-    Movement::MoveSplineInit init(creature);
-    init.MovebyPath(finalPath);
-    init.SetWalk(walk);
-    init.Launch();
-
-    ++_moveCount;
-    if (roll_chance_i((int32) _moveCount * 25 + 10))
-    {
-        _moveCount = 0;
-        _nextMoveTime.Reset(urand(4000, 8000));
-    }
-    if (sWorld->getBoolConfig(CONFIG_DONT_CACHE_RANDOM_MOVEMENT_PATHS))
-        _preComputedPaths.erase(pathIdx);
-
-    //Call for creature group update
-    if (creature->GetFormation() && creature->GetFormation()->GetLeader() == creature)
-        creature->GetFormation()->LeaderMoveTo(finalPoint.x, finalPoint.y, finalPoint.z, 0);
+    _moveAlongPath(creature, newPoint, pathIdx);
 }
 
 template<>
@@ -269,8 +299,12 @@ void RandomMovementGenerator<Creature>::DoInitialize(Creature* creature)
             float factor = 0.5f + rand_norm() * 0.5f;
             _destinationPoints.push_back(G3D::Vector3(_initialPosition.GetPositionX() + _wanderDistance * cos(angle)*factor, _initialPosition.GetPositionY() + _wanderDistance * std::sin(angle)*factor, _initialPosition.GetPositionZ()));
         }
+
+        _destinationGridHeights.resize(_destinationPoints.size());
+        creature->GetMap()->GetGridHeights(_destinationPoints.data(), _destinationGridHeights.data(), _destinationPoints.size());
     }
 
+    _pathRequest = nullptr;
     creature->AddUnitState(UNIT_STATE_ROAMING | UNIT_STATE_ROAMING_MOVE);
 }
 
@@ -292,6 +326,7 @@ bool RandomMovementGenerator<Creature>::DoUpdate(Creature* creature, const uint3
     if (creature->HasUnitState(UNIT_STATE_NOT_MOVE) || creature->IsMovementPreventedByCasting())
     {
         _nextMoveTime.Reset(0);  // Expire the timer
+        _pathRequest = nullptr;
         creature->StopMoving();
         return true;
     }
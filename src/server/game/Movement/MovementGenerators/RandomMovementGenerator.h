@@ -20,6 +20,7 @@
 
 #include "MovementGenerator.h"
 #include "PathGenerator.h"
+#include "PathRequest.h"
 #include "Timer.h"
 
 #define RANDOM_POINTS_NUMBER        12
@@ -32,7 +33,7 @@ template<class T>
 class RandomMovementGenerator : public MovementGeneratorMedium< T, RandomMovementGenerator<T> >
 {
 public:
-    RandomMovementGenerator(float wanderDistance = 0.0f) : _nextMoveTime(0), _moveCount(0), _wanderDistance(wanderDistance), _pathGenerator(nullptr), _currentPoint(RANDOM_POINTS_NUMBER)
+    RandomMovementGenerator(float wanderDistance = 0.0f) : _nextMoveTime(0), _moveCount(0), _wanderDistance(wanderDistance), _pathGenerator(nullptr), _requestedPoint(0), _currentPoint(RANDOM_POINTS_NUMBER)
     {
         _initialPosition.Relocate(0.0f, 0.0f, 0.0f, 0.0f);
         _destinationPoints.reserve(RANDOM_POINTS_NUMBER);
@@ -59,11 +60,17 @@ public:
     MovementGeneratorType GetMovementGeneratorType() { return RANDOM_MOTION_TYPE; }
 
 private:
+    bool _checkGroundPath(T*, bool pathFound, float x, float y, float z, Movement::PointsArray& finalPath);
+    void _moveAlongPath(T*, uint8 newPoint, uint16 pathIdx);
+
     TimeTrackerSmall _nextMoveTime;
     uint8 _moveCount;
     float _wanderDistance;
     std::unique_ptr<PathGenerator> _pathGenerator;
+    PathRequestPtr _pathRequest;
+    uint8 _requestedPoint;                          // destination point of _pathRequest
     std::vector<G3D::Vector3> _destinationPoints;
+    std::vector<float> _destinationGridHeights;     // .map height of each destination point
     std::vector<uint8> _validPointsVector[RANDOM_POINTS_NUMBER + 1];
     uint8 _currentPoint;
     std::map<uint16, Movement::PointsArray> _preComputedPaths;
@@ -80,9 +80,8 @@ void ChaseMovementGenerator<T>::SetNewTarget(Unit* target)
 template<class T>
 void ChaseMovementGenerator<T>::DistanceYourself(T* owner, float distance)
 {
-    // make a new path if we have to...
-    if (!i_path)
-        i_path = std::make_unique<PathGenerator>(owner);
+    // make a new path if we have to, distancing is decided now, drop the path still being computed
+    i_path = PathRequest::ReusePath(owner, std::move(i_path), i_pathRequest);
 
     float x, y, z;
     i_target->GetNearPoint(owner, x, y, z, owner->GetBoundaryRadius(), distance, i_target->GetAngle(owner));
@@ -97,15 +96,29 @@ void ChaseMovementGenerator<T>::DistanceYourself(T* owner, float distance)
 }
 
 template<class T>
-bool ChaseMovementGenerator<T>::DispatchSplineToPosition(T* owner, float x, float y, float z, bool walk, bool cutPath, float maxTarget, bool forceDest, bool target)
+bool ChaseMovementGenerator<T>::DispatchSplineToPosition(T* owner, float x, float y, float z, bool walk, bool cutPath, float maxTarget, bool forceDest, bool target, bool async)
 {
-    Creature* cOwner = owner->ToCreature();
-
     if (owner->IsHovering())
         owner->UpdateAllowedPositionZ(x, y, z);
 
+    if (async)
+    {
+        // keep moving along the current spline until the path is ready, see DoUpdate
+        i_pathRequest = PathRequest::Queue(owner, PathRequest::ReusePath(owner, std::move(i_path), i_pathRequest), G3D::Vector3(x, y, z), forceDest);
+        i_pendingSpline = { walk, cutPath, maxTarget, target };
+        return true;
+    }
+
     bool success = i_path->CalculatePath(x, y, z, forceDest);
-    if (!success || i_path->GetPathType() & PATHFIND_NOPATH)
+    return LaunchSpline(owner, success, G3D::Vector3(x, y, z), walk, cutPath, maxTarget, target);
+}
+
+template<class T>
+bool ChaseMovementGenerator<T>::LaunchSpline(T* owner, bool pathFound, G3D::Vector3 const& dest, bool walk, bool cutPath, float maxTarget, bool target)
+{
+    Creature* cOwner = owner->ToCreature();
+
+    if (!pathFound || i_path->GetPathType() & PATHFIND_NOPATH)
     {
         if (cOwner)
         {
@@ -117,7 +130,7 @@ bool ChaseMovementGenerator<T>::DispatchSplineToPosition(T* owner, float x, floa
     }
 
     if (cutPath)
-        i_path->ShortenPathUntilDist(G3D::Vector3(x, y, z), maxTarget);
+        i_path->ShortenPathUntilDist(dest, maxTarget);
 
     if (cOwner)
     {
@@ -148,6 +161,7 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
 
     if (owner->HasUnitState(UNIT_STATE_NO_COMBAT_MOVEMENT)) // script paused combat movement
     {
+        i_pathRequest = nullptr;
         owner->StopMoving();
         _lastTargetPosition.reset();
         return true;
@@ -159,6 +173,7 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
     // the owner might be unable to move (rooted or casting), or we have lost the target, pause movement
     if (owner->HasUnitState(UNIT_STATE_NOT_MOVE) || HasLostTarget(owner) || isStoppedBecauseOfCasting)
     {
+        i_pathRequest = nullptr;
         owner->StopMoving();
         _lastTargetPosition.reset();
         if (cOwner)
@@ -180,6 +195,14 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
         return true;
     }
 
+    // the path requested in an earlier update is ready
+    if (i_pathRequest && i_pathRequest->IsReady())
+    {
+        PathRequestPtr request = std::move(i_pathRequest);
+        i_path = request->TakePath();
+        LaunchSpline(owner, request->Succeeded(), request->GetDestination(), i_pendingSpline.Walk, i_pendingSpline.CutPath, i_pendingSpline.MaxTarget, i_pendingSpline.Target);
+    }
+
     bool forceDest =
         //(cOwner && (cOwner->isWorldBoss() || cOwner->IsDungeonBoss())) || // force for all bosses, even not in instances
         (i_target->IsPlayer() && i_target->ToPlayer()->IsGameMaster()) || // for .npc follow
@@ -227,6 +250,7 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
                 {
                     i_recalculateTravel = false;
                     i_path = nullptr;
+                    i_pathRequest = nullptr;
                     if (cOwner)
                         cOwner->SetCannotReachTarget();
                     owner->StopMoving();
@@ -281,6 +305,7 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
                 cOwner->SetCannotReachTarget(target->GetGUID());
                 cOwner->StopMoving();
                 i_path = nullptr;
+                i_pathRequest = nullptr;
                 return true;
             }
 
@@ -291,11 +316,23 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
             bool withinLOS = owner->IsWithinLOS(x, y, z);
             bool moveToward = !(withinRange && withinLOS);
 
+            bool const async = PathRequest::IsAsyncEnabled();
+
             // make a new path if we have to...
-            if (!i_path || moveToward != _movingTowards)
-                i_path = std::make_unique<PathGenerator>(owner);
-            else
-                i_path->Clear();
+            if (moveToward != _movingTowards)
+            {
+                i_path = nullptr;
+                i_pathRequest = nullptr;
+            }
+
+            // an asynchronous request takes the generator as it is, see PathRequest::ReusePath
+            if (!async)
+            {
+                if (!i_path)
+                    i_path = std::make_unique<PathGenerator>(owner);
+                else
+                    i_path->Clear();
+            }
 
             // Predict chase destination to keep up with chase target
             float additionalRange = 0;
@@ -347,7 +384,7 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
                 }
             }
 
-            DispatchSplineToPosition(owner, x, y, z, walk, shortenPath, maxTarget, forceDest, true);
+            DispatchSplineToPosition(owner, x, y, z, walk, shortenPath, maxTarget, forceDest, true, async);
         }
     }
 
@@ -359,6 +396,7 @@ template<>
 void ChaseMovementGenerator<Player>::DoInitialize(Player* owner)
 {
     i_path = nullptr;
+    i_pathRequest = nullptr;
     _lastTargetPosition.reset();
     owner->StopMoving();
     owner->AddUnitState(UNIT_STATE_CHASE);
@@ -368,6 +406,7 @@ template<>
 void ChaseMovementGenerator<Creature>::DoInitialize(Creature* owner)
 {
     i_path = nullptr;
+    i_pathRequest = nullptr;
     _lastTargetPosition.reset();
     i_recheckDistance.Reset(0);
     i_leashExtensionTimer.Reset(owner->GetAttackTime(BASE_ATTACK));
@@ -540,6 +579,7 @@ bool FollowMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
     if (owner->HasUnitState(UNIT_STATE_NOT_MOVE) || (cOwner && owner->ToCreature()->IsMovementPreventedByCasting()))
     {
         i_path = nullptr;
+        i_pathRequest = nullptr;
         owner->StopMoving();
         _lastTargetPosition.reset();
         return true;
@@ -558,6 +598,14 @@ bool FollowMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
         (i_target->IsPlayer() && i_target->ToPlayer()->IsGameMaster()) // for .npc follow
         ; // closes "bool forceDest", that way it is more appropriate, so we can comment out crap whenever we need to
 
+    // the path requested in an earlier update is ready
+    if (i_pathRequest && i_pathRequest->IsReady())
+    {
+        PathRequestPtr request = std::move(i_pathRequest);
+        i_path = request->TakePath();
+        LaunchSpline(owner, target, request->Succeeded(), followingMaster);
+    }
+
     bool targetIsMoving = false;
     if (PositionOkay(target, owner->IsGuardian() && target->IsPlayer(), targetIsMoving, time_diff))
     {
@@ -597,11 +645,6 @@ bool FollowMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
             i_recheckPredictedDistanceTimer.Reset(0);
         }
 
-        if (!i_path)
-            i_path = std::make_unique<PathGenerator>(owner);
-        else
-            i_path->Clear();
-
         target->MovePositionToFirstCollision(targetPosition, owner->GetCombatReach() + _range, target->ToAbsoluteAngle(_angle.RelativeAngle) - target->GetOrientation());
 
         float x, y, z;
@@ -610,35 +653,54 @@ bool FollowMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
         if (owner->IsHovering())
             owner->UpdateAllowedPositionZ(x, y, z);
 
-        bool success = i_path->CalculatePath(x, y, z, forceDest);
-        if (!success || (i_path->GetPathType() & PATHFIND_NOPATH && !followingMaster))
+        if (PathRequest::IsAsyncEnabled())
         {
-            if (!owner->IsStopped())
-                owner->StopMoving();
-
+            // keep moving along the current spline until the path is ready
+            i_pathRequest = PathRequest::Queue(owner, PathRequest::ReusePath(owner, std::move(i_path), i_pathRequest), G3D::Vector3(x, y, z), forceDest);
             return true;
         }
 
-        owner->AddUnitState(UNIT_STATE_FOLLOW_MOVE);
-
-        Movement::MoveSplineInit init(owner);
-        init.MovebyPath(i_path->GetPath());
-        if (_inheritWalkState)
-            init.SetWalk(target->IsWalking() || target->movespline->isWalking());
+        if (!i_path)
+            i_path = std::make_unique<PathGenerator>(owner);
+        else
+            i_path->Clear();
 
-        if (_inheritSpeed)
-            if (Optional<float> velocity = GetVelocity(owner, target, i_path->GetActualEndPosition(), owner->IsGuardian()))
-                init.SetVelocity(*velocity);
-        init.Launch();
+        bool success = i_path->CalculatePath(x, y, z, forceDest);
+        LaunchSpline(owner, target, success, followingMaster);
     }
 
     return true;
 }
 
+template<class T>
+void FollowMovementGenerator<T>::LaunchSpline(T* owner, Unit* target, bool pathFound, bool followingMaster)
+{
+    if (!pathFound || (i_path->GetPathType() & PATHFIND_NOPATH && !followingMaster))
+    {
+        if (!owner->IsStopped())
+            owner->StopMoving();
+
+        return;
+    }
+
+    owner->AddUnitState(UNIT_STATE_FOLLOW_MOVE);
+
+    Movement::MoveSplineInit init(owner);
+    init.MovebyPath(i_path->GetPath());
+    if (_inheritWalkState)
+        init.SetWalk(target->IsWalking() || target->movespline->isWalking());
+
+    if (_inheritSpeed)
+        if (Optional<float> velocity = GetVelocity(owner, target, i_path->GetActualEndPosition(), owner->IsGuardian()))
+            init.SetVelocity(*velocity);
+    init.Launch();
+}
+
 template<class T>
 void FollowMovementGenerator<T>::DoInitialize(T* owner)
 {
     i_path = nullptr;
+    i_pathRequest = nullptr;
     _lastTargetPosition.reset();
     owner->AddUnitState(UNIT_STATE_FOLLOW);
 }
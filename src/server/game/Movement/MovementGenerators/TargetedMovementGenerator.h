@@ -22,6 +22,7 @@
 #include "MovementGenerator.h"
 #include "Optional.h"
 #include "PathGenerator.h"
+#include "PathRequest.h"
 #include "Timer.h"
 #include "Unit.h"
 
@@ -70,10 +71,23 @@ public:
     void SetNewTarget(Unit* target);
 
     void DistanceYourself(T* owner, float distance);
-    bool DispatchSplineToPosition(T* owner, float x, float y, float z, bool walk, bool cutPath, float maxTarget, bool forceDest, bool target = false);
+    bool DispatchSplineToPosition(T* owner, float x, float y, float z, bool walk, bool cutPath, float maxTarget, bool forceDest, bool target = false, bool async = false);
 private:
+    bool LaunchSpline(T* owner, bool pathFound, G3D::Vector3 const& dest, bool walk, bool cutPath, float maxTarget, bool target);
+
+    // spline arguments of the path requested asynchronously
+    struct PendingSpline
+    {
+        bool Walk;
+        bool CutPath;
+        float MaxTarget;
+        bool Target;
+    };
+
     TimeTrackerSmall i_leashExtensionTimer;
     std::unique_ptr<PathGenerator> i_path;
+    PathRequestPtr i_pathRequest;
+    PendingSpline i_pendingSpline{};
     TimeTrackerSmall i_recheckDistance;
     bool i_recalculateTravel;
 
@@ -114,7 +128,10 @@ public:
     float GetFollowRange() const { return _range; }
 
 private:
+    void LaunchSpline(T* owner, Unit* target, bool pathFound, bool followingMaster);
+
     std::unique_ptr<PathGenerator> i_path;
+    PathRequestPtr i_pathRequest;
     TimeTrackerSmall i_recheckPredictedDistanceTimer;
     bool i_recheckPredictedDistance;
 
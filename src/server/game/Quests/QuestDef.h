@@ -209,6 +209,7 @@ struct QuestOfferRewardLocale
 class Quest
 {
     friend class ObjectMgr;
+    friend class WorldSnapshot;
 public:
     Quest(Field* questRecord);
     void LoadQuestDetails(Field* fields);
@@ -333,6 +334,8 @@ public:
 
     // cached data
 private:
+    Quest() = default;                                      // read from a WorldSnapshot
+
     uint32 _reqItemsCount;
     uint32 _reqCreatureOrGOcount;
     uint32 _rewChoiceItemsCount;
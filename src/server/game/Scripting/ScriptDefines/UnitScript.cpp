@@ -104,6 +104,11 @@ void ScriptMgr::OnPatchValuesUpdate(Unit const* unit, ByteBuffer& valuesUpdateBu
     CALL_ENABLED_HOOKS(UnitScript, UNITHOOK_ON_PATCH_VALUES_UPDATE, script->OnPatchValuesUpdate(unit, valuesUpdateBuf, posPointers, target));
 }
 
+bool ScriptMgr::IsPatchingValuesUpdate() const
+{
+    return !ScriptRegistry<UnitScript>::EnabledHooks[UNITHOOK_ON_PATCH_VALUES_UPDATE].empty();
+}
+
 void ScriptMgr::OnUnitUpdate(Unit* unit, uint32 diff)
 {
     CALL_ENABLED_HOOKS(UnitScript, UNITHOOK_ON_UNIT_UPDATE, script->OnUnitUpdate(unit, diff));
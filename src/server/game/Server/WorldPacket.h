@@ -18,11 +18,14 @@
 #ifndef _WORLDPACKET_H_
 #define _WORLDPACKET_H_
 
+#include "BufferPool.h"
 #include "ByteBuffer.h"
 #include "Duration.h"
+#include "ObjectPool.h"
 #include "Opcodes.h"
+#include <atomic>
 
-class WorldPacket : public ByteBuffer
+class WorldPacket : public ByteBuffer, public PooledObject<WorldPacket>
 {
 public:
     // just container for later use
@@ -32,10 +35,16 @@ public:
         ByteBuffer(res), m_opcode(opcode) { }
 
     WorldPacket(WorldPacket&& packet) noexcept :
-        ByteBuffer(std::move(packet)), m_opcode(packet.m_opcode) { }
+        ByteBuffer(std::move(packet)), m_opcode(packet.m_opcode), m_pooledStorage(packet.m_pooledStorage) { }
 
     WorldPacket(WorldPacket&& packet, TimePoint receivedTime) :
-        ByteBuffer(std::move(packet)), m_opcode(packet.m_opcode), m_receivedTime(receivedTime) { }
+        ByteBuffer(std::move(packet)), m_opcode(packet.m_opcode), m_receivedTime(receivedTime), m_pooledStorage(packet.m_pooledStorage) { }
+
+    ~WorldPacket()
+    {
+        if (m_pooledStorage)
+            BufferPool::Release(std::move(_storage));
+    }
 
     WorldPacket(WorldPacket const& right) :
         ByteBuffer(right), m_opcode(right.m_opcode) { }
@@ -56,14 +65,16 @@ public:
         if (this != &right)
         {
             m_opcode = right.m_opcode;
+            m_pooledStorage = right.m_pooledStorage;
             ByteBuffer::operator=(std::move(right));
         }
 
         return *this;
     }
 
+    // received packets, their storage comes from and goes back to the BufferPool
     WorldPacket(uint16 opcode, MessageBuffer&& buffer) :
-        ByteBuffer(std::move(buffer)), m_opcode(opcode) { }
+        ByteBuffer(std::move(buffer)), m_opcode(opcode), m_pooledStorage(true) { }
 
     void Initialize(uint16 opcode, std::size_t newres = 200)
     {
@@ -77,9 +88,13 @@ public:
 
     [[nodiscard]] TimePoint GetReceivedTime() const { return m_receivedTime; }
 
+    // Link to the next packet received by the same session, see WorldSessionPacketQueue. Not copied with the packet.
+    std::atomic<WorldPacket*> SessionQueueLink{nullptr};
+
 protected:
     uint16 m_opcode{NULL_OPCODE};
     TimePoint m_receivedTime; // only set for a specific set of opcodes, for performance reasons.
+    bool m_pooledStorage{false};
 };
 
 #endif
@@ -32,6 +32,7 @@
 #include "Packet.h"
 #include "SharedDefines.h"
 #include "World.h"
+#include "WorldSessionPacketQueue.h"
 #include <map>
 #include <memory>
 #include <utility>
@@ -1231,7 +1232,7 @@ private:
     AddonsList m_addonsList;
     uint32 recruiterId;
     bool isRecruiter;
-    LockedQueue<WorldPacket*> _recvQueue;
+    WorldSessionPacketQueue _recvQueue;
     uint32 m_currentVendorEntry;
     ObjectGuid m_currentBankerGUID;
     uint32 _offlineTime;
@@ -0,0 +1,99 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _WORLD_SESSION_PACKET_QUEUE_H
+#define _WORLD_SESSION_PACKET_QUEUE_H
+
+#include "MPSCQueue.h"
+#include "WorldPacket.h"
+#include <deque>
+
+/**
+ * Packets received by a session, waiting for WorldSession::Update.
+ *
+ * The socket thread adds packets without taking a lock. They are read by one consumer at a time:
+ * the world thread or the map thread updating the session, never both at once. Packets the
+ * filter of the current update does not accept stay first in line, in a list only the consumer
+ * touches, so the packet order is kept across world and map updates.
+ */
+class WorldSessionPacketQueue
+{
+public:
+    WorldSessionPacketQueue() = default;
+    WorldSessionPacketQueue(WorldSessionPacketQueue const&) = delete;
+    WorldSessionPacketQueue& operator=(WorldSessionPacketQueue const&) = delete;
+
+    ~WorldSessionPacketQueue()
+    {
+        for (WorldPacket* packet : _pending)
+            delete packet;
+    }
+
+    // Any thread
+    void Add(WorldPacket* packet)
+    {
+        _received.Enqueue(packet);
+    }
+
+    // Consumer only, takes the next packet whatever it is
+    bool Next(WorldPacket*& packet)
+    {
+        if (!_pending.empty())
+        {
+            packet = _pending.front();
+            _pending.pop_front();
+            return true;
+        }
+
+        return _received.Dequeue(packet);
+    }
+
+    // Consumer only, takes the next packet if the filter processes it, otherwise leaves it first in line
+    template<class Filter>
+    bool Next(WorldPacket*& packet, Filter& filter)
+    {
+        if (_pending.empty())
+        {
+            WorldPacket* received = nullptr;
+            if (!_received.Dequeue(received))
+                return false;
+
+            _pending.push_back(received);
+        }
+
+        if (!filter.Process(_pending.front()))
+            return false;
+
+        packet = _pending.front();
+        _pending.pop_front();
+        return true;
+    }
+
+    // Consumer only, puts packets back first in line, in the given order
+    template<class Iterator>
+    void Readd(Iterator begin, Iterator end)
+    {
+        _pending.insert(_pending.begin(), begin, end);
+    }
+
+private:
+    MPSCQueue<WorldPacket, &WorldPacket::SessionQueueLink> _received;
+    std::deque<WorldPacket*> _pending;
+};
+
+#endif
@@ -38,60 +38,127 @@
 
 using boost::asio::ip::tcp;
 
-void compressBuff(void* dst, uint32* dst_size, void* src, int src_size)
+namespace
 {
-    z_stream c_stream;
-
-    c_stream.zalloc = (alloc_func)0;
-    c_stream.zfree = (free_func)0;
-    c_stream.opaque = (voidpf)0;
+    std::atomic<uint64> CompressedPackets;
+    std::atomic<uint64> CompressionBytesIn;
+    std::atomic<uint64> CompressionBytesOut;
+    std::atomic<uint64> CompressionTime;
 
-    // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld->getIntConfig(CONFIG_COMPRESSION));
-    if (z_res != Z_OK)
+    // zlib deflate state is ~256KB, keep one per network thread and reuse it with deflateReset
+    class UpdatePacketCompressor
     {
-        LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflateInit) Error code: {} ({})", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+    public:
+        UpdatePacketCompressor() : _level(-1) { }
 
-    c_stream.next_out = (Bytef*)dst;
-    c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
+        ~UpdatePacketCompressor()
+        {
+            if (_level >= 0)
+                deflateEnd(&_stream);
+        }
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
-    if (z_res != Z_OK)
-    {
-        LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate) Error code: {} ({})", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+        UpdatePacketCompressor(UpdatePacketCompressor const&) = delete;
+        UpdatePacketCompressor& operator=(UpdatePacketCompressor const&) = delete;
+
+        bool Compress(void* dst, uint32* dst_size, void* src, int src_size);
 
-    if (c_stream.avail_in != 0)
+    private:
+        bool Prepare(int level);
+
+        z_stream _stream;
+        int _level;
+    };
+
+    bool UpdatePacketCompressor::Prepare(int level)
     {
-        LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate not greedy)");
-        *dst_size = 0;
-        return;
+        if (_level == level)
+        {
+            int z_res = deflateReset(&_stream);
+            if (z_res == Z_OK)
+                return true;
+
+            LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflateReset) Error code: {} ({})", z_res, zError(z_res));
+        }
+
+        // Compression level changed (config reload) or the stream is unusable, start over
+        if (_level >= 0)
+        {
+            deflateEnd(&_stream);
+            _level = -1;
+        }
+
+        _stream.zalloc = (alloc_func)0;
+        _stream.zfree = (free_func)0;
+        _stream.opaque = (voidpf)0;
+
+        int z_res = deflateInit(&_stream, level);
+        if (z_res != Z_OK)
+        {
+            LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflateInit) Error code: {} ({})", z_res, zError(z_res));
+            return false;
+        }
+
+        _level = level;
+        return true;
     }
 
-    z_res = deflate(&c_stream, Z_FINISH);
-    if (z_res != Z_STREAM_END)
+    bool UpdatePacketCompressor::Compress(void* dst, uint32* dst_size, void* src, int src_size)
     {
-        LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate should report Z_STREAM_END instead {} ({})", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
+        // default Z_BEST_SPEED (1)
+        if (!Prepare(int(sWorld->getIntConfig(CONFIG_COMPRESSION))))
+            return false;
+
+        _stream.next_out = (Bytef*)dst;
+        _stream.avail_out = *dst_size;
+        _stream.next_in = (Bytef*)src;
+        _stream.avail_in = (uInt)src_size;
+
+        int z_res = deflate(&_stream, Z_NO_FLUSH);
+        if (z_res != Z_OK)
+        {
+            LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate) Error code: {} ({})", z_res, zError(z_res));
+            return false;
+        }
+
+        if (_stream.avail_in != 0)
+        {
+            LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate not greedy)");
+            return false;
+        }
+
+        z_res = deflate(&_stream, Z_FINISH);
+        if (z_res != Z_STREAM_END)
+        {
+            LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate should report Z_STREAM_END instead {} ({})", z_res, zError(z_res));
+            return false;
+        }
+
+        *dst_size = _stream.total_out;
+        return true;
     }
+}
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
+void compressBuff(void* dst, uint32* dst_size, void* src, int src_size)
+{
+    thread_local UpdatePacketCompressor compressor;
+
+    TimePoint const start = std::chrono::steady_clock::now();
+
+    if (!compressor.Compress(dst, dst_size, src, src_size))
     {
-        LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflateEnd) Error code: {} ({})", z_res, zError(z_res));
         *dst_size = 0;
         return;
     }
 
-    *dst_size = c_stream.total_out;
+    CompressedPackets.fetch_add(1, std::memory_order_relaxed);
+    CompressionBytesIn.fetch_add(uint64(src_size), std::memory_order_relaxed);
+    CompressionBytesOut.fetch_add(*dst_size, std::memory_order_relaxed);
+    CompressionTime.fetch_add(uint64(std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - start).count()), std::memory_order_relaxed);
+}
+
+bool EncryptableAndCompressiblePacket::NeedsCompression() const
+{
+    return GetOpcode() == SMSG_UPDATE_OBJECT && size() > sWorld->getIntConfig(CONFIG_COMPRESSION_THRESHOLD);
 }
 
 void EncryptableAndCompressiblePacket::CompressIfNeeded()
@@ -116,6 +183,16 @@ void EncryptableAndCompressiblePacket::CompressIfNeeded()
     SetOpcode(SMSG_COMPRESSED_UPDATE_OBJECT);
 }
 
+UpdatePacketCompressionStats EncryptableAndCompressiblePacket::ConsumeCompressionStats()
+{
+    UpdatePacketCompressionStats stats;
+    stats.Packets = CompressedPackets.exchange(0, std::memory_order_relaxed);
+    stats.BytesIn = CompressionBytesIn.exchange(0, std::memory_order_relaxed);
+    stats.BytesOut = CompressionBytesOut.exchange(0, std::memory_order_relaxed);
+    stats.Time = Microseconds(CompressionTime.exchange(0, std::memory_order_relaxed));
+    return stats;
+}
+
 WorldSocket::WorldSocket(tcp::socket&& socket)
     : Socket(std::move(socket)), _OverSpeedPings(0), _worldSession(nullptr), _authed(false), _sendBufferSize(4096), _loggingPackets(false)
 {
@@ -166,9 +243,8 @@ bool WorldSocket::Update()
     EncryptableAndCompressiblePacket* queued;
     if (_bufferQueue.Dequeue(queued))
     {
-        // Allocate buffer only when it's needed but not on every Update() call.
-        MessageBuffer buffer(_sendBufferSize);
-        std::size_t currentPacketSize;
+        // Get a buffer only when a packet is copied, not on every Update() call.
+        MessageBuffer buffer(0);
         do
         {
             queued->CompressIfNeeded();
@@ -176,34 +252,30 @@ bool WorldSocket::Update()
             if (queued->NeedsEncryption())
                 _authCrypt.EncryptSend(header.header, header.getHeaderLength());
 
-            currentPacketSize = queued->size() + header.getHeaderLength();
+            std::size_t currentPacketSize = queued->size() + header.getHeaderLength();
 
-            if (buffer.GetRemainingSpace() < currentPacketSize)
+            // Large packets are written from their own storage after the buffered ones, small ones are cheaper to copy
+            if (!queued->empty() && (queued->size() >= MIN_GATHERED_PACKET_SIZE || currentPacketSize > _sendBufferSize))
             {
-                QueuePacket(std::move(buffer));
-                buffer.Resize(_sendBufferSize);
-            }
+                if (buffer.GetActiveSize() > 0)
+                    QueuePacket(std::move(buffer));
 
-            if (buffer.GetRemainingSpace() >= currentPacketSize)
-            {
-                buffer.Write(header.header, header.getHeaderLength());
-                if (!queued->empty())
-                    buffer.Write(queued->contents(), queued->size());
+                QueuePacket(header.header, header.getHeaderLength(), std::unique_ptr<ByteBuffer>(queued));
+                continue;
             }
-            else    // Single packet larger than current buffer size
-            {
-                // Resize buffer to fit current packet
-                buffer.Resize(currentPacketSize);
 
-                // Grow future buffers to current packet size if still below limit
-                if (currentPacketSize <= 65536)
-                    _sendBufferSize = currentPacketSize;
+            if (buffer.GetRemainingSpace() < currentPacketSize)
+            {
+                if (buffer.GetActiveSize() > 0)
+                    QueuePacket(std::move(buffer));
 
-                buffer.Write(header.header, header.getHeaderLength());
-                if (!queued->empty())
-                    buffer.Write(queued->contents(), queued->size());
+                buffer = GetSendBuffer(_sendBufferSize);
             }
 
+            buffer.Write(header.header, header.getHeaderLength());
+            if (!queued->empty())
+                buffer.Write(queued->contents(), queued->size());
+
             delete queued;
         } while (_bufferQueue.Dequeue(queued));
 
@@ -324,7 +396,7 @@ bool WorldSocket::ReadHeaderHandler()
     }
 
     header->size -= sizeof(header->cmd);
-    _packetBuffer.Resize(header->size);
+    _packetBuffer = MessageBuffer(BufferPool::Acquire(header->size));
 
     return true;
 }
@@ -29,6 +29,14 @@
 
 using boost::asio::ip::tcp;
 
+struct UpdatePacketCompressionStats
+{
+    uint64 Packets = 0;
+    uint64 BytesIn = 0;
+    uint64 BytesOut = 0;
+    Microseconds Time = 0us;
+};
+
 class EncryptableAndCompressiblePacket : public WorldPacket
 {
 public:
@@ -39,10 +47,13 @@ public:
 
     bool NeedsEncryption() const { return _encrypt; }
 
-    bool NeedsCompression() const { return GetOpcode() == SMSG_UPDATE_OBJECT && size() > 100; }
+    bool NeedsCompression() const;
 
     void CompressIfNeeded();
 
+    // Returns the compression counters accumulated by all network threads since the previous call
+    static UpdatePacketCompressionStats ConsumeCompressionStats();
+
     std::atomic<EncryptableAndCompressiblePacket*> SocketQueueLink;
 
 private:
@@ -72,6 +83,9 @@ class AC_GAME_API WorldSocket : public Socket<WorldSocket>
     typedef Socket<WorldSocket> BaseSocket;
 
 public:
+    // Packets with at least this many bytes are sent from their storage instead of being copied into the send buffer
+    static constexpr std::size_t MIN_GATHERED_PACKET_SIZE = 512;
+
     WorldSocket(tcp::socket&& socket);
     ~WorldSocket();
 
@@ -723,6 +723,8 @@ void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply)
     if (!handleMask)
         return;
 
+    GetBase()->SetNeedSaveForOwner();
+
     std::list<AuraApplication*> effectApplications;
     GetApplicationList(effectApplications);
 
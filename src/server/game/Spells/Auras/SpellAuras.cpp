@@ -817,6 +817,7 @@ void Aura::SetDuration(int32 duration, bool withMods)
     }
     m_duration = duration;
     SetNeedClientUpdateForTargets();
+    SetNeedSaveForOwner();
 }
 
 void Aura::RefreshDuration(bool withMods)
@@ -898,6 +899,7 @@ void Aura::SetCharges(uint8 charges)
     m_procCharges = charges;
     m_isUsingCharges = m_procCharges != 0;
     SetNeedClientUpdateForTargets();
+    SetNeedSaveForOwner();
 }
 
 uint8 Aura::CalcMaxCharges(Unit* caster) const
@@ -937,6 +939,7 @@ bool Aura::ModCharges(int32 num, AuraRemoveMode removeMode)
 void Aura::SetStackAmount(uint8 stackAmount)
 {
     m_stackAmount = stackAmount;
+    SetNeedSaveForOwner();
     Unit* caster = GetCaster();
 
     if (!caster)
@@ -1213,6 +1216,12 @@ void Aura::SetNeedClientUpdateForTargets() const
         appIter->second->SetNeedClientUpdate();
 }
 
+void Aura::SetNeedSaveForOwner() const
+{
+    if (Player* player = GetOwner()->ToPlayer())
+        player->SetSaveSectionChanged(PLAYER_SAVE_AURAS);
+}
+
 // trigger effects on real aura apply/remove
 void Aura::HandleAuraSpecificMods(AuraApplication const* aurApp, Unit* caster, bool apply, bool onReapply)
 {
@@ -186,6 +186,8 @@ public:
     bool IsAppliedOnTarget(ObjectGuid guid) const { return m_applications.find(guid) != m_applications.end(); }
 
     void SetNeedClientUpdateForTargets() const;
+    // marks the auras of a player owner as changed for the next save
+    void SetNeedSaveForOwner() const;
     void HandleAuraSpecificMods(AuraApplication const* aurApp, Unit* caster, bool apply, bool onReapply);
     bool CanBeAppliedOn(Unit* target);
     bool CheckAreaTarget(Unit* target);
@@ -1326,6 +1326,10 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTarge
             Acore::Containers::RandomResize(targets, maxTargets);
         }
 
+        // trace the line of sight rays checked by CheckEffectTarget for all targets at once
+        if (!m_targets.HasDst() && !m_spellInfo->HasAttribute(SPELL_ATTR2_IGNORE_LINE_OF_SIGHT))
+            m_caster->PrefetchLOSInMap(targets, VMAP::ModelIgnoreFlags::M2);
+
         for (std::list<WorldObject*>::iterator itr = targets.begin(); itr != targets.end(); ++itr)
         {
             if (Unit* unitTarget = (*itr)->ToUnit())
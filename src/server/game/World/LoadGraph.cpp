@@ -0,0 +1,184 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LoadGraph.h"
+#include "Log.h"
+#include "Timer.h"
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <thread>
+
+LoadGraph::Step& LoadGraph::Step::Reads(std::initializer_list<LoadStore> stores)
+{
+    for (LoadStore store : stores)
+        _reads.set(static_cast<std::size_t>(store));
+
+    return *this;
+}
+
+LoadGraph::Step& LoadGraph::Step::Writes(std::initializer_list<LoadStore> stores)
+{
+    for (LoadStore store : stores)
+        _writes.set(static_cast<std::size_t>(store));
+
+    return *this;
+}
+
+bool LoadGraph::Step::ConflictsWith(Step const& other) const
+{
+    if (IsBarrier() || other.IsBarrier())
+        return true;
+
+    return (_writes & (other._reads | other._writes)).any() || (_reads & other._writes).any();
+}
+
+LoadGraph::Step& LoadGraph::AddStep(std::string name, std::function<void()> task)
+{
+    _steps.push_back(Step(std::move(name), std::move(task)));
+    return _steps.back();
+}
+
+void LoadGraph::BuildDependencies()
+{
+    for (std::size_t i = 0; i < _steps.size(); ++i)
+    {
+        for (std::size_t j = 0; j < i; ++j)
+        {
+            if (!_steps[j].ConflictsWith(_steps[i]))
+                continue;
+
+            _steps[j]._dependents.push_back(i);
+            ++_steps[i]._pendingDependencies;
+        }
+    }
+}
+
+void LoadGraph::Run(uint32 threads)
+{
+    _threads = std::max<uint32>(threads, 1);
+    uint32 const startTime = getMSTime();
+
+    auto runStep = [](Step& step)
+    {
+        if (!step._quiet)
+            LOG_INFO("server.loading", "{}", step._name);
+
+        uint32 const stepStartTime = getMSTime();
+        step._task();
+        step._duration = Milliseconds(GetMSTimeDiffToNow(stepStartTime));
+    };
+
+    if (_threads == 1)
+    {
+        for (Step& step : _steps)
+            runStep(step);
+
+        _wallTime = Milliseconds(GetMSTimeDiffToNow(startTime));
+        return;
+    }
+
+    BuildDependencies();
+
+    std::mutex lock;
+    std::condition_variable stepDone;
+    std::set<std::size_t> ready;        // earliest added step first, keeps the log close to the serial order
+    std::size_t doneCount = 0;
+    std::exception_ptr error;           // first exception thrown by a step, no step is started after it
+
+    for (std::size_t i = 0; i < _steps.size(); ++i)
+        if (!_steps[i]._pendingDependencies)
+            ready.insert(i);
+
+    auto worker = [&]()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        while (true)
+        {
+            stepDone.wait(guard, [&] { return !ready.empty() || doneCount == _steps.size() || error; });
+            if (ready.empty() || error)
+                return;
+
+            std::size_t const index = *ready.begin();
+            ready.erase(ready.begin());
+
+            guard.unlock();
+            try
+            {
+                runStep(_steps[index]);
+            }
+            catch (...)
+            {
+                guard.lock();
+                if (!error)
+                    error = std::current_exception();
+
+                stepDone.notify_all();
+                return;
+            }
+            guard.lock();
+
+            ++doneCount;
+            for (std::size_t dependent : _steps[index]._dependents)
+                if (!--_steps[dependent]._pendingDependencies)
+                    ready.insert(dependent);
+
+            stepDone.notify_all();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(_threads - 1);
+    for (uint32 i = 1; i < _threads; ++i)
+        workers.emplace_back(worker);
+
+    worker();
+
+    for (std::thread& thread : workers)
+        thread.join();
+
+    _wallTime = Milliseconds(GetMSTimeDiffToNow(startTime));
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void LoadGraph::LogTimings() const
+{
+    std::vector<std::size_t> order(_steps.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](std::size_t left, std::size_t right)
+    {
+        return _steps[left]._duration > _steps[right]._duration;
+    });
+
+    Milliseconds totalStepTime = 0ms;
+    for (Step const& step : _steps)
+        totalStepTime += step._duration;
+
+    LOG_INFO("server.loading", " ");
+    LOG_INFO("server.loading", "Load step timings:");
+    for (std::size_t index : order)
+        LOG_INFO("server.loading", ">> {:>7} ms  {}", _steps[index]._duration.count(), _steps[index]._name);
+
+    LOG_INFO("server.loading", ">> {} load steps took {} ms using {} thread(s), {} ms when run one by one",
+        _steps.size(), _wallTime.count(), _threads, totalStepTime.count());
+    LOG_INFO("server.loading", " ");
+}
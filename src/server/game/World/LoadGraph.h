@@ -0,0 +1,211 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _LOAD_GRAPH_H
+#define _LOAD_GRAPH_H
+
+#include "Define.h"
+#include "Duration.h"
+#include <bitset>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+// Data stores filled during startup, used to order the load steps touching them
+enum class LoadStore : uint8
+{
+    ScriptNames,
+    InstanceTemplates,
+    Instances,
+    CharacterCache,
+    CharacterObjects,           // auctions, guilds, arena teams and groups
+    Maps,
+    BroadcastTexts,
+    CreatureLocales,
+    GameObjectLocales,
+    ItemLocales,
+    QuestLocales,
+    NpcTextLocales,
+    PageTextLocales,
+    GossipMenuItemLocales,
+    PointOfInterestLocales,
+    DbcLocale,
+    PageTexts,
+    GameObjectTemplates,
+    GameObjectTemplateAddons,
+    TransportTemplates,
+    TransportMaps,
+    SpellInfos,
+    SpellData,                  // SpellMgr data other than SpellInfo (ranks, procs, bonuses...)
+    GossipTexts,
+    RandomEnchantments,
+    Disables,
+    ItemTemplates,
+    ItemSetNames,
+    CharStartOutfits,
+    CreatureModels,
+    CreatureCustomIds,
+    CreatureTemplates,
+    EquipmentTemplates,
+    CreatureTemplateAddons,
+    Reputation,
+    PointsOfInterest,
+    CreatureBaseStats,
+    Creatures,
+    CreatureSparring,
+    TempSummons,
+    CreatureAddons,
+    CreatureMovementOverrides,
+    GameObjects,
+    GameObjectAddons,
+    QuestItems,
+    LinkedRespawn,
+    Weather,
+    Quests,
+    QuestPOI,
+    QuestRelations,
+    QuestGreetings,
+    QuestMoneyRewards,
+    Pools,
+    SpellClick,
+    VehicleAccessories,
+    VehicleSeatAddons,
+    AreaTriggers,
+    AreaTriggerData,            // teleports, quest and tavern triggers, trigger scripts
+    AccessRequirements,
+    Lfg,
+    InstanceEncounters,
+    Graveyards,
+    PlayerInfo,
+    ExplorationBaseXP,
+    PetNames,
+    PetNumber,
+    PetLevelInfo,
+    MailLevelRewards,
+    ServerMails,
+    LootCreature,
+    LootFishing,
+    LootGameobject,
+    LootItem,
+    LootMail,
+    LootMilling,
+    LootPickpocketing,
+    LootSkinning,
+    LootDisenchant,
+    LootProspecting,
+    LootSpell,
+    LootReference,
+    LootPlayer,
+    SkillDiscovery,
+    SkillExtraItems,
+    FishingBaseSkill,
+    Achievements,
+    ReservedNames,
+    ProfanityNames,
+    BattleMasters,
+    GameTele,
+    GossipMenus,
+    Vendors,
+    Trainers,
+    Waypoints,
+    SmartWaypoints,
+    CreatureFormations,
+    WorldStates,
+    FactionChange,
+    Tickets,
+    Addons,
+    Autobroadcasts,
+    Motd,
+    SpellScriptNames,
+    CreatureTexts,
+    SmartScripts,
+    Calendar,
+
+    Max
+};
+
+/**
+ * Runs startup load steps, concurrently when they do not touch the same stores.
+ *
+ * Each step declares the stores it reads and writes. A step runs after every step
+ * added before it that writes a store it reads or writes, or reads a store it writes,
+ * so the result is the same as running the steps one by one in insertion order.
+ * A step declaring no store at all is a barrier: it runs alone, after all previous
+ * steps and before all following ones.
+ */
+class LoadGraph
+{
+    using StoreMask = std::bitset<static_cast<std::size_t>(LoadStore::Max)>;
+
+public:
+    class Step
+    {
+        friend class LoadGraph;
+
+    public:
+        Step& Reads(std::initializer_list<LoadStore> stores);
+        Step& Writes(std::initializer_list<LoadStore> stores);
+
+        // Do not log the step name when it starts, for loaders logging their own progress
+        Step& Quiet() { _quiet = true; return *this; }
+
+    private:
+        Step(std::string name, std::function<void()> task) : _name(std::move(name)), _task(std::move(task)) { }
+
+        bool IsBarrier() const { return _reads.none() && _writes.none(); }
+        bool ConflictsWith(Step const& other) const;
+
+        std::string _name;
+        std::function<void()> _task;
+        StoreMask _reads;
+        StoreMask _writes;
+        bool _quiet = false;
+
+        std::vector<std::size_t> _dependents;
+        uint32 _pendingDependencies = 0;
+        Milliseconds _duration = 0ms;
+    };
+
+    LoadGraph() = default;
+    LoadGraph(LoadGraph const&) = delete;
+    LoadGraph& operator=(LoadGraph const&) = delete;
+
+    // name is logged when the step starts, like the former "Loading ..." lines
+    Step& AddStep(std::string name, std::function<void()> task);
+
+    /**
+     * Runs all steps and returns once they are done.
+     * With threads <= 1 the steps run one by one on the calling thread, in insertion order.
+     * Otherwise the calling thread and threads - 1 additional threads run the steps,
+     * picking the earliest added step whose dependencies are done.
+     * An exception thrown by a step is rethrown once the running steps are done, the remaining steps are skipped.
+     */
+    void Run(uint32 threads);
+
+    // Logs the duration of every step, longest first, and the total wall time
+    void LogTimings() const;
+
+private:
+    void BuildDependencies();
+
+    std::vector<Step> _steps;
+    Milliseconds _wallTime = 0ms;
+    uint32 _threads = 0;
+};
+
+#endif
@@ -56,6 +56,7 @@
 #include "InstanceSaveMgr.h"
 #include "ItemEnchantmentMgr.h"
 #include "LFGMgr.h"
+#include "LoadGraph.h"
 #include "Log.h"
 #include "LootItemStorage.h"
 #include "LootMgr.h"
@@ -67,6 +68,7 @@
 #include "ObjectMgr.h"
 #include "Opcodes.h"
 #include "OutdoorPvPMgr.h"
+#include "PathCache.h"
 #include "PetitionMgr.h"
 #include "Player.h"
 #include "PlayerDump.h"
@@ -195,6 +197,8 @@ void World::LoadConfigSettings(bool reload)
     for (uint8 i = 0; i < MAX_MOVE_TYPE; ++i)
         baseMoveSpeed[i] *= getRate(RATE_MOVESPEED_NPC);
 
+    sPathCache->SetCapacity(getIntConfig(CONFIG_MMAP_PATH_CACHE_SIZE));
+
     if (reload)
     {
         sMapMgr->SetMapUpdateInterval(getIntConfig(CONFIG_INTERVAL_MAPUPDATE));
@@ -316,6 +320,9 @@ void World::SetInitialWorldSettings()
     vmmgr2->GetLiquidFlagsPtr = &GetLiquidFlags;
     vmmgr2->IsVMAPDisabledForPtr = &DisableMgr::IsVMAPDisabledFor;
 
+    ///- Drop the cached paths crossing the navmesh tiles unloaded by MMapMgr
+    MMAP::MMapFactory::createOrGetMMapMgr()->TileUnloadedPtr = &PathCache::OnTileUnloaded;
+
     ///- Initialize config settings
     LoadConfigSettings();
 
@@ -438,434 +445,660 @@ void World::SetInitialWorldSettings()
     LOG_INFO("server.loading", "Loading GameObject Models...");
     LoadGameObjectModelList(_dataPath);
 
-    LOG_INFO("server.loading", "Loading Script Names...");
-    sObjectMgr->LoadScriptNames();
-
-    LOG_INFO("server.loading", "Loading Instance Template...");
-    sObjectMgr->LoadInstanceTemplate();
+    ///- Load the world data stores. Each step declares the stores it reads and writes, independent steps
+    ///- are loaded concurrently when Startup.LoadThreads is set, otherwise everything is loaded in order.
+    LoadGraph loadGraph;
 
-    LOG_INFO("server.loading", "Loading Character Cache...");
-    sCharacterCache->LoadCharacterCacheStorage();
-
-    // Must be called before `creature_respawn`/`gameobject_respawn` tables
-    LOG_INFO("server.loading", "Loading Instances...");
-    sInstanceSaveMgr->LoadInstances();
-
-    LOG_INFO("server.loading", "Loading Broadcast Texts...");
-    sObjectMgr->LoadBroadcastTexts();
-    sObjectMgr->LoadBroadcastTextLocales();
-
-    LOG_INFO("server.loading", "Loading Localization Strings...");
-    uint32 oldMSTime = getMSTime();
-    sObjectMgr->LoadCreatureLocales();
-    sObjectMgr->LoadGameObjectLocales();
-    sObjectMgr->LoadItemLocales();
-    sObjectMgr->LoadItemSetNameLocales();
-    sObjectMgr->LoadQuestLocales();
-    sObjectMgr->LoadQuestOfferRewardLocale();
-    sObjectMgr->LoadQuestRequestItemsLocale();
-    sObjectMgr->LoadNpcTextLocales();
-    sObjectMgr->LoadPageTextLocales();
-    sObjectMgr->LoadGossipMenuItemsLocales();
-    sObjectMgr->LoadPointOfInterestLocales();
-    sObjectMgr->LoadPetNamesLocales();
-
-    sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
-    LOG_INFO("server.loading", ">> Localization Strings loaded in {} ms", GetMSTimeDiffToNow(oldMSTime));
-    LOG_INFO("server.loading", " ");
+    loadGraph.AddStep("Loading Script Names...", [] { sObjectMgr->LoadScriptNames(); })
+        .Writes({ LoadStore::ScriptNames });
 
-    LOG_INFO("server.loading", "Loading Page Texts...");
-    sObjectMgr->LoadPageTexts();
+    loadGraph.AddStep("Loading Instance Template...", [] { sObjectMgr->LoadInstanceTemplate(); })
+        .Reads({ LoadStore::ScriptNames })
+        .Writes({ LoadStore::InstanceTemplates });
 
-    LOG_INFO("server.loading", "Loading Game Object Templates...");         // must be after LoadPageTexts
-    sObjectMgr->LoadGameObjectTemplate();
+    loadGraph.AddStep("Loading Character Cache...", [] { sCharacterCache->LoadCharacterCacheStorage(); })
+        .Writes({ LoadStore::CharacterCache });
 
-    LOG_INFO("server.loading", "Loading Game Object Template Addons...");
-    sObjectMgr->LoadGameObjectTemplateAddons();
+    // Must be called before `creature_respawn`/`gameobject_respawn` tables
+    loadGraph.AddStep("Loading Instances...", [] { sInstanceSaveMgr->LoadInstances(); })
+        .Reads({ LoadStore::InstanceTemplates })
+        .Writes({ LoadStore::Instances, LoadStore::Maps });
 
-    LOG_INFO("server.loading", "Loading Transport Templates...");
-    sTransportMgr->LoadTransportTemplates();
+    loadGraph.AddStep("Loading Broadcast Texts...", [] { sObjectMgr->LoadBroadcastTexts(); })
+        .Writes({ LoadStore::BroadcastTexts });
 
-    LOG_INFO("server.loading", "Loading Spell Required Data...");
-    sSpellMgr->LoadSpellRequired();
+    loadGraph.AddStep("Loading Broadcast Text Locales...", [] { sObjectMgr->LoadBroadcastTextLocales(); })
+        .Writes({ LoadStore::BroadcastTexts });
 
-    LOG_INFO("server.loading", "Loading Spell Group Types...");
-    sSpellMgr->LoadSpellGroups();
+    loadGraph.AddStep("Loading Creature Locales...", [] { sObjectMgr->LoadCreatureLocales(); })
+        .Writes({ LoadStore::CreatureLocales });
 
-    LOG_INFO("server.loading", "Loading Spell Learn Skills...");
-    sSpellMgr->LoadSpellLearnSkills();                           // must be after LoadSpellRanks
+    loadGraph.AddStep("Loading GameObject Locales...", [] { sObjectMgr->LoadGameObjectLocales(); })
+        .Writes({ LoadStore::GameObjectLocales });
 
-    LOG_INFO("server.loading", "Loading Spell Proc Event Conditions...");
-    sSpellMgr->LoadSpellProcEvents();
+    loadGraph.AddStep("Loading Item Locales...", [] { sObjectMgr->LoadItemLocales(); })
+        .Writes({ LoadStore::ItemLocales });
 
-    LOG_INFO("server.loading", "Loading Spell Proc Conditions and Data...");
-    sSpellMgr->LoadSpellProcs();
+    loadGraph.AddStep("Loading Item Set Name Locales...", [] { sObjectMgr->LoadItemSetNameLocales(); })
+        .Writes({ LoadStore::ItemLocales });
 
-    LOG_INFO("server.loading", "Loading Spell Bonus Data...");
-    sSpellMgr->LoadSpellBonuses();
+    loadGraph.AddStep("Loading Quest Locales...", [] { sObjectMgr->LoadQuestLocales(); })
+        .Writes({ LoadStore::QuestLocales });
 
-    LOG_INFO("server.loading", "Loading Aggro Spells Definitions...");
-    sSpellMgr->LoadSpellThreats();
+    loadGraph.AddStep("Loading Quest Offer Reward Locales...", [] { sObjectMgr->LoadQuestOfferRewardLocale(); })
+        .Writes({ LoadStore::QuestLocales });
 
-    LOG_INFO("server.loading", "Loading Mixology Bonuses...");
-    sSpellMgr->LoadSpellMixology();
+    loadGraph.AddStep("Loading Quest Request Items Locales...", [] { sObjectMgr->LoadQuestRequestItemsLocale(); })
+        .Writes({ LoadStore::QuestLocales });
 
-    LOG_INFO("server.loading", "Loading Spell Group Stack Rules...");
-    sSpellMgr->LoadSpellGroupStackRules();
+    loadGraph.AddStep("Loading NPC Text Locales...", [] { sObjectMgr->LoadNpcTextLocales(); })
+        .Writes({ LoadStore::NpcTextLocales });
 
-    LOG_INFO("server.loading", "Loading NPC Texts...");
-    sObjectMgr->LoadGossipText();
+    loadGraph.AddStep("Loading Page Text Locales...", [] { sObjectMgr->LoadPageTextLocales(); })
+        .Writes({ LoadStore::PageTextLocales });
 
-    LOG_INFO("server.loading", "Loading Enchant Spells Proc Datas...");
-    sSpellMgr->LoadSpellEnchantProcData();
+    loadGraph.AddStep("Loading Gossip Menu Option Locales...", [] { sObjectMgr->LoadGossipMenuItemsLocales(); })
+        .Writes({ LoadStore::GossipMenuItemLocales });
 
-    LOG_INFO("server.loading", "Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
+    loadGraph.AddStep("Loading Point Of Interest Locales...", [] { sObjectMgr->LoadPointOfInterestLocales(); })
+        .Writes({ LoadStore::PointOfInterestLocales });
 
-    LOG_INFO("server.loading", "Loading Disables");
-    sDisableMgr->LoadDisables();                                  // must be before loading quests and items
+    loadGraph.AddStep("Loading Pet Name Locales...", [] { sObjectMgr->LoadPetNamesLocales(); })
+        .Writes({ LoadStore::PetNames });
 
-    LOG_INFO("server.loading", "Loading Items...");                         // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr->LoadItemTemplates();
+    // Get once for all the locale index of DBC language (console/broadcasts)
+    loadGraph.AddStep("Setting DBC Locale Index...", [this] { sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale()); })
+        .Writes({ LoadStore::DbcLocale });
 
-    LOG_INFO("server.loading", "Loading Item Set Names...");                // must be after LoadItemPrototypes
-    sObjectMgr->LoadItemSetNames();
+    loadGraph.AddStep("Loading Page Texts...", [] { sObjectMgr->LoadPageTexts(); })
+        .Writes({ LoadStore::PageTexts });
 
-    LOG_INFO("server.loading", "Loading Creature Model Based Info Data...");
-    sObjectMgr->LoadCreatureModelInfo();
+    loadGraph.AddStep("Loading Game Object Templates...", [] { sObjectMgr->LoadGameObjectTemplate(); })
+        .Reads({ LoadStore::PageTexts, LoadStore::ScriptNames, LoadStore::SpellInfos })
+        .Writes({ LoadStore::GameObjectTemplates, LoadStore::TransportMaps });
 
-    LOG_INFO("server.loading", "Loading Creature Custom IDs Config...");
-    sObjectMgr->LoadCreatureCustomIDs();
+    loadGraph.AddStep("Loading Game Object Template Addons...", [] { sObjectMgr->LoadGameObjectTemplateAddons(); })
+        .Reads({ LoadStore::GameObjectTemplates })
+        .Writes({ LoadStore::GameObjectTemplateAddons });
 
-    LOG_INFO("server.loading", "Loading Creature Templates...");
-    sObjectMgr->LoadCreatureTemplates();
+    loadGraph.AddStep("Loading Transport Templates...", [] { sTransportMgr->LoadTransportTemplates(); })
+        .Reads({ LoadStore::GameObjectTemplates })
+        .Writes({ LoadStore::TransportTemplates });
 
-    LOG_INFO("server.loading", "Loading Equipment Templates...");           // must be after LoadCreatureTemplates
-    sObjectMgr->LoadEquipmentTemplates();
+    loadGraph.AddStep("Loading Spell Required Data...", [] { sSpellMgr->LoadSpellRequired(); })
+        .Reads({ LoadStore::SpellInfos })
+        .Writes({ LoadStore::SpellData });
 
-    LOG_INFO("server.loading", "Loading Creature Template Addons...");
-    sObjectMgr->LoadCreatureTemplateAddons();
+    loadGraph.AddStep("Loading Spell Group Types...", [] { sSpellMgr->LoadSpellGroups(); })
+        .Reads({ LoadStore::SpellInfos })
+        .Writes({ LoadStore::SpellData });
 
-    LOG_INFO("server.loading", "Loading Reputation Reward Rates...");
-    sObjectMgr->LoadReputationRewardRate();
+    loadGraph.AddStep("Loading Spell Learn Skills...", [] { sSpellMgr->LoadSpellLearnSkills(); })
+        .Reads({ LoadStore::SpellInfos })
+        .Writes({ LoadStore::SpellData });
 
-    LOG_INFO("server.loading", "Loading Creature Reputation OnKill Data...");
-    sObjectMgr->LoadReputationOnKill();
+    loadGraph.AddStep("Loading Spell Proc Event Conditions...", [] { sSpellMgr->LoadSpellProcEvents(); })
+        .Reads({ LoadStore::SpellInfos })
+        .Writes({ LoadStore::SpellData });
 
-    LOG_INFO("server.loading", "Loading Reputation Spillover Data..." );
-    sObjectMgr->LoadReputationSpilloverTemplate();
+    loadGraph.AddStep("Loading Spell Proc Conditions and Data...", [] { sSpellMgr->LoadSpellProcs(); })
+        .Reads({ LoadStore::SpellInfos })
+        .Writes({ LoadStore::SpellData });
 
-    LOG_INFO("server.loading", "Loading Points Of Interest Data...");
-    sObjectMgr->LoadPointsOfInterest();
+    loadGraph.AddStep("Loading Spell Bonus Data...", [] { sSpellMgr->LoadSpellBonuses(); })
+        .Reads({ LoadStore::SpellInfos })
+        .Writes({ LoadStore::SpellData });
 
-    LOG_INFO("server.loading", "Loading Creature Base Stats...");
-    sObjectMgr->LoadCreatureClassLevelStats();
+    loadGraph.AddStep("Loading Aggro Spells Definitions...", [] { sSpellMgr->LoadSpellThreats(); })
+        .Reads({ LoadStore::SpellInfos })
+        .Writes({ LoadStore::SpellData });
 
-    LOG_INFO("server.loading", "Loading Creature Data...");
-    sObjectMgr->LoadCreatures();
+    loadGraph.AddStep("Loading Mixology Bonuses...", [] { sSpellMgr->LoadSpellMixology(); })
+        .Reads({ LoadStore::SpellInfos })
+        .Writes({ LoadStore::SpellData });
 
-    LOG_INFO("server.loading", "Loading Creature sparring...");
-    sObjectMgr->LoadCreatureSparring();
+    loadGraph.AddStep("Loading Spell Group Stack Rules...", [] { sSpellMgr->LoadSpellGroupStackRules(); })
+        .Reads({ LoadStore::SpellInfos })
+        .Writes({ LoadStore::SpellData });
 
-    LOG_INFO("server.loading", "Loading Temporary Summon Data...");
-    sObjectMgr->LoadTempSummons();                               // must be after LoadCreatureTemplates() and LoadGameObjectTemplates()
+    loadGraph.AddStep("Loading NPC Texts...", [] { sObjectMgr->LoadGossipText(); })
+        .Reads({ LoadStore::BroadcastTexts })
+        .Writes({ LoadStore::GossipTexts });
 
-    LOG_INFO("server.loading", "Loading Pet Levelup Spells...");
-    sSpellMgr->LoadPetLevelupSpellMap();
+    loadGraph.AddStep("Loading Enchant Spells Proc Datas...", [] { sSpellMgr->LoadSpellEnchantProcData(); })
+        .Writes({ LoadStore::SpellData });
 
-    LOG_INFO("server.loading", "Loading Pet default Spells additional to Levelup Spells...");
-    sSpellMgr->LoadPetDefaultSpells();
+    loadGraph.AddStep("Loading Item Random Enchantments Table...", [] { LoadRandomEnchantmentsTable(); })
+        .Writes({ LoadStore::RandomEnchantments });
 
-    LOG_INFO("server.loading", "Loading Creature Addon Data...");
-    sObjectMgr->LoadCreatureAddons();                            // must be after LoadCreatureTemplates() and LoadCreatures()
+    // must be before loading quests and items
+    loadGraph.AddStep("Loading Disables", [] { sDisableMgr->LoadDisables(); })
+        .Reads({ LoadStore::GameObjectTemplates })
+        .Writes({ LoadStore::Disables, LoadStore::SpellInfos });
 
-    LOG_INFO("server.loading", "Loading Creature Movement Overrides...");
-    sObjectMgr->LoadCreatureMovementOverrides(); // must be after LoadCreatures()
+    // must be after LoadRandomEnchantmentsTable and LoadPageTexts
+    loadGraph.AddStep("Loading Items...", [] { sObjectMgr->LoadItemTemplates(); })
+        .Reads({ LoadStore::Disables, LoadStore::PageTexts, LoadStore::RandomEnchantments, LoadStore::ScriptNames, LoadStore::SpellInfos, LoadStore::CharStartOutfits })
+        .Writes({ LoadStore::ItemTemplates });
 
-    LOG_INFO("server.loading", "Loading Gameobject Data...");
-    sObjectMgr->LoadGameobjects();
+    // must be after LoadItemPrototypes
+    loadGraph.AddStep("Loading Item Set Names...", [] { sObjectMgr->LoadItemSetNames(); })
+        .Reads({ LoadStore::ItemTemplates })
+        .Writes({ LoadStore::ItemSetNames });
 
-    LOG_INFO("server.loading", "Loading GameObject Addon Data...");
-    sObjectMgr->LoadGameObjectAddons();                          // must be after LoadGameObjectTemplate() and LoadGameobjects()
+    loadGraph.AddStep("Loading Creature Model Based Info Data...", [] { sObjectMgr->LoadCreatureModelInfo(); })
+        .Writes({ LoadStore::CreatureModels });
 
-    LOG_INFO("server.loading", "Loading GameObject Quest Items...");
-    sObjectMgr->LoadGameObjectQuestItems();
+    loadGraph.AddStep("Loading Creature Custom IDs Config...", [] { sObjectMgr->LoadCreatureCustomIDs(); })
+        .Writes({ LoadStore::CreatureCustomIds });
 
-    LOG_INFO("server.loading", "Loading Creature Quest Items...");
-    sObjectMgr->LoadCreatureQuestItems();
+    // runs the OnAfterDatabaseLoadCreatureTemplates script hook, keep it alone
+    loadGraph.AddStep("Loading Creature Templates...", [] { sObjectMgr->LoadCreatureTemplates(); });
 
-    LOG_INFO("server.loading", "Loading Creature Linked Respawn...");
-    sObjectMgr->LoadLinkedRespawn();                             // must be after LoadCreatures(), LoadGameObjects()
+    // must be after LoadCreatureTemplates
+    loadGraph.AddStep("Loading Equipment Templates...", [] { sObjectMgr->LoadEquipmentTemplates(); })
+        .Reads({ LoadStore::CreatureTemplates })
+        .Writes({ LoadStore::EquipmentTemplates });
 
-    LOG_INFO("server.loading", "Loading Weather Data...");
-    WeatherMgr::LoadWeatherData();
+    loadGraph.AddStep("Loading Creature Template Addons...", [] { sObjectMgr->LoadCreatureTemplateAddons(); })
+        .Reads({ LoadStore::CreatureTemplates, LoadStore::SpellInfos })
+        .Writes({ LoadStore::CreatureTemplateAddons });
+
+    loadGraph.AddStep("Loading Reputation Reward Rates...", [] { sObjectMgr->LoadReputationRewardRate(); })
+        .Writes({ LoadStore::Reputation });
+
+    loadGraph.AddStep("Loading Creature Reputation OnKill Data...", [] { sObjectMgr->LoadReputationOnKill(); })
+        .Reads({ LoadStore::CreatureTemplates })
+        .Writes({ LoadStore::Reputation });
+
+    loadGraph.AddStep("Loading Reputation Spillover Data...", [] { sObjectMgr->LoadReputationSpilloverTemplate(); })
+        .Writes({ LoadStore::Reputation });
+
+    loadGraph.AddStep("Loading Points Of Interest Data...", [] { sObjectMgr->LoadPointsOfInterest(); })
+        .Writes({ LoadStore::PointsOfInterest });
 
-    LOG_INFO("server.loading", "Loading Quests...");
-    sObjectMgr->LoadQuests();                                    // must be loaded after DBCs, creature_template, item_template, gameobject tables
+    loadGraph.AddStep("Loading Creature Base Stats...", [] { sObjectMgr->LoadCreatureClassLevelStats(); })
+        .Reads({ LoadStore::CreatureTemplates })
+        .Writes({ LoadStore::CreatureBaseStats });
 
-    LOG_INFO("server.loading", "Checking Quest Disables");
-    sDisableMgr->CheckQuestDisables();                           // must be after loading quests
+    loadGraph.AddStep("Loading Creature Data...", [] { sObjectMgr->LoadCreatures(); })
+        .Reads({ LoadStore::CreatureTemplates, LoadStore::EquipmentTemplates, LoadStore::ScriptNames })
+        .Writes({ LoadStore::Creatures, LoadStore::TransportMaps, LoadStore::Maps });
 
-    LOG_INFO("server.loading", "Loading Quest POI");
-    sObjectMgr->LoadQuestPOI();
+    loadGraph.AddStep("Loading Creature sparring...", [] { sObjectMgr->LoadCreatureSparring(); })
+        .Reads({ LoadStore::Creatures })
+        .Writes({ LoadStore::CreatureSparring });
 
-    LOG_INFO("server.loading", "Loading Quests Starters and Enders...");
-    sObjectMgr->LoadQuestStartersAndEnders();                    // must be after quest load
+    // must be after LoadCreatureTemplates() and LoadGameObjectTemplates()
+    loadGraph.AddStep("Loading Temporary Summon Data...", [] { sObjectMgr->LoadTempSummons(); })
+        .Reads({ LoadStore::CreatureTemplates, LoadStore::GameObjectTemplates })
+        .Writes({ LoadStore::TempSummons });
+
+    loadGraph.AddStep("Loading Pet Levelup Spells...", [] { sSpellMgr->LoadPetLevelupSpellMap(); })
+        .Reads({ LoadStore::SpellInfos })
+        .Writes({ LoadStore::SpellData });
+
+    loadGraph.AddStep("Loading Pet default Spells additional to Levelup Spells...", [] { sSpellMgr->LoadPetDefaultSpells(); })
+        .Reads({ LoadStore::CreatureTemplates, LoadStore::SpellInfos })
+        .Writes({ LoadStore::SpellData });
+
+    // must be after LoadCreatureTemplates() and LoadCreatures()
+    loadGraph.AddStep("Loading Creature Addon Data...", [] { sObjectMgr->LoadCreatureAddons(); })
+        .Reads({ LoadStore::SpellInfos })
+        .Writes({ LoadStore::CreatureAddons, LoadStore::Creatures });
+
+    // must be after LoadCreatures()
+    loadGraph.AddStep("Loading Creature Movement Overrides...", [] { sObjectMgr->LoadCreatureMovementOverrides(); })
+        .Reads({ LoadStore::Creatures })
+        .Writes({ LoadStore::CreatureMovementOverrides });
 
-    LOG_INFO("server.loading", "Loading Quest Greetings...");
-    sObjectMgr->LoadQuestGreetings();                               // must be loaded after creature_template, gameobject_template tables
-    LOG_INFO("server.loading", "Loading Quest Greeting Locales...");
-    sObjectMgr->LoadQuestGreetingsLocales();                        // must be loaded after creature_template, gameobject_template tables, quest_greeting
+    loadGraph.AddStep("Loading Gameobject Data...", [] { sObjectMgr->LoadGameobjects(); })
+        .Reads({ LoadStore::GameObjectTemplates, LoadStore::ScriptNames })
+        .Writes({ LoadStore::GameObjects, LoadStore::TransportMaps, LoadStore::Maps });
 
-    LOG_INFO("server.loading", "Loading Quest Money Rewards...");
-    sObjectMgr->LoadQuestMoneyRewards();
+    // must be after LoadGameObjectTemplate() and LoadGameobjects()
+    loadGraph.AddStep("Loading GameObject Addon Data...", [] { sObjectMgr->LoadGameObjectAddons(); })
+        .Reads({ LoadStore::GameObjects })
+        .Writes({ LoadStore::GameObjectAddons });
 
-    LOG_INFO("server.loading", "Loading Objects Pooling Data...");
-    sPoolMgr->LoadFromDB();
+    loadGraph.AddStep("Loading GameObject Quest Items...", [] { sObjectMgr->LoadGameObjectQuestItems(); })
+        .Reads({ LoadStore::GameObjectTemplates })
+        .Writes({ LoadStore::QuestItems });
 
-    LOG_INFO("server.loading", "Loading Game Event Data...");               // must be after loading pools fully
-    sGameEventMgr->LoadHolidayDates();                           // Must be after loading DBC
-    sGameEventMgr->LoadFromDB();                                 // Must be after loading holiday dates
+    loadGraph.AddStep("Loading Creature Quest Items...", [] { sObjectMgr->LoadCreatureQuestItems(); })
+        .Reads({ LoadStore::CreatureTemplates })
+        .Writes({ LoadStore::QuestItems });
+
+    // must be after LoadCreatures(), LoadGameObjects()
+    loadGraph.AddStep("Loading Creature Linked Respawn...", [] { sObjectMgr->LoadLinkedRespawn(); })
+        .Reads({ LoadStore::Creatures, LoadStore::GameObjects })
+        .Writes({ LoadStore::LinkedRespawn });
+
+    loadGraph.AddStep("Loading Weather Data...", [] { WeatherMgr::LoadWeatherData(); })
+        .Reads({ LoadStore::ScriptNames })
+        .Writes({ LoadStore::Weather });
+
+    // must be loaded after DBCs, creature_template, item_template, gameobject tables
+    loadGraph.AddStep("Loading Quests...", [] { sObjectMgr->LoadQuests(); })
+        .Reads({ LoadStore::CreatureTemplates, LoadStore::GameObjectTemplates, LoadStore::ItemTemplates, LoadStore::SpellInfos, LoadStore::Disables })
+        .Writes({ LoadStore::Quests });
+
+    // must be after loading quests
+    loadGraph.AddStep("Checking Quest Disables", [] { sDisableMgr->CheckQuestDisables(); })
+        .Reads({ LoadStore::Quests })
+        .Writes({ LoadStore::Disables });
 
-    LOG_INFO("server.loading", "Loading UNIT_NPC_FLAG_SPELLCLICK Data..."); // must be after LoadQuests
-    sObjectMgr->LoadNPCSpellClickSpells();
+    loadGraph.AddStep("Loading Quest POI", [] { sObjectMgr->LoadQuestPOI(); })
+        .Writes({ LoadStore::QuestPOI });
+
+    // must be after quest load
+    loadGraph.AddStep("Loading Quests Starters and Enders...", [] { sObjectMgr->LoadQuestStartersAndEnders(); })
+        .Reads({ LoadStore::Quests, LoadStore::CreatureTemplates, LoadStore::GameObjectTemplates })
+        .Writes({ LoadStore::QuestRelations, LoadStore::Pools });
+
+    // must be loaded after creature_template, gameobject_template tables
+    loadGraph.AddStep("Loading Quest Greetings...", [] { sObjectMgr->LoadQuestGreetings(); })
+        .Reads({ LoadStore::CreatureTemplates, LoadStore::GameObjectTemplates })
+        .Writes({ LoadStore::QuestGreetings });
+
+    // must be loaded after creature_template, gameobject_template tables, quest_greeting
+    loadGraph.AddStep("Loading Quest Greeting Locales...", [] { sObjectMgr->LoadQuestGreetingsLocales(); })
+        .Reads({ LoadStore::CreatureTemplates, LoadStore::GameObjectTemplates })
+        .Writes({ LoadStore::QuestGreetings });
+
+    loadGraph.AddStep("Loading Quest Money Rewards...", [] { sObjectMgr->LoadQuestMoneyRewards(); })
+        .Writes({ LoadStore::QuestMoneyRewards });
+
+    // spawns pooled objects, keep it alone
+    loadGraph.AddStep("Loading Objects Pooling Data...", [] { sPoolMgr->LoadFromDB(); });
+
+    // must be after loading pools fully, changes quests, vendors and spawns
+    loadGraph.AddStep("Loading Game Event Data...", []
+    {
+        sGameEventMgr->LoadHolidayDates();                           // Must be after loading DBC
+        sGameEventMgr->LoadFromDB();                                 // Must be after loading holiday dates
+    });
+
+    // must be after LoadQuests
+    // sets UNIT_NPC_FLAG_SPELLCLICK on the creature templates
+    loadGraph.AddStep("Loading UNIT_NPC_FLAG_SPELLCLICK Data...", [] { sObjectMgr->LoadNPCSpellClickSpells(); })
+        .Reads({ LoadStore::SpellInfos })
+        .Writes({ LoadStore::CreatureTemplates, LoadStore::SpellClick });
 
-    LOG_INFO("server.loading", "Loading Vehicle Template Accessories...");
-    sObjectMgr->LoadVehicleTemplateAccessories();                // must be after LoadCreatureTemplates() and LoadNPCSpellClickSpells()
+    // must be after LoadCreatureTemplates() and LoadNPCSpellClickSpells()
+    loadGraph.AddStep("Loading Vehicle Template Accessories...", [] { sObjectMgr->LoadVehicleTemplateAccessories(); })
+        .Reads({ LoadStore::CreatureTemplates, LoadStore::SpellClick })
+        .Writes({ LoadStore::VehicleAccessories });
 
-    LOG_INFO("server.loading", "Loading Vehicle Accessories...");
-    sObjectMgr->LoadVehicleAccessories();                       // must be after LoadCreatureTemplates() and LoadNPCSpellClickSpells()
+    // must be after LoadCreatureTemplates() and LoadNPCSpellClickSpells()
+    loadGraph.AddStep("Loading Vehicle Accessories...", [] { sObjectMgr->LoadVehicleAccessories(); })
+        .Reads({ LoadStore::CreatureTemplates, LoadStore::SpellClick })
+        .Writes({ LoadStore::VehicleAccessories });
 
-    LOG_INFO("server.loading", "Loading Vehicle Seat Addon Data...");
-    sObjectMgr->LoadVehicleSeatAddon();                         // must be after loading DBC
+    // must be after loading DBC
+    loadGraph.AddStep("Loading Vehicle Seat Addon Data...", [] { sObjectMgr->LoadVehicleSeatAddon(); })
+        .Writes({ LoadStore::VehicleSeatAddons });
 
-    LOG_INFO("server.loading", "Loading SpellArea Data...");                // must be after quest load
-    sSpellMgr->LoadSpellAreas();
+    // must be after quest load
+    loadGraph.AddStep("Loading SpellArea Data...", [] { sSpellMgr->LoadSpellAreas(); })
+        .Reads({ LoadStore::Quests })
+        .Writes({ LoadStore::SpellData, LoadStore::SpellInfos });
 
-    LOG_INFO("server.loading", "Loading Area Trigger Definitions");
-    sObjectMgr->LoadAreaTriggers();
+    loadGraph.AddStep("Loading Area Trigger Definitions", [] { sObjectMgr->LoadAreaTriggers(); })
+        .Writes({ LoadStore::AreaTriggers });
 
-    LOG_INFO("server.loading", "Loading Area Trigger Teleport Definitions...");
-    sObjectMgr->LoadAreaTriggerTeleports();
+    loadGraph.AddStep("Loading Area Trigger Teleport Definitions...", [] { sObjectMgr->LoadAreaTriggerTeleports(); })
+        .Reads({ LoadStore::AreaTriggers })
+        .Writes({ LoadStore::AreaTriggerData });
 
-    LOG_INFO("server.loading", "Loading Access Requirements...");
-    sObjectMgr->LoadAccessRequirements();                        // must be after item template load
+    // must be after item template load
+    loadGraph.AddStep("Loading Access Requirements...", [] { sObjectMgr->LoadAccessRequirements(); })
+        .Reads({ LoadStore::ItemTemplates, LoadStore::Quests })
+        .Writes({ LoadStore::AccessRequirements });
 
-    LOG_INFO("server.loading", "Loading Quest Area Triggers...");
-    sObjectMgr->LoadQuestAreaTriggers();                         // must be after LoadQuests
+    // must be after LoadQuests
+    loadGraph.AddStep("Loading Quest Area Triggers...", [] { sObjectMgr->LoadQuestAreaTriggers(); })
+        .Reads({ LoadStore::AreaTriggers })
+        .Writes({ LoadStore::AreaTriggerData, LoadStore::Quests });
 
-    LOG_INFO("server.loading", "Loading Tavern Area Triggers...");
-    sObjectMgr->LoadTavernAreaTriggers();
+    loadGraph.AddStep("Loading Tavern Area Triggers...", [] { sObjectMgr->LoadTavernAreaTriggers(); })
+        .Reads({ LoadStore::AreaTriggers })
+        .Writes({ LoadStore::AreaTriggerData });
 
-    LOG_INFO("server.loading", "Loading AreaTrigger Script Names...");
-    sObjectMgr->LoadAreaTriggerScripts();
+    loadGraph.AddStep("Loading AreaTrigger Script Names...", [] { sObjectMgr->LoadAreaTriggerScripts(); })
+        .Reads({ LoadStore::AreaTriggers, LoadStore::ScriptNames })
+        .Writes({ LoadStore::AreaTriggerData });
 
-    LOG_INFO("server.loading", "Loading LFG Entrance Positions..."); // Must be after areatriggers
-    sLFGMgr->LoadLFGDungeons();
+    // Must be after areatriggers
+    loadGraph.AddStep("Loading LFG Entrance Positions...", [] { sLFGMgr->LoadLFGDungeons(); })
+        .Reads({ LoadStore::AreaTriggerData })
+        .Writes({ LoadStore::Lfg });
 
-    LOG_INFO("server.loading", "Loading Dungeon Boss Data...");
-    sObjectMgr->LoadInstanceEncounters();
+    loadGraph.AddStep("Loading Dungeon Boss Data...", [] { sObjectMgr->LoadInstanceEncounters(); })
+        .Reads({ LoadStore::Lfg })
+        .Writes({ LoadStore::InstanceEncounters, LoadStore::CreatureTemplates, LoadStore::SpellInfos });
 
-    LOG_INFO("server.loading", "Loading LFG Rewards...");
-    sLFGMgr->LoadRewards();
+    loadGraph.AddStep("Loading LFG Rewards...", [] { sLFGMgr->LoadRewards(); })
+        .Reads({ LoadStore::Quests })
+        .Writes({ LoadStore::Lfg });
 
-    LOG_INFO("server.loading", "Loading Graveyard-Zone Links...");
-    sGraveyard->LoadGraveyardZones();
+    loadGraph.AddStep("Loading Graveyard-Zone Links...", [] { sGraveyard->LoadGraveyardZones(); })
+        .Writes({ LoadStore::Graveyards });
 
-    LOG_INFO("server.loading", "Loading Spell Pet Auras...");
-    sSpellMgr->LoadSpellPetAuras();
+    loadGraph.AddStep("Loading Spell Pet Auras...", [] { sSpellMgr->LoadSpellPetAuras(); })
+        .Reads({ LoadStore::SpellInfos })
+        .Writes({ LoadStore::SpellData });
 
-    LOG_INFO("server.loading", "Loading Spell Target Coordinates...");
-    sSpellMgr->LoadSpellTargetPositions();
+    loadGraph.AddStep("Loading Spell Target Coordinates...", [] { sSpellMgr->LoadSpellTargetPositions(); })
+        .Reads({ LoadStore::SpellInfos })
+        .Writes({ LoadStore::SpellData });
 
-    LOG_INFO("server.loading", "Loading Enchant Custom Attributes...");
-    sSpellMgr->LoadEnchantCustomAttr();
+    loadGraph.AddStep("Loading Enchant Custom Attributes...", [] { sSpellMgr->LoadEnchantCustomAttr(); })
+        .Reads({ LoadStore::SpellInfos })
+        .Writes({ LoadStore::SpellData });
 
-    LOG_INFO("server.loading", "Loading linked Spells...");
-    sSpellMgr->LoadSpellLinked();
+    loadGraph.AddStep("Loading linked Spells...", [] { sSpellMgr->LoadSpellLinked(); })
+        .Reads({ LoadStore::SpellInfos })
+        .Writes({ LoadStore::SpellData });
 
-    LOG_INFO("server.loading", "Loading Player Create Data...");
-    sObjectMgr->LoadPlayerInfo();
+    loadGraph.AddStep("Loading Player Create Data...", [] { sObjectMgr->LoadPlayerInfo(); })
+        .Reads({ LoadStore::ItemTemplates, LoadStore::SpellInfos })
+        .Writes({ LoadStore::PlayerInfo, LoadStore::CharStartOutfits });
 
-    LOG_INFO("server.loading", "Loading Exploration BaseXP Data...");
-    sObjectMgr->LoadExplorationBaseXP();
+    loadGraph.AddStep("Loading Exploration BaseXP Data...", [] { sObjectMgr->LoadExplorationBaseXP(); })
+        .Writes({ LoadStore::ExplorationBaseXP });
 
-    LOG_INFO("server.loading", "Loading Pet Name Parts...");
-    sObjectMgr->LoadPetNames();
+    loadGraph.AddStep("Loading Pet Name Parts...", [] { sObjectMgr->LoadPetNames(); })
+        .Writes({ LoadStore::PetNames });
 
-    CharacterDatabaseCleaner::CleanDatabase();
+    loadGraph.AddStep("Character database cleanup", [] { CharacterDatabaseCleaner::CleanDatabase(); })
+        .Quiet();
 
-    LOG_INFO("server.loading", "Loading The Max Pet Number...");
-    sObjectMgr->LoadPetNumber();
+    loadGraph.AddStep("Loading The Max Pet Number...", [] { sObjectMgr->LoadPetNumber(); })
+        .Writes({ LoadStore::PetNumber });
 
-    LOG_INFO("server.loading", "Loading Pet Level Stats...");
-    sObjectMgr->LoadPetLevelInfo();
+    loadGraph.AddStep("Loading Pet Level Stats...", [] { sObjectMgr->LoadPetLevelInfo(); })
+        .Reads({ LoadStore::CreatureTemplates })
+        .Writes({ LoadStore::PetLevelInfo });
 
-    LOG_INFO("server.loading", "Loading Player Level Dependent Mail Rewards...");
-    sObjectMgr->LoadMailLevelRewards();
+    loadGraph.AddStep("Loading Player Level Dependent Mail Rewards...", [] { sObjectMgr->LoadMailLevelRewards(); })
+        .Reads({ LoadStore::CreatureTemplates })
+        .Writes({ LoadStore::MailLevelRewards });
 
-    LOG_INFO("server.loading", "Load Mail Server definitions...");
-    sServerMailMgr->LoadMailServerTemplates();
+    loadGraph.AddStep("Load Mail Server definitions...", [] { sServerMailMgr->LoadMailServerTemplates(); })
+        .Reads({ LoadStore::ItemTemplates, LoadStore::Quests })
+        .Writes({ LoadStore::ServerMails });
 
     // Loot tables
-    LoadLootTables();
-
-    LOG_INFO("server.loading", "Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
-
-    LOG_INFO("server.loading", "Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
-
-    LOG_INFO("server.loading", "Loading Skill Perfection Data Table...");
-    LoadSkillPerfectItemTable();
-
-    LOG_INFO("server.loading", "Loading Skill Fishing Base Level Requirements...");
-    sObjectMgr->LoadFishingBaseSkillLevel();
-
-    LOG_INFO("server.loading", "Loading Achievements...");
-    sAchievementMgr->LoadAchievementReferenceList();
-    LOG_INFO("server.loading", "Loading Achievement Criteria Lists...");
-    sAchievementMgr->LoadAchievementCriteriaList();
-    LOG_INFO("server.loading", "Loading Achievement Criteria Data...");
-    sAchievementMgr->LoadAchievementCriteriaData();
-    LOG_INFO("server.loading", "Loading Achievement Rewards...");
-    sAchievementMgr->LoadRewards();
-    LOG_INFO("server.loading", "Loading Achievement Reward Locales...");
-    sAchievementMgr->LoadRewardLocales();
-    LOG_INFO("server.loading", "Loading Completed Achievements...");
-    sAchievementMgr->LoadCompletedAchievements();
+    loadGraph.AddStep("Creature loot templates", [] { LoadLootTemplates_Creature(); })
+        .Reads({ LoadStore::CreatureTemplates, LoadStore::ItemTemplates })
+        .Writes({ LoadStore::LootCreature })
+        .Quiet();
+
+    loadGraph.AddStep("Fishing loot templates", [] { LoadLootTemplates_Fishing(); })
+        .Reads({ LoadStore::ItemTemplates })
+        .Writes({ LoadStore::LootFishing })
+        .Quiet();
+
+    loadGraph.AddStep("Gameobject loot templates", [] { LoadLootTemplates_Gameobject(); })
+        .Reads({ LoadStore::GameObjectTemplates, LoadStore::ItemTemplates })
+        .Writes({ LoadStore::LootGameobject })
+        .Quiet();
+
+    loadGraph.AddStep("Item loot templates", [] { LoadLootTemplates_Item(); })
+        .Reads({ LoadStore::ItemTemplates })
+        .Writes({ LoadStore::LootItem })
+        .Quiet();
+
+    loadGraph.AddStep("Mail loot templates", [] { LoadLootTemplates_Mail(); })
+        .Reads({ LoadStore::ItemTemplates })
+        .Writes({ LoadStore::LootMail })
+        .Quiet();
+
+    loadGraph.AddStep("Milling loot templates", [] { LoadLootTemplates_Milling(); })
+        .Reads({ LoadStore::ItemTemplates })
+        .Writes({ LoadStore::LootMilling })
+        .Quiet();
+
+    loadGraph.AddStep("Pickpocketing loot templates", [] { LoadLootTemplates_Pickpocketing(); })
+        .Reads({ LoadStore::CreatureTemplates, LoadStore::ItemTemplates })
+        .Writes({ LoadStore::LootPickpocketing })
+        .Quiet();
+
+    loadGraph.AddStep("Skinning loot templates", [] { LoadLootTemplates_Skinning(); })
+        .Reads({ LoadStore::CreatureTemplates, LoadStore::ItemTemplates })
+        .Writes({ LoadStore::LootSkinning })
+        .Quiet();
+
+    loadGraph.AddStep("Disenchanting loot templates", [] { LoadLootTemplates_Disenchant(); })
+        .Reads({ LoadStore::ItemTemplates })
+        .Writes({ LoadStore::LootDisenchant })
+        .Quiet();
+
+    loadGraph.AddStep("Prospecting loot templates", [] { LoadLootTemplates_Prospecting(); })
+        .Reads({ LoadStore::ItemTemplates })
+        .Writes({ LoadStore::LootProspecting })
+        .Quiet();
+
+    loadGraph.AddStep("Spell loot templates", [] { LoadLootTemplates_Spell(); })
+        .Reads({ LoadStore::ItemTemplates, LoadStore::SpellInfos })
+        .Writes({ LoadStore::LootSpell })
+        .Quiet();
+
+    loadGraph.AddStep("Reference loot templates", [] { LoadLootTemplates_Reference(); })
+        .Reads({ LoadStore::ItemTemplates, LoadStore::LootCreature, LoadStore::LootFishing, LoadStore::LootGameobject, LoadStore::LootItem,
+            LoadStore::LootMail, LoadStore::LootMilling, LoadStore::LootPickpocketing, LoadStore::LootSkinning, LoadStore::LootDisenchant,
+            LoadStore::LootProspecting, LoadStore::LootSpell })
+        .Writes({ LoadStore::LootReference })
+        .Quiet();
+
+    loadGraph.AddStep("Player loot templates", [] { LoadLootTemplates_Player(); })
+        .Reads({ LoadStore::ItemTemplates })
+        .Writes({ LoadStore::LootPlayer })
+        .Quiet();
+
+    loadGraph.AddStep("Loading Skill Discovery Table...", [] { LoadSkillDiscoveryTable(); })
+        .Reads({ LoadStore::SpellInfos })
+        .Writes({ LoadStore::SkillDiscovery });
+
+    loadGraph.AddStep("Loading Skill Extra Item Table...", [] { LoadSkillExtraItemTable(); })
+        .Reads({ LoadStore::SpellInfos })
+        .Writes({ LoadStore::SkillExtraItems });
+
+    loadGraph.AddStep("Loading Skill Perfection Data Table...", [] { LoadSkillPerfectItemTable(); })
+        .Reads({ LoadStore::ItemTemplates, LoadStore::SpellInfos })
+        .Writes({ LoadStore::SkillExtraItems });
+
+    loadGraph.AddStep("Loading Skill Fishing Base Level Requirements...", [] { sObjectMgr->LoadFishingBaseSkillLevel(); })
+        .Writes({ LoadStore::FishingBaseSkill });
+
+    loadGraph.AddStep("Loading Achievements...", [] { sAchievementMgr->LoadAchievementReferenceList(); })
+        .Writes({ LoadStore::Achievements });
+
+    loadGraph.AddStep("Loading Achievement Criteria Lists...", [] { sAchievementMgr->LoadAchievementCriteriaList(); })
+        .Writes({ LoadStore::Achievements });
+
+    loadGraph.AddStep("Loading Achievement Criteria Data...", [] { sAchievementMgr->LoadAchievementCriteriaData(); })
+        .Reads({ LoadStore::Disables, LoadStore::ScriptNames })
+        .Writes({ LoadStore::Achievements });
+
+    loadGraph.AddStep("Loading Achievement Rewards...", [] { sAchievementMgr->LoadRewards(); })
+        .Reads({ LoadStore::CreatureTemplates, LoadStore::ItemTemplates })
+        .Writes({ LoadStore::Achievements });
+
+    loadGraph.AddStep("Loading Achievement Reward Locales...", [] { sAchievementMgr->LoadRewardLocales(); })
+        .Writes({ LoadStore::Achievements });
+
+    loadGraph.AddStep("Loading Completed Achievements...", [] { sAchievementMgr->LoadCompletedAchievements(); })
+        .Writes({ LoadStore::Achievements });
 
     ///- Load dynamic data tables from the database
-    LOG_INFO("server.loading", "Loading Item Auctions...");
-    sAuctionMgr->LoadAuctionItems();
-    LOG_INFO("server.loading", "Loading Auctions...");
-    sAuctionMgr->LoadAuctions();
+    loadGraph.AddStep("Loading Item Auctions...", [] { sAuctionMgr->LoadAuctionItems(); })
+        .Reads({ LoadStore::ItemTemplates, LoadStore::CharacterCache })
+        .Writes({ LoadStore::CharacterObjects });
+
+    loadGraph.AddStep("Loading Auctions...", [] { sAuctionMgr->LoadAuctions(); })
+        .Reads({ LoadStore::CharacterCache })
+        .Writes({ LoadStore::CharacterObjects });
 
-    sGuildMgr->LoadGuilds();
+    loadGraph.AddStep("Guilds", [] { sGuildMgr->LoadGuilds(); })
+        .Reads({ LoadStore::ItemTemplates })
+        .Writes({ LoadStore::CharacterObjects, LoadStore::CharacterCache })
+        .Quiet();
 
-    LOG_INFO("server.loading", "Loading ArenaTeams...");
-    sArenaTeamMgr->LoadArenaTeams();
+    loadGraph.AddStep("Loading ArenaTeams...", [] { sArenaTeamMgr->LoadArenaTeams(); })
+        .Writes({ LoadStore::CharacterObjects, LoadStore::CharacterCache });
 
-    LOG_INFO("server.loading", "Loading Groups...");
-    sGroupMgr->LoadGroups();
+    loadGraph.AddStep("Loading Groups...", [] { sGroupMgr->LoadGroups(); })
+        .Reads({ LoadStore::ItemTemplates })
+        .Writes({ LoadStore::CharacterObjects, LoadStore::CharacterCache, LoadStore::Instances, LoadStore::Lfg });
 
-    LOG_INFO("server.loading", "Loading Reserved Names...");
-    sObjectMgr->LoadReservedPlayerNamesDB();
-    sObjectMgr->LoadReservedPlayerNamesDBC(); // Needs to be after LoadReservedPlayerNamesDB()
+    // DBC names need to be after LoadReservedPlayerNamesDB()
+    loadGraph.AddStep("Loading Reserved Names...", []
+    {
+        sObjectMgr->LoadReservedPlayerNamesDB();
+        sObjectMgr->LoadReservedPlayerNamesDBC();
+    }).Writes({ LoadStore::ReservedNames });
 
-    LOG_INFO("server.loading", "Loading Profanity Names...");
-    sObjectMgr->LoadProfanityNamesFromDB();
-    sObjectMgr->LoadProfanityNamesFromDBC(); // Needs to be after LoadProfanityNamesFromDB()
+    // DBC names need to be after LoadProfanityNamesFromDB()
+    loadGraph.AddStep("Loading Profanity Names...", []
+    {
+        sObjectMgr->LoadProfanityNamesFromDB();
+        sObjectMgr->LoadProfanityNamesFromDBC();
+    }).Writes({ LoadStore::ProfanityNames });
 
-    LOG_INFO("server.loading", "Loading GameObjects for Quests...");
-    sObjectMgr->LoadGameObjectForQuests();
+    loadGraph.AddStep("Loading GameObjects for Quests...", [] { sObjectMgr->LoadGameObjectForQuests(); })
+        .Reads({ LoadStore::LootGameobject })
+        .Writes({ LoadStore::GameObjectTemplates });
 
-    LOG_INFO("server.loading", "Loading BattleMasters...");
-    sBattlegroundMgr->LoadBattleMastersEntry();
+    loadGraph.AddStep("Loading BattleMasters...", [] { sBattlegroundMgr->LoadBattleMastersEntry(); })
+        .Writes({ LoadStore::BattleMasters, LoadStore::CreatureTemplates });
 
-    LOG_INFO("server.loading", "Loading GameTeleports...");
-    sObjectMgr->LoadGameTele();
+    loadGraph.AddStep("Loading GameTeleports...", [] { sObjectMgr->LoadGameTele(); })
+        .Writes({ LoadStore::GameTele });
 
-    LOG_INFO("server.loading", "Loading Gossip Menu...");
-    sObjectMgr->LoadGossipMenu();
+    loadGraph.AddStep("Loading Gossip Menu...", [] { sObjectMgr->LoadGossipMenu(); })
+        .Reads({ LoadStore::GossipTexts })
+        .Writes({ LoadStore::GossipMenus });
 
-    LOG_INFO("server.loading", "Loading Gossip Menu Options...");
-    sObjectMgr->LoadGossipMenuItems();
+    loadGraph.AddStep("Loading Gossip Menu Options...", [] { sObjectMgr->LoadGossipMenuItems(); })
+        .Reads({ LoadStore::BroadcastTexts, LoadStore::PointsOfInterest })
+        .Writes({ LoadStore::GossipMenus });
 
-    LOG_INFO("server.loading", "Loading Vendors...");
-    sObjectMgr->LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
+    // must be after load CreatureTemplate and ItemTemplate
+    loadGraph.AddStep("Loading Vendors...", [] { sObjectMgr->LoadVendors(); })
+        .Reads({ LoadStore::CreatureTemplates, LoadStore::ItemTemplates })
+        .Writes({ LoadStore::Vendors });
 
-    LOG_INFO("server.loading", "Loading Trainers...");
-    sObjectMgr->LoadTrainerSpell();                              // must be after load CreatureTemplate
+    // must be after load CreatureTemplate
+    loadGraph.AddStep("Loading Trainers...", [] { sObjectMgr->LoadTrainerSpell(); })
+        .Reads({ LoadStore::CreatureTemplates, LoadStore::SpellInfos })
+        .Writes({ LoadStore::Trainers });
 
-    LOG_INFO("server.loading", "Loading Waypoints...");
-    sWaypointMgr->Load();
+    loadGraph.AddStep("Loading Waypoints...", [] { sWaypointMgr->Load(); })
+        .Writes({ LoadStore::Waypoints });
 
-    LOG_INFO("server.loading", "Loading SmartAI Waypoints...");
-    sSmartWaypointMgr->LoadFromDB();
+    loadGraph.AddStep("Loading SmartAI Waypoints...", [] { sSmartWaypointMgr->LoadFromDB(); })
+        .Writes({ LoadStore::SmartWaypoints });
 
-    LOG_INFO("server.loading", "Loading Creature Formations...");
-    sFormationMgr->LoadCreatureFormations();
+    loadGraph.AddStep("Loading Creature Formations...", [] { sFormationMgr->LoadCreatureFormations(); })
+        .Reads({ LoadStore::Creatures })
+        .Writes({ LoadStore::CreatureFormations });
 
-    LOG_INFO("server.loading", "Loading WorldStates...");              // must be loaded before battleground, outdoor PvP and conditions
-    sWorldState->LoadWorldStates();
+    // must be loaded before battleground, outdoor PvP and conditions
+    loadGraph.AddStep("Loading WorldStates...", [] { sWorldState->LoadWorldStates(); })
+        .Writes({ LoadStore::WorldStates });
 
-    LOG_INFO("server.loading", "Loading Conditions...");
-    sConditionMgr->LoadConditions();
+    // attaches conditions to loot, gossip, spells, vehicles and more, keep it alone
+    loadGraph.AddStep("Loading Conditions...", [] { sConditionMgr->LoadConditions(); });
 
-    LOG_INFO("server.loading", "Loading Faction Change Achievement Pairs...");
-    sObjectMgr->LoadFactionChangeAchievements();
+    loadGraph.AddStep("Loading Faction Change Achievement Pairs...", [] { sObjectMgr->LoadFactionChangeAchievements(); })
+        .Writes({ LoadStore::FactionChange });
 
-    LOG_INFO("server.loading", "Loading Faction Change Spell Pairs...");
-    sObjectMgr->LoadFactionChangeSpells();
+    loadGraph.AddStep("Loading Faction Change Spell Pairs...", [] { sObjectMgr->LoadFactionChangeSpells(); })
+        .Reads({ LoadStore::SpellInfos })
+        .Writes({ LoadStore::FactionChange });
 
-    LOG_INFO("server.loading", "Loading Faction Change Item Pairs...");
-    sObjectMgr->LoadFactionChangeItems();
+    loadGraph.AddStep("Loading Faction Change Item Pairs...", [] { sObjectMgr->LoadFactionChangeItems(); })
+        .Reads({ LoadStore::ItemTemplates })
+        .Writes({ LoadStore::FactionChange });
 
-    LOG_INFO("server.loading", "Loading Faction Change Reputation Pairs...");
-    sObjectMgr->LoadFactionChangeReputations();
+    loadGraph.AddStep("Loading Faction Change Reputation Pairs...", [] { sObjectMgr->LoadFactionChangeReputations(); })
+        .Writes({ LoadStore::FactionChange });
 
-    LOG_INFO("server.loading", "Loading Faction Change Title Pairs...");
-    sObjectMgr->LoadFactionChangeTitles();
+    loadGraph.AddStep("Loading Faction Change Title Pairs...", [] { sObjectMgr->LoadFactionChangeTitles(); })
+        .Writes({ LoadStore::FactionChange });
 
-    LOG_INFO("server.loading", "Loading Faction Change Quest Pairs...");
-    sObjectMgr->LoadFactionChangeQuests();
+    loadGraph.AddStep("Loading Faction Change Quest Pairs...", [] { sObjectMgr->LoadFactionChangeQuests(); })
+        .Reads({ LoadStore::Quests })
+        .Writes({ LoadStore::FactionChange });
 
-    LOG_INFO("server.loading", "Loading GM Tickets...");
-    sTicketMgr->LoadTickets();
+    loadGraph.AddStep("Loading GM Tickets...", [] { sTicketMgr->LoadTickets(); })
+        .Writes({ LoadStore::Tickets });
 
-    LOG_INFO("server.loading", "Loading GM Surveys...");
-    sTicketMgr->LoadSurveys();
+    loadGraph.AddStep("Loading GM Surveys...", [] { sTicketMgr->LoadSurveys(); })
+        .Writes({ LoadStore::Tickets });
 
-    LOG_INFO("server.loading", "Loading Client Addons...");
-    AddonMgr::LoadFromDB();
+    loadGraph.AddStep("Loading Client Addons...", [] { AddonMgr::LoadFromDB(); })
+        .Writes({ LoadStore::Addons });
 
     // pussywizard:
-    LOG_INFO("server.loading", "Deleting Invalid Mail Items...");
-    LOG_INFO("server.loading", " ");
-    CharacterDatabase.Execute("DELETE mi FROM mail_items mi LEFT JOIN item_instance ii ON mi.item_guid = ii.guid WHERE ii.guid IS NULL");
-    CharacterDatabase.Execute("DELETE mi FROM mail_items mi LEFT JOIN mail m ON mi.mail_id = m.id WHERE m.id IS NULL");
-    CharacterDatabase.Execute("UPDATE mail m LEFT JOIN mail_items mi ON m.id = mi.mail_id SET m.has_items=0 WHERE m.has_items<>0 AND mi.mail_id IS NULL");
+    loadGraph.AddStep("Deleting Invalid Mail Items...", []
+    {
+        CharacterDatabase.Execute("DELETE mi FROM mail_items mi LEFT JOIN item_instance ii ON mi.item_guid = ii.guid WHERE ii.guid IS NULL");
+        CharacterDatabase.Execute("DELETE mi FROM mail_items mi LEFT JOIN mail m ON mi.mail_id = m.id WHERE m.id IS NULL");
+        CharacterDatabase.Execute("UPDATE mail m LEFT JOIN mail_items mi ON m.id = mi.mail_id SET m.has_items=0 WHERE m.has_items<>0 AND mi.mail_id IS NULL");
+    });
 
     ///- Handle outdated emails (delete/return)
-    LOG_INFO("server.loading", "Returning Old Mails...");
-    LOG_INFO("server.loading", " ");
-    sObjectMgr->ReturnOrDeleteOldMails(false);
+    loadGraph.AddStep("Returning Old Mails...", [] { sObjectMgr->ReturnOrDeleteOldMails(false); });
 
     ///- Load AutoBroadCast
-    LOG_INFO("server.loading", "Loading Autobroadcasts...");
-    sAutobroadcastMgr->LoadAutobroadcasts();
-    sAutobroadcastMgr->LoadAutobroadcastsLocalized();
+    loadGraph.AddStep("Loading Autobroadcasts...", []
+    {
+        sAutobroadcastMgr->LoadAutobroadcasts();
+        sAutobroadcastMgr->LoadAutobroadcastsLocalized();
+    }).Writes({ LoadStore::Autobroadcasts });
 
     ///- Load Motd
-    LOG_INFO("server.loading", "Loading Motd...");
-    sMotdMgr->LoadMotd();
+    loadGraph.AddStep("Loading Motd...", [] { sMotdMgr->LoadMotd(); })
+        .Writes({ LoadStore::Motd });
+
+    ///- Load and initialize scripts, must be after load Creature/Gameobject(Template/Data)
+    loadGraph.AddStep("Spell, event and waypoint scripts", []
+    {
+        sObjectMgr->LoadSpellScripts();
+        sObjectMgr->LoadEventScripts();
+        sObjectMgr->LoadWaypointScripts();
+    }).Quiet();
 
-    ///- Load and initialize scripts
-    sObjectMgr->LoadSpellScripts();                              // must be after load Creature/Gameobject(Template/Data)
-    sObjectMgr->LoadEventScripts();                              // must be after load Creature/Gameobject(Template/Data)
-    sObjectMgr->LoadWaypointScripts();
+    loadGraph.AddStep("Loading Spell Script Names...", [] { sObjectMgr->LoadSpellScriptNames(); })
+        .Reads({ LoadStore::SpellInfos, LoadStore::ScriptNames })
+        .Writes({ LoadStore::SpellScriptNames });
 
-    LOG_INFO("server.loading", "Loading Spell Script Names...");
-    sObjectMgr->LoadSpellScriptNames();
+    loadGraph.AddStep("Loading Creature Texts...", [] { sCreatureTextMgr->LoadCreatureTexts(); })
+        .Reads({ LoadStore::BroadcastTexts })
+        .Writes({ LoadStore::CreatureTexts });
 
-    LOG_INFO("server.loading", "Loading Creature Texts...");
-    sCreatureTextMgr->LoadCreatureTexts();
+    loadGraph.AddStep("Loading Creature Text Locales...", [] { sCreatureTextMgr->LoadCreatureTextLocales(); })
+        .Writes({ LoadStore::CreatureTexts });
 
-    LOG_INFO("server.loading", "Loading Creature Text Locales...");
-    sCreatureTextMgr->LoadCreatureTextLocales();
+    loadGraph.AddStep("Loading Scripts...", [] { sScriptMgr->LoadDatabase(); });
 
-    LOG_INFO("server.loading", "Loading Scripts...");
-    sScriptMgr->LoadDatabase();
+    loadGraph.AddStep("Validating Spell Scripts...", [] { sObjectMgr->ValidateSpellScripts(); });
 
-    LOG_INFO("server.loading", "Validating Spell Scripts...");
-    sObjectMgr->ValidateSpellScripts();
+    loadGraph.AddStep("Loading SmartAI Scripts...", [] { sSmartScriptMgr->LoadSmartAIFromDB(); })
+        .Reads({ LoadStore::AreaTriggers, LoadStore::AreaTriggerData, LoadStore::CreatureTemplates, LoadStore::Creatures, LoadStore::CreatureTexts,
+            LoadStore::EquipmentTemplates, LoadStore::GameObjectTemplates, LoadStore::GameObjects, LoadStore::Quests, LoadStore::ScriptNames,
+            LoadStore::SmartWaypoints, LoadStore::SpellInfos })
+        .Writes({ LoadStore::SmartScripts });
 
-    LOG_INFO("server.loading", "Loading SmartAI Scripts...");
-    sSmartScriptMgr->LoadSmartAIFromDB();
+    loadGraph.AddStep("Loading Calendar Data...", [] { sCalendarMgr->LoadFromDB(); })
+        .Reads({ LoadStore::CharacterCache })
+        .Writes({ LoadStore::Calendar });
 
-    LOG_INFO("server.loading", "Loading Calendar Data...");
-    sCalendarMgr->LoadFromDB();
+    loadGraph.Run(getIntConfig(CONFIG_STARTUP_LOAD_THREADS));
+    loadGraph.LogTimings();
 
     LOG_INFO("server.loading", "Initializing SpellInfo Precomputed Data..."); // must be called after loading items, professions, spells and pretty much anything
     LOG_INFO("server.loading", " ");
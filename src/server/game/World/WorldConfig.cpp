@@ -145,6 +145,8 @@ void WorldConfig::BuildConfigCache()
     SetConfigValue<bool>(CONFIG_DURABILITY_LOSS_IN_PVP, "DurabilityLoss.InPvP", false);
 
     SetConfigValue<uint32>(CONFIG_COMPRESSION, "Compression", 1, ConfigValueCache::Reloadable::Yes, [](uint32 const& value) { return value > 0 && value < 10; }, "> 0 && < 10");
+    SetConfigValue<uint32>(CONFIG_COMPRESSION_THRESHOLD, "Compression.Threshold", 100);
+    SetConfigValue<uint32>(CONFIG_STARTUP_LOAD_THREADS, "Startup.LoadThreads", 0);
 
     SetConfigValue<bool>(CONFIG_ADDON_CHANNEL, "AddonChannel", true);
     SetConfigValue<bool>(CONFIG_CLEAN_CHARACTER_DB, "CleanCharacterDB", false);
@@ -524,6 +526,7 @@ void WorldConfig::BuildConfigCache()
 
     SetConfigValue<bool>(CONFIG_VMAP_BLIZZLIKE_PVP_LOS, "vmap.BlizzlikePvPLOS", true);
     SetConfigValue<bool>(CONFIG_VMAP_BLIZZLIKE_LOS_OPEN_WORLD, "vmap.BlizzlikeLOSInOpenWorld", true);
+    SetConfigValue<bool>(CONFIG_VMAP_LOS_CACHE, "vmap.LOSCache", true);
 
     SetConfigValue<bool>(CONFIG_START_CUSTOM_SPELLS, "PlayerStart.CustomSpells", false);
     SetConfigValue<uint32>(CONFIG_HONOR_AFTER_DUEL, "HonorPointsAfterDuel", 0);
@@ -541,6 +544,8 @@ void WorldConfig::BuildConfigCache()
     SetConfigValue<bool>(CONFIG_SHOW_MUTE_IN_WORLD, "ShowMuteInWorld", false);
     SetConfigValue<bool>(CONFIG_SHOW_BAN_IN_WORLD, "ShowBanInWorld", false);
     SetConfigValue<uint32>(CONFIG_NUMTHREADS, "MapUpdate.Threads", 1);
+    SetConfigValue<uint32>(CONFIG_MAP_UPDATE_REGION_THREADS, "MapUpdate.ParallelRegions.Threads", 0);
+    SetConfigValue<uint32>(CONFIG_MAP_UPDATE_REGION_MIN_OBJECTS, "MapUpdate.ParallelRegions.MinObjects", 2000);
     SetConfigValue<uint32>(CONFIG_MAX_RESULTS_LOOKUP_COMMANDS, "Command.LookupMaxResults", 0);
 
     // Warden
@@ -577,6 +582,8 @@ void WorldConfig::BuildConfigCache()
     SetConfigValue<bool>(CONFIG_PDUMP_NO_PATHS, "PlayerDump.DisallowPaths", true);
     SetConfigValue<bool>(CONFIG_PDUMP_NO_OVERWRITE, "PlayerDump.DisallowOverwrite", true);
     SetConfigValue<bool>(CONFIG_ENABLE_MMAPS, "MoveMaps.Enable", true);
+    SetConfigValue<uint32>(CONFIG_MMAP_ASYNC_PATHFINDING_THREADS, "MoveMaps.AsyncPathfinding.Threads", 0);
+    SetConfigValue<uint32>(CONFIG_MMAP_PATH_CACHE_SIZE, "MoveMaps.PathCache.Size", 2048);
 
     // Wintergrasp
     SetConfigValue<uint32>(CONFIG_WINTERGRASP_ENABLE, "Wintergrasp.Enable", 1);
@@ -609,6 +616,7 @@ void WorldConfig::BuildConfigCache()
 
     // Preload all grids of all non-instanced maps
     SetConfigValue<bool>(CONFIG_PRELOAD_ALL_NON_INSTANCED_MAP_GRIDS, "PreloadAllNonInstancedMapGrids", false);
+    SetConfigValue<bool>(CONFIG_MEMORY_MAPPED_MAP_FILES, "MemoryMappedMapFiles", false);
 
     // ICC buff override
     SetConfigValue<uint32>(CONFIG_ICC_BUFF_HORDE, "ICC.Buff.Horde", 73822);
@@ -669,4 +677,5 @@ void WorldConfig::BuildConfigCache()
     SetConfigValue<uint32>(CONFIG_SCOURGEINVASION_COUNTER_THIRD, "ScourgeInvasion.CounterThird", 150);
 
     SetConfigValue<std::string>(CONFIG_NEW_CHAR_STRING, "PlayerStart.String", "");
+    SetConfigValue<std::string>(CONFIG_STARTUP_SNAPSHOT_PATH, "Startup.SnapshotPath", "");
 }
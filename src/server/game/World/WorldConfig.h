@@ -116,6 +116,7 @@ enum ServerConfigs
     CONFIG_CLOSE_IDLE_CONNECTIONS,
     CONFIG_LFG_LOCATION_ALL,
     CONFIG_PRELOAD_ALL_NON_INSTANCED_MAP_GRIDS,
+    CONFIG_MEMORY_MAPPED_MAP_FILES,
     CONFIG_ALLOW_TWO_SIDE_INTERACTION_EMOTE,
     CONFIG_ITEMDELETE_METHOD,
     CONFIG_ITEMDELETE_VENDOR,
@@ -135,6 +136,7 @@ enum ServerConfigs
     CONFIG_QUEST_POI_ENABLED,
     CONFIG_VMAP_BLIZZLIKE_PVP_LOS,
     CONFIG_VMAP_BLIZZLIKE_LOS_OPEN_WORLD,
+    CONFIG_VMAP_LOS_CACHE,
     CONFIG_OBJECT_SPARKLES,
     CONFIG_LOW_LEVEL_REGEN_BOOST,
     CONFIG_OBJECT_QUEST_MARKERS,
@@ -162,6 +164,8 @@ enum ServerConfigs
     CONFIG_RESPAWN_DYNAMICRATE_GAMEOBJECT,
     CONFIG_RESPAWN_DYNAMICRATE_CREATURE,
     CONFIG_COMPRESSION,
+    CONFIG_COMPRESSION_THRESHOLD,
+    CONFIG_STARTUP_LOAD_THREADS,
     CONFIG_INTERVAL_MAPUPDATE,
     CONFIG_INTERVAL_CHANGEWEATHER,
     CONFIG_INTERVAL_DISCONNECT_TOLERANCE,
@@ -297,6 +301,10 @@ enum ServerConfigs
     CONFIG_PVP_TOKEN_COUNT,
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_NUMTHREADS,
+    CONFIG_MAP_UPDATE_REGION_THREADS,
+    CONFIG_MAP_UPDATE_REGION_MIN_OBJECTS,
+    CONFIG_MMAP_ASYNC_PATHFINDING_THREADS,
+    CONFIG_MMAP_PATH_CACHE_SIZE,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_TELEPORT_TIMEOUT_NEAR,
@@ -484,6 +492,7 @@ enum ServerConfigs
     RATE_MISS_CHANCE_MULTIPLIER_TARGET_CREATURE,
     RATE_MISS_CHANCE_MULTIPLIER_TARGET_PLAYER,
     CONFIG_NEW_CHAR_STRING,
+    CONFIG_STARTUP_SNAPSHOT_PATH,
     CONFIG_VALIDATE_SKILL_LEARNED_BY_SPELLS,
 
     MAX_NUM_SERVER_CONFIGS
@@ -31,6 +31,7 @@
 #include "MMapFactory.h"
 #include "MMapMgr.h"
 #include "Map.h"
+#include "PathCache.h"
 #include "PathGenerator.h"
 #include "Player.h"
 #include "TargetedMovementGenerator.h"
@@ -46,6 +47,7 @@ public:
     {
         static ChatCommandTable mmapCommandTable =
         {
+            { "cache",       HandleMmapCacheCommand,       SEC_ADMINISTRATOR, Console::Yes },
             { "loadedtiles", HandleMmapLoadedTilesCommand, SEC_ADMINISTRATOR, Console::No },
             { "loc",         HandleMmapLocCommand,         SEC_ADMINISTRATOR, Console::No },
             { "path",        HandleMmapPathCommand,        SEC_ADMINISTRATOR, Console::No },
@@ -174,8 +176,9 @@ public:
         handler->PSendSysMessage("gridloc [{}, {}]", gridCoord.x_coord, gridCoord.y_coord);
 
         // calculate navmesh tile location
-        dtNavMesh const* navmesh = MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMesh(handler->GetSession()->GetPlayer()->GetMapId());
-        dtNavMeshQuery const* navmeshquery = MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMeshQuery(handler->GetSession()->GetPlayer()->GetMapId(), player->GetInstanceId());
+        MMAP::NavMeshQueryHandle query = MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMeshQuery(handler->GetSession()->GetPlayer()->GetMapId());
+        dtNavMesh const* navmesh = query.GetNavMesh();
+        dtNavMeshQuery const* navmeshquery = query.GetQuery();
         if (!navmesh || !navmeshquery)
         {
             handler->PSendSysMessage("NavMesh not loaded for current map.");
@@ -226,8 +229,9 @@ public:
     static bool HandleMmapLoadedTilesCommand(ChatHandler* handler)
     {
         uint32 mapid = handler->GetSession()->GetPlayer()->GetMapId();
-        dtNavMesh const* navmesh = MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMesh(mapid);
-        dtNavMeshQuery const* navmeshquery = MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMeshQuery(mapid, handler->GetSession()->GetPlayer()->GetInstanceId());
+        MMAP::NavMeshQueryHandle query = MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMeshQuery(mapid);
+        dtNavMesh const* navmesh = query.GetNavMesh();
+        dtNavMeshQuery const* navmeshquery = query.GetQuery();
         if (!navmesh || !navmeshquery)
         {
             handler->PSendSysMessage("NavMesh not loaded for current map.");
@@ -255,7 +259,8 @@ public:
         MMAP::MMapMgr* manager = MMAP::MMapFactory::createOrGetMMapMgr();
         handler->PSendSysMessage(" {} maps loaded with {} tiles overall", manager->getLoadedMapsCount(), manager->getLoadedTilesCount());
 
-        dtNavMesh const* navmesh = manager->GetNavMesh(handler->GetSession()->GetPlayer()->GetMapId());
+        MMAP::NavMeshQueryHandle query = manager->GetNavMeshQuery(handler->GetSession()->GetPlayer()->GetMapId());
+        dtNavMesh const* navmesh = query.GetNavMesh();
         if (!navmesh)
         {
             handler->PSendSysMessage("NavMesh not loaded for current map.");
@@ -294,6 +299,17 @@ public:
         return true;
     }
 
+    static bool HandleMmapCacheCommand(ChatHandler* handler)
+    {
+        PathCacheStats stats = sPathCache->GetStats();
+        uint64 lookups = stats.Hits + stats.Misses;
+
+        handler->PSendSysMessage("mmap path cache:");
+        handler->PSendSysMessage(" {} / {} paths cached, {} dropped with their navmesh tiles", stats.Entries, stats.Capacity, stats.Invalidations);
+        handler->PSendSysMessage(" {} hits, {} misses, {:.1f}% hit rate", stats.Hits, stats.Misses, lookups ? stats.Hits * 100.0 / lookups : 0.0);
+        return true;
+    }
+
     static bool HandleMmapTestArea(ChatHandler* handler)
     {
         float radius = 40.0f;
@@ -26,6 +26,7 @@
 #include "MotdMgr.h"
 #include "MySQLThreading.h"
 #include "Realm.h"
+#include "SQLOperationQueue.h"
 #include "StringConvert.h"
 #include "UpdateTime.h"
 #include "VMapFactory.h"
@@ -80,6 +81,7 @@ public:
         static ChatCommandTable serverCommandTable =
         {
             { "corpses",      HandleServerCorpsesCommand,        SEC_GAMEMASTER,    Console::Yes },
+            { "dbstats",      HandleServerDbStatsCommand,        SEC_ADMINISTRATOR, Console::Yes },
             { "debug",        HandleServerDebugCommand,          SEC_ADMINISTRATOR, Console::Yes },
             { "exit",         HandleServerExitCommand,           SEC_CONSOLE,       Console::Yes },
             { "idlerestart",  serverIdleRestartCommandTable },
@@ -109,6 +111,51 @@ public:
         return true;
     }
 
+    template<class T>
+    static void SendDatabaseStats(ChatHandler* handler, std::string_view name, DatabaseWorkerPool<T> const& pool, uint32 count)
+    {
+        handler->PSendSysMessage("{} database:", name);
+
+        for (uint8 i = 0; i < MAX_DATABASE_LANES; ++i)
+        {
+            DatabaseLane lane = DatabaseLane(i);
+            DatabaseLatencyHistogram::Snapshot wait = pool.GetQueueWaitTime(lane);
+            handler->PSendSysMessage("  {} lane: {} queued, {} dequeued, wait avg {}us p50 {}us p99 {}us max {}us", GetDatabaseLaneName(lane),
+                pool.QueueSize(lane), wait.Count, wait.GetAverage().count(), wait.GetPercentile(50.0f).count(), wait.GetPercentile(99.0f).count(), wait.Max.count());
+        }
+
+        std::vector<DatabaseStatementLatency> statements = pool.GetStatementLatencies();
+        std::sort(statements.begin(), statements.end(), [](DatabaseStatementLatency const& left, DatabaseStatementLatency const& right)
+        {
+            return left.Latency.Total > right.Latency.Total;
+        });
+
+        if (statements.size() > count)
+            statements.resize(count);
+
+        for (DatabaseStatementLatency const& statement : statements)
+            handler->PSendSysMessage("  #{}: {} executions, total {}ms avg {}us p99 {}us max {}us - {:.60}", statement.Index, statement.Latency.Count,
+                std::chrono::duration_cast<Milliseconds>(statement.Latency.Total).count(), statement.Latency.GetAverage().count(),
+                statement.Latency.GetPercentile(99.0f).count(), statement.Latency.Max.count(), statement.Sql);
+    }
+
+    // Queue wait times per lane and the statements taking the most time, for one database or all of them
+    static bool HandleServerDbStatsCommand(ChatHandler* handler, Optional<std::string> database, Optional<uint32> count)
+    {
+        uint32 statementCount = count.value_or(10);
+
+        if (!database || StringEqualI(*database, "login"))
+            SendDatabaseStats(handler, "Login", LoginDatabase, statementCount);
+
+        if (!database || StringEqualI(*database, "world"))
+            SendDatabaseStats(handler, "World", WorldDatabase, statementCount);
+
+        if (!database || StringEqualI(*database, "character"))
+            SendDatabaseStats(handler, "Character", CharacterDatabase, statementCount);
+
+        return true;
+    }
+
     static bool HandleServerDebugCommand(ChatHandler* handler)
     {
         uint16 worldPort = uint16(sWorld->getIntConfig(CONFIG_PORT_WORLD));
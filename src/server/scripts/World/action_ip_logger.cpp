@@ -148,7 +148,7 @@ public:
             stmt->SetData(2, aType);
             stmt->SetData(3, playerGuid);
             stmt->SetData(4, systemNote.c_str());
-            LoginDatabase.Execute(stmt);
+            LoginDatabase.Execute(stmt, DatabaseLane::Background);
         }
         else // ... but for failed login, we query last_attempt_ip from account table. Which we do with an unique query
         {
@@ -159,7 +159,7 @@ public:
             stmt->SetData(2, aType);
             stmt->SetData(3, playerGuid);
             stmt->SetData(4, systemNote.c_str());
-            LoginDatabase.Execute(stmt);
+            LoginDatabase.Execute(stmt, DatabaseLane::Background);
         }
         return;
     }
@@ -255,7 +255,7 @@ public:
         // Seeing as the time differences should be minimal, we do not get unixtime and the timestamp right now;
         // Rather, we let it be added with the SQL query.
 
-        LoginDatabase.Execute(stmt);
+        LoginDatabase.Execute(stmt, DatabaseLane::Background);
         return;
     }
 };
@@ -324,7 +324,7 @@ public:
         // Seeing as the time differences should be minimal, we do not get unixtime and the timestamp right now;
         // Rather, we let it be added with the SQL query.
 
-        LoginDatabase.Execute(stmt2);
+        LoginDatabase.Execute(stmt2, DatabaseLane::Background);
         return;
     }
 };
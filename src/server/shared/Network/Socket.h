@@ -18,15 +18,20 @@
 #ifndef __SOCKET_H__
 #define __SOCKET_H__
 
+#include "ByteBuffer.h"
+#include "Errors.h"
 #include "Log.h"
 #include "MessageBuffer.h"
+#include <array>
 #include <atomic>
 #include <boost/asio.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/container/static_vector.hpp>
+#include <deque>
 #include <functional>
 #include <memory>
-#include <queue>
 #include <type_traits>
+#include <vector>
 
 using boost::asio::ip::tcp;
 
@@ -47,6 +52,88 @@ enum ProxyHeaderAddressFamilyAndProtocol {
     PROXY_HEADER_ADDRESS_FAMILY_AND_PROTOCOL_TCP_V6 = 0x21,
 };
 
+/**
+ * Bytes queued for sending: either a buffer owned by the socket, or a small header
+ * followed by the storage of a packet, sent in place and released once written.
+ */
+class SocketWriteEntry
+{
+public:
+    static constexpr std::size_t MAX_HEADER_SIZE = 8;
+
+    explicit SocketWriteEntry(MessageBuffer&& buffer) : _buffer(std::move(buffer)) { }
+
+    SocketWriteEntry(uint8 const* header, std::size_t headerSize, std::unique_ptr<ByteBuffer>&& payload) :
+        _buffer(0), _headerSize(headerSize), _payload(std::move(payload))
+    {
+        ASSERT(headerSize <= MAX_HEADER_SIZE);
+        ASSERT(!_payload->empty());
+        std::memcpy(_header.data(), header, headerSize);
+    }
+
+    /// Appends the unsent bytes to buffers, returns false when there is not enough room left for them
+    template<class Buffers>
+    bool AppendTo(Buffers& buffers)
+    {
+        if (!_payload)
+        {
+            if (buffers.size() == buffers.capacity())
+                return false;
+
+            buffers.push_back(boost::asio::buffer(_buffer.GetReadPointer(), _buffer.GetActiveSize()));
+            return true;
+        }
+
+        if (buffers.capacity() - buffers.size() < 2)
+            return false;
+
+        if (_headerSent < _headerSize)
+            buffers.push_back(boost::asio::buffer(_header.data() + _headerSent, _headerSize - _headerSent));
+
+        buffers.push_back(boost::asio::buffer(_payload->contents() + _payloadSent, _payload->size() - _payloadSent));
+        return true;
+    }
+
+    /// Marks up to bytes as sent, returns how many of them were beyond this entry
+    std::size_t Consume(std::size_t bytes)
+    {
+        if (!_payload)
+        {
+            std::size_t const sent = std::min(bytes, _buffer.GetActiveSize());
+            _buffer.ReadCompleted(sent);
+            return bytes - sent;
+        }
+
+        std::size_t const headerSent = std::min(bytes, _headerSize - _headerSent);
+        _headerSent += headerSent;
+        bytes -= headerSent;
+
+        std::size_t const payloadSent = std::min(bytes, _payload->size() - _payloadSent);
+        _payloadSent += payloadSent;
+        return bytes - payloadSent;
+    }
+
+    [[nodiscard]] bool IsSent() const
+    {
+        if (!_payload)
+            return _buffer.GetActiveSize() == 0;
+
+        return _headerSent == _headerSize && _payloadSent == _payload->size();
+    }
+
+    [[nodiscard]] bool HasPayload() const { return _payload != nullptr; }
+
+    MessageBuffer& GetBuffer() { return _buffer; }
+
+private:
+    MessageBuffer _buffer;
+    std::array<uint8, MAX_HEADER_SIZE> _header{};
+    std::size_t _headerSize{0};
+    std::size_t _headerSent{0};
+    std::unique_ptr<ByteBuffer> _payload;
+    std::size_t _payloadSent{0};
+};
+
 template<class T>
 class Socket : public std::enable_shared_from_this<T>
 {
@@ -141,13 +228,38 @@ public:
 
     void QueuePacket(MessageBuffer&& buffer)
     {
-        _writeQueue.push(std::move(buffer));
+        _writeQueue.emplace_back(std::move(buffer));
+
+#ifdef AC_SOCKET_USE_IOCP
+        AsyncProcessQueue();
+#endif
+    }
+
+    /// Queues header and then the content of payload without copying it, payload is kept alive until it is sent
+    void QueuePacket(uint8 const* header, std::size_t headerSize, std::unique_ptr<ByteBuffer>&& payload)
+    {
+        _writeQueue.emplace_back(header, headerSize, std::move(payload));
 
 #ifdef AC_SOCKET_USE_IOCP
         AsyncProcessQueue();
 #endif
     }
 
+    /// Returns an empty buffer of at least size bytes, reusing the storage of buffers already sent by this socket
+    MessageBuffer GetSendBuffer(std::size_t size)
+    {
+        if (_freeSendBuffers.empty())
+            return MessageBuffer(size);
+
+        MessageBuffer buffer(std::move(_freeSendBuffers.back()));
+        _freeSendBuffers.pop_back();
+
+        if (buffer.GetBufferSize() < size)
+            buffer.Resize(size);
+
+        return buffer;
+    }
+
     [[nodiscard]] ProxyHeaderReadingState GetProxyHeaderReadingState() const { return _proxyHeaderReadingState; }
 
     [[nodiscard]] bool IsOpen() const { return !_closed && !_closing; }
@@ -184,8 +296,8 @@ protected:
         _isWritingAsync = true;
 
 #ifdef AC_SOCKET_USE_IOCP
-        MessageBuffer& buffer = _writeQueue.front();
-        _socket.async_write_some(boost::asio::buffer(buffer.GetReadPointer(), buffer.GetActiveSize()), std::bind(&Socket<T>::WriteHandler,
+        // entries stay in the queue, and their storage alive, until the write completes
+        _socket.async_write_some(GatherWriteQueue(), std::bind(&Socket<T>::WriteHandler,
             this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
 #else
         _socket.async_write_some(boost::asio::null_buffers(), std::bind(&Socket<T>::WriteHandlerWrapper,
@@ -194,6 +306,16 @@ protected:
         return false;
     }
 
+    static constexpr std::size_t MAX_GATHERED_BUFFERS = 64;
+
+    using GatheredBuffers = boost::container::static_vector<boost::asio::const_buffer, MAX_GATHERED_BUFFERS>;
+
+    /// Writes what the socket accepts without blocking from buffers, called by the queue processing of non IOCP builds
+    virtual std::size_t WriteSome(GatheredBuffers const& buffers, boost::system::error_code& error)
+    {
+        return _socket.write_some(buffers, error);
+    }
+
     void SetNoDelay(bool enable)
     {
         boost::system::error_code err;
@@ -329,16 +451,52 @@ private:
         _proxyHeaderReadingState = PROXY_HEADER_READING_STATE_FINISHED;
     }
 
+    static constexpr std::size_t MAX_FREE_SEND_BUFFERS = 4;
+
+    /// Buffer sequence of the queued bytes, written with a single call
+    GatheredBuffers GatherWriteQueue()
+    {
+        GatheredBuffers buffers;
+        for (SocketWriteEntry& entry : _writeQueue)
+            if (!entry.AppendTo(buffers))
+                break;
+
+        return buffers;
+    }
+
+    /// Removes the written bytes from the write queue and keeps the storage of sent buffers for GetSendBuffer
+    void WriteCompleted(std::size_t bytes)
+    {
+        while (!_writeQueue.empty())
+        {
+            SocketWriteEntry& entry = _writeQueue.front();
+            bytes = entry.Consume(bytes);
+            if (!entry.IsSent())
+                break;
+
+            PopWriteQueue();
+        }
+    }
+
+    void PopWriteQueue()
+    {
+        SocketWriteEntry& entry = _writeQueue.front();
+        if (!entry.HasPayload() && _freeSendBuffers.size() < MAX_FREE_SEND_BUFFERS)
+        {
+            entry.GetBuffer().Reset();
+            _freeSendBuffers.push_back(std::move(entry.GetBuffer()));
+        }
+
+        _writeQueue.pop_front();
+    }
+
 #ifdef AC_SOCKET_USE_IOCP
     void WriteHandler(boost::system::error_code error, std::size_t transferedBytes)
     {
         if (!error)
         {
             _isWritingAsync = false;
-            _writeQueue.front().ReadCompleted(transferedBytes);
-
-            if (!_writeQueue.front().GetActiveSize())
-                _writeQueue.pop();
+            WriteCompleted(transferedBytes);
 
             if (!_writeQueue.empty())
                 AsyncProcessQueue();
@@ -362,12 +520,11 @@ private:
         if (_writeQueue.empty())
             return false;
 
-        MessageBuffer& queuedMessage = _writeQueue.front();
-
-        std::size_t bytesToSend = queuedMessage.GetActiveSize();
+        GatheredBuffers buffers = GatherWriteQueue();
+        std::size_t bytesToSend = boost::asio::buffer_size(buffers);
 
         boost::system::error_code error;
-        std::size_t bytesSent = _socket.write_some(boost::asio::buffer(queuedMessage.GetReadPointer(), bytesToSend), error);
+        std::size_t bytesSent = WriteSome(buffers, error);
 
         if (error)
         {
@@ -376,7 +533,7 @@ private:
                 return AsyncProcessQueue();
             }
 
-            _writeQueue.pop();
+            PopWriteQueue();
 
             if (_closing && _writeQueue.empty())
             {
@@ -387,7 +544,7 @@ private:
         }
         else if (bytesSent == 0)
         {
-            _writeQueue.pop();
+            PopWriteQueue();
 
             if (_closing && _writeQueue.empty())
             {
@@ -396,13 +553,11 @@ private:
 
             return false;
         }
-        else if (bytesSent < bytesToSend) // now n > 0
-        {
-            queuedMessage.ReadCompleted(bytesSent);
-            return AsyncProcessQueue();
-        }
 
-        _writeQueue.pop();
+        WriteCompleted(bytesSent);
+
+        if (bytesSent < bytesToSend) // now n > 0
+            return AsyncProcessQueue();
 
         if (_closing && _writeQueue.empty())
         {
@@ -419,7 +574,8 @@ private:
     uint16 _remotePort;
 
     MessageBuffer _readBuffer;
-    std::queue<MessageBuffer> _writeQueue;
+    std::deque<SocketWriteEntry> _writeQueue;
+    std::vector<MessageBuffer> _freeSendBuffers;
 
     std::atomic<bool> _closed;
     std::atomic<bool> _closing;
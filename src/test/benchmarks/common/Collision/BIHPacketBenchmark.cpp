@@ -0,0 +1,167 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CollisionModels.h"
+#include "MapDefines.h"
+#include "ModelIgnoreFlags.h"
+#include "VMapMgr2.h"
+#include "WorldModel.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+using G3D::Vector3;
+
+TEST(BIHPacketBenchmark, PacketsAgainstSingleRays)
+{
+    VMAP::WorldModel const model = BuildModel(16, 1000);
+
+    constexpr std::size_t RAY_COUNT = 1 << 16;
+    std::vector<float> distances;
+    std::vector<G3D::Ray> const rays = RandomRays(RAY_COUNT, 5.0f, distances);
+
+    std::size_t scalarHits = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < RAY_COUNT; ++i)
+    {
+        float distance = distances[i];
+        if (model.IntersectRay(rays[i], distance, true, VMAP::ModelIgnoreFlags::Nothing))
+            ++scalarHits;
+    }
+    auto scalarTime = std::chrono::steady_clock::now() - start;
+
+    std::size_t packetHits = 0;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t first = 0; first < RAY_COUNT; first += RAY_PACKET_SIZE)
+    {
+        RayPacket packet;
+        float packetDistances[RAY_PACKET_SIZE];
+        for (uint32 lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+        {
+            packet.SetRay(lane, rays[first + lane]);
+            packetDistances[lane] = distances[first + lane];
+        }
+
+        uint32 hits = model.IntersectRayPacket(packet, packetDistances, 0xF, true, VMAP::ModelIgnoreFlags::Nothing);
+        for (uint32 lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+            if (hits & (1 << lane))
+                ++packetHits;
+    }
+    auto packetTime = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(scalarHits, packetHits);
+
+    std::cout << "[ BENCH    ] " << RAY_COUNT << " line of sight rays, IntersectRay: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(scalarTime).count() << "us, IntersectRayPacket: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(packetTime).count() << "us" << std::endl;
+}
+
+// Same comparison over extracted vmaps, run with ACORE_VMAP_BENCH_DIR pointing to a vmaps directory,
+// ACORE_VMAP_BENCH_MAP and ACORE_VMAP_BENCH_TILE ("x,y") select the tile, map 0 tile 32,32 by default
+TEST(BIHPacketBenchmark, ExtractedVMaps)
+{
+    char const* directory = std::getenv("ACORE_VMAP_BENCH_DIR");
+    if (!directory)
+    {
+        std::cout << "[ BENCH    ] ACORE_VMAP_BENCH_DIR not set, skipping the extracted vmaps benchmark" << std::endl;
+        return;
+    }
+
+    uint32 mapId = 0;
+    int tileX = 32;
+    int tileY = 32;
+    if (char const* map = std::getenv("ACORE_VMAP_BENCH_MAP"))
+        mapId = std::strtoul(map, nullptr, 10);
+    if (char const* tile = std::getenv("ACORE_VMAP_BENCH_TILE"))
+        std::sscanf(tile, "%d,%d", &tileX, &tileY);
+
+    VMAP::VMapMgr2 vmgr;
+    vmgr.InitializeThreadUnsafe({ mapId });
+    ASSERT_EQ(vmgr.loadMap(directory, mapId, tileX, tileY), VMAP::VMAP_LOAD_RESULT_OK);
+
+    // casters and targets standing on the models of the tile
+    std::mt19937 rng(42);
+    float const tileLow = (31 - tileX) * SIZE_OF_GRIDS;
+    std::uniform_real_distribution<float> coordX(tileLow, tileLow + SIZE_OF_GRIDS);
+    float const tileLowY = (31 - tileY) * SIZE_OF_GRIDS;
+    std::uniform_real_distribution<float> coordY(tileLowY, tileLowY + SIZE_OF_GRIDS);
+    std::uniform_real_distribution<float> offset(-30.0f, 30.0f);
+    auto groundPoint = [&](float x, float y, Vector3& point)
+    {
+        float z = vmgr.getHeight(mapId, x, y, 1000.0f, 2000.0f);
+        if (z <= VMAP_INVALID_HEIGHT)
+            return false;
+
+        point = Vector3(x, y, z + 2.0f);
+        return true;
+    };
+
+    constexpr std::size_t CASTER_COUNT = 4096;
+    constexpr std::size_t TARGETS_PER_CASTER = 20;
+    std::vector<Vector3> casters;
+    std::vector<Vector3> targets;
+    for (uint32 attempt = 0; casters.size() < CASTER_COUNT && attempt < CASTER_COUNT * 20; ++attempt)
+    {
+        Vector3 caster;
+        if (!groundPoint(coordX(rng), coordY(rng), caster))
+            continue;
+
+        std::vector<Vector3> casterTargets;
+        while (casterTargets.size() < TARGETS_PER_CASTER)
+        {
+            Vector3 target;
+            if (groundPoint(caster.x + offset(rng), caster.y + offset(rng), target))
+                casterTargets.push_back(target);
+            else
+                casterTargets.push_back(caster + Vector3(offset(rng), offset(rng), 0.0f));
+        }
+
+        casters.push_back(caster);
+        targets.insert(targets.end(), casterTargets.begin(), casterTargets.end());
+    }
+    ASSERT_FALSE(casters.empty()) << "no model found on tile " << tileX << "," << tileY;
+
+    std::vector<bool> scalarResults(targets.size());
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < targets.size(); ++i)
+    {
+        Vector3 const& caster = casters[i / TARGETS_PER_CASTER];
+        scalarResults[i] = vmgr.isInLineOfSight(mapId, caster.x, caster.y, caster.z, targets[i].x, targets[i].y, targets[i].z, VMAP::ModelIgnoreFlags::Nothing);
+    }
+    auto scalarTime = std::chrono::steady_clock::now() - start;
+
+    std::unique_ptr<bool[]> batchResults = std::make_unique<bool[]>(targets.size());
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < casters.size(); ++i)
+        vmgr.isInLineOfSight(mapId, casters[i].x, casters[i].y, casters[i].z, &targets[i * TARGETS_PER_CASTER], &batchResults[i * TARGETS_PER_CASTER], TARGETS_PER_CASTER, VMAP::ModelIgnoreFlags::Nothing);
+    auto batchTime = std::chrono::steady_clock::now() - start;
+
+    for (std::size_t i = 0; i < targets.size(); ++i)
+        ASSERT_EQ(scalarResults[i], batchResults[i]) << "target " << i;
+
+    std::cout << "[ BENCH    ] " << targets.size() << " line of sight checks on map " << mapId << " tile " << tileX << "," << tileY
+              << ", isInLineOfSight: " << std::chrono::duration_cast<std::chrono::microseconds>(scalarTime).count()
+              << "us, batch isInLineOfSight: " << std::chrono::duration_cast<std::chrono::microseconds>(batchTime).count() << "us" << std::endl;
+
+    vmgr.unloadMap(mapId, tileX, tileY);
+}
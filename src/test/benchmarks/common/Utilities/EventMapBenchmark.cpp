@@ -0,0 +1,123 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EventMap.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <vector>
+
+namespace
+{
+    // The multimap EventMap replaced by the sorted small vector: its Update, ScheduleEvent and ExecuteEvent
+    class MultimapEventMap
+    {
+        struct Event
+        {
+            uint16 Id;
+            uint8 GroupMask;
+            uint8 PhaseMask;
+        };
+
+    public:
+        void Update(uint32 time) { _time += Milliseconds(time); }
+
+        void ScheduleEvent(uint16 eventId, Milliseconds time, uint8 group = 0, uint8 phase = 0)
+        {
+            _eventMap.emplace(_time + time, Event{ eventId, uint8(group ? 1u << (group - 1u) : 0u), uint8(phase ? 1u << (phase - 1u) : 0u) });
+        }
+
+        uint16 ExecuteEvent()
+        {
+            while (!_eventMap.empty())
+            {
+                auto const& itr = _eventMap.begin();
+
+                if (itr->first > _time)
+                    return 0;
+                else if (_phaseMask && itr->second.PhaseMask && !(itr->second.PhaseMask & _phaseMask))
+                    _eventMap.erase(itr);
+                else
+                {
+                    auto eventId = itr->second.Id;
+                    _lastEvent = itr->second;
+                    _eventMap.erase(itr);
+                    return eventId;
+                }
+            }
+
+            return 0;
+        }
+
+    private:
+        TimePoint _time{ TimePoint::min() };
+        uint8 _phaseMask{ 0 };
+        Event _lastEvent{};
+        std::multimap<TimePoint, Event> _eventMap;
+    };
+
+    // a boss script: a dozen abilities recast on their own timers, 100ms AI updates
+    constexpr uint32 SCRIPTS = 1000;
+    constexpr uint32 ABILITIES = 12;
+    constexpr uint32 UPDATES = 2000;
+    constexpr uint32 UPDATE_TIME = 100;
+
+    Milliseconds Cooldown(uint32 eventId) { return Milliseconds(1000 + eventId * 1700); }
+
+    template<typename Events>
+    std::chrono::steady_clock::duration RunScripts(uint64& executed)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<Events> scripts(SCRIPTS);
+        for (Events& events : scripts)
+            for (uint32 eventId = 1; eventId <= ABILITIES; ++eventId)
+                events.ScheduleEvent(eventId, Cooldown(eventId));
+
+        for (uint32 i = 0; i < UPDATES; ++i)
+        {
+            for (Events& events : scripts)
+            {
+                events.Update(UPDATE_TIME);
+                while (uint32 eventId = events.ExecuteEvent())
+                {
+                    events.ScheduleEvent(eventId, Cooldown(eventId));
+                    ++executed;
+                }
+            }
+        }
+
+        return std::chrono::steady_clock::now() - start;
+    }
+}
+
+TEST(EventMapBenchmark, SmallVectorAgainstMultimap)
+{
+    uint64 flatExecuted = 0;
+    auto flatTime = RunScripts<EventMap>(flatExecuted);
+
+    uint64 multimapExecuted = 0;
+    auto multimapTime = RunScripts<MultimapEventMap>(multimapExecuted);
+
+    EXPECT_EQ(flatExecuted, multimapExecuted);
+
+    std::cout << "[ BENCH    ] " << SCRIPTS << " scripts, " << ABILITIES << " events, " << UPDATES << " updates, small vector: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(flatTime).count() << "us, multimap: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(multimapTime).count() << "us" << std::endl;
+}
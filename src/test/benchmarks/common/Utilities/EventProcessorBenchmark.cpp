@@ -0,0 +1,119 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EventProcessor.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <vector>
+
+namespace
+{
+    // The multimap EventProcessor replaced by the timing wheel: its AddEvent and Update loop,
+    // abort handling left out as the benchmark events never abort
+    class MultimapEventProcessor
+    {
+    public:
+        ~MultimapEventProcessor()
+        {
+            for (auto const& [time, event] : m_events)
+                delete event;
+        }
+
+        void Update(uint32 p_time)
+        {
+            m_time += p_time;
+
+            std::multimap<uint64, BasicEvent*>::iterator i;
+            while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+            {
+                BasicEvent* event = i->second;
+                m_events.erase(i);
+
+                if (event->Execute(m_time, p_time))
+                    delete event;
+            }
+        }
+
+        void AddEventAtOffset(BasicEvent* event, Milliseconds offset) { m_events.emplace(m_time + offset.count(), event); }
+
+    private:
+        uint64 m_time{0};
+        std::multimap<uint64, BasicEvent*> m_events;
+    };
+
+    // periodic timer rescheduling itself, from spell ticks to long auras
+    template<typename Processor>
+    class PeriodicEvent : public BasicEvent
+    {
+    public:
+        PeriodicEvent(Processor& events, uint64 period, uint64& executed) : _events(events), _period(period), _executed(executed) { }
+
+        bool Execute(uint64 /*e_time*/, uint32 /*p_time*/) override
+        {
+            ++_executed;
+            _events.AddEventAtOffset(this, Milliseconds(_period));
+            return false;
+        }
+
+    private:
+        Processor& _events;
+        uint64 _period;
+        uint64& _executed;
+    };
+
+    constexpr uint32 EVENT_COUNT = 100000;
+    constexpr uint32 TICKS = 2000;
+    constexpr uint32 TICK_TIME = 50;
+
+    template<typename Processor>
+    std::chrono::steady_clock::duration RunPeriodicEvents(std::vector<uint64> const& periods, uint64& executed)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        Processor events;
+        for (uint32 i = 0; i < EVENT_COUNT; ++i)
+            events.AddEventAtOffset(new PeriodicEvent<Processor>(events, periods[i], executed), Milliseconds(i % 1000));
+
+        for (uint32 i = 0; i < TICKS; ++i)
+            events.Update(TICK_TIME);
+
+        return std::chrono::steady_clock::now() - start;
+    }
+}
+
+TEST(EventProcessorBenchmark, TimingWheelAgainstMultimap)
+{
+    std::vector<uint64> periods;
+    periods.reserve(EVENT_COUNT);
+    for (uint32 i = 0; i < EVENT_COUNT; ++i)
+        periods.push_back(TICK_TIME + (uint64(i) * 2654435761u) % 30000);
+
+    uint64 wheelExecuted = 0;
+    auto wheelTime = RunPeriodicEvents<EventProcessor>(periods, wheelExecuted);
+
+    uint64 multimapExecuted = 0;
+    auto multimapTime = RunPeriodicEvents<MultimapEventProcessor>(periods, multimapExecuted);
+
+    EXPECT_EQ(wheelExecuted, multimapExecuted);
+
+    std::cout << "[ BENCH    ] " << EVENT_COUNT << " periodic events, " << TICKS << " updates, " << wheelExecuted << " executions, timing wheel: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(wheelTime).count() << "ms, multimap: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(multimapTime).count() << "ms" << std::endl;
+}
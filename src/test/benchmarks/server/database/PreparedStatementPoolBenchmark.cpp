@@ -0,0 +1,99 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "PreparedStatement.h"
+#include "SaveWorkload.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <vector>
+
+namespace
+{
+    // Counts the heap allocations of the thread running the workload
+    thread_local bool CountAllocations = false;
+    thread_local uint64 Allocations = 0;
+
+    // Runs saves by rounds, each round is destroyed by the worker before the next one starts
+    uint64 RunSaves(SaveWorker& worker, uint32 rounds, uint32 savesPerRound)
+    {
+        uint64 allocations = 0;
+        for (uint32 round = 0; round < rounds; ++round)
+        {
+            std::vector<std::vector<PreparedStatementTask*>> saves(savesPerRound);
+
+            Allocations = 0;
+            CountAllocations = true;
+            for (uint32 save = 0; save < savesPerRound; ++save)
+                saves[save] = CreateSave(round * savesPerRound + save);
+            CountAllocations = false;
+            allocations += Allocations;
+
+            for (std::vector<PreparedStatementTask*> const& tasks : saves)
+                worker.Destroy(tasks);
+        }
+
+        return allocations;
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    if (CountAllocations)
+        ++Allocations;
+
+    if (void* memory = std::malloc(size ? size : 1))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t /*size*/) noexcept
+{
+    std::free(memory);
+}
+
+TEST(PreparedStatementPoolBenchmark, SaveAllocations)
+{
+    constexpr uint32 ROUNDS = 100;
+    constexpr uint32 SAVES_PER_ROUND = 20;
+    constexpr uint32 SAVES = ROUNDS * SAVES_PER_ROUND;
+
+    SaveWorker worker;
+    RunSaves(worker, 3, SAVES_PER_ROUND);
+
+    auto start = std::chrono::steady_clock::now();
+    uint64 const allocations = RunSaves(worker, ROUNDS, SAVES_PER_ROUND);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // the only allocations left are the vectors holding the tasks of each save
+    EXPECT_LE(allocations, SAVES);
+
+    std::cout << "[ BENCH    ] " << SAVES << " saves of " << STATEMENTS_PER_SAVE << " statements, "
+              << allocations << " heap allocations ("
+              << double(allocations) / (SAVES * STATEMENTS_PER_SAVE) << " per statement), "
+              << std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() << "us" << std::endl;
+}
@@ -0,0 +1,57 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GridDefines.h"
+#include "GridTerrainData.h"
+#include "TerrainMapFile.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+TEST(GridTerrainDataBenchmark, BatchAgainstScalar)
+{
+    std::string const path = WriteMapFile("grid_terrain_test_bench.map", MAP_HEIGHT_AS_INT16);
+
+    GridTerrainData terrain;
+    ASSERT_EQ(terrain.Load(path), TerrainMapDataReadResult::Success);
+
+    constexpr std::size_t POINT_COUNT = 1 << 20;
+    std::vector<G3D::Vector3> const points = RandomPoints(POINT_COUNT);
+    std::vector<float> scalarHeights(POINT_COUNT);
+    std::vector<float> batchHeights(POINT_COUNT);
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < POINT_COUNT; ++i)
+        scalarHeights[i] = terrain.getHeight(points[i].x, points[i].y);
+    auto scalarTime = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    terrain.getHeights(points.data(), batchHeights.data(), POINT_COUNT);
+    auto batchTime = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(std::memcmp(scalarHeights.data(), batchHeights.data(), POINT_COUNT * sizeof(float)), 0);
+
+    std::cout << "[ BENCH    ] " << POINT_COUNT << " height queries, getHeight: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(scalarTime).count() << "us, getHeights: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(batchTime).count() << "us" << std::endl;
+
+    std::filesystem::remove(path);
+}
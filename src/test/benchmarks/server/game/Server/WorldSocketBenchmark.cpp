@@ -0,0 +1,261 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OpenSSLCrypto.h"
+#include "Opcodes.h"
+#include "ServerPktHeader.h"
+#include "WorldPacket.h"
+#include "WorldSocket.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t SEND_BUFFER_SIZE = 4096;
+
+    // WorldSocket counting the write calls of its queue processing
+    class CountingWorldSocket : public WorldSocket
+    {
+    public:
+        using WorldSocket::WorldSocket;
+
+        uint64 GetWriteCalls() const { return _writeCalls; }
+
+    protected:
+        std::size_t WriteSome(GatheredBuffers const& buffers, boost::system::error_code& error) override
+        {
+            ++_writeCalls;
+            return WorldSocket::WriteSome(buffers, error);
+        }
+
+    private:
+        uint64 _writeCalls = 0;
+    };
+
+    // The previous WorldSocket::Update: every packet is copied into a newly allocated send buffer
+    class CopyingSocket : public Socket<CopyingSocket>
+    {
+    public:
+        using Socket::Socket;
+
+        void Start() override { }
+
+        void SendPacket(WorldPacket const& packet) { _queue.push_back(packet); }
+
+        bool Update() override
+        {
+            if (!_queue.empty())
+            {
+                MessageBuffer buffer(_sendBufferSize);
+                for (WorldPacket& queued : _queue)
+                {
+                    ServerPktHeader header(queued.size() + 2, queued.GetOpcode());
+                    std::size_t currentPacketSize = queued.size() + header.getHeaderLength();
+
+                    if (buffer.GetRemainingSpace() < currentPacketSize)
+                    {
+                        QueuePacket(std::move(buffer));
+                        buffer.Resize(_sendBufferSize);
+                    }
+
+                    if (buffer.GetRemainingSpace() < currentPacketSize)
+                    {
+                        buffer.Resize(currentPacketSize);
+                        if (currentPacketSize <= 65536)
+                            _sendBufferSize = currentPacketSize;
+                    }
+
+                    buffer.Write(header.header, header.getHeaderLength());
+                    if (!queued.empty())
+                        buffer.Write(queued.contents(), queued.size());
+                }
+
+                QueuePacket(std::move(buffer));
+                _queue.clear();
+            }
+
+            return Socket::Update();
+        }
+
+        uint64 GetWriteCalls() const { return _writeCalls; }
+
+    protected:
+        void ReadHandler() override { }
+
+        std::size_t WriteSome(GatheredBuffers const& buffers, boost::system::error_code& error) override
+        {
+            ++_writeCalls;
+            return Socket::WriteSome(buffers, error);
+        }
+
+    private:
+        std::vector<WorldPacket> _queue;
+        std::size_t _sendBufferSize = SEND_BUFFER_SIZE;
+        uint64 _writeCalls = 0;
+    };
+
+    // Client side of a connection, counts the received bytes
+    class Receiver
+    {
+    public:
+        explicit Receiver(tcp::socket&& socket) : _socket(std::move(socket)), _buffer(65536) { Read(); }
+
+        uint64 GetReceived() const { return _received.load(std::memory_order_acquire); }
+
+    private:
+        void Read()
+        {
+            _socket.async_read_some(boost::asio::buffer(_buffer), [this](boost::system::error_code error, std::size_t bytes)
+            {
+                if (error)
+                    return;
+
+                _received.fetch_add(bytes, std::memory_order_release);
+                Read();
+            });
+        }
+
+        tcp::socket _socket;
+        std::vector<uint8> _buffer;
+        std::atomic<uint64> _received{0};
+    };
+
+    // Packets of a world update for one client, mostly small with a few large ones
+    constexpr std::size_t PACKET_SIZES[] = { 12, 40, 8, 1800, 96, 20, 6000, 64, 30, 700 };
+
+    struct BenchmarkResult
+    {
+        uint64 Bytes = 0;
+        uint64 Copied = 0;
+        uint64 WriteCalls = 0;
+        std::chrono::steady_clock::duration Time{};
+    };
+
+    template<class SocketType>
+    BenchmarkResult RunClients(std::size_t clientCount, std::size_t updates, bool copiesEveryPacket)
+    {
+        boost::asio::io_context serverContext;
+        boost::asio::io_context clientContext;
+        tcp::acceptor acceptor(serverContext, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+
+        std::vector<std::shared_ptr<SocketType>> sockets;
+        std::vector<std::unique_ptr<Receiver>> receivers;
+        for (std::size_t i = 0; i < clientCount; ++i)
+        {
+            tcp::socket client(clientContext);
+            client.connect(acceptor.local_endpoint());
+
+            tcp::socket server = acceptor.accept();
+            server.non_blocking(true);
+
+            sockets.push_back(std::make_shared<SocketType>(std::move(server)));
+            receivers.push_back(std::make_unique<Receiver>(std::move(client)));
+        }
+
+        auto work = boost::asio::make_work_guard(clientContext);
+        std::thread clientThread([&clientContext] { clientContext.run(); });
+
+        std::vector<WorldPacket> packets;
+        BenchmarkResult result;
+        for (std::size_t size : PACKET_SIZES)
+        {
+            WorldPacket packet(SMSG_MESSAGECHAT, size);
+            packet.resize(size);
+            packets.push_back(std::move(packet));
+
+            std::size_t const bytes = 4 + size;
+            result.Bytes += bytes;
+            if (copiesEveryPacket || size < WorldSocket::MIN_GATHERED_PACKET_SIZE)
+                result.Copied += bytes;
+        }
+
+        result.Bytes *= clientCount * updates;
+        result.Copied *= clientCount * updates;
+
+        auto const start = std::chrono::steady_clock::now();
+
+        for (std::size_t update = 0; update < updates; ++update)
+        {
+            for (std::shared_ptr<SocketType>& socket : sockets)
+            {
+                for (WorldPacket const& packet : packets)
+                    socket->SendPacket(packet);
+
+                socket->Update();
+            }
+
+            serverContext.poll();
+        }
+
+        uint64 const expected = result.Bytes / clientCount;
+        auto const deadline = std::chrono::steady_clock::now() + 30s;
+        for (std::size_t i = 0; i < clientCount; ++i)
+        {
+            while (receivers[i]->GetReceived() < expected && std::chrono::steady_clock::now() < deadline)
+            {
+                sockets[i]->Update();
+                serverContext.poll();
+                std::this_thread::yield();
+            }
+
+            EXPECT_EQ(receivers[i]->GetReceived(), expected);
+        }
+
+        result.Time = std::chrono::steady_clock::now() - start;
+        for (std::shared_ptr<SocketType>& socket : sockets)
+        {
+            result.WriteCalls += socket->GetWriteCalls();
+            socket->CloseSocket();
+        }
+
+        sockets.clear();
+        work.reset();
+        clientContext.stop();
+        clientThread.join();
+        return result;
+    }
+
+    void Print(char const* label, BenchmarkResult const& result)
+    {
+        double const seconds = std::chrono::duration<double>(result.Time).count();
+        std::cout << "[ BENCH    ] " << label << ": " << result.Bytes << " bytes in " << uint64(seconds * 1000000) << "us, "
+                  << uint64(result.Bytes / seconds / (1024 * 1024)) << " MB/s, " << result.Copied << " bytes copied, "
+                  << result.WriteCalls << " write calls (" << uint64(result.WriteCalls / seconds) << "/s)" << std::endl;
+    }
+}
+
+TEST(WorldSocketBenchmark, CopiedAgainstGathered)
+{
+    constexpr std::size_t CLIENTS = 32;
+    constexpr std::size_t UPDATES = 200;
+
+    OpenSSLCrypto::threadsSetup();
+
+    BenchmarkResult const copied = RunClients<CopyingSocket>(CLIENTS, UPDATES, true);
+    BenchmarkResult const gathered = RunClients<CountingWorldSocket>(CLIENTS, UPDATES, false);
+
+    OpenSSLCrypto::threadsCleanup();
+
+    Print("copied  ", copied);
+    Print("gathered", gathered);
+}
@@ -0,0 +1,83 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "CollisionModels.h"
+#include "ModelIgnoreFlags.h"
+#include "WorldModel.h"
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    void CheckSameAsScalar(bool stopAtFirstHit)
+    {
+        VMAP::WorldModel const model = BuildModel(12, 400);
+
+        std::vector<float> distances;
+        std::vector<G3D::Ray> rays = RandomRays(20000, 100.0f, distances);
+        std::vector<float> coherentDistances;
+        std::vector<G3D::Ray> const coherentRays = RandomRays(20000, 5.0f, coherentDistances);
+        rays.insert(rays.end(), coherentRays.begin(), coherentRays.end());
+        distances.insert(distances.end(), coherentDistances.begin(), coherentDistances.end());
+
+        std::size_t hitCount = 0;
+        for (std::size_t first = 0; first < rays.size(); first += RAY_PACKET_SIZE)
+        {
+            RayPacket packet;
+            float packetDistances[RAY_PACKET_SIZE];
+            for (uint32 lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+            {
+                packet.SetRay(lane, rays[first + lane]);
+                packetDistances[lane] = distances[first + lane];
+            }
+
+            // leave one lane out now and then, it must not be touched
+            uint32 rayMask = (first / RAY_PACKET_SIZE) % 5 ? 0xF : 0xB;
+            uint32 hits = model.IntersectRayPacket(packet, packetDistances, rayMask, stopAtFirstHit, VMAP::ModelIgnoreFlags::Nothing);
+            for (uint32 lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+            {
+                float expected = distances[first + lane];
+                bool hit = (rayMask & (1 << lane)) && model.IntersectRay(rays[first + lane], expected, stopAtFirstHit, VMAP::ModelIgnoreFlags::Nothing);
+                ASSERT_EQ(hit, bool(hits & (1 << lane))) << "ray " << first + lane;
+                if (hit)
+                    ++hitCount;
+
+                // the first hit found depends on the traversal order, only the closest one is the same
+                if (!stopAtFirstHit || !hit)
+                {
+                    ASSERT_EQ(std::memcmp(&expected, &packetDistances[lane], sizeof(float)), 0) << "ray " << first + lane << ": expected " << expected << ", got " << packetDistances[lane];
+                }
+            }
+        }
+
+        EXPECT_GT(hitCount, 0u);
+        EXPECT_LT(hitCount, rays.size());
+    }
+}
+
+TEST(BIHPacketTest, LineOfSightMatchesSingleRays)
+{
+    CheckSameAsScalar(true);
+}
+
+TEST(BIHPacketTest, ClosestHitMatchesSingleRays)
+{
+    CheckSameAsScalar(false);
+}
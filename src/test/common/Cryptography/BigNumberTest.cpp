@@ -0,0 +1,65 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "BigNumber.h"
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // g^x mod N, then (g^x mod N) * x / 3 mod N, exercising every operation using a BN_CTX
+    std::string Compute(BigNumber const& g, BigNumber const& x, BigNumber const& N)
+    {
+        BigNumber value = g.ModExp(x, N);
+        value = (value * x) / BigNumber(3u);
+        return (value % N).AsHexStr();
+    }
+}
+
+TEST(BigNumberTest, ThreadContextsGiveSameResults)
+{
+    BigNumber const N("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
+    BigNumber const g(7u);
+
+    std::vector<BigNumber> exponents(64);
+    std::vector<std::string> expected(exponents.size());
+    for (std::size_t i = 0; i < exponents.size(); ++i)
+    {
+        exponents[i].SetRand(19 * 8);
+        expected[i] = Compute(g, exponents[i], N);
+    }
+
+    std::vector<std::vector<std::string>> results(4, std::vector<std::string>(exponents.size()));
+    std::vector<std::thread> threads;
+    for (std::vector<std::string>& threadResults : results)
+    {
+        threads.emplace_back([&]()
+        {
+            for (int repeat = 0; repeat < 10; ++repeat)
+                for (std::size_t i = 0; i < exponents.size(); ++i)
+                    threadResults[i] = Compute(g, exponents[i], N);
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    for (std::vector<std::string> const& threadResults : results)
+        EXPECT_EQ(threadResults, expected);
+}
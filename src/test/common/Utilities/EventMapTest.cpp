@@ -0,0 +1,115 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EventMap.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+namespace
+{
+    std::vector<uint32> ExecuteAll(EventMap& events)
+    {
+        std::vector<uint32> executed;
+        while (uint32 eventId = events.ExecuteEvent())
+            executed.push_back(eventId);
+
+        return executed;
+    }
+}
+
+TEST(EventMapTest, ExecutesInTimeThenScheduleOrder)
+{
+    EventMap events;
+    events.ScheduleEvent(1, 3s);
+    events.ScheduleEvent(2, 1s);
+    events.ScheduleEvent(3, 3s);
+    events.ScheduleEvent(4, 2s);
+    events.ScheduleEvent(5, 1s);
+
+    events.Update(1500);
+    EXPECT_EQ(ExecuteAll(events), std::vector<uint32>({ 2, 5 }));
+
+    events.Update(2000);
+    EXPECT_EQ(ExecuteAll(events), std::vector<uint32>({ 4, 1, 3 }));
+    EXPECT_TRUE(events.Empty());
+}
+
+TEST(EventMapTest, PhasesSkipEvents)
+{
+    EventMap events;
+    events.SetPhase(1);
+    events.ScheduleEvent(1, 1s, 0, 2);
+    events.ScheduleEvent(2, 1s, 0, 1);
+    events.ScheduleEvent(3, 1s);
+
+    events.Update(1000);
+    EXPECT_EQ(ExecuteAll(events), std::vector<uint32>({ 2, 3 }));
+    EXPECT_TRUE(events.Empty());
+}
+
+TEST(EventMapTest, GroupsAndDelays)
+{
+    EventMap events;
+    events.ScheduleEvent(1, 1s, 1);
+    events.ScheduleEvent(2, 2s, 2);
+    events.ScheduleEvent(3, 3s, 1);
+    events.ScheduleEvent(4, 3s);
+
+    // delayed events run after events already due at their new time
+    events.DelayEvents(2s, 1);
+    EXPECT_EQ(events.GetTimeUntilEvent(1), 3s);
+    EXPECT_EQ(events.GetTimeUntilEvent(3), 5s);
+
+    events.Update(3000);
+    EXPECT_EQ(ExecuteAll(events), std::vector<uint32>({ 2, 4, 1 }));
+
+    events.CancelEventGroup(1);
+    EXPECT_TRUE(events.Empty());
+    EXPECT_FALSE(events.HasTimeUntilEvent(3));
+}
+
+TEST(EventMapTest, DelayEventsToMaxAndRepeat)
+{
+    EventMap events;
+    events.ScheduleEvent(1, 1s);
+    events.ScheduleEvent(2, 10s);
+    events.DelayEventsToMax(5s, 0);
+
+    EXPECT_EQ(events.GetTimeUntilEvent(1), 5s);
+    EXPECT_EQ(events.GetTimeUntilEvent(2), 10s);
+
+    events.Update(5000);
+    EXPECT_EQ(events.ExecuteEvent(), 1u);
+    events.Repeat(5s);
+
+    events.Update(5000);
+    EXPECT_EQ(ExecuteAll(events), std::vector<uint32>({ 2, 1 }));
+}
+
+TEST(EventMapTest, RescheduleCancelsPrevious)
+{
+    EventMap events;
+    events.ScheduleEvent(1, 1s);
+    events.ScheduleEvent(1, 2s);
+    events.RescheduleEvent(1, 4s);
+
+    EXPECT_EQ(events.GetTimeUntilEvent(1), 4s);
+
+    events.Update(4000);
+    EXPECT_EQ(ExecuteAll(events), std::vector<uint32>({ 1 }));
+}
@@ -0,0 +1,190 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EventProcessor.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+namespace
+{
+    class RecordEvent : public BasicEvent
+    {
+    public:
+        RecordEvent(std::vector<std::pair<uint32, uint64>>& log, uint32 id) : _log(log), _id(id) { }
+
+        bool Execute(uint64 e_time, uint32 /*p_time*/) override
+        {
+            _log.emplace_back(_id, e_time);
+            return true;
+        }
+
+    private:
+        std::vector<std::pair<uint32, uint64>>& _log;
+        uint32 _id;
+    };
+
+    class CountEvent : public BasicEvent
+    {
+    public:
+        CountEvent(uint32& executed, uint32& aborted) : _executed(executed), _aborted(aborted) { }
+
+        bool Execute(uint64 /*e_time*/, uint32 /*p_time*/) override
+        {
+            ++_executed;
+            return true;
+        }
+
+        void Abort(uint64 /*e_time*/) override { ++_aborted; }
+
+    private:
+        uint32& _executed;
+        uint32& _aborted;
+    };
+
+    class PinnedEvent : public BasicEvent
+    {
+    public:
+        bool IsDeletable() const override { return false; }
+    };
+}
+
+TEST(EventProcessorTest, ExecutesInTimeOrder)
+{
+    EventProcessor events;
+    std::vector<std::pair<uint32, uint64>> log;
+
+    // spread over every wheel level and the overflow list
+    std::vector<uint64> const delays = { 20000000, 5, 300000, 70, 0, 4500, 64, 1 };
+    for (uint32 i = 0; i < delays.size(); ++i)
+        events.AddEventAtOffset(new RecordEvent(log, i), Milliseconds(delays[i]));
+
+    for (uint32 i = 0; i < 1000; ++i)
+        events.Update(25000);
+
+    ASSERT_EQ(log.size(), delays.size());
+    EXPECT_FALSE(events.HasEvents());
+
+    uint64 previous = 0;
+    for (auto const& [id, time] : log)
+    {
+        EXPECT_GE(time, delays[id]);
+        EXPECT_GE(delays[id], previous);
+        previous = delays[id];
+    }
+}
+
+TEST(EventProcessorTest, ExecutesAtExactTime)
+{
+    EventProcessor events;
+    std::vector<std::pair<uint32, uint64>> log;
+
+    events.AddEventAtOffset(new RecordEvent(log, 0), 4100ms);
+    events.AddEventAtOffset(new RecordEvent(log, 1), 63ms);
+
+    for (uint32 i = 0; i < 5000; ++i)
+        events.Update(1);
+
+    ASSERT_EQ(log.size(), 2u);
+    EXPECT_EQ(log[0], std::make_pair(1u, uint64(63)));
+    EXPECT_EQ(log[1], std::make_pair(0u, uint64(4100)));
+}
+
+TEST(EventProcessorTest, SameTimeKeepsInsertionOrder)
+{
+    EventProcessor events;
+    std::vector<std::pair<uint32, uint64>> log;
+
+    // same due time, scheduled on different levels, must still run in insertion order
+    events.AddEventAtOffset(new RecordEvent(log, 0), 5000ms);
+    events.Update(4990);
+    events.AddEventAtOffset(new RecordEvent(log, 1), 10ms);
+    events.Update(100);
+
+    ASSERT_EQ(log.size(), 2u);
+    EXPECT_EQ(log[0].first, 0u);
+    EXPECT_EQ(log[1].first, 1u);
+}
+
+TEST(EventProcessorTest, CancelEventGroup)
+{
+    EventProcessor events;
+    uint32 executed = 0, aborted = 0;
+
+    for (uint8 i = 0; i < 10; ++i)
+        events.AddEvent(new CountEvent(executed, aborted), events.CalculateTime(100 * i), true, i % 2);
+
+    events.CancelEventGroup(1);
+    EXPECT_EQ(aborted, 5u);
+
+    events.Update(1000);
+    EXPECT_EQ(executed, 5u);
+    EXPECT_FALSE(events.HasEvents());
+}
+
+TEST(EventProcessorTest, ModifyEventTime)
+{
+    EventProcessor events;
+    std::vector<std::pair<uint32, uint64>> log;
+
+    auto* event = new RecordEvent(log, 0);
+    events.AddEventAtOffset(event, 10min);
+    events.AddEventAtOffset(new RecordEvent(log, 1), 50ms);
+    events.ModifyEventTime(event, 20ms);
+
+    events.Update(30);
+    ASSERT_EQ(log.size(), 1u);
+    EXPECT_EQ(log[0].first, 0u);
+
+    events.Update(30);
+    EXPECT_EQ(log.size(), 2u);
+}
+
+TEST(EventProcessorTest, KillAllEventsKeepsNonDeletable)
+{
+    EventProcessor events;
+    uint32 executed = 0, aborted = 0;
+
+    events.AddEventAtOffset(new CountEvent(executed, aborted), 10ms);
+    events.AddEventAtOffset(new PinnedEvent(), 1h);
+
+    events.KillAllEvents(false);
+    EXPECT_EQ(aborted, 1u);
+    EXPECT_TRUE(events.HasEvents());
+
+    events.KillAllEvents(true);
+    EXPECT_FALSE(events.HasEvents());
+}
+
+TEST(EventProcessorTest, SchedulesAgainAfterRunningEmpty)
+{
+    EventProcessor events;
+    std::vector<std::pair<uint32, uint64>> log;
+
+    events.AddEventAtOffset(new RecordEvent(log, 0), 100ms);
+    events.Update(200);
+    EXPECT_FALSE(events.HasEvents());
+
+    // the wheel was given back, the next event takes one again
+    events.AddEventAtOffset(new RecordEvent(log, 1), 5s);
+    events.Update(4999);
+    EXPECT_EQ(log.size(), 1u);
+
+    events.Update(1);
+    ASSERT_EQ(log.size(), 2u);
+    EXPECT_EQ(log[1], std::make_pair(1u, uint64(5200)));
+}
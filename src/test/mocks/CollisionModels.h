@@ -0,0 +1,84 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AZEROTHCORE_COLLISIONMODELS_H
+#define AZEROTHCORE_COLLISIONMODELS_H
+
+#include "WorldModel.h"
+#include <random>
+#include <vector>
+
+// Groups of random triangles scattered in a 100 yard cube, dense enough for rays to both hit and miss
+inline VMAP::WorldModel BuildModel(uint32 groupCount, uint32 trianglesPerGroup)
+{
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> coord(0.0f, 100.0f);
+    std::uniform_real_distribution<float> edge(-4.0f, 4.0f);
+
+    std::vector<VMAP::GroupModel> groups;
+    for (uint32 g = 0; g < groupCount; ++g)
+    {
+        std::vector<G3D::Vector3> vertices;
+        std::vector<VMAP::MeshTriangle> triangles;
+        G3D::AABox bound = G3D::AABox::empty();
+        for (uint32 i = 0; i < trianglesPerGroup; ++i)
+        {
+            G3D::Vector3 corner(coord(rng), coord(rng), coord(rng));
+            uint32 first = vertices.size();
+            vertices.push_back(corner);
+            vertices.push_back(corner + G3D::Vector3(edge(rng), edge(rng), edge(rng)));
+            vertices.push_back(corner + G3D::Vector3(edge(rng), edge(rng), edge(rng)));
+            triangles.emplace_back(first, first + 1, first + 2);
+            for (uint32 v = first; v < first + 3; ++v)
+                bound.merge(vertices[v]);
+        }
+
+        groups.emplace_back(0, g, bound);
+        groups.back().setMeshData(vertices, triangles);
+    }
+
+    VMAP::WorldModel model;
+    model.Flags = 0;
+    model.setGroupModels(groups);
+    return model;
+}
+
+// Four rays from each origin, like the targets of an area spell, with targets up to spread yards around a random center
+inline std::vector<G3D::Ray> RandomRays(std::size_t count, float spread, std::vector<float>& distances)
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> coord(-10.0f, 110.0f);
+    std::uniform_real_distribution<float> offset(-spread, spread);
+
+    std::vector<G3D::Ray> rays;
+    distances.clear();
+    while (rays.size() < count)
+    {
+        G3D::Vector3 origin(coord(rng), coord(rng), coord(rng));
+        G3D::Vector3 center(coord(rng), coord(rng), coord(rng));
+        for (uint32 lane = 0; lane < RAY_PACKET_SIZE && rays.size() < count; ++lane)
+        {
+            G3D::Vector3 target = center + G3D::Vector3(offset(rng), offset(rng), offset(rng));
+            float distance = (target - origin).magnitude();
+            rays.push_back(G3D::Ray::fromOriginAndDirection(origin, (target - origin) / distance));
+            distances.push_back(distance);
+        }
+    }
+    return rays;
+}
+
+#endif
@@ -0,0 +1,102 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef AZEROTHCORE_SAVEWORKLOAD_H
+#define AZEROTHCORE_SAVEWORKLOAD_H
+
+#include "PCQueue.h"
+#include "PreparedStatement.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+struct WorkloadConnection { };
+
+using WorkloadStatement = PreparedStatement<WorkloadConnection>;
+
+constexpr uint32 STATEMENTS_PER_SAVE = 40;
+
+// Statements of a player save: mostly a few numeric columns, some with short strings
+inline std::vector<PreparedStatementTask*> CreateSave(uint32 save)
+{
+    std::vector<PreparedStatementTask*> tasks;
+    tasks.reserve(STATEMENTS_PER_SAVE);
+
+    for (uint32 i = 0; i < STATEMENTS_PER_SAVE; ++i)
+    {
+        uint8 const parameters = uint8(3 + i % 6);
+        WorkloadStatement* stmt = new WorkloadStatement(i, parameters);
+        stmt->SetData(0, save);
+        stmt->SetData(1, uint64(save) << 32 | i);
+        if (i % 4)
+            stmt->SetData(2, float(i) * 0.5f);
+        else
+            stmt->SetData(2, "spell_cooldown");
+
+        for (uint8 param = 3; param < parameters; ++param)
+            stmt->SetData(param, uint32(param * i));
+
+        tasks.push_back(new PreparedStatementTask(stmt));
+    }
+
+    return tasks;
+}
+
+// Destroys tasks on its own thread, like a database worker
+class SaveWorker
+{
+public:
+    SaveWorker() : _thread([this]() { Run(); }) { }
+
+    ~SaveWorker()
+    {
+        _queue.Shutdown();
+        _thread.join();
+    }
+
+    void Destroy(std::vector<PreparedStatementTask*> const& tasks)
+    {
+        uint64 const target = _destroyed + tasks.size();
+        for (PreparedStatementTask* task : tasks)
+            _queue.Push(task);
+
+        while (_destroyed < target)
+            std::this_thread::yield();
+    }
+
+private:
+    void Run()
+    {
+        for (;;)
+        {
+            PreparedStatementTask* task = nullptr;
+            _queue.WaitAndPop(task);
+            if (!task)
+                return;
+
+            delete task;
+            ++_destroyed;
+        }
+    }
+
+    ProducerConsumerQueue<PreparedStatementTask*> _queue;
+    std::atomic<uint64> _destroyed{0};
+    std::thread _thread;
+};
+
+#endif
@@ -0,0 +1,95 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AZEROTHCORE_TERRAINMAPFILE_H
+#define AZEROTHCORE_TERRAINMAPFILE_H
+
+#include "GridDefines.h"
+#include "GridTerrainData.h"
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Writes a map file with height and holes data, heights follow a bumpy surface
+inline std::string WriteMapFile(std::string const& name, uint32 heightFlags)
+{
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> noise(0.0f, 1.0f);
+
+    auto height = [&](uint32 x, uint32 y) { return 50.0f * std::sin(x * 0.1f) * std::cos(y * 0.07f) + noise(rng) * 5.0f; };
+
+    std::vector<uint8> heights;
+    auto append = [&](uint32 x, uint32 y)
+    {
+        float value = height(x, y);
+        if (heightFlags & MAP_HEIGHT_AS_INT16)
+        {
+            uint16 scaled = uint16((value + 60.0f) / 120.0f * 65535.0f);
+            heights.insert(heights.end(), reinterpret_cast<uint8*>(&scaled), reinterpret_cast<uint8*>(&scaled) + sizeof(scaled));
+        }
+        else
+            heights.insert(heights.end(), reinterpret_cast<uint8*>(&value), reinterpret_cast<uint8*>(&value) + sizeof(value));
+    };
+
+    for (uint32 x = 0; x < 129; ++x)
+        for (uint32 y = 0; y < 129; ++y)
+            append(x * 2, y * 2);
+
+    for (uint32 x = 0; x < 128; ++x)
+        for (uint32 y = 0; y < 128; ++y)
+            append(x * 2 + 1, y * 2 + 1);
+
+    std::vector<uint16> holes(LoadedHoleData::HolesSize);
+    for (std::size_t i = 0; i < holes.size(); i += 7)
+        holes[i] = 0x0421;
+
+    map_heightHeader heightHeader{ MapHeightMagic.asUInt, heightFlags, -60.0f, 60.0f };
+
+    map_fileheader header{};
+    header.mapMagic = MapMagic.asUInt;
+    header.versionMagic = MapVersionMagic;
+    header.heightMapOffset = sizeof(header);
+    header.heightMapSize = uint32(sizeof(heightHeader) + heights.size());
+    header.holesOffset = header.heightMapOffset + header.heightMapSize;
+    header.holesSize = uint32(holes.size() * sizeof(uint16));
+
+    std::string const path = (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    file.write(reinterpret_cast<char const*>(&heightHeader), sizeof(heightHeader));
+    file.write(reinterpret_cast<char const*>(heights.data()), heights.size());
+    file.write(reinterpret_cast<char const*>(holes.data()), header.holesSize);
+    return path;
+}
+
+// Random points in the grid covering [0, SIZE_OF_GRIDS) on both axes
+inline std::vector<G3D::Vector3> RandomPoints(std::size_t count)
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> coord(0.0f, SIZE_OF_GRIDS - 0.01f);
+
+    std::vector<G3D::Vector3> points(count);
+    for (G3D::Vector3& point : points)
+        point = G3D::Vector3(coord(rng), coord(rng), 0.0f);
+
+    return points;
+}
+
+#endif
@@ -0,0 +1,56 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "PreparedStatement.h"
+#include "SaveWorkload.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+namespace
+{
+    // Runs saves by rounds, each round is destroyed by the worker before the next one starts
+    void RunSaves(SaveWorker& worker, uint32 rounds, uint32 savesPerRound)
+    {
+        for (uint32 round = 0; round < rounds; ++round)
+        {
+            std::vector<std::vector<PreparedStatementTask*>> saves(savesPerRound);
+            for (uint32 save = 0; save < savesPerRound; ++save)
+                saves[save] = CreateSave(round * savesPerRound + save);
+
+            for (std::vector<PreparedStatementTask*> const& tasks : saves)
+                worker.Destroy(tasks);
+        }
+    }
+}
+
+TEST(PreparedStatementPoolTest, ReusesStatementsDestroyedOnAnotherThread)
+{
+    SaveWorker worker;
+
+    // the first rounds fill the free lists from the heap
+    RunSaves(worker, 3, 20);
+
+    uint64 const heapStatements = ObjectPool<WorkloadStatement>::GetHeapAllocations();
+    uint64 const heapTasks = ObjectPool<PreparedStatementTask>::GetHeapAllocations();
+
+    RunSaves(worker, 10, 20);
+
+    EXPECT_EQ(ObjectPool<WorkloadStatement>::GetHeapAllocations(), heapStatements);
+    EXPECT_EQ(ObjectPool<PreparedStatementTask>::GetHeapAllocations(), heapTasks);
+}
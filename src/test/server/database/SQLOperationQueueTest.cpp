@@ -0,0 +1,100 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SQLOperation.h"
+#include "SQLOperationQueue.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace
+{
+    class NoopOperation : public SQLOperation
+    {
+    public:
+        bool Execute() override { return true; }
+    };
+
+    constexpr SQLOperationQueue::LaneMask ALL_LANES = 0x7;
+}
+
+TEST(SQLOperationQueueTest, TakesHigherPriorityLanesFirst)
+{
+    SQLOperationQueue queue;
+    queue.SetWorkerLanes(0, 0, 0ms);
+
+    NoopOperation bulk, background, interactive;
+    queue.Push(&bulk, DatabaseLane::Bulk);
+    queue.Push(&background, DatabaseLane::Background);
+    queue.Push(&interactive, DatabaseLane::Interactive);
+
+    EXPECT_EQ(queue.WaitAndPop(ALL_LANES), &interactive);
+    EXPECT_EQ(queue.WaitAndPop(ALL_LANES), &background);
+    EXPECT_EQ(queue.WaitAndPop(ALL_LANES), &bulk);
+}
+
+TEST(SQLOperationQueueTest, OverdueOperationsGoBeforeHigherPriorityLanes)
+{
+    SQLOperationQueue queue;
+    queue.SetWorkerLanes(0, 0, 10ms);
+
+    NoopOperation bulk, interactive, newerInteractive;
+    queue.Push(&bulk, DatabaseLane::Bulk);
+    std::this_thread::sleep_for(20ms);
+    queue.Push(&interactive, DatabaseLane::Interactive);
+    queue.Push(&newerInteractive, DatabaseLane::Interactive);
+
+    EXPECT_EQ(queue.WaitAndPop(ALL_LANES), &bulk);
+    EXPECT_EQ(queue.WaitAndPop(ALL_LANES), &interactive);
+    EXPECT_EQ(queue.WaitAndPop(ALL_LANES), &newerInteractive);
+}
+
+// The interactive worker waiting too must not take the wakeup of the bulk operation
+TEST(SQLOperationQueueTest, WakesAWorkerServingTheLane)
+{
+    SQLOperationQueue queue;
+    queue.SetWorkerLanes(1, 0);
+
+    std::atomic<SQLOperation*> taken[2] = { nullptr, nullptr };
+    std::thread workers[2];
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        SQLOperationQueue::LaneMask const lanes = queue.AssignWorkerLanes();
+        workers[i] = std::thread([&queue, &taken, i, lanes]()
+        {
+            while (SQLOperation* operation = queue.WaitAndPop(lanes))
+                taken[i] = operation;
+        });
+    }
+
+    // let both workers wait
+    std::this_thread::sleep_for(50ms);
+
+    NoopOperation bulk;
+    queue.Push(&bulk, DatabaseLane::Bulk);
+    for (uint32 i = 0; i < 500 && !taken[1]; ++i)
+        std::this_thread::sleep_for(10ms);
+
+    EXPECT_EQ(taken[1], &bulk);
+    EXPECT_EQ(taken[0], nullptr);
+
+    queue.Shutdown();
+    for (std::thread& worker : workers)
+        worker.join();
+}
@@ -0,0 +1,125 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "UpdateData.h"
+#include "UpdateFieldFlags.h"
+#include "WorldPacket.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+    ByteBuffer MakeBlock(uint8 value)
+    {
+        ByteBuffer block(8);
+        block << uint8(UPDATETYPE_VALUES) << value;
+        return block;
+    }
+}
+
+TEST(UpdateBlockCacheTest, ReturnsBlocksOfTheSameFlags)
+{
+    UpdateBlockCache cache;
+    EXPECT_FALSE(cache.Find(UF_FLAG_PUBLIC, ItemUpdateFieldFlags));
+
+    std::shared_ptr<ByteBuffer const> stored = cache.Store(MakeBlock(1), UF_FLAG_PUBLIC, ItemUpdateFieldFlags).Data;
+    ASSERT_TRUE(cache.Find(UF_FLAG_PUBLIC, ItemUpdateFieldFlags));
+    EXPECT_EQ(cache.Find(UF_FLAG_PUBLIC, ItemUpdateFieldFlags)->Data, stored);
+    EXPECT_EQ(stored->read<uint8>(1), 1);
+}
+
+TEST(UpdateBlockCacheTest, SeparatesVisibilityAndFieldFlags)
+{
+    UpdateBlockCache cache;
+    cache.Store(MakeBlock(1), UF_FLAG_PUBLIC, ItemUpdateFieldFlags);
+
+    // the owner sees more fields, other types have other fields
+    EXPECT_FALSE(cache.Find(UF_FLAG_PUBLIC | UF_FLAG_OWNER | UF_FLAG_ITEM_OWNER, ItemUpdateFieldFlags));
+    EXPECT_FALSE(cache.Find(UF_FLAG_PUBLIC, DynamicObjectUpdateFieldFlags));
+
+    std::shared_ptr<ByteBuffer const> owner = cache.Store(MakeBlock(2), UF_FLAG_PUBLIC | UF_FLAG_OWNER | UF_FLAG_ITEM_OWNER, ItemUpdateFieldFlags).Data;
+    EXPECT_EQ(cache.Find(UF_FLAG_PUBLIC | UF_FLAG_OWNER | UF_FLAG_ITEM_OWNER, ItemUpdateFieldFlags)->Data, owner);
+    EXPECT_NE(cache.Find(UF_FLAG_PUBLIC, ItemUpdateFieldFlags)->Data, owner);
+}
+
+TEST(UpdateBlockCacheTest, ClearDropsBlocks)
+{
+    UpdateBlockCache cache;
+    std::shared_ptr<ByteBuffer const> stored = cache.Store(MakeBlock(1), UF_FLAG_PUBLIC, ItemUpdateFieldFlags).Data;
+
+    cache.Clear();
+    EXPECT_FALSE(cache.Find(UF_FLAG_PUBLIC, ItemUpdateFieldFlags));
+
+    // blocks already added to update data stay valid
+    EXPECT_EQ(stored->read<uint8>(1), 1);
+}
+
+TEST(UpdateBlockCacheTest, SharedBlocksKeepTheirPositionInThePacket)
+{
+    UpdateBlockCache cache;
+    std::shared_ptr<ByteBuffer const> shared = cache.Store(MakeBlock(2), UF_FLAG_PUBLIC, ItemUpdateFieldFlags).Data;
+
+    UpdateData data;
+    data.AddUpdateBlock(MakeBlock(1));
+    data.AddSharedUpdateBlock(shared);
+    data.AddUpdateBlock(MakeBlock(3));
+
+    UpdateData other;
+    other.AddSharedUpdateBlock(shared);
+    data.AddUpdateBlock(other);
+
+    WorldPacket packet;
+    ASSERT_TRUE(data.BuildPacket(packet));
+    ASSERT_EQ(packet.size(), 4u + 4 * 2);
+    EXPECT_EQ(packet.read<uint32>(0), 4u);
+    EXPECT_EQ(packet.read<uint8>(5), 1);
+    EXPECT_EQ(packet.read<uint8>(7), 2);
+    EXPECT_EQ(packet.read<uint8>(9), 3);
+    EXPECT_EQ(packet.read<uint8>(11), 2);
+}
+
+TEST(UpdateBlockCacheTest, PatchesObserverFieldsOfSharedBlocks)
+{
+    ByteBuffer buf(16);
+    buf << uint8(UPDATETYPE_VALUES) << uint32(0x10) << uint32(0x20);
+
+    // the fields at 1 and 5 depend on the observer
+    UpdateBlockCache cache;
+    UpdateBlockCache::Block const& block = cache.Store(std::move(buf), UF_FLAG_PUBLIC, UnitUpdateFieldFlags, { { 1, 10 }, { 5, 20 } });
+
+    // values equal to the shared ones are not patched
+    std::vector<UpdateFieldPatch> patches = block.BuildPatches([](uint16 index) { return index == 10 ? 0x10u : 0x21u; });
+    ASSERT_EQ(patches.size(), 1u);
+    EXPECT_EQ(patches[0].Offset, 5u);
+    EXPECT_EQ(patches[0].Value, 0x21u);
+
+    UpdateData patched;
+    patched.AddSharedUpdateBlock(block.Data, std::move(patches));
+
+    UpdateData unpatched;
+    unpatched.AddSharedUpdateBlock(block.Data, block.BuildPatches([](uint16 index) { return index == 10 ? 0x10u : 0x20u; }));
+
+    WorldPacket patchedPacket;
+    ASSERT_TRUE(patched.BuildPacket(patchedPacket));
+    EXPECT_EQ(patchedPacket.read<uint32>(4 + 1), 0x10u);
+    EXPECT_EQ(patchedPacket.read<uint32>(4 + 5), 0x21u);
+
+    // the other observers keep the shared values
+    WorldPacket unpatchedPacket;
+    ASSERT_TRUE(unpatched.BuildPacket(unpatchedPacket));
+    EXPECT_EQ(unpatchedPacket.read<uint32>(4 + 5), 0x20u);
+    EXPECT_EQ(block.Data->read<uint32>(5), 0x20u);
+}
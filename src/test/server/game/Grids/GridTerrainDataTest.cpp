@@ -0,0 +1,65 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GridDefines.h"
+#include "GridTerrainData.h"
+#include "TerrainMapFile.h"
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+namespace
+{
+    void CheckSameAsScalar(uint32 heightFlags, char const* label)
+    {
+        std::string const path = WriteMapFile(std::string("grid_terrain_test_") + label + ".map", heightFlags);
+
+        GridTerrainData terrain;
+        ASSERT_EQ(terrain.Load(path), TerrainMapDataReadResult::Success);
+
+        // odd count to also go through the scalar remainder
+        std::vector<G3D::Vector3> const points = RandomPoints(100003);
+        std::vector<float> heights(points.size());
+        terrain.getHeights(points.data(), heights.data(), points.size());
+
+        std::size_t holes = 0;
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            float const expected = terrain.getHeight(points[i].x, points[i].y);
+            ASSERT_EQ(std::memcmp(&expected, &heights[i], sizeof(float)), 0) << "point " << i << ": expected " << expected << ", got " << heights[i];
+
+            if (expected == INVALID_HEIGHT)
+                ++holes;
+        }
+
+        EXPECT_GT(holes, 0u);
+
+        std::filesystem::remove(path);
+    }
+}
+
+TEST(GridTerrainDataTest, BatchHeightsMatchFloatHeights)
+{
+    CheckSameAsScalar(0, "float");
+}
+
+TEST(GridTerrainDataTest, BatchHeightsMatchUint16Heights)
+{
+    CheckSameAsScalar(MAP_HEIGHT_AS_INT16, "uint16");
+}
@@ -0,0 +1,62 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "LineOfSightCache.h"
+#include "gtest/gtest.h"
+
+TEST(LineOfSightCacheTest, ReturnsStoredResultsUntilInvalidated)
+{
+    LineOfSightCache cache;
+    LineOfSightCache::Key const blocked = LineOfSightCache::MakeKey(10.0f, 20.0f, 30.0f, 40.0f, 50.0f, 60.0f, 1, 0);
+    LineOfSightCache::Key const clear = LineOfSightCache::MakeKey(-10.0f, 20.0f, 30.0f, 40.0f, 50.0f, 60.0f, 1, 0);
+
+    EXPECT_FALSE(cache.Get(blocked));
+
+    cache.Set(blocked, false);
+    cache.Set(clear, true);
+    EXPECT_EQ(cache.Get(blocked), false);
+    EXPECT_EQ(cache.Get(clear), true);
+
+    cache.Invalidate();
+    EXPECT_FALSE(cache.Get(blocked));
+    EXPECT_FALSE(cache.Get(clear));
+
+    LineOfSightCacheStats stats = LineOfSightCache::ConsumeStats();
+    EXPECT_EQ(stats.Hits, 2u);
+    EXPECT_EQ(stats.Misses, 1u);
+}
+
+TEST(LineOfSightCacheTest, KeysAreQuantized)
+{
+    LineOfSightCache cache;
+    cache.Set(LineOfSightCache::MakeKey(10.01f, 20.0f, 30.0f, 40.0f, 50.0f, 60.0f, 1, 0), false);
+
+    // same 1/8 yard cell
+    EXPECT_EQ(cache.Get(LineOfSightCache::MakeKey(10.1f, 20.0f, 30.0f, 40.0f, 50.0f, 60.0f, 1, 0)), false);
+
+    // next cell, other phase and other flags
+    EXPECT_FALSE(cache.Get(LineOfSightCache::MakeKey(10.13f, 20.0f, 30.0f, 40.0f, 50.0f, 60.0f, 1, 0)));
+    EXPECT_FALSE(cache.Get(LineOfSightCache::MakeKey(10.01f, 20.0f, 30.0f, 40.0f, 50.0f, 60.0f, 2, 0)));
+    EXPECT_FALSE(cache.Get(LineOfSightCache::MakeKey(10.01f, 20.0f, 30.0f, 40.0f, 50.0f, 60.0f, 1, 1)));
+
+    // endpoints are not interchangeable
+    EXPECT_FALSE(cache.Get(LineOfSightCache::MakeKey(40.0f, 50.0f, 60.0f, 10.01f, 20.0f, 30.0f, 1, 0)));
+
+    cache.Invalidate();
+    LineOfSightCache::ConsumeStats();
+}
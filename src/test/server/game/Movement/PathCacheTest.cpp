@@ -0,0 +1,139 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PathCache.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+    PathCache::Key MakeKey(float x, uint32 mapId = 571)
+    {
+        return PathCache::MakeKey(mapId, 0, G3D::Vector3(x, 20.0f, 30.0f), G3D::Vector3(40.0f, 50.0f, 60.0f), 1, 0, 2.0f, 0.5f, 0.0f);
+    }
+
+    PathCache::Result MakeResult(float x)
+    {
+        auto points = std::make_shared<Movement::PointsArray>();
+        points->emplace_back(x, 20.0f, 30.0f);
+        points->emplace_back(40.0f, 50.0f, 60.0f);
+        return { points, points->back() };
+    }
+}
+
+TEST(PathCacheTest, DropsLeastRecentlyUsedPaths)
+{
+    PathCache cache(2);
+    PathCache::Result result;
+
+    cache.Store(MakeKey(1.0f), MakeResult(1.0f), { PathCache::MakeTileId(31, 31) });
+    cache.Store(MakeKey(2.0f), MakeResult(2.0f), { PathCache::MakeTileId(31, 31) });
+
+    // the first path becomes the most recently used one
+    ASSERT_TRUE(cache.Get(MakeKey(1.0f), result));
+    EXPECT_EQ(result.Points->front().x, 1.0f);
+
+    cache.Store(MakeKey(3.0f), MakeResult(3.0f), { PathCache::MakeTileId(31, 31) });
+    EXPECT_TRUE(cache.Get(MakeKey(1.0f), result));
+    EXPECT_FALSE(cache.Get(MakeKey(2.0f), result));
+    EXPECT_TRUE(cache.Get(MakeKey(3.0f), result));
+
+    cache.SetCapacity(1);
+    EXPECT_FALSE(cache.Get(MakeKey(1.0f), result));
+    EXPECT_TRUE(cache.Get(MakeKey(3.0f), result));
+
+    PathCacheStats stats = cache.GetStats();
+    EXPECT_EQ(stats.Hits, 4u);
+    EXPECT_EQ(stats.Misses, 2u);
+    EXPECT_EQ(stats.Entries, 1u);
+    EXPECT_EQ(stats.Capacity, 1u);
+}
+
+TEST(PathCacheTest, KeysAreQuantized)
+{
+    PathCache cache(16);
+    PathCache::Result result;
+    cache.Store(MakeKey(10.1f), MakeResult(10.1f), {});
+
+    // same half yard cell
+    EXPECT_TRUE(cache.Get(MakeKey(10.4f), result));
+
+    // next cell and other map
+    EXPECT_FALSE(cache.Get(MakeKey(10.6f), result));
+    EXPECT_FALSE(cache.Get(MakeKey(10.1f, 530), result));
+
+    // other unit sizes and path options
+    PathCache::Key const taller = PathCache::MakeKey(571, 0, G3D::Vector3(10.1f, 20.0f, 30.0f), G3D::Vector3(40.0f, 50.0f, 60.0f), 1, 0, 4.0f, 0.5f, 0.0f);
+    PathCache::Key const flags = PathCache::MakeKey(571, 0, G3D::Vector3(10.1f, 20.0f, 30.0f), G3D::Vector3(40.0f, 50.0f, 60.0f), 1, 1, 2.0f, 0.5f, 0.0f);
+    EXPECT_FALSE(cache.Get(taller, result));
+    EXPECT_FALSE(cache.Get(flags, result));
+}
+
+TEST(PathCacheTest, DropsPathsCrossingUnloadedTiles)
+{
+    PathCache cache(16);
+    PathCache::Result result;
+
+    cache.Store(MakeKey(1.0f), MakeResult(1.0f), { PathCache::MakeTileId(31, 31), PathCache::MakeTileId(32, 31) });
+    cache.Store(MakeKey(2.0f), MakeResult(2.0f), { PathCache::MakeTileId(31, 31) });
+    cache.Store(MakeKey(1.0f, 530), MakeResult(1.0f), { PathCache::MakeTileId(32, 31) });
+
+    cache.InvalidateTile(571, 32, 31);
+    EXPECT_FALSE(cache.Get(MakeKey(1.0f), result));
+    EXPECT_TRUE(cache.Get(MakeKey(2.0f), result));
+    EXPECT_TRUE(cache.Get(MakeKey(1.0f, 530), result));
+
+    PathCacheStats stats = cache.GetStats();
+    EXPECT_EQ(stats.Invalidations, 1u);
+    EXPECT_EQ(stats.Entries, 2u);
+}
+
+TEST(PathCacheTest, TracksTheTilesOfReplacedAndDroppedPaths)
+{
+    PathCache cache(2);
+    PathCache::Result result;
+
+    // built again across another tile
+    cache.Store(MakeKey(1.0f), MakeResult(1.0f), { PathCache::MakeTileId(31, 31) });
+    cache.Store(MakeKey(1.0f), MakeResult(1.0f), { PathCache::MakeTileId(32, 32) });
+    cache.InvalidateTile(571, 31, 31);
+    EXPECT_TRUE(cache.Get(MakeKey(1.0f), result));
+    cache.InvalidateTile(571, 32, 32);
+    EXPECT_FALSE(cache.Get(MakeKey(1.0f), result));
+
+    // a path dropped as least recently used is not invalidated again
+    cache.Store(MakeKey(1.0f), MakeResult(1.0f), { PathCache::MakeTileId(31, 31) });
+    cache.Store(MakeKey(2.0f), MakeResult(2.0f), { PathCache::MakeTileId(31, 31) });
+    cache.Store(MakeKey(3.0f), MakeResult(3.0f), { PathCache::MakeTileId(32, 32) });
+    cache.InvalidateTile(571, 31, 31);
+    EXPECT_FALSE(cache.Get(MakeKey(2.0f), result));
+    EXPECT_TRUE(cache.Get(MakeKey(3.0f), result));
+
+    PathCacheStats stats = cache.GetStats();
+    EXPECT_EQ(stats.Invalidations, 2u);
+    EXPECT_EQ(stats.Entries, 1u);
+}
+
+TEST(PathCacheTest, DisabledCacheStoresNothing)
+{
+    PathCache cache;
+    PathCache::Result result;
+    EXPECT_FALSE(cache.IsEnabled());
+
+    cache.Store(MakeKey(1.0f), MakeResult(1.0f), {});
+    EXPECT_FALSE(cache.Get(MakeKey(1.0f), result));
+    EXPECT_EQ(cache.GetStats().Entries, 0u);
+}
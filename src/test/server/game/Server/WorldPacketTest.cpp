@@ -0,0 +1,126 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MessageBuffer.h"
+#include "PCQueue.h"
+#include "WorldPacket.h"
+#include "gtest/gtest.h"
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Deletes the received packets on its own thread, like the session updates
+    class SessionWorker
+    {
+    public:
+        SessionWorker() : _thread([this]() { Run(); }) { }
+
+        ~SessionWorker()
+        {
+            _queue.Shutdown();
+            _thread.join();
+        }
+
+        void Process(WorldPacket* packet)
+        {
+            ++_queued;
+            _queue.Push(packet);
+        }
+
+        void Wait()
+        {
+            while (_processed < _queued)
+                std::this_thread::yield();
+        }
+
+    private:
+        void Run()
+        {
+            for (;;)
+            {
+                WorldPacket* packet = nullptr;
+                _queue.WaitAndPop(packet);
+                if (!packet)
+                    return;
+
+                delete packet;
+                ++_processed;
+            }
+        }
+
+        ProducerConsumerQueue<WorldPacket*> _queue;
+        std::atomic<uint64> _queued{0};
+        std::atomic<uint64> _processed{0};
+        std::thread _thread;
+    };
+
+    // one size in each class of the BufferPool
+    constexpr std::array<std::size_t, 3> PACKET_SIZES = { 20, 150, 600 };
+
+    // Receives packets like WorldSocket::ReadDataHandler, each round is processed before the next one starts.
+    // Rounds of whole batches of each size leave the same number of free buffers to each thread after every round.
+    void ReceivePackets(SessionWorker& worker, uint32 rounds, uint32 batchesPerRound)
+    {
+        uint32 const packetsPerRound = batchesPerRound * BufferPool::BATCH_SIZE * PACKET_SIZES.size();
+        for (uint32 round = 0; round < rounds; ++round)
+        {
+            std::vector<WorldPacket*> packets;
+            for (uint32 i = 0; i < packetsPerRound; ++i)
+            {
+                WorldPacket packet(CMSG_MESSAGECHAT, MessageBuffer(BufferPool::Acquire(PACKET_SIZES[i % PACKET_SIZES.size()] + i % 16)));
+                packets.push_back(new WorldPacket(std::move(packet)));
+            }
+
+            for (WorldPacket* packet : packets)
+                worker.Process(packet);
+
+            worker.Wait();
+        }
+    }
+}
+
+TEST(WorldPacketTest, ReceivedPacketsReuseTheirStorage)
+{
+    SessionWorker worker;
+
+    // the first rounds fill the free lists from the heap
+    ReceivePackets(worker, 3, 4);
+
+    uint64 const heapBuffers = BufferPool::GetHeapAllocations();
+    uint64 const heapPackets = ObjectPool<WorldPacket>::GetHeapAllocations();
+
+    ReceivePackets(worker, 10, 4);
+
+    EXPECT_EQ(BufferPool::GetHeapAllocations(), heapBuffers);
+    EXPECT_EQ(ObjectPool<WorldPacket>::GetHeapAllocations(), heapPackets);
+}
+
+TEST(WorldPacketTest, SentPacketsKeepTheirStorage)
+{
+    uint64 const heapBuffers = BufferPool::GetHeapAllocations();
+
+    WorldPacket packet(SMSG_MESSAGECHAT, 100);
+    packet << uint32(1);
+
+    WorldPacket moved(std::move(packet));
+    EXPECT_EQ(moved.size(), sizeof(uint32));
+    EXPECT_EQ(BufferPool::GetHeapAllocations(), heapBuffers);
+}
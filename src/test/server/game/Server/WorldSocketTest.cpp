@@ -0,0 +1,153 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OpenSSLCrypto.h"
+#include "Opcodes.h"
+#include "WorldPacket.h"
+#include "WorldSocket.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    // Server side of a loopback connection, the test reads what WorldSocket::Update writes on the client side
+    class WorldSocketSendTest : public ::testing::Test
+    {
+    protected:
+        // the packet crypt of WorldSocket needs the legacy provider for RC4
+        static void SetUpTestSuite() { OpenSSLCrypto::threadsSetup(); }
+        static void TearDownTestSuite() { OpenSSLCrypto::threadsCleanup(); }
+
+        void SetUp() override
+        {
+            tcp::acceptor acceptor(_context, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+            _client.connect(acceptor.local_endpoint());
+
+            tcp::socket server = acceptor.accept();
+            server.non_blocking(true);
+            _socket = std::make_shared<WorldSocket>(std::move(server));
+        }
+
+        void TearDown() override
+        {
+            _socket->CloseSocket();
+            _socket.reset();
+        }
+
+        // Payload bytes are numbered over the whole connection to check their order on the other side
+        void Send(OpcodeServer opcode, std::size_t size)
+        {
+            WorldPacket packet(opcode, size);
+            for (std::size_t i = 0; i < size; ++i)
+                packet << uint8(_sentBytes++);
+
+            _sent.push_back({ uint16(opcode), size });
+            _socket->SendPacket(packet);
+        }
+
+        // Updates the socket until every sent packet was received, or gives up after a few seconds
+        void ReceiveAll()
+        {
+            std::size_t expected = 0;
+            for (SentPacket const& packet : _sent)
+                expected += 4 + packet.Size;
+
+            auto const deadline = std::chrono::steady_clock::now() + 5s;
+            while (_received.size() < expected && std::chrono::steady_clock::now() < deadline)
+            {
+                _socket->Update();
+                _context.poll();
+
+                if (std::size_t available = _client.available())
+                {
+                    std::size_t const offset = _received.size();
+                    _received.resize(offset + available);
+                    _received.resize(offset + _client.read_some(boost::asio::buffer(_received.data() + offset, available)));
+                }
+            }
+
+            ASSERT_EQ(_received.size(), expected);
+        }
+
+        // Parses the received stream, unencrypted headers as no session was authenticated
+        void CheckReceived() const
+        {
+            std::size_t offset = 0;
+            uint8 payloadByte = 0;
+            for (SentPacket const& packet : _sent)
+            {
+                uint16 const size = uint16(_received[offset] << 8 | _received[offset + 1]);
+                uint16 const opcode = uint16(_received[offset + 2] | _received[offset + 3] << 8);
+                offset += 4;
+
+                EXPECT_EQ(size, packet.Size + 2);
+                EXPECT_EQ(opcode, packet.Opcode);
+
+                for (std::size_t i = 0; i < packet.Size; ++i)
+                    ASSERT_EQ(_received[offset + i], payloadByte++) << "opcode " << packet.Opcode << ", byte " << i;
+
+                offset += packet.Size;
+            }
+        }
+
+        struct SentPacket
+        {
+            uint16 Opcode;
+            std::size_t Size;
+        };
+
+        boost::asio::io_context _context;
+        tcp::socket _client{ _context };
+        std::shared_ptr<WorldSocket> _socket;
+        std::vector<SentPacket> _sent;
+        std::vector<uint8> _received;
+        uint8 _sentBytes = 0;
+    };
+}
+
+TEST_F(WorldSocketSendTest, CopiedAndGatheredPacketsKeepTheirOrder)
+{
+    // small packets are copied into send buffers, the others are sent from their storage between them
+    std::size_t const sizes[] = { 12, 40, 0, 1800, 96, 20, 6000, 64, 30, WorldSocket::MIN_GATHERED_PACKET_SIZE, 8 };
+    OpcodeServer const opcodes[] = { SMSG_MONSTER_MOVE, SMSG_MESSAGECHAT, SMSG_MOTD, SMSG_INITIAL_SPELLS, SMSG_CHAR_ENUM };
+
+    for (uint32 update = 0; update < 20; ++update)
+    {
+        for (std::size_t i = 0; i < std::size(sizes); ++i)
+            Send(opcodes[(update + i) % std::size(opcodes)], sizes[i]);
+
+        _socket->Update();
+    }
+
+    ReceiveAll();
+    CheckReceived();
+}
+
+TEST_F(WorldSocketSendTest, PacketsLargerThanTheSendBufferAreNotCopied)
+{
+    _socket->SetSendBufferSize(64);
+
+    // below MIN_GATHERED_PACKET_SIZE but larger than the send buffer
+    for (std::size_t size : { 10, 200, 30, 300, 59, 60, 61 })
+        Send(SMSG_MESSAGECHAT, size);
+
+    ReceiveAll();
+    CheckReceived();
+}
@@ -0,0 +1,167 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LoadGraph.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct TestStep
+    {
+        std::vector<LoadStore> Reads;
+        std::vector<LoadStore> Writes;
+
+        bool Touches(std::vector<LoadStore> const& stores, LoadStore store) const
+        {
+            return std::find(stores.begin(), stores.end(), store) != stores.end();
+        }
+
+        // written out again rather than taken from LoadGraph, a step without stores is a barrier
+        bool ConflictsWith(TestStep const& other) const
+        {
+            if ((Reads.empty() && Writes.empty()) || (other.Reads.empty() && other.Writes.empty()))
+                return true;
+
+            for (LoadStore store : Writes)
+                if (Touches(other.Reads, store) || Touches(other.Writes, store))
+                    return true;
+
+            for (LoadStore store : Reads)
+                if (Touches(other.Writes, store))
+                    return true;
+
+            return false;
+        }
+    };
+
+    // like the template, quest and npc flag loads of World::SetInitialWorldSettings
+    std::vector<TestStep> const STEPS =
+    {
+        { { LoadStore::SpellInfos }, { LoadStore::CreatureTemplates } },
+        { { LoadStore::SpellInfos }, { LoadStore::ItemTemplates } },
+        { { LoadStore::CreatureTemplates }, { LoadStore::Creatures } },
+        { { LoadStore::ItemTemplates }, { LoadStore::Quests } },
+        { { LoadStore::SpellInfos }, { LoadStore::CreatureTemplates, LoadStore::SpellClick } },
+        { { LoadStore::CreatureTemplates, LoadStore::SpellInfos }, { LoadStore::Trainers } },
+        { { LoadStore::CreatureTemplates, LoadStore::ItemTemplates }, { LoadStore::Vendors } },
+        { { LoadStore::Quests }, { LoadStore::QuestRelations, LoadStore::CreatureTemplates } },
+        { { }, { } },
+        { { LoadStore::Creatures }, { LoadStore::CreatureAddons } },
+        { { LoadStore::Quests }, { LoadStore::QuestPOI } },
+        { { LoadStore::SpellInfos }, { LoadStore::SpellData } },
+        { { LoadStore::SpellData, LoadStore::Creatures }, { LoadStore::SmartScripts } },
+    };
+
+    LoadGraph::Step& AddTestStep(LoadGraph& graph, TestStep const& step, std::function<void()> task)
+    {
+        LoadGraph::Step& added = graph.AddStep("test step", std::move(task)).Quiet();
+        for (LoadStore store : step.Reads)
+            added.Reads({ store });
+
+        for (LoadStore store : step.Writes)
+            added.Writes({ store });
+
+        return added;
+    }
+}
+
+TEST(LoadGraphTest, OrdersConflictingSteps)
+{
+    for (uint32 threads : { 1u, 4u })
+    {
+        std::atomic<uint32> clock{0};
+        std::vector<uint32> started(STEPS.size());
+        std::vector<uint32> finished(STEPS.size());
+
+        LoadGraph graph;
+        for (std::size_t i = 0; i < STEPS.size(); ++i)
+        {
+            AddTestStep(graph, STEPS[i], [&, i]()
+            {
+                started[i] = ++clock;
+                // long enough for the other threads to start whatever they may run meanwhile
+                std::this_thread::sleep_for(2ms);
+                finished[i] = ++clock;
+            });
+        }
+
+        graph.Run(threads);
+
+        for (std::size_t i = 0; i < STEPS.size(); ++i)
+        {
+            ASSERT_NE(finished[i], 0u) << "step " << i << " did not run";
+            for (std::size_t j = 0; j < i; ++j)
+            {
+                if (!STEPS[j].ConflictsWith(STEPS[i]))
+                    continue;
+
+                EXPECT_LT(finished[j], started[i]) << "step " << i << " overlapped step " << j << " with " << threads << " threads";
+            }
+        }
+    }
+}
+
+TEST(LoadGraphTest, RunsIndependentStepsConcurrently)
+{
+    std::atomic<uint32> running{0};
+    std::atomic<uint32> maxRunning{0};
+
+    LoadGraph graph;
+    for (LoadStore store : { LoadStore::LootCreature, LoadStore::LootFishing, LoadStore::LootGameobject, LoadStore::LootItem })
+    {
+        graph.AddStep("loot", [&]()
+        {
+            uint32 const now = ++running;
+            uint32 previous = maxRunning;
+            while (previous < now && !maxRunning.compare_exchange_weak(previous, now))
+                ;
+
+            std::this_thread::sleep_for(20ms);
+            --running;
+        }).Reads({ LoadStore::ItemTemplates }).Writes({ store }).Quiet();
+    }
+
+    graph.Run(4);
+
+    EXPECT_GT(maxRunning.load(), 1u);
+}
+
+TEST(LoadGraphTest, RethrowsStepExceptions)
+{
+    for (uint32 threads : { 1u, 4u })
+    {
+        std::atomic<bool> dependentRan{false};
+
+        LoadGraph graph;
+        graph.AddStep("throws", []() { throw std::runtime_error("broken table"); })
+            .Writes({ LoadStore::CreatureTemplates }).Quiet();
+        graph.AddStep("independent", []() { })
+            .Writes({ LoadStore::ItemTemplates }).Quiet();
+        graph.AddStep("dependent", [&]() { dependentRan = true; })
+            .Reads({ LoadStore::CreatureTemplates }).Writes({ LoadStore::Creatures }).Quiet();
+
+        EXPECT_THROW(graph.Run(threads), std::runtime_error);
+        EXPECT_FALSE(dependentRan) << threads << " threads";
+    }
+}
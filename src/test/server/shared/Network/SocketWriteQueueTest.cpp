@@ -0,0 +1,115 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ByteBuffer.h"
+#include "Socket.h"
+#include "gtest/gtest.h"
+
+#include <boost/container/static_vector.hpp>
+#include <memory>
+
+namespace
+{
+    using Buffers = boost::container::static_vector<boost::asio::const_buffer, 4>;
+
+    std::unique_ptr<ByteBuffer> MakePayload(std::size_t size)
+    {
+        auto payload = std::make_unique<ByteBuffer>(size);
+        for (std::size_t i = 0; i < size; ++i)
+            *payload << uint8(i);
+
+        return payload;
+    }
+}
+
+TEST(SocketWriteQueueTest, BufferEntryIsSentOnceConsumed)
+{
+    MessageBuffer buffer(16);
+    uint8 const bytes[] = { 1, 2, 3, 4, 5, 6 };
+    buffer.Write(bytes, sizeof(bytes));
+
+    SocketWriteEntry entry(std::move(buffer));
+    EXPECT_FALSE(entry.HasPayload());
+
+    Buffers buffers;
+    ASSERT_TRUE(entry.AppendTo(buffers));
+    ASSERT_EQ(buffers.size(), 1u);
+    EXPECT_EQ(buffers[0].size(), sizeof(bytes));
+
+    EXPECT_EQ(entry.Consume(4), 0u);
+    EXPECT_FALSE(entry.IsSent());
+
+    // the next write starts after the sent bytes, bytes of following entries are returned
+    buffers.clear();
+    ASSERT_TRUE(entry.AppendTo(buffers));
+    EXPECT_EQ(buffers[0].size(), 2u);
+    EXPECT_EQ(*static_cast<uint8 const*>(buffers[0].data()), 5);
+
+    EXPECT_EQ(entry.Consume(10), 8u);
+    EXPECT_TRUE(entry.IsSent());
+}
+
+TEST(SocketWriteQueueTest, PayloadEntryIsSentFromItsStorage)
+{
+    uint8 const header[] = { 0xA0, 0xA1, 0xA2, 0xA3 };
+    std::unique_ptr<ByteBuffer> payload = MakePayload(600);
+    uint8 const* storage = payload->contents();
+
+    SocketWriteEntry entry(header, sizeof(header), std::move(payload));
+    EXPECT_TRUE(entry.HasPayload());
+
+    Buffers buffers;
+    ASSERT_TRUE(entry.AppendTo(buffers));
+    ASSERT_EQ(buffers.size(), 2u);
+    EXPECT_EQ(buffers[0].size(), sizeof(header));
+    EXPECT_EQ(buffers[1].data(), storage);
+    EXPECT_EQ(buffers[1].size(), 600u);
+
+    // a write stopping inside the header
+    EXPECT_EQ(entry.Consume(3), 0u);
+    buffers.clear();
+    ASSERT_TRUE(entry.AppendTo(buffers));
+    ASSERT_EQ(buffers.size(), 2u);
+    EXPECT_EQ(buffers[0].size(), 1u);
+    EXPECT_EQ(*static_cast<uint8 const*>(buffers[0].data()), 0xA3);
+
+    // then inside the payload, the header is not written again
+    EXPECT_EQ(entry.Consume(101), 0u);
+    buffers.clear();
+    ASSERT_TRUE(entry.AppendTo(buffers));
+    ASSERT_EQ(buffers.size(), 1u);
+    EXPECT_EQ(buffers[0].data(), storage + 100);
+    EXPECT_EQ(buffers[0].size(), 500u);
+
+    EXPECT_FALSE(entry.IsSent());
+    EXPECT_EQ(entry.Consume(500), 0u);
+    EXPECT_TRUE(entry.IsSent());
+}
+
+TEST(SocketWriteQueueTest, EntryIsNotSplitAcrossWrites)
+{
+    uint8 const header[] = { 1, 2, 3, 4 };
+    SocketWriteEntry entry(header, sizeof(header), MakePayload(8));
+
+    Buffers buffers(3);
+    EXPECT_FALSE(entry.AppendTo(buffers));
+    EXPECT_EQ(buffers.size(), 3u);
+
+    buffers.pop_back();
+    EXPECT_TRUE(entry.AppendTo(buffers));
+    EXPECT_EQ(buffers.size(), 4u);
+}
@@ -0,0 +1,183 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "AuthClient.h"
+#include "BigNumber.h"
+#include "ByteBuffer.h"
+#include "SRP6.h"
+#include "StringFormat.h"
+#include "Util.h"
+#include <algorithm>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+
+namespace
+{
+    constexpr uint8 AUTH_LOGON_CHALLENGE = 0x00;
+    constexpr uint8 AUTH_LOGON_PROOF = 0x01;
+    constexpr uint8 WOW_SUCCESS = 0x00;
+
+    constexpr uint16 CLIENT_BUILD = 12340;
+
+    // cmd, error, M2, AccountFlags, SurveyId, LoginFlags
+    constexpr std::size_t LOGON_PROOF_RESPONSE_SIZE = 1 + 1 + 20 + 4 + 4 + 2;
+
+    using Acore::Crypto::SHA1;
+    using Acore::Crypto::SRP6;
+}
+
+Optional<SessionKey> AuthClient::Login(boost::asio::io_context& ioContext, std::string account, std::string password, std::string& error) const
+{
+    if (!Utf8ToUpperOnlyLatin(account) || !Utf8ToUpperOnlyLatin(password) || account.empty() || account.size() > 16)
+    {
+        error = "invalid account name or password";
+        return {};
+    }
+
+    boost::system::error_code ec;
+    boost::asio::ip::tcp::socket socket(ioContext);
+    socket.connect(_endpoint, ec);
+    if (ec)
+    {
+        error = "could not connect to the auth server: " + ec.message();
+        return {};
+    }
+
+    ByteBuffer challenge;
+    challenge << uint8(AUTH_LOGON_CHALLENGE);
+    challenge << uint8(8);                      // protocol version
+    challenge << uint16(30 + account.size());   // size of the packet after this field
+    challenge.append("WoW", 4);
+    challenge << uint8(3) << uint8(3) << uint8(5) << uint16(CLIENT_BUILD);
+    challenge.append("68x", 4);                 // platform, byte swapped
+    challenge.append("niW", 4);                 // os, byte swapped
+    challenge.append("SUne", 4);                // country, byte swapped
+    challenge << uint32(0);                     // timezone bias
+    challenge << uint32(0x0100007F);            // ip, not checked
+    challenge << uint8(account.size());
+    challenge.append(account.data(), account.size());
+
+    boost::asio::write(socket, boost::asio::buffer(challenge.contents(), challenge.size()), ec);
+
+    // cmd, unk, result, B, g_len, g, N_len, N, s, version challenge, security flags
+    ByteBuffer challengeResponse;
+    challengeResponse.resize(1 + 1 + 1 + 32 + 1 + 1 + 1 + 32 + 32 + 16 + 1);
+    if (!ec)
+        boost::asio::read(socket, boost::asio::buffer(challengeResponse.contents(), 3), ec);
+
+    if (ec)
+    {
+        error = "auth challenge failed: " + ec.message();
+        return {};
+    }
+
+    if (challengeResponse.contents()[2] != WOW_SUCCESS)
+    {
+        error = Acore::StringFormat("auth challenge rejected with error {}", challengeResponse.contents()[2]);
+        return {};
+    }
+
+    boost::asio::read(socket, boost::asio::buffer(challengeResponse.contents() + 3, challengeResponse.size() - 3), ec);
+    if (ec)
+    {
+        error = "auth challenge failed: " + ec.message();
+        return {};
+    }
+
+    SRP6::EphemeralKey B;
+    SRP6::Salt s;
+    challengeResponse.read_skip(3);
+    challengeResponse.read(B);
+    challengeResponse.read_skip(1 + 1 + 1 + 32);    // g and N, always the ones of SRP6
+    challengeResponse.read(s);
+    challengeResponse.read_skip(16);
+    if (challengeResponse.read<uint8>() != 0)
+    {
+        error = "the account requires a pin, matrix card or token";
+        return {};
+    }
+
+    // client side of SRP6, see SRP6::VerifyChallengeResponse for the server side
+    BigNumber const g(SRP6::g);
+    BigNumber const N(SRP6::N);
+
+    BigNumber a;
+    a.SetRand(19 * 8);
+    SRP6::EphemeralKey const A = g.ModExp(a, N).ToByteArray<SRP6::EPHEMERAL_KEY_LENGTH>();
+
+    BigNumber const x(SHA1::GetDigestOf(s, SHA1::GetDigestOf(account, ":", password)));
+    BigNumber const u(SHA1::GetDigestOf(A, B));
+
+    // S = (B - 3 * g^x) ^ (a + u * x) mod N, offset by 3N to stay positive
+    BigNumber const base = (BigNumber(B) + N * 3 - g.ModExp(x, N) * 3) % N;
+    SRP6::EphemeralKey const S = base.ModExp(a + u * x, N).ToByteArray<SRP6::EPHEMERAL_KEY_LENGTH>();
+    SessionKey const K = SRP6::SHA1Interleave(S);
+
+    SHA1::Digest const NHash = SHA1::GetDigestOf(SRP6::N);
+    SHA1::Digest const gHash = SHA1::GetDigestOf(SRP6::g);
+    SHA1::Digest NgHash;
+    std::transform(NHash.begin(), NHash.end(), gHash.begin(), NgHash.begin(), std::bit_xor<>());
+
+    SHA1::Digest const M1 = SHA1::GetDigestOf(NgHash, SHA1::GetDigestOf(account), s, A, B, K);
+
+    ByteBuffer proof;
+    proof << uint8(AUTH_LOGON_PROOF);
+    proof.append(A);
+    proof.append(M1);
+    proof.append(SHA1::Digest{});   // crc hash, not checked
+    proof << uint8(0);              // number of keys
+    proof << uint8(0);              // security flags
+
+    boost::asio::write(socket, boost::asio::buffer(proof.contents(), proof.size()), ec);
+
+    ByteBuffer proofResponse;
+    proofResponse.resize(LOGON_PROOF_RESPONSE_SIZE);
+    if (!ec)
+        boost::asio::read(socket, boost::asio::buffer(proofResponse.contents(), 2), ec);
+
+    if (ec)
+    {
+        error = "auth proof failed: " + ec.message();
+        return {};
+    }
+
+    if (proofResponse.contents()[1] != WOW_SUCCESS)
+    {
+        error = Acore::StringFormat("auth proof rejected with error {}, check the account password", proofResponse.contents()[1]);
+        return {};
+    }
+
+    boost::asio::read(socket, boost::asio::buffer(proofResponse.contents() + 2, proofResponse.size() - 2), ec);
+    if (ec)
+    {
+        error = "auth proof failed: " + ec.message();
+        return {};
+    }
+
+    SHA1::Digest M2;
+    proofResponse.read_skip(2);
+    proofResponse.read(M2);
+    if (M2 != SRP6::GetSessionVerifier(A, M1, K))
+    {
+        error = "the auth server proof does not match";
+        return {};
+    }
+
+    socket.close(ec);
+    return K;
+}
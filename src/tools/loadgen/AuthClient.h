@@ -0,0 +1,46 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _LOADGEN_AUTH_CLIENT_H
+#define _LOADGEN_AUTH_CLIENT_H
+
+#include "AuthDefines.h"
+#include "Optional.h"
+#include <boost/asio/ip/tcp.hpp>
+#include <string>
+
+/**
+ * Logs an account in on the auth server the way a 3.3.5a client does, so the
+ * world server accepts its session key.
+ *
+ * The connection is blocking and closed once the proof is accepted, the realm
+ * list is not requested: the world server address comes from the configuration.
+ */
+class AuthClient
+{
+public:
+    explicit AuthClient(boost::asio::ip::tcp::endpoint endpoint) : _endpoint(std::move(endpoint)) { }
+
+    // account and password are uppercased before use, error is set when no session key is returned
+    Optional<SessionKey> Login(boost::asio::io_context& ioContext, std::string account, std::string password, std::string& error) const;
+
+private:
+    boost::asio::ip::tcp::endpoint _endpoint;
+};
+
+#endif
@@ -0,0 +1,513 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "BotSocket.h"
+#include "CryptoHash.h"
+#include "CryptoRandom.h"
+#include "HMAC.h"
+#include "LoadStats.h"
+#include "Log.h"
+#include "Opcodes.h"
+#include "SharedDefines.h"
+#include <cmath>
+
+namespace
+{
+    constexpr uint32 CLIENT_BUILD = 12340;
+
+    constexpr uint32 MOVEMENTFLAG_NONE = 0x00000000;
+    constexpr uint32 MOVEMENTFLAG_FORWARD = 0x00000001;
+
+    // run speed of a player, bots walk MOVE_DISTANCE yards then turn around
+    constexpr float MOVE_SPEED = 7.0f;
+    constexpr float MOVE_DISTANCE = 10.0f;
+    constexpr Milliseconds MOVE_LEG_DURATION = Milliseconds(uint32(MOVE_DISTANCE / MOVE_SPEED * 1000));
+    constexpr Milliseconds MOVE_HEARTBEAT_INTERVAL = 500ms;
+
+    // the server counts pings closer than 27 seconds as overspeed
+    constexpr Milliseconds PING_INTERVAL = 30s;
+
+    // Character names only accept letters
+    std::string MakeCharacterName(uint32 index)
+    {
+        std::string suffix;
+        do
+        {
+            suffix.insert(suffix.begin(), char('a' + index % 26));
+            index /= 26;
+        } while (index);
+
+        return "Bot" + suffix;
+    }
+}
+
+BotSocket::BotSocket(tcp::socket&& socket, BotSettings const& settings, uint32 index, std::string account, SessionKey const& sessionKey)
+    : BaseSocket(std::move(socket)), _settings(settings), _index(index), _account(std::move(account)), _sessionKey(sessionKey),
+    _state(State::Authenticating), _cryptInitialized(false), _header(), _headerSize(0), _headerExpected(4), _readingPayload(false),
+    _payloadReceived(0), _guid(0), _characterCreated(false), _start(std::chrono::steady_clock::now()), _random(index), _x(0.0f), _y(0.0f), _z(0.0f),
+    _orientation(0.0f), _moving(false), _pingSequence(0), _castCount(0)
+{
+}
+
+void BotSocket::Start()
+{
+    SetNoDelay(true);
+    AsyncRead();
+}
+
+bool BotSocket::Update()
+{
+    if (!IsOpen())
+        return false;
+
+    if (_state == State::InWorld)
+        UpdateInWorld(std::chrono::steady_clock::now());
+
+    return BaseSocket::Update();
+}
+
+void BotSocket::OnClose()
+{
+    if (_state == State::InWorld)
+        sLoadStats->RemoveBotInWorld();
+    else
+        sLoadStats->AddBotFailed();
+
+    LOG_DEBUG("loadgen", "Bot {} ({}) disconnected", _index, _account);
+}
+
+void BotSocket::ReadHandler()
+{
+    if (!IsOpen())
+        return;
+
+    MessageBuffer& buffer = GetReadBuffer();
+    while (buffer.GetActiveSize() > 0)
+    {
+        if (!_readingPayload)
+        {
+            // headers are decrypted byte by byte, the first byte tells the header size
+            while (_headerSize < _headerExpected && buffer.GetActiveSize() > 0)
+            {
+                uint8 byte = *buffer.GetReadPointer();
+                buffer.ReadCompleted(1);
+
+                if (_cryptInitialized)
+                    _decrypt.UpdateData(&byte, 1);
+
+                if (_headerSize == 0 && (byte & 0x80))
+                    _headerExpected = 5;
+
+                _header[_headerSize++] = byte;
+            }
+
+            if (_headerSize < _headerExpected)
+                break;
+
+            // size is big endian and includes the opcode
+            std::size_t size = _headerExpected == 5 ? ((_header[0] & 0x7F) << 16) | (_header[1] << 8) | _header[2] : (_header[0] << 8) | _header[1];
+            if (size < 2)
+            {
+                LOG_ERROR("loadgen", "Bot {} received a packet header with size {}", _index, size);
+                CloseSocket();
+                return;
+            }
+
+            _payload.resize(size - 2);
+            _payloadReceived = 0;
+            _readingPayload = true;
+        }
+
+        std::size_t const readSize = std::min(buffer.GetActiveSize(), _payload.size() - _payloadReceived);
+        if (readSize)
+        {
+            std::memcpy(_payload.contents() + _payloadReceived, buffer.GetReadPointer(), readSize);
+            buffer.ReadCompleted(readSize);
+            _payloadReceived += readSize;
+        }
+
+        if (_payloadReceived < _payload.size())
+            break;
+
+        uint16 const opcode = _header[_headerExpected - 2] | (_header[_headerExpected - 1] << 8);
+        _headerSize = 0;
+        _headerExpected = 4;
+        _readingPayload = false;
+
+        sLoadStats->AddReceived(_payload.size() + 4);
+
+        bool handled;
+        try
+        {
+            handled = HandlePacket(opcode, _payload);
+        }
+        catch (ByteBufferException const&)
+        {
+            LOG_ERROR("loadgen", "Bot {} received a malformed packet {}", _index, opcode);
+            handled = false;
+        }
+
+        if (!handled)
+        {
+            CloseSocket();
+            return;
+        }
+    }
+
+    AsyncRead();
+}
+
+void BotSocket::SendPacket(uint16 opcode, ByteBuffer const& payload)
+{
+    // size is big endian and includes the 4 byte opcode
+    std::array<uint8, 6> header;
+    uint16 const size = uint16(payload.size() + 4);
+    header[0] = uint8(size >> 8);
+    header[1] = uint8(size);
+    header[2] = uint8(opcode);
+    header[3] = uint8(opcode >> 8);
+    header[4] = 0;
+    header[5] = 0;
+
+    if (_cryptInitialized)
+        _encrypt.UpdateData(header);
+
+    MessageBuffer buffer(header.size() + payload.size());
+    buffer.Write(header.data(), header.size());
+    if (!payload.empty())
+        buffer.Write(payload.contents(), payload.size());
+
+    sLoadStats->AddSent(buffer.GetActiveSize());
+    QueuePacket(std::move(buffer));
+}
+
+bool BotSocket::HandlePacket(uint16 opcode, ByteBuffer& packet)
+{
+    switch (opcode)
+    {
+        case SMSG_AUTH_CHALLENGE:
+            return HandleAuthChallenge(packet);
+        case SMSG_AUTH_RESPONSE:
+            return HandleAuthResponse(packet);
+        case SMSG_CHAR_ENUM:
+            return HandleCharEnum(packet);
+        case SMSG_CHAR_CREATE:
+            return HandleCharCreate(packet);
+        case SMSG_LOGIN_VERIFY_WORLD:
+            HandleLoginVerifyWorld(packet);
+            break;
+        case SMSG_MESSAGECHAT:
+            HandleMessageChat(packet);
+            break;
+        case SMSG_QUERY_TIME_RESPONSE:
+            if (_latencyRequest)
+            {
+                sLoadStats->AddLatency(std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - *_latencyRequest));
+                _latencyRequest.reset();
+            }
+            break;
+        case SMSG_TIME_SYNC_REQ:
+        {
+            ByteBuffer response(8);
+            response << packet.read<uint32>();
+            response << GetClientTime();
+            SendPacket(CMSG_TIME_SYNC_RESP, response);
+            break;
+        }
+        default:
+            break;
+    }
+
+    return true;
+}
+
+bool BotSocket::HandleAuthChallenge(ByteBuffer& packet)
+{
+    std::array<uint8, 4> serverSeed;
+    packet.read_skip<uint32>();
+    packet.read(serverSeed);
+
+    std::array<uint8, 4> const localChallenge = Acore::Crypto::GetRandomBytes<4>();
+    uint32 const zero = 0;
+
+    Acore::Crypto::SHA1 sha;
+    sha.UpdateData(_account);
+    sha.UpdateData(reinterpret_cast<uint8 const*>(&zero), sizeof(zero));
+    sha.UpdateData(localChallenge);
+    sha.UpdateData(serverSeed);
+    sha.UpdateData(_sessionKey);
+    sha.Finalize();
+
+    ByteBuffer authSession;
+    authSession << uint32(CLIENT_BUILD);
+    authSession << uint32(0);               // login server id
+    authSession << _account;
+    authSession << uint32(0);               // login server type
+    authSession.append(localChallenge);
+    authSession << uint32(0);               // region id
+    authSession << uint32(0);               // battlegroup id
+    authSession << uint32(_settings.RealmId);
+    authSession << uint64(0);               // dos response
+    authSession.append(sha.GetDigest());
+    authSession << uint32(0);               // no addon info
+
+    SendPacket(CMSG_AUTH_SESSION, authSession);
+
+    // everything after CMSG_AUTH_SESSION has encrypted headers, both ways
+    uint8 ServerEncryptionKey[] = { 0xCC, 0x98, 0xAE, 0x04, 0xE8, 0x97, 0xEA, 0xCA, 0x12, 0xDD, 0xC0, 0x93, 0x42, 0x91, 0x53, 0x57 };
+    _decrypt.Init(Acore::Crypto::HMAC_SHA1::GetDigestOf(ServerEncryptionKey, _sessionKey));
+
+    uint8 ServerDecryptionKey[] = { 0xC2, 0xB3, 0x72, 0x3C, 0xC6, 0xAE, 0xD9, 0xB5, 0x34, 0x3C, 0x53, 0xEE, 0x2F, 0x43, 0x67, 0xCE };
+    _encrypt.Init(Acore::Crypto::HMAC_SHA1::GetDigestOf(ServerDecryptionKey, _sessionKey));
+
+    // Drop first 1024 bytes, as WoW uses ARC4-drop1024.
+    std::array<uint8, 1024> syncBuf{};
+    _decrypt.UpdateData(syncBuf);
+    _encrypt.UpdateData(syncBuf);
+
+    _cryptInitialized = true;
+    return true;
+}
+
+bool BotSocket::HandleAuthResponse(ByteBuffer& packet)
+{
+    uint8 const code = packet.read<uint8>();
+    if (code == AUTH_WAIT_QUEUE)
+    {
+        LOG_DEBUG("loadgen", "Bot {} ({}) is in the login queue", _index, _account);
+        return true;
+    }
+
+    if (code != AUTH_OK)
+    {
+        LOG_ERROR("loadgen", "Bot {} ({}) was refused by the world server with code {}", _index, _account, code);
+        return false;
+    }
+
+    _state = State::SelectingCharacter;
+    SendPacket(CMSG_CHAR_ENUM, ByteBuffer(0));
+    return true;
+}
+
+bool BotSocket::HandleCharEnum(ByteBuffer& packet)
+{
+    if (packet.read<uint8>())
+    {
+        _guid = packet.read<uint64>();
+        _state = State::EnteringWorld;
+
+        ByteBuffer login(8);
+        login << uint64(_guid);
+        SendPacket(CMSG_PLAYER_LOGIN, login);
+        return true;
+    }
+
+    if (_characterCreated)
+    {
+        LOG_ERROR("loadgen", "Bot {} ({}) has no character after creating one", _index, _account);
+        return false;
+    }
+
+    // human warrior, the default spell is Battle Stance
+    ByteBuffer create;
+    create << MakeCharacterName(_index);
+    create << uint8(RACE_HUMAN) << uint8(CLASS_WARRIOR) << uint8(GENDER_MALE);
+    create << uint8(0) << uint8(0) << uint8(0) << uint8(0) << uint8(0); // skin, face, hair style, hair color, facial hair
+    create << uint8(0);                                                 // outfit id
+    SendPacket(CMSG_CHAR_CREATE, create);
+
+    _characterCreated = true;
+    return true;
+}
+
+bool BotSocket::HandleCharCreate(ByteBuffer& packet)
+{
+    uint8 const result = packet.read<uint8>();
+    if (result != CHAR_CREATE_SUCCESS)
+    {
+        LOG_ERROR("loadgen", "Bot {} ({}) could not create character {}, error {}", _index, _account, MakeCharacterName(_index), result);
+        return false;
+    }
+
+    SendPacket(CMSG_CHAR_ENUM, ByteBuffer(0));
+    return true;
+}
+
+void BotSocket::HandleLoginVerifyWorld(ByteBuffer& packet)
+{
+    packet.read_skip<uint32>();             // map
+    packet >> _x >> _y >> _z >> _orientation;
+
+    _state = State::InWorld;
+    sLoadStats->AddBotInWorld();
+    LOG_DEBUG("loadgen", "Bot {} ({}) entered the world", _index, _account);
+
+    // spread the actions of bots logging in together
+    TimePoint const now = std::chrono::steady_clock::now();
+    auto randomDelay = [this, now](Milliseconds interval)
+    {
+        return now + Milliseconds(interval.count() ? std::uniform_int_distribution<Milliseconds::rep>(0, interval.count())(_random) : 0);
+    };
+
+    _nextMove = randomDelay(_settings.MoveInterval);
+    _nextChat = randomDelay(_settings.ChatInterval);
+    _nextCast = randomDelay(_settings.CastInterval);
+    _nextAuction = randomDelay(_settings.AuctionInterval);
+    _nextLatency = randomDelay(_settings.LatencyInterval);
+    _nextServerInfo = now;
+    _nextPing = now + PING_INTERVAL;
+}
+
+void BotSocket::HandleMessageChat(ByteBuffer& packet)
+{
+    // only the replies to ".server info" are read
+    if (packet.read<uint8>() != CHAT_MSG_SYSTEM)
+        return;
+
+    packet.read_skip<int32>();              // language
+    packet.read_skip<uint64>();             // sender
+    packet.read_skip<uint32>();             // flags
+    packet.read_skip<uint64>();             // receiver
+    packet.read_skip<uint32>();             // text length
+    sLoadStats->ParseServerInfoLine(packet.ReadCString(false));
+}
+
+void BotSocket::UpdateInWorld(TimePoint now)
+{
+    if (_moving)
+    {
+        if (now - _moveStart >= MOVE_LEG_DURATION)
+        {
+            _x += std::cos(_orientation) * MOVE_DISTANCE;
+            _y += std::sin(_orientation) * MOVE_DISTANCE;
+            _moving = false;
+            SendMovement(MSG_MOVE_STOP, MOVEMENTFLAG_NONE);
+
+            _orientation = std::fmod(_orientation + float(M_PI), float(2 * M_PI));
+            SendMovement(MSG_MOVE_SET_FACING, MOVEMENTFLAG_NONE);
+        }
+        else if (now >= _nextHeartbeat)
+        {
+            _nextHeartbeat = now + MOVE_HEARTBEAT_INTERVAL;
+            SendMovement(MSG_MOVE_HEARTBEAT, MOVEMENTFLAG_FORWARD);
+        }
+    }
+    else if (IsDue(now, _nextMove, _settings.MoveInterval))
+    {
+        _moving = true;
+        _moveStart = now;
+        _nextHeartbeat = now + MOVE_HEARTBEAT_INTERVAL;
+        SendMovement(MSG_MOVE_START_FORWARD, MOVEMENTFLAG_FORWARD);
+    }
+
+    if (IsDue(now, _nextChat, _settings.ChatInterval))
+    {
+        ByteBuffer chat;
+        chat << uint32(CHAT_MSG_SAY) << uint32(LANG_COMMON);
+        chat << Acore::StringFormat("load test message {}", std::uniform_int_distribution<uint32>()(_random));
+        SendPacket(CMSG_MESSAGECHAT, chat);
+        sLoadStats->AddAction(BotAction::Chat);
+    }
+
+    if (_settings.SpellId && IsDue(now, _nextCast, _settings.CastInterval))
+    {
+        ByteBuffer cast(10);
+        cast << uint8(++_castCount);
+        cast << uint32(_settings.SpellId);
+        cast << uint8(0);                   // cast flags
+        cast << uint32(0);                  // target mask, self
+        SendPacket(CMSG_CAST_SPELL, cast);
+        sLoadStats->AddAction(BotAction::Cast);
+    }
+
+    if (_settings.AuctioneerGuid && IsDue(now, _nextAuction, _settings.AuctionInterval))
+    {
+        ByteBuffer search;
+        search << uint64(_settings.AuctioneerGuid);
+        search << uint32(0);                // list from
+        search << std::string();            // name
+        search << uint8(0) << uint8(0);     // level range
+        search << int32(-1) << int32(-1) << int32(-1) << int32(-1); // slot, class, subclass, quality
+        search << uint8(0);                 // usable only
+        search << uint8(0);                 // get all
+        search << uint8(0);                 // sort count
+        SendPacket(CMSG_AUCTION_LIST_ITEMS, search);
+        sLoadStats->AddAction(BotAction::AuctionSearch);
+    }
+
+    if (!_latencyRequest && IsDue(now, _nextLatency, _settings.LatencyInterval))
+    {
+        _latencyRequest = now;
+        SendPacket(CMSG_QUERY_TIME, ByteBuffer(0));
+    }
+
+    // a single bot asks for the world update times
+    if (_index == 0 && IsDue(now, _nextServerInfo, _settings.ServerInfoInterval))
+    {
+        ByteBuffer chat;
+        chat << uint32(CHAT_MSG_SAY) << uint32(LANG_COMMON);
+        chat << std::string(".server info");
+        SendPacket(CMSG_MESSAGECHAT, chat);
+    }
+
+    if (now >= _nextPing)
+    {
+        _nextPing = now + PING_INTERVAL;
+
+        ByteBuffer ping(8);
+        ping << uint32(++_pingSequence);
+        ping << uint32(0);                  // latency
+        SendPacket(CMSG_PING, ping);
+    }
+}
+
+void BotSocket::SendMovement(uint16 opcode, uint32 movementFlags)
+{
+    float x = _x;
+    float y = _y;
+    if (_moving)
+    {
+        float const distance = std::chrono::duration<float>(std::chrono::steady_clock::now() - _moveStart).count() * MOVE_SPEED;
+        x += std::cos(_orientation) * std::min(distance, MOVE_DISTANCE);
+        y += std::sin(_orientation) * std::min(distance, MOVE_DISTANCE);
+    }
+
+    ByteBuffer movement(40);
+    movement.appendPackGUID(_guid);
+    movement << uint32(movementFlags);
+    movement << uint16(0);                  // extra movement flags
+    movement << GetClientTime();
+    movement << x << y << _z << _orientation;
+    movement << uint32(0);                  // fall time
+    SendPacket(opcode, movement);
+    sLoadStats->AddAction(BotAction::Move);
+}
+
+bool BotSocket::IsDue(TimePoint now, TimePoint& next, Milliseconds interval)
+{
+    if (interval == 0ms || now < next)
+        return false;
+
+    next = now + interval;
+    return true;
+}
+
+uint32 BotSocket::GetClientTime() const
+{
+    return uint32(std::chrono::duration_cast<Milliseconds>(std::chrono::steady_clock::now() - _start).count());
+}
@@ -0,0 +1,140 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _LOADGEN_BOT_SOCKET_H
+#define _LOADGEN_BOT_SOCKET_H
+
+#include "ARC4.h"
+#include "AuthDefines.h"
+#include "ByteBuffer.h"
+#include "Duration.h"
+#include "Optional.h"
+#include "Socket.h"
+#include <array>
+#include <random>
+
+// Behaviour of the bots, read once from the configuration
+struct BotSettings
+{
+    uint32 RealmId = 1;
+
+    // zero disables the action
+    Milliseconds MoveInterval = 0ms;
+    Milliseconds ChatInterval = 0ms;
+    Milliseconds CastInterval = 0ms;
+    Milliseconds AuctionInterval = 0ms;
+    Milliseconds LatencyInterval = 0ms;
+    Milliseconds ServerInfoInterval = 0ms;
+
+    uint32 SpellId = 0;
+    uint64 AuctioneerGuid = 0;
+};
+
+/**
+ * One client connected to the world server, driven by the network thread it was added to.
+ *
+ * The bot sends CMSG_AUTH_SESSION with the session key obtained from the auth server,
+ * creates a character when the account has none, enters the world with the first
+ * character and then repeats the configured actions until the connection is closed.
+ */
+class BotSocket : public Socket<BotSocket>
+{
+    using BaseSocket = Socket<BotSocket>;
+
+public:
+    BotSocket(tcp::socket&& socket, BotSettings const& settings, uint32 index, std::string account, SessionKey const& sessionKey);
+
+    BotSocket(BotSocket const&) = delete;
+    BotSocket& operator=(BotSocket const&) = delete;
+
+    void Start() override;
+    bool Update() override;
+
+protected:
+    void OnClose() override;
+    void ReadHandler() override;
+
+private:
+    enum class State : uint8
+    {
+        Authenticating,
+        SelectingCharacter,
+        EnteringWorld,
+        InWorld
+    };
+
+    // encrypts the header once the session is authenticated
+    void SendPacket(uint16 opcode, ByteBuffer const& payload);
+
+    bool HandlePacket(uint16 opcode, ByteBuffer& packet);
+    bool HandleAuthChallenge(ByteBuffer& packet);
+    bool HandleAuthResponse(ByteBuffer& packet);
+    bool HandleCharEnum(ByteBuffer& packet);
+    bool HandleCharCreate(ByteBuffer& packet);
+    void HandleLoginVerifyWorld(ByteBuffer& packet);
+    void HandleMessageChat(ByteBuffer& packet);
+
+    void UpdateInWorld(TimePoint now);
+    void SendMovement(uint16 opcode, uint32 movementFlags);
+
+    bool IsDue(TimePoint now, TimePoint& next, Milliseconds interval);
+    uint32 GetClientTime() const;
+
+    BotSettings const& _settings;
+    uint32 _index;
+    std::string _account;
+    SessionKey _sessionKey;
+    State _state;
+
+    Acore::Crypto::ARC4 _encrypt;
+    Acore::Crypto::ARC4 _decrypt;
+    bool _cryptInitialized;
+
+    // server header, 4 bytes or 5 for packets larger than 0x7FFF bytes
+    std::array<uint8, 5> _header;
+    std::size_t _headerSize;
+    std::size_t _headerExpected;
+    bool _readingPayload;
+    ByteBuffer _payload;
+    std::size_t _payloadReceived;
+
+    uint64 _guid;
+    bool _characterCreated;
+    TimePoint _start;
+    std::mt19937 _random;
+
+    // position from SMSG_LOGIN_VERIFY_WORLD, bots walk back and forth from there
+    float _x, _y, _z, _orientation;
+    bool _moving;
+    TimePoint _moveStart;
+    TimePoint _nextHeartbeat;
+
+    TimePoint _nextMove;
+    TimePoint _nextChat;
+    TimePoint _nextCast;
+    TimePoint _nextAuction;
+    TimePoint _nextLatency;
+    TimePoint _nextServerInfo;
+    TimePoint _nextPing;
+
+    Optional<TimePoint> _latencyRequest;
+    uint32 _pingSequence;
+    uint8 _castCount;
+};
+
+#endif
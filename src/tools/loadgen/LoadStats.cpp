@@ -0,0 +1,91 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "LoadStats.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+LoadStats* LoadStats::instance()
+{
+    static LoadStats instance;
+    return &instance;
+}
+
+void LoadStats::AddLatency(Microseconds latency)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _latencies.push_back(latency);
+}
+
+bool LoadStats::ParseServerInfoLine(std::string_view line)
+{
+    std::string const text(line);
+    unsigned last, count, mean, median, p95, p99, max;
+
+    std::lock_guard<std::mutex> lock(_lock);
+    if (std::sscanf(text.c_str(), "Update time diff: %ums. Last %u diffs summary:", &last, &count) == 2)
+        _updateTime.Last = last;
+    else if (std::sscanf(text.c_str(), "|- Mean: %ums", &mean) == 1)
+        _updateTime.Mean = mean;
+    else if (std::sscanf(text.c_str(), "|- Median: %ums", &median) == 1)
+        _updateTime.Median = median;
+    else if (std::sscanf(text.c_str(), "|- Percentiles (95, 99, max): %ums, %ums, %ums", &p95, &p99, &max) == 3)
+    {
+        _updateTime.P95 = p95;
+        _updateTime.P99 = p99;
+        _updateTime.Max = max;
+        _hasUpdateTime = true;
+    }
+    else
+        return false;
+
+    return true;
+}
+
+LoadReport LoadStats::Consume()
+{
+    LoadReport report;
+    report.BotsInWorld = _botsInWorld.load();
+    report.BotsFailed = _botsFailed.load();
+    report.PacketsSent = _packetsSent.exchange(0, std::memory_order_relaxed);
+    report.PacketsReceived = _packetsReceived.exchange(0, std::memory_order_relaxed);
+    report.BytesSent = _bytesSent.exchange(0, std::memory_order_relaxed);
+    report.BytesReceived = _bytesReceived.exchange(0, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < report.Actions.size(); ++i)
+        report.Actions[i] = _actions[i].exchange(0, std::memory_order_relaxed);
+
+    std::vector<Microseconds> latencies;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        latencies.swap(_latencies);
+        report.HasServerUpdateTime = _hasUpdateTime;
+        report.UpdateTime = _updateTime;
+    }
+
+    report.LatencySamples = latencies.size();
+    if (!latencies.empty())
+    {
+        std::sort(latencies.begin(), latencies.end());
+        report.LatencyP50 = latencies[latencies.size() / 2];
+        report.LatencyP99 = latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+        report.LatencyMax = latencies.back();
+    }
+
+    return report;
+}
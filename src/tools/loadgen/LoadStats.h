@@ -0,0 +1,125 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _LOADGEN_LOAD_STATS_H
+#define _LOADGEN_LOAD_STATS_H
+
+#include "Define.h"
+#include "Duration.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+enum class BotAction : uint8
+{
+    Move,
+    Chat,
+    Cast,
+    AuctionSearch,
+
+    Max
+};
+
+// World update times reported by ".server info", read from sWorldUpdateTime on the server
+struct ServerUpdateTime
+{
+    uint32 Last = 0;
+    uint32 Mean = 0;
+    uint32 Median = 0;
+    uint32 P95 = 0;
+    uint32 P99 = 0;
+    uint32 Max = 0;
+};
+
+// Totals since the previous report
+struct LoadReport
+{
+    uint32 BotsInWorld = 0;
+    uint32 BotsFailed = 0;
+    uint64 PacketsSent = 0;
+    uint64 PacketsReceived = 0;
+    uint64 BytesSent = 0;
+    uint64 BytesReceived = 0;
+    std::array<uint64, std::size_t(BotAction::Max)> Actions{};
+
+    // round trips of CMSG_QUERY_TIME, answered during the world or map update
+    std::size_t LatencySamples = 0;
+    Microseconds LatencyP50 = 0us;
+    Microseconds LatencyP99 = 0us;
+    Microseconds LatencyMax = 0us;
+
+    bool HasServerUpdateTime = false;
+    ServerUpdateTime UpdateTime;
+};
+
+/**
+ * Counters updated by the bots on the network threads and read by the report loop.
+ */
+class LoadStats
+{
+public:
+    static LoadStats* instance();
+
+    void AddBotInWorld() { ++_botsInWorld; }
+    void RemoveBotInWorld() { --_botsInWorld; }
+    void AddBotFailed() { ++_botsFailed; }
+
+    void AddSent(std::size_t bytes)
+    {
+        _packetsSent.fetch_add(1, std::memory_order_relaxed);
+        _bytesSent.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    void AddReceived(std::size_t bytes)
+    {
+        _packetsReceived.fetch_add(1, std::memory_order_relaxed);
+        _bytesReceived.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    void AddAction(BotAction action) { _actions[std::size_t(action)].fetch_add(1, std::memory_order_relaxed); }
+
+    void AddLatency(Microseconds latency);
+
+    // Parses the update time lines of ".server info", returns false for any other message
+    bool ParseServerInfoLine(std::string_view line);
+
+    // Returns the counters accumulated since the previous call
+    LoadReport Consume();
+
+private:
+    LoadStats() = default;
+
+    std::atomic<uint32> _botsInWorld{0};
+    std::atomic<uint32> _botsFailed{0};
+    std::atomic<uint64> _packetsSent{0};
+    std::atomic<uint64> _packetsReceived{0};
+    std::atomic<uint64> _bytesSent{0};
+    std::atomic<uint64> _bytesReceived{0};
+    std::array<std::atomic<uint64>, std::size_t(BotAction::Max)> _actions{};
+
+    std::mutex _lock;
+    std::vector<Microseconds> _latencies;
+    ServerUpdateTime _updateTime;
+    bool _hasUpdateTime = false;
+};
+
+#define sLoadStats LoadStats::instance()
+
+#endif
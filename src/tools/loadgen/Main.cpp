@@ -0,0 +1,359 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/** \file
+    \ingroup loadgen
+    Headless 3.3.5a clients logging in and playing on a test realm, to measure the server under load.
+*/
+
+#include "AuthClient.h"
+#include "Banner.h"
+#include "BotSocket.h"
+#include "Config.h"
+#include "DatabaseEnv.h"
+#include "DatabaseLoader.h"
+#include "IoContext.h"
+#include "LoadStats.h"
+#include "Log.h"
+#include "MySQLThreading.h"
+#include "NetworkThread.h"
+#include "OpenSSLCrypto.h"
+#include "Resolver.h"
+#include "SRP6.h"
+#include "Util.h"
+#include <boost/program_options.hpp>
+#include <boost/version.hpp>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <openssl/crypto.h>
+#include <openssl/opensslv.h>
+#include <thread>
+
+#ifndef _ACORE_LOADGEN_CONFIG
+#define _ACORE_LOADGEN_CONFIG "loadgen.conf"
+#endif
+
+using namespace boost::program_options;
+namespace fs = std::filesystem;
+
+namespace
+{
+    std::atomic<bool> StopRequested{false};
+
+    void SignalHandler(int /*signal*/)
+    {
+        StopRequested = true;
+    }
+
+    // Accounts are named <Prefix><index>, starting at 1
+    std::string GetAccountName(uint32 index)
+    {
+        return Acore::StringFormat("{}{}", sConfigMgr->GetOption<std::string>("LoadGen.Accounts.Prefix", "LOADBOT"), index + 1);
+    }
+
+    bool CreateAccounts(uint32 count, std::string const& password);
+    void LogReport(std::ofstream& reportFile, Seconds elapsed);
+}
+
+variables_map GetConsoleArguments(int argc, char** argv, fs::path& configFile);
+
+/// Launch the load generator
+int main(int argc, char** argv)
+{
+    signal(SIGABRT, &Acore::AbortHandler);
+
+    // Command line parsing
+    auto configFile = fs::path(sConfigMgr->GetConfigPath() + std::string(_ACORE_LOADGEN_CONFIG));
+    auto vm = GetConsoleArguments(argc, argv, configFile);
+
+    // exit if help is enabled
+    if (vm.count("help"))
+        return 0;
+
+    // Add file and args in config
+    sConfigMgr->Configure(configFile.generic_string(), std::vector<std::string>(argv, argv + argc));
+
+    if (!sConfigMgr->LoadAppConfigs())
+        return 1;
+
+    std::vector<std::string> overriddenKeys = sConfigMgr->OverrideWithEnvVariablesIfAny();
+
+    // Init logging
+    sLog->Initialize();
+
+    Acore::Banner::Show("loadgen",
+        [](std::string_view text)
+        {
+            LOG_INFO("loadgen", text);
+        },
+        []()
+        {
+            LOG_INFO("loadgen", "> Using configuration file:       {}", sConfigMgr->GetFilename());
+            LOG_INFO("loadgen", "> Using SSL version:              {} (library: {})", OPENSSL_VERSION_TEXT, OpenSSL_version(OPENSSL_VERSION));
+            LOG_INFO("loadgen", "> Using Boost version:            {}.{}.{}", BOOST_VERSION / 100000, BOOST_VERSION / 100 % 1000, BOOST_VERSION % 100);
+        }
+    );
+
+    for (std::string const& key : overriddenKeys)
+        LOG_INFO("loadgen", "Configuration field {} was overridden with environment variable.", key);
+
+    OpenSSLCrypto::threadsSetup();
+
+    std::shared_ptr<void> opensslHandle(nullptr, [](void*) { OpenSSLCrypto::threadsCleanup(); });
+
+    uint32 const botCount = sConfigMgr->GetOption<uint32>("LoadGen.Accounts.Count", 100);
+    std::string const password = sConfigMgr->GetOption<std::string>("LoadGen.Accounts.Password", "loadbot");
+
+    if (sConfigMgr->GetOption<bool>("LoadGen.Accounts.Create", false) && !CreateAccounts(botCount, password))
+        return 1;
+
+    BotSettings settings;
+    settings.RealmId = sConfigMgr->GetOption<uint32>("LoadGen.RealmID", 1);
+    settings.MoveInterval = Milliseconds(sConfigMgr->GetOption<uint32>("LoadGen.MoveInterval", 3000));
+    settings.ChatInterval = Milliseconds(sConfigMgr->GetOption<uint32>("LoadGen.ChatInterval", 30000));
+    settings.CastInterval = Milliseconds(sConfigMgr->GetOption<uint32>("LoadGen.CastInterval", 10000));
+    settings.SpellId = sConfigMgr->GetOption<uint32>("LoadGen.SpellId", 2457);
+    settings.AuctionInterval = Milliseconds(sConfigMgr->GetOption<uint32>("LoadGen.AuctionInterval", 60000));
+    settings.AuctioneerGuid = sConfigMgr->GetOption<uint64>("LoadGen.AuctioneerGuid", 0);
+    settings.LatencyInterval = Milliseconds(sConfigMgr->GetOption<uint32>("LoadGen.LatencyInterval", 5000));
+
+    Seconds const reportInterval = Seconds(std::max<uint32>(1, sConfigMgr->GetOption<uint32>("LoadGen.ReportInterval", 10)));
+    settings.ServerInfoInterval = reportInterval;
+
+    Acore::Asio::IoContext ioContext;
+    Acore::Asio::Resolver resolver(ioContext);
+
+    std::string const authHost = sConfigMgr->GetOption<std::string>("LoadGen.AuthServer", "127.0.0.1");
+    std::string const worldHost = sConfigMgr->GetOption<std::string>("LoadGen.WorldServer", "127.0.0.1");
+    Optional<boost::asio::ip::tcp::endpoint> authEndpoint = resolver.Resolve(boost::asio::ip::tcp::v4(), authHost, std::to_string(sConfigMgr->GetOption<uint16>("LoadGen.AuthPort", 3724)));
+    Optional<boost::asio::ip::tcp::endpoint> worldEndpoint = resolver.Resolve(boost::asio::ip::tcp::v4(), worldHost, std::to_string(sConfigMgr->GetOption<uint16>("LoadGen.WorldPort", 8085)));
+    if (!authEndpoint || !worldEndpoint)
+    {
+        LOG_ERROR("loadgen", "Could not resolve {}", !authEndpoint ? authHost : worldHost);
+        return 1;
+    }
+
+    std::ofstream reportFile;
+    if (std::string const reportPath = sConfigMgr->GetOption<std::string>("LoadGen.ReportFile", ""); !reportPath.empty())
+    {
+        reportFile.open(reportPath, std::ios::trunc);
+        if (!reportFile)
+        {
+            LOG_ERROR("loadgen", "Could not open report file {}", reportPath);
+            return 1;
+        }
+
+        reportFile << "elapsed_s,bots_in_world,bots_failed,packets_sent,packets_received,bytes_sent,bytes_received,"
+            "moves,chats,casts,auction_searches,latency_samples,latency_p50_us,latency_p99_us,latency_max_us,"
+            "server_update_last_ms,server_update_mean_ms,server_update_median_ms,server_update_p95_ms,server_update_p99_ms,server_update_max_ms\n";
+    }
+
+    int32 const networkThreads = std::max<int32>(1, sConfigMgr->GetOption<int32>("LoadGen.NetworkThreads", 1));
+    std::unique_ptr<NetworkThread<BotSocket>[]> threads(new NetworkThread<BotSocket>[networkThreads]);
+    for (int32 i = 0; i < networkThreads; ++i)
+        threads[i].Start();
+
+    signal(SIGINT, &SignalHandler);
+    signal(SIGTERM, &SignalHandler);
+
+    AuthClient const authClient(*authEndpoint);
+    uint32 const loginRate = std::max<uint32>(1, sConfigMgr->GetOption<uint32>("LoadGen.LoginRate", 10));
+    Seconds const duration = Seconds(sConfigMgr->GetOption<uint32>("LoadGen.Duration", 600));
+
+    LOG_INFO("loadgen", "Logging in {} bots on {}:{}, {} per second", botCount, worldEndpoint->address().to_string(), worldEndpoint->port(), loginRate);
+
+    TimePoint const start = std::chrono::steady_clock::now();
+    TimePoint nextLogin = start;
+    TimePoint nextReport = start + reportInterval;
+    uint32 loggedIn = 0;
+
+    while (!StopRequested && (duration == 0s || std::chrono::steady_clock::now() - start < duration))
+    {
+        TimePoint const now = std::chrono::steady_clock::now();
+        if (loggedIn < botCount && now >= nextLogin)
+        {
+            uint32 const index = loggedIn++;
+            nextLogin += Microseconds(1000000 / loginRate);
+
+            std::string const account = GetAccountName(index);
+            std::string error;
+            Optional<SessionKey> sessionKey = authClient.Login(ioContext, account, password, error);
+            if (!sessionKey)
+            {
+                LOG_ERROR("loadgen", "Bot {} ({}) could not log in: {}", index, account, error);
+                sLoadStats->AddBotFailed();
+                continue;
+            }
+
+            // pick the network thread with the least bots, the socket is then only used by that thread
+            int32 thread = 0;
+            for (int32 i = 1; i < networkThreads; ++i)
+                if (threads[i].GetConnectionCount() < threads[thread].GetConnectionCount())
+                    thread = i;
+
+            boost::system::error_code ec;
+            tcp::socket socket(threads[thread].GetSocketForAccept()->get_executor());
+            socket.connect(*worldEndpoint, ec);
+            if (ec)
+            {
+                LOG_ERROR("loadgen", "Bot {} ({}) could not connect to the world server: {}", index, account, ec.message());
+                sLoadStats->AddBotFailed();
+                continue;
+            }
+
+            // the account name is the one the session key was stored for
+            std::string upperAccount = account;
+            Utf8ToUpperOnlyLatin(upperAccount);
+            threads[thread].AddSocket(std::make_shared<BotSocket>(std::move(socket), settings, index, upperAccount, *sessionKey));
+            continue;
+        }
+
+        if (now >= nextReport)
+        {
+            nextReport += reportInterval;
+            LogReport(reportFile, std::chrono::duration_cast<Seconds>(now - start));
+        }
+
+        std::this_thread::sleep_until(loggedIn < botCount ? std::min(nextLogin, nextReport) : nextReport);
+    }
+
+    LogReport(reportFile, std::chrono::duration_cast<Seconds>(std::chrono::steady_clock::now() - start));
+    LOG_INFO("loadgen", "Stopping, disconnecting all bots");
+
+    for (int32 i = 0; i < networkThreads; ++i)
+        threads[i].Stop();
+
+    for (int32 i = 0; i < networkThreads; ++i)
+        threads[i].Wait();
+
+    LOG_INFO("loadgen", "Halting process...");
+
+    return 0;
+}
+
+namespace
+{
+    /// Creates or resets the bot accounts, needs write access to the auth database of the test realm
+    bool CreateAccounts(uint32 count, std::string const& password)
+    {
+        MySQL::Library_Init();
+
+        DatabaseLoader loader("loadgen", DatabaseLoader::DATABASE_NONE);
+        loader.AddDatabase(LoginDatabase, "Login");
+
+        if (!loader.Load())
+            return false;
+
+        std::string upperPassword = password;
+        Utf8ToUpperOnlyLatin(upperPassword);
+
+        constexpr uint32 ACCOUNTS_PER_QUERY = 100;
+        for (uint32 first = 0; first < count; first += ACCOUNTS_PER_QUERY)
+        {
+            std::string values;
+            for (uint32 index = first; index < std::min(count, first + ACCOUNTS_PER_QUERY); ++index)
+            {
+                std::string account = GetAccountName(index);
+                Utf8ToUpperOnlyLatin(account);
+
+                auto [salt, verifier] = Acore::Crypto::SRP6::MakeRegistrationData(account, upperPassword);
+                if (!values.empty())
+                    values += ", ";
+
+                values += Acore::StringFormat("('{}', 0x{}, 0x{}, 2, '', '', NOW())", account, ByteArrayToHexStr(salt), ByteArrayToHexStr(verifier));
+            }
+
+            LoginDatabase.DirectExecute("INSERT INTO account (username, salt, verifier, expansion, reg_mail, email, joindate) VALUES {} "
+                "ON DUPLICATE KEY UPDATE salt = VALUES(salt), verifier = VALUES(verifier)", values);
+        }
+
+        LOG_INFO("loadgen", "Created or reset {} bot accounts.", count);
+
+        LoginDatabase.Close();
+        MySQL::Library_End();
+        return true;
+    }
+
+    void LogReport(std::ofstream& reportFile, Seconds elapsed)
+    {
+        LoadReport const report = sLoadStats->Consume();
+        auto const& actions = report.Actions;
+
+        LOG_INFO("loadgen", "[{}s] {} bots in world, {} failed | sent {} packets ({} bytes), received {} packets ({} bytes) | "
+            "moves {}, chats {}, casts {}, auction searches {}",
+            elapsed.count(), report.BotsInWorld, report.BotsFailed, report.PacketsSent, report.BytesSent, report.PacketsReceived, report.BytesReceived,
+            actions[std::size_t(BotAction::Move)], actions[std::size_t(BotAction::Chat)], actions[std::size_t(BotAction::Cast)],
+            actions[std::size_t(BotAction::AuctionSearch)]);
+
+        if (report.LatencySamples)
+            LOG_INFO("loadgen", "[{}s] query time round trip over {} samples: p50 {}us, p99 {}us, max {}us",
+                elapsed.count(), report.LatencySamples, report.LatencyP50.count(), report.LatencyP99.count(), report.LatencyMax.count());
+
+        if (report.HasServerUpdateTime)
+            LOG_INFO("loadgen", "[{}s] server update time: last {}ms, mean {}ms, median {}ms, p95 {}ms, p99 {}ms, max {}ms",
+                elapsed.count(), report.UpdateTime.Last, report.UpdateTime.Mean, report.UpdateTime.Median,
+                report.UpdateTime.P95, report.UpdateTime.P99, report.UpdateTime.Max);
+
+        if (!reportFile.is_open())
+            return;
+
+        reportFile << elapsed.count() << ',' << report.BotsInWorld << ',' << report.BotsFailed << ','
+            << report.PacketsSent << ',' << report.PacketsReceived << ',' << report.BytesSent << ',' << report.BytesReceived;
+
+        for (uint64 count : actions)
+            reportFile << ',' << count;
+
+        reportFile << ',' << report.LatencySamples << ',' << report.LatencyP50.count() << ',' << report.LatencyP99.count() << ',' << report.LatencyMax.count();
+
+        if (report.HasServerUpdateTime)
+            reportFile << ',' << report.UpdateTime.Last << ',' << report.UpdateTime.Mean << ',' << report.UpdateTime.Median
+                << ',' << report.UpdateTime.P95 << ',' << report.UpdateTime.P99 << ',' << report.UpdateTime.Max;
+        else
+            reportFile << ",,,,,,";
+
+        reportFile << std::endl;
+    }
+}
+
+variables_map GetConsoleArguments(int argc, char** argv, fs::path& configFile)
+{
+    options_description all("Allowed options");
+    all.add_options()
+        ("help,h", "print usage message")
+        ("version,v", "print version build info")
+        ("config,c", value<fs::path>(&configFile)->default_value(fs::path(sConfigMgr->GetConfigPath() + std::string(_ACORE_LOADGEN_CONFIG))), "use <arg> as configuration file");
+
+    variables_map variablesMap;
+
+    try
+    {
+        store(command_line_parser(argc, argv).options(all).allow_unregistered().run(), variablesMap);
+        notify(variablesMap);
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << e.what() << "\n";
+    }
+
+    if (variablesMap.count("help"))
+        std::cout << all << "\n";
+
+    return variablesMap;
+}